@@ -197,6 +197,10 @@ std::shared_ptr<Analyzer::Expr> OffsetInFragment::deep_copy() const {
   return makeExpr<OffsetInFragment>();
 }
 
+std::shared_ptr<Analyzer::Expr> RangeOper::deep_copy() const {
+  return makeExpr<RangeOper>(operand_->deep_copy(), distance_->deep_copy(), is_geodesic_);
+}
+
 std::shared_ptr<Analyzer::Expr> WindowFunction::deep_copy() const {
   return makeExpr<WindowFunction>(
       type_info, kind_, args_, partition_keys_, order_keys_, collation_);
@@ -2335,6 +2339,15 @@ bool OffsetInFragment::operator==(const Expr& rhs) const {
   return typeid(rhs) == typeid(OffsetInFragment);
 }
 
+bool RangeOper::operator==(const Expr& rhs) const {
+  if (typeid(rhs) != typeid(RangeOper)) {
+    return false;
+  }
+  const RangeOper& rhs_rg = dynamic_cast<const RangeOper&>(rhs);
+  return is_geodesic_ == rhs_rg.is_geodesic() && *operand_ == *rhs_rg.get_operand() &&
+         *distance_ == *rhs_rg.get_distance();
+}
+
 bool WindowFunction::operator==(const Expr& rhs) const {
   const auto rhs_window = dynamic_cast<const WindowFunction*>(&rhs);
   if (!rhs_window) {
@@ -2714,6 +2727,11 @@ std::string OffsetInFragment::toString() const {
   return "(OffsetInFragment) ";
 }
 
+std::string RangeOper::toString() const {
+  return "(RangeOper " + operand_->toString() + " WITHIN " + distance_->toString() +
+         (is_geodesic_ ? " GEODESIC" : "") + ") ";
+}
+
 std::string WindowFunction::toString() const {
   std::string result = "WindowFunction(" + ::toString(kind_);
   for (const auto& arg : args_) {
@@ -1406,6 +1406,52 @@ class OffsetInFragment : public Expr {
   std::string toString() const override;
 };
 
+/*
+ * @type RangeOper
+ * @brief All values within a distance of an expression. Only used as the inner operand
+ * of an overlaps join qual for distance joins, e.g. ST_DWithin(a.pt, b.pt, r). The
+ * distance is in meters on the WGS84 sphere when geodesic, in coordinate units otherwise.
+ */
+class RangeOper : public Expr {
+ public:
+  RangeOper(std::shared_ptr<Analyzer::Expr> operand,
+            std::shared_ptr<Analyzer::Expr> distance,
+            const bool is_geodesic)
+      : Expr(operand->get_type_info())
+      , operand_(operand)
+      , distance_(distance)
+      , is_geodesic_(is_geodesic) {
+    CHECK(operand_);
+    CHECK(distance_);
+  }
+
+  const Expr* get_operand() const { return operand_.get(); }
+  const std::shared_ptr<Analyzer::Expr> get_own_operand() const { return operand_; }
+  const Expr* get_distance() const { return distance_.get(); }
+  bool is_geodesic() const { return is_geodesic_; }
+
+  std::shared_ptr<Analyzer::Expr> deep_copy() const override;
+  void collect_rte_idx(std::set<int>& rte_idx_set) const override {
+    operand_->collect_rte_idx(rte_idx_set);
+    distance_->collect_rte_idx(rte_idx_set);
+  }
+  void collect_column_var(
+      std::set<const ColumnVar*, bool (*)(const ColumnVar*, const ColumnVar*)>&
+          colvar_set,
+      bool include_agg) const override {
+    operand_->collect_column_var(colvar_set, include_agg);
+    distance_->collect_column_var(colvar_set, include_agg);
+  }
+
+  bool operator==(const Expr& rhs) const override;
+  std::string toString() const override;
+
+ private:
+  std::shared_ptr<Analyzer::Expr> operand_;
+  std::shared_ptr<Analyzer::Expr> distance_;
+  bool is_geodesic_;
+};
+
 /*
  * @type OrderEntry
  * @brief represents an entry in ORDER BY clause.
@@ -4674,6 +4674,27 @@ std::vector<const TableDescriptor*> Catalog::getAllForeignTablesForRefresh() con
   return tables;
 }
 
+std::vector<const foreign_storage::ForeignTable*>
+Catalog::getAllForeignTablesForFileChangeRefresh() const {
+  cat_read_lock read_lock(this);
+  std::vector<const foreign_storage::ForeignTable*> tables;
+  for (auto entry : tableDescriptorMapById_) {
+    auto table_descriptor = entry.second;
+    if (table_descriptor->storageType == StorageType::FOREIGN_TABLE) {
+      auto foreign_table = dynamic_cast<foreign_storage::ForeignTable*>(table_descriptor);
+      CHECK(foreign_table);
+      auto timing_type_entry = foreign_table->options.find(
+          foreign_storage::ForeignTable::REFRESH_TIMING_TYPE_KEY);
+      CHECK(timing_type_entry != foreign_table->options.end());
+      if (timing_type_entry->second ==
+          foreign_storage::ForeignTable::FILE_CHANGE_REFRESH_TIMING_TYPE) {
+        tables.emplace_back(foreign_table);
+      }
+    }
+  }
+  return tables;
+}
+
 void Catalog::updateForeignTableRefreshTimes(const int32_t table_id) {
   cat_write_lock write_lock(this);
   cat_sqlite_lock sqlite_lock(getObjForLock());
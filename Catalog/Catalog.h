@@ -449,6 +449,15 @@ class Catalog final {
    */
   std::vector<const TableDescriptor*> getAllForeignTablesForRefresh() const;
 
+  /**
+   * Gets all the foreign tables that are configured for refreshes on changes to their
+   * source files.
+   *
+   * @return foreign tables refreshed on file changes
+   */
+  std::vector<const foreign_storage::ForeignTable*>
+  getAllForeignTablesForFileChangeRefresh() const;
+
   /**
    * Updates the last and next (if applicable) refresh times of the foreign table
    * with the given table id.
@@ -18,11 +18,13 @@
 
 #include <regex>
 
+#include "DataMgr/ForeignStorage/AbstractFileStorageDataWrapper.h"
 #include "DataMgr/ForeignStorage/ForeignDataWrapperFactory.h"
 #include "Shared/DateTimeParser.h"
 #include "Shared/misc.h"
 
 bool g_enable_seconds_refresh{false};
+bool g_enable_foreign_table_file_change_refresh{false};
 
 namespace foreign_storage {
 ForeignTable::ForeignTable()
@@ -117,11 +119,37 @@ void ForeignTable::validateRefreshOptionValues() const {
                                  std::string{REFRESH_INTERVAL_KEY} + " option."};
       }
     }
+  } else if (refresh_timing_value == FILE_CHANGE_REFRESH_TIMING_TYPE) {
+    if (!g_enable_foreign_table_file_change_refresh) {
+      throw std::runtime_error{
+          "File change refreshes are disabled. Restart the server with "
+          "\"enable-foreign-table-file-change-refresh\" enabled."};
+    }
+    auto storage_type_entry = foreign_server->options.find(
+        AbstractFileStorageDataWrapper::STORAGE_TYPE_KEY);
+    if (storage_type_entry == foreign_server->options.end() ||
+        storage_type_entry->second !=
+            AbstractFileStorageDataWrapper::LOCAL_FILE_STORAGE_TYPE) {
+      throw std::runtime_error{
+          "File change refreshes are only supported for foreign tables with a " +
+          AbstractFileStorageDataWrapper::LOCAL_FILE_STORAGE_TYPE + " storage type."};
+    }
   } else if (refresh_timing_value != MANUAL_REFRESH_TIMING_TYPE) {
     throw std::runtime_error{"Invalid value provided for the " +
                              std::string{REFRESH_TIMING_TYPE_KEY} +
                              " option. Value must be \"" + MANUAL_REFRESH_TIMING_TYPE +
-                             "\" or \"" + SCHEDULE_REFRESH_TIMING_TYPE + "\"."};
+                             "\", \"" + SCHEDULE_REFRESH_TIMING_TYPE + "\" or \"" +
+                             FILE_CHANGE_REFRESH_TIMING_TYPE + "\"."};
+  }
+
+  auto max_staleness_entry = options.find(REFRESH_MAX_STALENESS_KEY);
+  if (max_staleness_entry != options.end()) {
+    boost::regex max_staleness_regex{"^\\d{1,}[SHD]$",
+                                     boost::regex::extended | boost::regex::icase};
+    if (!boost::regex_match(max_staleness_entry->second, max_staleness_regex)) {
+      throw std::runtime_error{"Invalid value provided for the " +
+                               std::string{REFRESH_MAX_STALENESS_KEY} + " option."};
+    }
   }
 }
 
@@ -43,11 +43,13 @@ struct ForeignTable : public TableDescriptor, public OptionsContainer {
   static constexpr const char* REFRESH_START_DATE_TIME_KEY = "REFRESH_START_DATE_TIME";
   static constexpr const char* REFRESH_INTERVAL_KEY = "REFRESH_INTERVAL";
   static constexpr const char* REFRESH_UPDATE_TYPE_KEY = "REFRESH_UPDATE_TYPE";
+  static constexpr const char* REFRESH_MAX_STALENESS_KEY = "REFRESH_MAX_STALENESS";
   // Option values
   static constexpr const char* ALL_REFRESH_UPDATE_TYPE = "ALL";
   static constexpr const char* APPEND_REFRESH_UPDATE_TYPE = "APPEND";
   static constexpr const char* SCHEDULE_REFRESH_TIMING_TYPE = "SCHEDULED";
   static constexpr const char* MANUAL_REFRESH_TIMING_TYPE = "MANUAL";
+  static constexpr const char* FILE_CHANGE_REFRESH_TIMING_TYPE = "FILE_CHANGE";
   static constexpr int NULL_REFRESH_TIME = -1;
 
   const ForeignServer* foreign_server;
@@ -57,19 +59,22 @@ struct ForeignTable : public TableDescriptor, public OptionsContainer {
                                                               REFRESH_TIMING_TYPE_KEY,
                                                               REFRESH_START_DATE_TIME_KEY,
                                                               REFRESH_INTERVAL_KEY,
-                                                              REFRESH_UPDATE_TYPE_KEY};
+                                                              REFRESH_UPDATE_TYPE_KEY,
+                                                              REFRESH_MAX_STALENESS_KEY};
 
   inline static const std::set<const char*> upper_case_options{
       REFRESH_TIMING_TYPE_KEY,
       REFRESH_START_DATE_TIME_KEY,
       REFRESH_INTERVAL_KEY,
-      REFRESH_UPDATE_TYPE_KEY};
+      REFRESH_UPDATE_TYPE_KEY,
+      REFRESH_MAX_STALENESS_KEY};
 
   // We don't want all options to be alterable, so this contains a subset.
   inline static const std::set<const char*> alterable_options{REFRESH_TIMING_TYPE_KEY,
                                                               REFRESH_START_DATE_TIME_KEY,
                                                               REFRESH_INTERVAL_KEY,
-                                                              REFRESH_UPDATE_TYPE_KEY};
+                                                              REFRESH_UPDATE_TYPE_KEY,
+                                                              REFRESH_MAX_STALENESS_KEY};
 
   /**
     @brief Verifies the values for mapped options are valid.
@@ -28,6 +28,7 @@
 #include "DataMgr/BufferMgr/Buffer.h"
 #include "DataMgr/ForeignStorage/ForeignStorageException.h"
 #include "Logger/Logger.h"
+#include "Shared/Metrics.h"
 #include "Shared/measure.h"
 
 using namespace std;
@@ -57,6 +58,7 @@ BufferMgr::BufferMgr(const int device_id,
     , max_slab_size_(max_slab_size)
     , page_size_(page_size)
     , num_pages_allocated_(0)
+    , num_pages_in_use_(0)
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
@@ -103,6 +105,7 @@ void BufferMgr::clear() {
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
+  num_pages_in_use_ = 0;
   buffer_epoch_ = 0;
 }
 
@@ -152,6 +155,9 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunk_key,
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
                                       const size_t num_pages_requested,
                                       const int slab_num) {
+  static auto& evictions = metrics::Registry::instance().counter(
+      "omnisci_buffer_pool_evictions_total",
+      "Chunks evicted from the CPU and GPU buffer pools to make room for others.");
   // We can assume here that buffer for evictStart either doesn't exist
   // (evictStart is first buffer) or was not free, so don't need ot merge
   // it
@@ -163,8 +169,12 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
       CHECK(evict_it->buffer->getPinCount() < 1);
     }
     num_pages += evict_it->num_pages;
+    if (evict_it->mem_status == USED) {
+      num_pages_in_use_ -= evict_it->num_pages;
+    }
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
+      evictions.increment();
     }
     evict_it = slab_segments_[slab_num].erase(
         evict_it);  // erase operations returns next iterator - safe if we ever move
@@ -174,6 +184,7 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
       start_page, num_pages_requested, USED, buffer_epoch_++);  // until we can
   // data_seg.pinCount++;
   data_seg.slab_num = slab_num;
+  num_pages_in_use_ += num_pages_requested;
   auto data_seg_it =
       slab_segments_[slab_num].insert(evict_it, data_seg);  // Will insert before evict_it
   if (num_pages_requested < num_pages) {
@@ -210,6 +221,7 @@ BufferList::iterator BufferMgr::reserveBuffer(
       // Then we can just use the next BufferSeg which happens to be free
       size_t leftover_pages = next_it->num_pages - num_pages_extra_needed;
       seg_it->num_pages = num_pages_requested;
+      num_pages_in_use_ += num_pages_extra_needed;
       next_it->num_pages = leftover_pages;
       next_it->start_page = seg_it->start_page + seg_it->num_pages;
       return seg_it;
@@ -255,6 +267,7 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
       size_t excess_pages = buffer_it->num_pages - num_pages_requested;
       buffer_it->num_pages = num_pages_requested;
       buffer_it->mem_status = USED;
+      num_pages_in_use_ += num_pages_requested;
       buffer_it->last_touched = buffer_epoch_++;
       buffer_it->slab_num = slab_num;
       if (excess_pages > 0) {
@@ -504,17 +517,10 @@ size_t BufferMgr::getPageSize() {
   return page_size_;
 }
 
-// return the size of the chunks in use in bytes
+// return the size of the chunks in use in bytes, kept up to date as the segments are
+// used and freed so that it can be read without walking the segment lists
 size_t BufferMgr::getInUseSize() {
-  size_t in_use = 0;
-  for (auto& segment_list : slab_segments_) {
-    for (auto& segment : segment_list) {
-      if (segment.mem_status != FREE) {
-        in_use += segment.num_pages * page_size_;
-      }
-    }
-  }
-  return in_use;
+  return num_pages_in_use_ * page_size_;
 }
 
 std::string BufferMgr::printSeg(BufferList::iterator& seg_it) {
@@ -644,6 +650,9 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
     unsized_segs_.erase(seg_it);
   } else {
+    if (seg_it->mem_status == USED) {
+      num_pages_in_use_ -= seg_it->num_pages;
+    }
     if (seg_it != slab_segments_[slab_num].begin()) {
       auto prev_it = std::prev(seg_it);
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
@@ -828,6 +837,21 @@ AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key,
   return buffer;
 }
 
+bool BufferMgr::insertFetchedBuffer(const ChunkKey& key, AbstractBuffer* src_buffer) {
+  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+  {
+    std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+    if (chunk_index_.find(key) != chunk_index_.end()) {
+      return false;
+    }
+  }
+  // createBuffer pins for us
+  AbstractBuffer* buffer = createBuffer(key, page_size_, src_buffer->size());
+  src_buffer->copyTo(buffer, src_buffer->size());
+  buffer->unPin();
+  return true;
+}
+
 int BufferMgr::getBufferId() {
   std::lock_guard<std::mutex> lock(buffer_id_mutex_);
   return max_buffer_id_++;
@@ -26,6 +26,7 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
@@ -152,6 +153,9 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   AbstractBuffer* putBuffer(const ChunkKey& key,
                             AbstractBuffer* d,
                             const size_t num_bytes = 0) override;
+  /// Inserts, unpinned, a copy of a chunk the caller fetched from the parent manager.
+  /// Returns false if the chunk is in the pool already.
+  bool insertFetchedBuffer(const ChunkKey& key, AbstractBuffer* src_buffer);
   void checkpoint() override;
   void checkpoint(const int db_id, const int tb_id) override;
   void removeTableRelatedDS(const int db_id, const int table_id) override;
@@ -201,7 +205,9 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   std::map<ChunkKey, BufferList::iterator> chunk_index_;
   size_t max_buffer_pool_num_pages_;  // max number of pages for buffer pool
-  size_t num_pages_allocated_;
+  // read by the buffer pool metrics without the locks of the segment lists
+  std::atomic<size_t> num_pages_allocated_;
+  std::atomic<size_t> num_pages_in_use_;
   size_t min_num_pages_per_slab_;
   size_t max_num_pages_per_slab_;
   size_t current_max_slab_page_size_;
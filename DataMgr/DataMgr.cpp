@@ -23,8 +23,10 @@
 #include "BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "BufferMgr/GpuCudaBufferMgr/GpuCudaBufferMgr.h"
 #include "CudaMgr/CudaMgr.h"
+#include "ForeignStorage/ForeignStorageBuffer.h"
 #include "FileMgr/GlobalFileMgr.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
+#include "Shared/Metrics.h"
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -70,9 +72,11 @@ DataMgr::DataMgr(const std::string& dataDir,
 
   populateMgrs(system_parameters, numReaderThreads, cache_config);
   createTopLevelMetadata();
+  registerBufferPoolMetrics();
 }
 
 DataMgr::~DataMgr() {
+  unregisterBufferPoolMetrics();
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
     for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
@@ -165,6 +169,7 @@ size_t DataMgr::getTotalSystemMemory() {
 void DataMgr::resetPersistentStorage(const DiskCacheConfig& cache_config,
                                      const size_t num_reader_threads,
                                      const SystemParameters& sys_params) {
+  unregisterBufferPoolMetrics();
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
     for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
@@ -174,6 +179,43 @@ void DataMgr::resetPersistentStorage(const DiskCacheConfig& cache_config,
   bufferMgrs_.clear();
   populateMgrs(sys_params, num_reader_threads, cache_config);
   createTopLevelMetadata();
+  registerBufferPoolMetrics();
+}
+
+void DataMgr::registerBufferPoolMetrics() {
+  auto& registry = metrics::Registry::instance();
+  // the disk level is not a buffer pool
+  for (size_t level = MemoryLevel::CPU_LEVEL; level < bufferMgrs_.size(); ++level) {
+    for (size_t device = 0; device < bufferMgrs_[level].size(); ++device) {
+      const auto labels = "level=\"" +
+                          std::string(level == MemoryLevel::CPU_LEVEL ? "cpu" : "gpu") +
+                          "\",device=\"" + std::to_string(device) + "\"";
+      auto buffer_mgr = bufferMgrs_[level][device];
+      metrics_handles_.push_back(registry.addCallbackGauge(
+          "omnisci_buffer_pool_max_bytes",
+          "Maximum size of the buffer pool.",
+          labels,
+          [buffer_mgr] { return buffer_mgr->getMaxSize(); }));
+      metrics_handles_.push_back(registry.addCallbackGauge(
+          "omnisci_buffer_pool_allocated_bytes",
+          "Bytes allocated to the buffer pool.",
+          labels,
+          [buffer_mgr] { return buffer_mgr->getAllocated(); }));
+      metrics_handles_.push_back(registry.addCallbackGauge(
+          "omnisci_buffer_pool_in_use_bytes",
+          "Bytes of the buffer pool held by chunks.",
+          labels,
+          [buffer_mgr] { return buffer_mgr->getInUseSize(); }));
+    }
+  }
+}
+
+void DataMgr::unregisterBufferPoolMetrics() {
+  auto& registry = metrics::Registry::instance();
+  for (const auto handle : metrics_handles_) {
+    registry.removeCallbackGauge(handle);
+  }
+  metrics_handles_.clear();
 }
 
 void DataMgr::populateMgrs(const SystemParameters& system_parameters,
@@ -422,6 +464,25 @@ AbstractBuffer* DataMgr::createChunkBuffer(const ChunkKey& key,
   return bufferMgrs_[level][deviceId]->createBuffer(key, page_size);
 }
 
+bool DataMgr::readAheadChunk(const ChunkKey& key, const size_t num_bytes) {
+  // the persistent storage synchronizes the fetches itself
+  foreign_storage::ForeignStorageBuffer staging_buffer;
+  getPersistentStorageMgr()->fetchBuffer(key, &staging_buffer, num_bytes);
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  auto cpu_buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+      bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+  CHECK(cpu_buffer_mgr);
+  return cpu_buffer_mgr->insertFetchedBuffer(key, &staging_buffer);
+}
+
+size_t DataMgr::getCpuBufferPoolFreeSize() {
+  // Without the buffer access lock, which the chunk fetches hold while they read: the
+  // maximum size is constant and the size in use is kept in an atomic counter.
+  auto cpu_buffer_mgr = bufferMgrs_[MemoryLevel::CPU_LEVEL][0];
+  const auto max_size = cpu_buffer_mgr->getMaxSize();
+  return max_size - std::min(cpu_buffer_mgr->getInUseSize(), max_size);
+}
+
 AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
                                         const MemoryLevel memoryLevel,
                                         const int deviceId,
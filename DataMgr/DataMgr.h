@@ -191,6 +191,13 @@ class DataMgr {
   bool isBufferOnDevice(const ChunkKey& key,
                         const MemoryLevel memLevel,
                         const int deviceId);
+  // Loads a chunk from the persistent storage into the CPU buffer pool, unpinned. The
+  // chunk is read into a staging buffer first, without holding the buffer pool locks
+  // the chunk fetches of the running kernels wait on. Returns false if the chunk got
+  // into the pool meanwhile.
+  bool readAheadChunk(const ChunkKey& key, const size_t num_bytes);
+  // Bytes of the CPU buffer pool not in use by chunks, allocated in slabs or not.
+  size_t getCpuBufferPoolFreeSize();
   std::vector<MemoryInfo> getMemoryInfo(const MemoryLevel memLevel);
   std::string dumpLevel(const MemoryLevel memLevel);
   void clearMemory(const MemoryLevel memLevel);
@@ -238,6 +245,10 @@ class DataMgr {
   void convertDB(const std::string basePath);
   void checkpoint();  // checkpoint for whole DB, called from convertDB proc only
   void createTopLevelMetadata() const;
+  // Exposes the sizes of the CPU and GPU buffer pools as callback gauges, the gauges
+  // have to be unregistered before the buffer managers are destroyed.
+  void registerBufferPoolMetrics();
+  void unregisterBufferPoolMetrics();
 
   std::vector<std::vector<AbstractBufferMgr*>> bufferMgrs_;
   std::unique_ptr<CudaMgr_Namespace::CudaMgr> cudaMgr_;
@@ -245,6 +256,7 @@ class DataMgr {
   bool hasGpus_;
   size_t reservedGpuMem_;
   std::mutex buffer_access_mutex_;
+  std::vector<size_t> metrics_handles_;
 };
 
 std::ostream& operator<<(std::ostream& os, const DataMgr::SystemMemoryUsage&);
@@ -58,6 +58,7 @@ void FileInfo::initNewFile() {
 }
 
 size_t FileInfo::write(const size_t offset, const size_t size, int8_t* buf) {
+  fileMgr->invalidatePageManifest();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   isDirty = true;
   return File_Namespace::write(f, offset, size, buf);
@@ -204,6 +205,7 @@ static void sighandler(int sig) {
 #endif
 
 void FileInfo::freePage(int pageId, const bool isRolloff) {
+  fileMgr->invalidatePageManifest();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
 #define RESILIENT_PAGE_HEADER
 #ifdef RESILIENT_PAGE_HEADER
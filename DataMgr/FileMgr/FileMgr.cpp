@@ -24,6 +24,7 @@
 
 #include <fcntl.h>
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <string>
@@ -31,20 +32,27 @@
 #include <utility>
 #include <vector>
 
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/error_code.hpp>
 
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
+#include "OSDependent/omnisci_fs.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/measure.h"
+#include "Shared/scope.h"
 
 constexpr char LEGACY_EPOCH_FILENAME[] = "epoch";
 constexpr char EPOCH_FILENAME[] = "epoch_metadata";
 constexpr char DB_META_FILENAME[] = "dbmeta";
 constexpr char FILE_MGR_VERSION_FILENAME[] = "filemgr_version";
 constexpr int32_t INVALID_VERSION = -1;
+constexpr int32_t PAGE_MANIFEST_MAGIC = 0x4d50464f;  // "OFPM"
+constexpr int32_t PAGE_MANIFEST_VERSION = 1;
+
+bool g_enable_page_manifest{true};
 
 using namespace std;
 
@@ -255,19 +263,32 @@ void FileMgr::clearFileInfos() {
 void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride) {
   // if epochCeiling = -1 this means open from epoch file
 
+  page_manifest_enabled_ = g_enable_page_manifest && hasFileMgrKey();
+  auto clock_begin = timer_start();
   const bool dataExists = coreInit();
   if (dataExists) {
     if (epochOverride != -1) {  // if opening at specified epoch
       setEpoch(epochOverride);
     }
-
-    auto open_files_result = openFiles();
+    const auto epoch_files_ms = timer_stop(clock_begin);
+
+    OpenFilesResult open_files_result;
+    const bool from_page_manifest =
+        page_manifest_enabled_ && openFilesFromPageManifest(open_files_result);
+    if (!from_page_manifest) {
+      if (!g_read_only) {
+        // The scan below may fix up page headers, which a stale manifest doesn't know
+        removePageManifest();
+      }
+      open_files_result = openFiles();
+    }
     if (!open_files_result.compaction_status_file_name.empty()) {
       resumeFileCompaction(open_files_result.compaction_status_file_name);
       clearFileInfos();
       open_files_result = openFiles();
       CHECK(open_files_result.compaction_status_file_name.empty());
     }
+    const auto page_headers_ms = timer_stop(clock_begin) - epoch_files_ms;
 
     /* Sort headerVec so that all HeaderInfos
      * from a chunk will be grouped together
@@ -299,9 +320,19 @@ void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride)
           new FileBuffer(this, /*pageSize,*/ lastChunkKey, startIt, header_vec.end());
     }
     nextFileId_ = open_files_result.max_file_id + 1;
+    const auto chunk_index_ms =
+        timer_stop(clock_begin) - epoch_files_ms - page_headers_ms;
     rollOffOldData(epoch(), true /* only checkpoint if data is rolled off */);
     incrementEpoch();
     freePages();
+    const auto total_ms = timer_stop(clock_begin);
+    LOG(INFO) << "Opened " << describeSelf() << " in " << total_ms
+              << "ms (epoch and version files: " << epoch_files_ms
+              << "ms, page headers from "
+              << (from_page_manifest ? "page manifest: " : "page scan: ")
+              << page_headers_ms << "ms, chunk index of " << chunkIndex_.size()
+              << " chunks: " << chunk_index_ms << "ms, roll off: "
+              << total_ms - epoch_files_ms - page_headers_ms - chunk_index_ms << "ms)";
   } else {
     boost::filesystem::path path(fileMgrBasePath_);
     if (!boost::filesystem::create_directory(path)) {
@@ -713,6 +744,7 @@ void FileMgr::checkpoint() {
   rollOffOldData(epoch(), false /* shouldCheckpoint */);
   syncFilesToDisk();
   writeAndSyncEpochToDisk();
+  writePageManifest();
   incrementEpoch();
   freePages();  // write free_page mutex.
 }
@@ -761,6 +793,11 @@ void FileMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
   // chunkIt->second->writeMetadata(-1); // writes -1 as epoch - signifies deleted
   if (purge) {
     chunkIt->second->freePages();
+  } else {
+    // The pages are still on disk and a page scan would bring the chunk back, so the
+    // manifest can't describe the files anymore
+    page_manifest_enabled_ = false;
+    invalidatePageManifest();
   }
   //@todo need a way to represent delete in non purge case
   delete chunkIt->second;
@@ -780,6 +817,9 @@ void FileMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const bool purg
                      keyPrefix.end()) != chunkIt->first.begin() + keyPrefix.size()) {
     if (purge) {
       chunkIt->second->freePages();
+    } else {
+      page_manifest_enabled_ = false;
+      invalidatePageManifest();
     }
     //@todo need a way to represent delete in non purge case
     delete chunkIt->second;
@@ -981,6 +1021,7 @@ FileInfo* FileMgr::createFile(const size_t pageSize, const size_t numPages) {
   if (pageSize == 0 || numPages == 0) {
     LOG(FATAL) << "File creation failed: pageSize and numPages must be greater than 0.";
   }
+  invalidatePageManifest();
 
   // create the new file
   FILE* f = create(fileMgrBasePath_,
@@ -1582,6 +1623,311 @@ void FileMgr::freePages() {
   free_pages_.clear();
 }
 
+namespace {
+// Appends the raw bytes of a fixed size value to the page manifest.
+template <typename T>
+void append_to_manifest(std::vector<int8_t>& manifest, const T value) {
+  static_assert(std::is_trivially_copyable<T>::value);
+  const auto bytes = reinterpret_cast<const int8_t*>(&value);
+  manifest.insert(manifest.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds checked reader over the mapped page manifest.
+class PageManifestReader {
+ public:
+  PageManifestReader(const int8_t* begin, const int8_t* end) : ptr_(begin), end_(end) {}
+
+  template <typename T>
+  bool read(T& value) {
+    if (ptr_ + sizeof(T) > end_) {
+      return false;
+    }
+    std::memcpy(&value, ptr_, sizeof(T));
+    ptr_ += sizeof(T);
+    return true;
+  }
+
+  bool atEnd() const { return ptr_ == end_; }
+
+ private:
+  const int8_t* ptr_;
+  const int8_t* end_;
+};
+
+uint32_t page_manifest_checksum(const int8_t* data, const size_t size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+// Makes a file creation, rename or removal in the directory durable.
+void sync_directory(const boost::filesystem::path& path) {
+#ifndef _WIN32
+  const auto fd = omnisci::open(path.string().c_str(), O_RDONLY, 0);
+  CHECK_GE(fd, 0) << "Could not open directory " << path;
+  CHECK_EQ(omnisci::fsync(fd), 0) << "Could not sync directory " << path;
+  omnisci::close(fd);
+#endif
+}
+}  // namespace
+
+/**
+ * Writes the page headers of all chunks as of the checkpoint being completed, along with
+ * the files they live in. The manifest is written to a temporary file and renamed over
+ * the previous one, and it is removed again by the first page write after the checkpoint.
+ */
+void FileMgr::writePageManifest() {
+  if (!page_manifest_enabled_ || g_read_only) {
+    return;
+  }
+  auto timer = DEBUG_TIMER(__func__);
+  std::vector<int8_t> manifest;
+  append_to_manifest(manifest, PAGE_MANIFEST_MAGIC);
+  append_to_manifest(manifest, PAGE_MANIFEST_VERSION);
+  append_to_manifest(manifest, epoch());
+  {
+    mapd_shared_lock<mapd_shared_mutex> files_read_lock(files_rw_mutex_);
+    append_to_manifest(manifest, static_cast<int64_t>(files_.size()));
+    for (const auto& [file_id, file_info] : files_) {
+      append_to_manifest(manifest, file_id);
+      append_to_manifest(manifest, static_cast<int64_t>(file_info->pageSize));
+      append_to_manifest(manifest, static_cast<int64_t>(file_info->numPages));
+    }
+  }
+  {
+    mapd_shared_lock<mapd_shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+    const auto chunk_count_offset = manifest.size();
+    int64_t chunk_count{0};
+    append_to_manifest(manifest, chunk_count);
+    for (const auto& [chunk_key, buffer] : chunkIndex_) {
+      const auto& metadata_versions = buffer->metadataPages_.pageVersions;
+      if (metadata_versions.empty()) {
+        if (!buffer->multiPages_.empty()) {
+          LOG(WARNING) << "Chunk " << show_chunk(chunk_key)
+                       << " has no metadata page, skipping the page manifest of "
+                       << describeSelf();
+          return;
+        }
+        // Never written, a page scan wouldn't find it either
+        continue;
+      }
+      chunk_count++;
+      append_to_manifest(manifest, static_cast<int32_t>(chunk_key.size()));
+      for (const auto key_component : chunk_key) {
+        append_to_manifest(manifest, key_component);
+      }
+      int64_t page_count = metadata_versions.size();
+      for (const auto& multi_page : buffer->multiPages_) {
+        page_count += multi_page.pageVersions.size();
+      }
+      append_to_manifest(manifest, page_count);
+      auto append_page = [&manifest](const int32_t page_id,
+                                     const EpochedPage& epoched_page) {
+        append_to_manifest(manifest, page_id);
+        append_to_manifest(manifest, epoched_page.epoch);
+        append_to_manifest(manifest, epoched_page.page.fileId);
+        append_to_manifest(manifest, static_cast<int64_t>(epoched_page.page.pageNum));
+      };
+      for (const auto& epoched_page : metadata_versions) {
+        append_page(-1, epoched_page);
+      }
+      for (size_t page_id = 0; page_id < buffer->multiPages_.size(); ++page_id) {
+        for (const auto& epoched_page : buffer->multiPages_[page_id].pageVersions) {
+          append_page(page_id, epoched_page);
+        }
+      }
+    }
+    std::memcpy(&manifest[chunk_count_offset], &chunk_count, sizeof(chunk_count));
+  }
+  append_to_manifest(manifest, page_manifest_checksum(manifest.data(), manifest.size()));
+
+  std::lock_guard<std::mutex> page_manifest_lock(page_manifest_mutex_);
+  const auto manifest_path = getFilePath(PAGE_MANIFEST);
+  auto temp_path = manifest_path;
+  temp_path += ".tmp";
+  auto manifest_file = omnisci::fopen(temp_path.string().c_str(), "wb");
+  CHECK(manifest_file) << "Could not create page manifest " << temp_path;
+  const auto bytes_written =
+      fwrite(manifest.data(), sizeof(int8_t), manifest.size(), manifest_file);
+  CHECK_EQ(bytes_written, manifest.size()) << "Could not write page manifest";
+  CHECK_EQ(fflush(manifest_file), 0) << "Could not flush page manifest";
+  CHECK_EQ(omnisci::fsync(fileno(manifest_file)), 0) << "Could not sync page manifest";
+  fclose(manifest_file);
+  boost::filesystem::rename(temp_path, manifest_path);
+  sync_directory(fileMgrBasePath_);
+  page_manifest_on_disk_ = true;
+}
+
+void FileMgr::invalidatePageManifest() {
+  if (!page_manifest_on_disk_) {
+    return;
+  }
+  std::lock_guard<std::mutex> page_manifest_lock(page_manifest_mutex_);
+  if (page_manifest_on_disk_) {
+    removePageManifest();
+  }
+}
+
+void FileMgr::removePageManifest() {
+  if (boost::filesystem::remove(getFilePath(PAGE_MANIFEST))) {
+    // The removal has to be durable before the page write which invalidated the
+    // manifest lands on disk
+    sync_directory(fileMgrBasePath_);
+  }
+  page_manifest_on_disk_ = false;
+}
+
+bool FileMgr::openFilesFromPageManifest(OpenFilesResult& result) {
+  auto clock_begin = timer_start();
+  const auto manifest_path = getFilePath(PAGE_MANIFEST);
+  if (!boost::filesystem::exists(manifest_path)) {
+    return false;
+  }
+  const auto fd = omnisci::open(manifest_path.string().c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return false;
+  }
+  ScopeGuard close_manifest = [fd] { omnisci::close(fd); };
+  const auto manifest_size = omnisci::file_size(fd);
+  constexpr size_t min_manifest_size =
+      3 * sizeof(int32_t) + 2 * sizeof(int64_t) + sizeof(uint32_t);
+  if (manifest_size < min_manifest_size) {
+    LOG(WARNING) << "Page manifest of " << describeSelf() << " is truncated";
+    return false;
+  }
+  const auto manifest =
+      reinterpret_cast<const int8_t*>(omnisci::checked_mmap(fd, manifest_size));
+  ScopeGuard unmap_manifest = [manifest, manifest_size] {
+    omnisci::checked_munmap(const_cast<int8_t*>(manifest), manifest_size);
+  };
+
+  const auto payload_size = manifest_size - sizeof(uint32_t);
+  uint32_t checksum;
+  std::memcpy(&checksum, manifest + payload_size, sizeof(checksum));
+  if (checksum != page_manifest_checksum(manifest, payload_size)) {
+    LOG(WARNING) << "Page manifest of " << describeSelf() << " failed its checksum";
+    return false;
+  }
+  PageManifestReader reader(manifest, manifest + payload_size);
+  int32_t magic, version, manifest_epoch;
+  reader.read(magic);
+  reader.read(version);
+  reader.read(manifest_epoch);
+  if (magic != PAGE_MANIFEST_MAGIC || version != PAGE_MANIFEST_VERSION) {
+    LOG(WARNING) << "Unsupported page manifest version " << version << " for "
+                 << describeSelf();
+    return false;
+  }
+  if (manifest_epoch != epoch()) {
+    LOG(INFO) << "Page manifest of " << describeSelf() << " is at epoch "
+              << manifest_epoch << " rather than " << epoch();
+    return false;
+  }
+
+  // The data files on disk have to be exactly the ones of the manifest
+  std::map<int32_t, FileMetadata> data_files;
+  boost::filesystem::directory_iterator end_itr;
+  for (boost::filesystem::directory_iterator file_it(fileMgrBasePath_);
+       file_it != end_itr;
+       ++file_it) {
+    if (is_compaction_status_file(file_it->path().filename().string())) {
+      return false;
+    }
+    auto file_metadata = getMetadataForFile(file_it);
+    if (file_metadata.is_data_file) {
+      data_files.emplace(file_metadata.file_id, std::move(file_metadata));
+    }
+  }
+  int64_t file_count;
+  if (!reader.read(file_count) || file_count != static_cast<int64_t>(data_files.size())) {
+    return false;
+  }
+  std::map<int32_t, std::vector<bool>> used_pages;
+  for (int64_t i = 0; i < file_count; ++i) {
+    int32_t file_id;
+    int64_t page_size, num_pages;
+    if (!reader.read(file_id) || !reader.read(page_size) || !reader.read(num_pages)) {
+      return false;
+    }
+    const auto it = data_files.find(file_id);
+    if (it == data_files.end() || it->second.page_size != size_t(page_size) ||
+        it->second.num_pages != size_t(num_pages)) {
+      return false;
+    }
+    used_pages[file_id].resize(num_pages, false);
+  }
+
+  std::vector<HeaderInfo> header_infos;
+  int64_t chunk_count;
+  if (!reader.read(chunk_count)) {
+    return false;
+  }
+  for (int64_t i = 0; i < chunk_count; ++i) {
+    int32_t key_size;
+    if (!reader.read(key_size) || key_size < 0) {
+      return false;
+    }
+    ChunkKey chunk_key(key_size);
+    for (auto& key_component : chunk_key) {
+      if (!reader.read(key_component)) {
+        return false;
+      }
+    }
+    int64_t page_count;
+    if (!reader.read(page_count)) {
+      return false;
+    }
+    for (int64_t j = 0; j < page_count; ++j) {
+      int32_t page_id, version_epoch, file_id;
+      int64_t page_num;
+      if (!reader.read(page_id) || !reader.read(version_epoch) ||
+          !reader.read(file_id) || !reader.read(page_num)) {
+        return false;
+      }
+      auto it = used_pages.find(file_id);
+      if (it == used_pages.end() || page_num < 0 ||
+          page_num >= static_cast<int64_t>(it->second.size())) {
+        return false;
+      }
+      it->second[page_num] = true;
+      header_infos.emplace_back(
+          chunk_key, page_id, version_epoch, Page(file_id, page_num));
+    }
+  }
+  if (!reader.atEnd()) {
+    return false;
+  }
+
+  result.max_file_id = -1;
+  for (const auto& [file_id, file_metadata] : data_files) {
+    auto file_info = new FileInfo(this,
+                                  file_id,
+                                  open(file_metadata.file_path),
+                                  file_metadata.page_size,
+                                  file_metadata.num_pages,
+                                  false);
+    const auto& file_used_pages = used_pages[file_id];
+    for (size_t page_num = 0; page_num < file_used_pages.size(); ++page_num) {
+      if (!file_used_pages[page_num]) {
+        file_info->freePages.insert(page_num);
+      }
+    }
+    mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+    files_[file_id] = file_info;
+    fileIndex_.insert(std::pair<size_t, int32_t>(file_metadata.page_size, file_id));
+    result.max_file_id = std::max(result.max_file_id, file_id);
+  }
+  result.header_infos = std::move(header_infos);
+  page_manifest_on_disk_ = true;
+
+  LOG(INFO) << "Completed reading table's page manifest, Elapsed time : "
+            << timer_stop(clock_begin) << "ms Epoch: " << epoch()
+            << " files: " << data_files.size() << " headers: "
+            << result.header_infos.size() << " table location: '" << fileMgrBasePath_
+            << "'";
+  return true;
+}
+
 size_t FileMgr::num_pages_per_data_file_{DEFAULT_NUM_PAGES_PER_DATA_FILE};
 size_t FileMgr::num_pages_per_metadata_file_{DEFAULT_NUM_PAGES_PER_METADATA_FILE};
 }  // namespace File_Namespace
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <iostream>
 #include <map>
@@ -43,6 +44,8 @@
 
 using namespace Data_Namespace;
 
+extern bool g_enable_page_manifest;
+
 namespace File_Namespace {
 
 class GlobalFileMgr;  // forward declaration
@@ -333,6 +336,11 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void removeTableRelatedDS(const int32_t db_id, const int32_t table_id) override;
 
   void free_page(std::pair<FileInfo*, int32_t>&& page);
+
+  // Removes the page manifest written by the last checkpoint. Called before any page of
+  // the table files gets modified, since the manifest only describes the files as they
+  // were at that checkpoint.
+  void invalidatePageManifest();
   inline virtual bool hasFileMgrKey() const { return true; }
   const std::pair<const int32_t, const int32_t> get_fileMgrKey() const {
     return fileMgrKey_;
@@ -359,6 +367,10 @@ class FileMgr : public AbstractBufferMgr {  // implements
   static constexpr char const* UPDATE_PAGE_VISIBILITY_STATUS{"pending_data_compaction_1"};
   static constexpr char const* DELETE_EMPTY_FILES_STATUS{"pending_data_compaction_2"};
 
+  // Name of the file holding the page headers of all table files as of the last
+  // checkpoint, which lets startup skip reading the header of every page.
+  static constexpr char const* PAGE_MANIFEST{"page_manifest"};
+
   // Methods that enable override of number of pages per data/metadata file
   // for use in unit tests.
   static void setNumPagesPerDataFile(size_t num_pages);
@@ -396,6 +408,10 @@ class FileMgr : public AbstractBufferMgr {  // implements
   std::vector<std::pair<FileInfo*, int32_t>> free_pages_;
   bool isFullyInitted_{false};
 
+  bool page_manifest_enabled_{false};
+  std::atomic<bool> page_manifest_on_disk_{false};
+  std::mutex page_manifest_mutex_;
+
   static size_t num_pages_per_data_file_;
   static size_t num_pages_per_metadata_file_;
 
@@ -441,6 +457,13 @@ class FileMgr : public AbstractBufferMgr {  // implements
 
   OpenFilesResult openFiles();
 
+  // Opens the table files using the page manifest rather than the page headers. Returns
+  // false, leaving the file manager untouched, if the manifest is missing or doesn't
+  // match the table files and epoch.
+  bool openFilesFromPageManifest(OpenFilesResult& result);
+  void writePageManifest();
+  void removePageManifest();
+
   void clearFileInfos();
 
   // Data compaction methods
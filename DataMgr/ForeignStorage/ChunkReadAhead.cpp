@@ -0,0 +1,160 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ChunkReadAhead.h"
+
+#include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+
+namespace foreign_storage {
+
+namespace {
+
+std::pair<int, int> get_fragment_key(const ChunkKey& chunk_key) {
+  return {chunk_key[CHUNK_KEY_TABLE_IDX], chunk_key[CHUNK_KEY_FRAGMENT_IDX]};
+}
+
+}  // namespace
+
+ChunkReadAhead::ChunkReadAhead(
+    Data_Namespace::DataMgr* data_mgr,
+    std::vector<std::vector<ChunkToRead>>&& chunks_per_fragment,
+    const size_t thread_count)
+    : data_mgr_(data_mgr), chunks_per_fragment_(std::move(chunks_per_fragment)) {
+  CHECK(data_mgr_);
+  const auto memory_info = data_mgr_->getMemoryInfo(Data_Namespace::CPU_LEVEL);
+  CHECK_EQ(memory_info.size(), size_t(1));
+  max_outstanding_bytes_ =
+      memory_info[0].pageSize * memory_info[0].maxNumPages / kBufferPoolFraction;
+  const auto read_thread_count = std::min(thread_count, chunks_per_fragment_.size());
+  for (size_t i = 0; i < read_thread_count; ++i) {
+    futures_.emplace_back(std::async(std::launch::async, [this] { readFragments(); }));
+  }
+}
+
+ChunkReadAhead::~ChunkReadAhead() {
+  stop();
+  for (auto& future : futures_) {
+    future.wait();
+  }
+}
+
+void ChunkReadAhead::stop() {
+  {
+    std::lock_guard<std::mutex> lock(outstanding_mutex_);
+    stop_ = true;
+  }
+  outstanding_cv_.notify_all();
+}
+
+void ChunkReadAhead::fragmentScanned(const int table_id, const int fragment_id) {
+  {
+    std::lock_guard<std::mutex> lock(outstanding_mutex_);
+    const auto fragment_key = std::make_pair(table_id, fragment_id);
+    scanned_fragments_.emplace(fragment_key);
+    const auto it = outstanding_bytes_per_fragment_.find(fragment_key);
+    if (it == outstanding_bytes_per_fragment_.end()) {
+      return;
+    }
+    CHECK_LE(it->second, outstanding_bytes_);
+    outstanding_bytes_ -= it->second;
+    outstanding_bytes_per_fragment_.erase(it);
+  }
+  outstanding_cv_.notify_all();
+}
+
+void ChunkReadAhead::readFragments() {
+  while (!stop_) {
+    const auto fragment_idx = next_fragment_++;
+    if (fragment_idx >= chunks_per_fragment_.size()) {
+      return;
+    }
+    for (const auto& chunk : chunks_per_fragment_[fragment_idx]) {
+      if (stop_ || !readChunk(chunk)) {
+        stop();
+        return;
+      }
+    }
+  }
+}
+
+ChunkReadAhead::Reservation ChunkReadAhead::reserveBytes(const ChunkToRead& chunk) {
+  const auto fragment_key = get_fragment_key(chunk.chunk_key);
+  std::unique_lock<std::mutex> lock(outstanding_mutex_);
+  while (!stop_) {
+    if (scanned_fragments_.count(fragment_key)) {
+      return Reservation::kFragmentScanned;
+    }
+    // The chunks being read get allocated in the free memory as well. The kernels don't
+    // free any, only the budget of the fragments they scan is worth waiting for.
+    const bool fits_free_memory =
+        reading_bytes_ + chunk.num_bytes <= data_mgr_->getCpuBufferPoolFreeSize();
+    const bool fits_budget =
+        outstanding_bytes_ + chunk.num_bytes <= max_outstanding_bytes_;
+    if (fits_free_memory && fits_budget) {
+      outstanding_bytes_ += chunk.num_bytes;
+      outstanding_bytes_per_fragment_[fragment_key] += chunk.num_bytes;
+      reading_bytes_ += chunk.num_bytes;
+      return Reservation::kReserved;
+    }
+    if (!fits_free_memory || !outstanding_bytes_) {
+      VLOG(1) << "Foreign table read ahead stopped with " << outstanding_bytes_
+              << " bytes read ahead of the kernels, a chunk of " << chunk.num_bytes
+              << " bytes doesn't fit in the CPU buffer pool";
+      break;
+    }
+    outstanding_cv_.wait(lock);
+  }
+  return Reservation::kStopped;
+}
+
+void ChunkReadAhead::chunkRead(const ChunkToRead& chunk) {
+  std::lock_guard<std::mutex> lock(outstanding_mutex_);
+  CHECK_LE(chunk.num_bytes, reading_bytes_);
+  reading_bytes_ -= chunk.num_bytes;
+}
+
+bool ChunkReadAhead::readChunk(const ChunkToRead& chunk) {
+  static auto& chunks_read = metrics::Registry::instance().counter(
+      "omnisci_foreign_table_read_ahead_chunks_total",
+      "Foreign table chunks read by the read ahead threads, including the ones a kernel "
+      "loaded into the CPU buffer pool first.");
+  if (data_mgr_->isBufferOnDevice(chunk.chunk_key, Data_Namespace::CPU_LEVEL, 0)) {
+    return true;
+  }
+  const auto reservation = reserveBytes(chunk);
+  if (reservation != Reservation::kReserved) {
+    // a kernel has fetched the chunk meanwhile, the next fragments may still be ahead
+    return reservation == Reservation::kFragmentScanned;
+  }
+  try {
+    // The chunk stays in the buffer pool unpinned, where the kernel fetching it finds
+    // it. It's read without holding the buffer pool locks, so that the kernels fetching
+    // other chunks meanwhile don't wait on it.
+    data_mgr_->readAheadChunk(chunk.chunk_key, chunk.num_bytes);
+    chunks_read.increment();
+  } catch (const std::exception& e) {
+    // The kernel fetching the chunk gets the error again and reports it.
+    VLOG(1) << "Foreign table read ahead of chunk " << show_chunk(chunk.chunk_key)
+            << " failed: " << e.what();
+    chunkRead(chunk);
+    return false;
+  }
+  chunkRead(chunk);
+  return true;
+}
+
+}  // namespace foreign_storage
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkReadAhead.h
+ * @brief   Background loading of the foreign table chunks a query is about to scan.
+ *
+ * Foreign table chunks are loaded by the data wrapper when a kernel first fetches them,
+ * so the kernels on a table which is not cached yet alternate between I/O and compute.
+ * The read ahead loads the chunks of the upcoming fragments into the CPU buffer pool,
+ * and into the disk cache when it is enabled, while the kernels process the previous
+ * ones.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "DataMgr/DataMgr.h"
+
+namespace foreign_storage {
+
+struct ChunkToRead {
+  ChunkKey chunk_key;
+  size_t num_bytes;
+};
+
+class ChunkReadAhead {
+ public:
+  // The chunks read ahead are not pinned. The chunks read ahead of the kernels are kept
+  // within this fraction of the CPU buffer pool, so that they don't evict each other
+  // before the kernels get to them.
+  static constexpr size_t kBufferPoolFraction{4};
+
+  /**
+   * Starts reading the chunks, one fragment at a time in the given order, on
+   * `thread_count` threads. A chunk is only read into the free memory of the CPU buffer
+   * pool. The reading waits for the kernels to scan the fragments read ahead while
+   * those hold a fraction of the pool, and stops once a chunk doesn't fit.
+   */
+  ChunkReadAhead(Data_Namespace::DataMgr* data_mgr,
+                 std::vector<std::vector<ChunkToRead>>&& chunks_per_fragment,
+                 const size_t thread_count);
+
+  // Stops reading and waits for the chunks being read.
+  ~ChunkReadAhead();
+
+  // Releases the budget of the chunks read ahead in a fragment a kernel has scanned.
+  void fragmentScanned(const int table_id, const int fragment_id);
+
+ private:
+  // Stops the reading threads, including the ones waiting for the kernels.
+  void stop();
+
+  void readFragments();
+
+  bool readChunk(const ChunkToRead& chunk);
+
+  enum class Reservation { kReserved, kFragmentScanned, kStopped };
+
+  // Waits until the chunk fits in the budget and in the free memory of the buffer pool,
+  // then takes it out of the budget. Stops the reading if the chunk can't fit.
+  Reservation reserveBytes(const ChunkToRead& chunk);
+
+  // Called once the chunk is in the buffer pool, or failed to load.
+  void chunkRead(const ChunkToRead& chunk);
+
+  Data_Namespace::DataMgr* data_mgr_;
+  const std::vector<std::vector<ChunkToRead>> chunks_per_fragment_;
+  size_t max_outstanding_bytes_;
+  std::atomic<size_t> next_fragment_{0};
+  std::atomic<bool> stop_{false};
+
+  std::mutex outstanding_mutex_;
+  std::condition_variable outstanding_cv_;
+  // bytes read ahead, or being read, in the fragments the kernels haven't scanned yet
+  size_t outstanding_bytes_{0};
+  std::map<std::pair<int, int>, size_t> outstanding_bytes_per_fragment_;
+  std::set<std::pair<int, int>> scanned_fragments_;
+  // bytes being read, not allocated in the buffer pool yet
+  size_t reading_bytes_{0};
+
+  std::vector<std::future<void>> futures_;
+};
+
+}  // namespace foreign_storage
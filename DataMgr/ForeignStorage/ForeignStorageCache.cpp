@@ -22,6 +22,7 @@
 
 #include "ForeignStorageCache.h"
 #include "Shared/File.h"
+#include "Shared/Metrics.h"
 #include "Shared/measure.h"
 
 namespace foreign_storage {
@@ -49,6 +50,13 @@ void set_metadata_for_buffer(AbstractBuffer* buffer, ChunkMetadata* meta) {
   buffer->getEncoder()->resetChunkStats(meta->chunkStats);
   buffer->setUpdated();
 }
+
+metrics::Counter& get_evicted_chunks_counter() {
+  static auto& evictions = metrics::Registry::instance().counter(
+      "omnisci_foreign_storage_cache_evictions_total",
+      "Chunks removed from the foreign storage cache.");
+  return evictions;
+}
 }  // namespace
 
 ForeignStorageCache::ForeignStorageCache(const DiskCacheConfig& config)
@@ -103,14 +111,22 @@ void ForeignStorageCache::cacheTableChunks(const std::vector<ChunkKey>& chunk_ke
 }
 
 AbstractBuffer* ForeignStorageCache::getCachedChunkIfExists(const ChunkKey& chunk_key) {
+  static auto& hits = metrics::Registry::instance().counter(
+      "omnisci_foreign_storage_cache_hits_total",
+      "Foreign storage cache lookups which found the chunk.");
+  static auto& misses = metrics::Registry::instance().counter(
+      "omnisci_foreign_storage_cache_misses_total",
+      "Foreign storage cache lookups which did not find the chunk.");
   {
     read_lock lock(chunks_mutex_);
     // We do this instead of calling getBuffer so that we don't create a fileMgr if the
     // chunk doesn't exist.
     if (cached_chunks_.find(chunk_key) == cached_chunks_.end()) {
+      misses.increment();
       return nullptr;
     }
   }
+  hits.increment();
   return caching_file_mgr_->getBuffer(chunk_key);
 }
 
@@ -344,6 +360,7 @@ void ForeignStorageCache::eraseChunk(const ChunkKey& chunk_key) {
       static_cast<File_Namespace::FileBuffer*>(caching_file_mgr_->getBuffer(chunk_key));
   file_buffer->freeChunkPages();
   cached_chunks_.erase(chunk_key);
+  get_evicted_chunks_counter().increment();
 }
 
 std::set<ChunkKey>::iterator ForeignStorageCache::evictChunkByIterator(
@@ -351,6 +368,7 @@ std::set<ChunkKey>::iterator ForeignStorageCache::evictChunkByIterator(
   File_Namespace::FileBuffer* file_buffer =
       static_cast<File_Namespace::FileBuffer*>(caching_file_mgr_->getBuffer(*chunk_it));
   file_buffer->freeChunkPages();
+  get_evicted_chunks_counter().increment();
   return cached_chunks_.erase(chunk_it);
 }
 
@@ -16,9 +16,12 @@
 
 #include "LazyParquetChunkLoader.h"
 
+#include <algorithm>
+
 #include <arrow/api.h>
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/column_reader.h>
 #include <parquet/column_scanner.h>
 #include <parquet/exception.h>
 #include <parquet/platform.h>
@@ -1354,6 +1357,32 @@ std::map<int, std::shared_ptr<ParquetEncoder>> populate_encoder_map(
   }
   return encoder_map;
 }
+
+/**
+ * @brief Detect a column chunk whose data pages all hold indices of the entries of its
+ * dictionary page.
+ *
+ * Writers fall back to plain encoded data pages once the dictionary grows too large.
+ * Column chunks without page encoding statistics, from older writers, are not known to
+ * be fully dictionary encoded.
+ */
+bool is_fully_dictionary_encoded(const parquet::ColumnChunkMetaData& column_chunk) {
+  if (!column_chunk.has_dictionary_page()) {
+    return false;
+  }
+  const auto& encoding_stats = column_chunk.encoding_stats();
+  if (encoding_stats.empty()) {
+    return false;
+  }
+  return std::all_of(
+      encoding_stats.begin(),
+      encoding_stats.end(),
+      [](const parquet::PageEncodingStats& page_encoding_stats) {
+        return page_encoding_stats.page_type == parquet::PageType::DICTIONARY_PAGE ||
+               page_encoding_stats.encoding == parquet::Encoding::PLAIN_DICTIONARY ||
+               page_encoding_stats.encoding == parquet::Encoding::RLE_DICTIONARY;
+      });
+}
 }  // namespace
 
 std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroups(
@@ -1370,6 +1399,7 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
   std::vector<int16_t> def_levels(LazyParquetChunkLoader::batch_reader_num_elements);
   std::vector<int16_t> rep_levels(LazyParquetChunkLoader::batch_reader_num_elements);
   std::vector<int8_t> values;
+  std::vector<int32_t> dictionary_indices;
 
   CHECK(!row_group_intervals.empty());
   const auto& first_file_path = row_group_intervals.front().file_path;
@@ -1384,6 +1414,11 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
                                         string_dictionary,
                                         chunk_metadata);
   CHECK(encoder.get());
+  auto dictionary_index_encoder =
+      dynamic_cast<ParquetDictionaryIndexEncoder*>(encoder.get());
+  if (dictionary_index_encoder) {
+    dictionary_indices.resize(LazyParquetChunkLoader::batch_reader_num_elements);
+  }
 
   for (const auto& row_group_interval : row_group_intervals) {
     const auto& file_path = row_group_interval.file_path;
@@ -1411,8 +1446,34 @@ std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroup
       auto group_reader = parquet_reader->RowGroup(row_group_index);
       std::shared_ptr<parquet::ColumnReader> col_reader =
           group_reader->Column(parquet_column_index);
+      auto byte_array_reader =
+          dictionary_index_encoder &&
+                  is_fully_dictionary_encoded(
+                      *group_reader->metadata()->ColumnChunk(parquet_column_index))
+              ? dynamic_cast<parquet::ByteArrayReader*>(col_reader.get())
+              : nullptr;
 
       try {
+        while (byte_array_reader && byte_array_reader->HasNext()) {
+          const parquet::ByteArray* dictionary{nullptr};
+          int32_t dictionary_length{0};
+          int64_t levels_read = byte_array_reader->ReadBatchWithDictionary(
+              LazyParquetChunkLoader::batch_reader_num_elements,
+              def_levels.data(),
+              rep_levels.data(),
+              dictionary_indices.data(),
+              &values_read,
+              &dictionary,
+              &dictionary_length);
+          dictionary_index_encoder->appendDictionaryIndices(def_levels.data(),
+                                                            rep_levels.data(),
+                                                            values_read,
+                                                            levels_read,
+                                                            !col_reader->HasNext(),
+                                                            dictionary,
+                                                            dictionary_length,
+                                                            dictionary_indices.data());
+        }
         while (col_reader->HasNext()) {
           int64_t levels_read =
               parquet::ScanAllValues(LazyParquetChunkLoader::batch_reader_num_elements,
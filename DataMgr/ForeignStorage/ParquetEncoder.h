@@ -103,4 +103,29 @@ class ParquetScalarEncoder : public ParquetEncoder {
                                        const size_t num_elements) = 0;
 };
 
+class ParquetDictionaryIndexEncoder {
+ public:
+  virtual ~ParquetDictionaryIndexEncoder() = default;
+
+  /**
+   * Appends the values of a column chunk whose data pages are all dictionary encoded,
+   * given as indices of the entries of its dictionary page.
+   *
+   * @param indices_read - the number of non-null values read
+   * @param levels_read - the total number of values (non-null & null) that are read
+   * @param dictionary - the entries of the dictionary page of the column chunk
+   * @param indices - the indices of the dictionary entries of the non-null values
+   *
+   * See comment for `ParquetInPlaceEncoder::appendData` for the other parameters.
+   */
+  virtual void appendDictionaryIndices(const int16_t* def_levels,
+                                       const int16_t* rep_levels,
+                                       const int64_t indices_read,
+                                       const int64_t levels_read,
+                                       const bool is_last_batch,
+                                       const parquet::ByteArray* dictionary,
+                                       const int32_t dictionary_length,
+                                       const int32_t* indices) = 0;
+};
+
 }  // namespace foreign_storage
@@ -26,7 +26,8 @@
 namespace foreign_storage {
 
 template <typename V>
-class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
+class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V>,
+                             public ParquetDictionaryIndexEncoder {
  public:
   ParquetStringEncoder(Data_Namespace::AbstractBuffer* buffer,
                        StringDictionary* string_dictionary,
@@ -53,6 +54,45 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
                                                  encode_buffer_.data());
   }
 
+  void appendDictionaryIndices(const int16_t* def_levels,
+                               const int16_t* rep_levels,
+                               const int64_t indices_read,
+                               const int64_t levels_read,
+                               const bool is_last_batch,
+                               const parquet::ByteArray* dictionary,
+                               const int32_t dictionary_length,
+                               const int32_t* indices) override {
+    if (indices_read > 0 && dictionary_string_ids_.empty()) {
+      // the dictionary entries of the column chunk translate to string ids once,
+      // instead of once per row
+      CHECK(string_dictionary_);
+      std::vector<std::string_view> string_views;
+      string_views.reserve(dictionary_length);
+      for (int32_t i = 0; i < dictionary_length; ++i) {
+        string_views.emplace_back(reinterpret_cast<const char*>(dictionary[i].ptr),
+                                  dictionary[i].len);
+      }
+      dictionary_string_ids_.resize(dictionary_length);
+      string_dictionary_->getOrAddBulk(string_views, dictionary_string_ids_.data());
+    }
+    auto omnisci_data_ptr = reinterpret_cast<V*>(encode_buffer_.data());
+    for (int64_t i = 0; i < indices_read; ++i) {
+      CHECK_LT(static_cast<size_t>(indices[i]), dictionary_string_ids_.size());
+      omnisci_data_ptr[i] = dictionary_string_ids_[indices[i]];
+    }
+    updateMetadataStats(indices_read, encode_buffer_.data());
+    if (is_last_batch) {
+      // the next column chunk has its own dictionary page
+      dictionary_string_ids_.clear();
+    }
+    TypedParquetInPlaceEncoder<V, V>::appendData(def_levels,
+                                                 rep_levels,
+                                                 indices_read,
+                                                 levels_read,
+                                                 is_last_batch,
+                                                 encode_buffer_.data());
+  }
+
   void encodeAndCopyContiguous(const int8_t* parquet_data_bytes,
                                int8_t* omnisci_data_bytes,
                                const size_t num_elements) override {
@@ -105,6 +145,9 @@ class ParquetStringEncoder : public TypedParquetInPlaceEncoder<V, V> {
   std::unique_ptr<ChunkMetadata>& chunk_metadata_;
   std::vector<int8_t> encode_buffer_;
 
+  // string ids of the dictionary page entries of the current column chunk
+  std::vector<V> dictionary_string_ids_;
+
   V min_, max_;
 };
 
@@ -55,8 +55,21 @@ class CursorImpl : public Cursor {
 
   Row getNextRow() {
     if (result_set_) {
-      auto row = result_set_->getNextRow(true, false);
-      return row.empty() ? Row() : Row(row);
+      if (batch_row_ == batch_.row_count) {
+        batch_ =
+            result_set_->getNextBatch(ResultSet::kDefaultBatchRowCount, true, false);
+        batch_row_ = 0;
+        if (batch_.empty()) {
+          return Row();
+        }
+      }
+      std::vector<TargetValue> row;
+      row.reserve(batch_.columns.size());
+      for (const auto& column : batch_.columns) {
+        row.push_back(column.getTargetValue(batch_row_));
+      }
+      ++batch_row_;
+      return Row(row);
     }
     return Row();
   }
@@ -90,6 +103,9 @@ class CursorImpl : public Cursor {
   std::shared_ptr<ResultSet> result_set_;
   std::vector<std::string> col_names_;
   std::shared_ptr<arrow::RecordBatch> record_batch_;
+  // rows fetched from result_set_ but not returned by getNextRow() yet
+  ResultSetBatch batch_;
+  size_t batch_row_{0};
 };
 
 /**
@@ -64,6 +64,7 @@
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/TypePunning.h"
 #include "Shared/DateTimeParser.h"
+#include "Shared/Metrics.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/import_helpers.h"
 #include "Shared/likely.h"
@@ -4107,8 +4108,31 @@ void DataStreamSink::import_compressed(
   }
 }
 
+namespace {
+
+metrics::Gauge& get_active_imports_gauge() {
+  static auto& active_imports = metrics::Registry::instance().gauge(
+      "omnisci_active_imports", "Imports currently loading rows.");
+  return active_imports;
+}
+
+void record_import_rows(const ImportStatus& import_status) {
+  static auto& rows_loaded = metrics::Registry::instance().counter(
+      "omnisci_import_rows_loaded_total", "Rows loaded by completed imports.");
+  static auto& rows_rejected = metrics::Registry::instance().counter(
+      "omnisci_import_rows_rejected_total", "Rows rejected by completed imports.");
+  rows_loaded.increment(import_status.rows_completed);
+  rows_rejected.increment(import_status.rows_rejected);
+}
+
+}  // namespace
+
 ImportStatus Importer::import(const Catalog_Namespace::SessionInfo* session_info) {
-  return DataStreamSink::archivePlumber(session_info);
+  get_active_imports_gauge().add(1);
+  ScopeGuard active_import_guard = [] { get_active_imports_gauge().add(-1); };
+  const auto import_status = DataStreamSink::archivePlumber(session_info);
+  record_import_rows(import_status);
+  return import_status;
 }
 
 ImportStatus Importer::importDelimited(
@@ -4903,6 +4927,8 @@ std::vector<Importer::GeoFileLayerInfo> Importer::gdalGetLayersInGeoFile(
 
 ImportStatus Importer::importGDAL(ColumnNameToSourceNameMapType columnNameToSourceNameMap,
                                   const Catalog_Namespace::SessionInfo* session_info) {
+  get_active_imports_gauge().add(1);
+  ScopeGuard active_import_guard = [] { get_active_imports_gauge().add(-1); };
   // initial status
   set_import_status(import_id, import_status_);
   OGRDataSourceUqPtr poDS(openGDALDataset(file_path, copy_params));
@@ -5156,6 +5182,7 @@ ImportStatus Importer::importGDAL(ColumnNameToSourceNameMapType columnNameToSour
 #endif
 
   checkpoint(table_epochs);
+  record_import_rows(import_status_);
 
   return import_status_;
 }
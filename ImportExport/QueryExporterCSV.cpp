@@ -78,122 +78,155 @@ void QueryExporterCSV::exportResults(const std::vector<AggregatedResult>& query_
     auto const& targets = agg_result.targets_meta;
 
     while (true) {
-      auto const crt_row = results->getNextRow(true, true);
-      if (crt_row.empty()) {
+      auto const batch =
+          results->getNextBatch(ResultSet::kDefaultBatchRowCount, true, true);
+      if (batch.empty()) {
         break;
       }
-      bool not_first = false;
-      for (size_t i = 0; i < results->colCount(); ++i) {
-        bool is_null{false};
-        auto const tv = crt_row[i];
-        auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
-        if (not_first) {
-          outfile_ << copy_params_.delimiter;
-        } else {
-          not_first = true;
-        }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
-        }
-        auto const& ti = targets[i].get_type_info();
-        if (!scalar_tv) {
-          outfile_ << datum_to_string(crt_row[i], ti, " | ");
+      for (size_t row = 0; row < batch.row_count; ++row) {
+        for (size_t i = 0; i < results->colCount(); ++i) {
+          if (i > 0) {
+            outfile_ << copy_params_.delimiter;
+          }
           if (copy_params_.quoted) {
             outfile_ << copy_params_.quote;
           }
-          continue;
-        }
-        if (boost::get<int64_t>(scalar_tv)) {
-          auto int_val = *(boost::get<int64_t>(scalar_tv));
-          switch (ti.get_type()) {
-            case kBOOLEAN:
-              is_null = (int_val == NULL_BOOLEAN);
-              break;
-            case kTINYINT:
-              is_null = (int_val == NULL_TINYINT);
-              break;
-            case kSMALLINT:
-              is_null = (int_val == NULL_SMALLINT);
-              break;
-            case kINT:
-              is_null = (int_val == NULL_INT);
+          auto const& column = batch.columns[i];
+          auto const& ti = targets[i].get_type_info();
+          switch (column.format) {
+            case ResultSetColumnBatch::Format::Int:
+              if (column.isNull(row)) {
+                outfile_ << copy_params_.null_str;
+              } else if (column.string_dict_proxy) {
+                exportString(column.getString(row));
+              } else {
+                exportInt(column.int_values[row], ti);
+              }
               break;
-            case kBIGINT:
-              is_null = (int_val == NULL_BIGINT);
+            case ResultSetColumnBatch::Format::Fp:
+              if (column.isNull(row)) {
+                outfile_ << copy_params_.null_str;
+              } else {
+                exportFp(column.fp_values[row], ti);
+              }
               break;
-            case kTIME:
-            case kTIMESTAMP:
-            case kDATE:
-              is_null = (int_val == NULL_BIGINT);
+            case ResultSetColumnBatch::Format::TargetValue:
+              exportTargetValue(column.target_values[row], ti);
               break;
-            default:
-              is_null = false;
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kTIME) {
-            constexpr size_t buf_size = 9;
-            char buf[buf_size];
-            size_t const len = shared::formatHMS(buf, buf_size, int_val);
-            CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
-            outfile_ << buf;
-          } else {
-            outfile_ << int_val;
           }
-        } else if (boost::get<double>(scalar_tv)) {
-          auto real_val = *(boost::get<double>(scalar_tv));
-          if (ti.get_type() == kFLOAT) {
-            is_null = (real_val == NULL_FLOAT);
-          } else {
-            is_null = (real_val == NULL_DOUBLE);
-          }
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else if (ti.get_type() == kNUMERIC) {
-            outfile_ << std::setprecision(ti.get_precision()) << real_val;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<double>::digits10 + 1)
-                     << real_val;
-          }
-        } else if (boost::get<float>(scalar_tv)) {
-          CHECK_EQ(kFLOAT, ti.get_type());
-          auto real_val = *(boost::get<float>(scalar_tv));
-          if (real_val == NULL_FLOAT) {
-            outfile_ << copy_params_.null_str;
-          } else {
-            outfile_ << std::setprecision(std::numeric_limits<float>::digits10 + 1)
-                     << real_val;
-          }
-        } else {
-          auto s = boost::get<NullableString>(scalar_tv);
-          is_null = !s || boost::get<void*>(s);
-          if (is_null) {
-            outfile_ << copy_params_.null_str;
-          } else {
-            auto s_notnull = boost::get<std::string>(s);
-            CHECK(s_notnull);
-            if (!copy_params_.quoted) {
-              outfile_ << *s_notnull;
-            } else {
-              size_t q = s_notnull->find(copy_params_.quote);
-              if (q == std::string::npos) {
-                outfile_ << *s_notnull;
-              } else {
-                std::string str(*s_notnull);
-                while (q != std::string::npos) {
-                  str.insert(q, 1, copy_params_.escape);
-                  q = str.find(copy_params_.quote, q + 2);
-                }
-                outfile_ << str;
-              }
-            }
+          if (copy_params_.quoted) {
+            outfile_ << copy_params_.quote;
           }
         }
-        if (copy_params_.quoted) {
-          outfile_ << copy_params_.quote;
-        }
+        outfile_ << copy_params_.line_delim;
       }
-      outfile_ << copy_params_.line_delim;
+    }
+  }
+}
+
+void QueryExporterCSV::exportInt(const int64_t int_val, const SQLTypeInfo& ti) {
+  if (ti.get_type() == kTIME) {
+    constexpr size_t buf_size = 9;
+    char buf[buf_size];
+    size_t const len = shared::formatHMS(buf, buf_size, int_val);
+    CHECK_EQ(8u, len);  // 8 == strlen("HH:MM:SS")
+    outfile_ << buf;
+  } else {
+    outfile_ << int_val;
+  }
+}
+
+void QueryExporterCSV::exportFp(const double real_val, const SQLTypeInfo& ti) {
+  if (ti.get_type() == kFLOAT) {
+    outfile_ << std::setprecision(std::numeric_limits<float>::digits10 + 1)
+             << static_cast<float>(real_val);
+  } else if (ti.get_type() == kNUMERIC) {
+    outfile_ << std::setprecision(ti.get_precision()) << real_val;
+  } else {
+    outfile_ << std::setprecision(std::numeric_limits<double>::digits10 + 1) << real_val;
+  }
+}
+
+void QueryExporterCSV::exportString(const std::string& str) {
+  if (!copy_params_.quoted) {
+    outfile_ << str;
+    return;
+  }
+  size_t q = str.find(copy_params_.quote);
+  if (q == std::string::npos) {
+    outfile_ << str;
+    return;
+  }
+  std::string escaped_str(str);
+  while (q != std::string::npos) {
+    escaped_str.insert(q, 1, copy_params_.escape);
+    q = escaped_str.find(copy_params_.quote, q + 2);
+  }
+  outfile_ << escaped_str;
+}
+
+// Arrays, geo, none encoded strings and the targets the batch does not decode itself.
+void QueryExporterCSV::exportTargetValue(const TargetValue& tv, const SQLTypeInfo& ti) {
+  auto const scalar_tv = boost::get<ScalarTargetValue>(&tv);
+  if (!scalar_tv) {
+    outfile_ << datum_to_string(tv, ti, " | ");
+    return;
+  }
+  if (boost::get<int64_t>(scalar_tv)) {
+    auto int_val = *(boost::get<int64_t>(scalar_tv));
+    bool is_null{false};
+    switch (ti.get_type()) {
+      case kBOOLEAN:
+        is_null = (int_val == NULL_BOOLEAN);
+        break;
+      case kTINYINT:
+        is_null = (int_val == NULL_TINYINT);
+        break;
+      case kSMALLINT:
+        is_null = (int_val == NULL_SMALLINT);
+        break;
+      case kINT:
+        is_null = (int_val == NULL_INT);
+        break;
+      case kBIGINT:
+        is_null = (int_val == NULL_BIGINT);
+        break;
+      case kTIME:
+      case kTIMESTAMP:
+      case kDATE:
+        is_null = (int_val == NULL_BIGINT);
+        break;
+      default:
+        is_null = false;
+    }
+    if (is_null) {
+      outfile_ << copy_params_.null_str;
+    } else {
+      exportInt(int_val, ti);
+    }
+  } else if (boost::get<double>(scalar_tv)) {
+    auto real_val = *(boost::get<double>(scalar_tv));
+    if (real_val == (ti.get_type() == kFLOAT ? NULL_FLOAT : NULL_DOUBLE)) {
+      outfile_ << copy_params_.null_str;
+    } else {
+      exportFp(real_val, ti);
+    }
+  } else if (boost::get<float>(scalar_tv)) {
+    CHECK_EQ(kFLOAT, ti.get_type());
+    auto real_val = *(boost::get<float>(scalar_tv));
+    if (real_val == NULL_FLOAT) {
+      outfile_ << copy_params_.null_str;
+    } else {
+      exportFp(real_val, ti);
+    }
+  } else {
+    auto s = boost::get<NullableString>(scalar_tv);
+    if (!s || boost::get<void*>(s)) {
+      outfile_ << copy_params_.null_str;
+    } else {
+      auto s_notnull = boost::get<std::string>(s);
+      CHECK(s_notnull);
+      exportString(*s_notnull);
     }
   }
 }
@@ -19,6 +19,7 @@
 #include <fstream>
 
 #include <ImportExport/QueryExporter.h>
+#include <QueryEngine/TargetValue.h>
 
 namespace import_export {
 
@@ -37,6 +38,11 @@ class QueryExporterCSV : public QueryExporter {
   void endExport() final;
 
  private:
+  void exportInt(const int64_t int_val, const SQLTypeInfo& ti);
+  void exportFp(const double real_val, const SQLTypeInfo& ti);
+  void exportString(const std::string& str);
+  void exportTargetValue(const TargetValue& tv, const SQLTypeInfo& ti);
+
   std::ofstream outfile_;
   CopyParams copy_params_;
 };
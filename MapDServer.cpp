@@ -58,10 +58,12 @@
 #endif
 #include "MapDRelease.h"
 #include "Shared/Compressor.h"
+#include "Shared/MetricsServer.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/file_delete.h"
 #include "Shared/mapd_shared_ptr.h"
 #include "Shared/scope.h"
+#include "ThriftHandler/ForeignTableFileWatcher.h"
 #include "ThriftHandler/ForeignTableRefreshScheduler.h"
 #if ENABLE_ITT
 #include <ittnotify.h>
@@ -444,6 +446,20 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
 
   if (g_enable_fsi) {
     foreign_storage::ForeignTableRefreshScheduler::start(g_running);
+    if (g_enable_foreign_table_file_change_refresh) {
+      foreign_storage::ForeignTableFileWatcher::start(g_running);
+    }
+  }
+
+  std::unique_ptr<metrics::MetricsServer> metrics_server;
+  if (prog_config_opts.metrics_port > 0) {
+    try {
+      metrics_server = std::make_unique<metrics::MetricsServer>(
+          prog_config_opts.metrics_address, prog_config_opts.metrics_port);
+    } catch (const std::exception& e) {
+      LOG(FATAL) << "Failed to start the metrics server on port "
+                 << prog_config_opts.metrics_port << ": " << e.what();
+    }
   }
 
   mapd::shared_ptr<TServerSocket> serverSocket;
@@ -537,8 +553,10 @@ int startMapdServer(CommandLineOptions& prog_config_opts, bool start_http_server
   g_running = false;
   file_delete_thread.join();
   heartbeat_thread.join();
+  metrics_server.reset();
 
   if (g_enable_fsi) {
+    foreign_storage::ForeignTableFileWatcher::stop();
     foreign_storage::ForeignTableRefreshScheduler::stop();
   }
 
@@ -39,6 +39,24 @@ inline const ColumnarResults* columnarize_result(
       row_set_mem_owner, *result, result->colCount(), col_types, thread_idx);
 }
 
+// Returns the memory level a chunk fetched at the given level comes from: that level if
+// the chunk is there already, else the first level below it holding the chunk.
+Data_Namespace::MemoryLevel get_chunk_source_level(
+    Data_Namespace::DataMgr& data_mgr,
+    const ChunkKey& chunk_key,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_id) {
+  if (memory_level == Data_Namespace::GPU_LEVEL &&
+      data_mgr.isBufferOnDevice(chunk_key, Data_Namespace::GPU_LEVEL, device_id)) {
+    return Data_Namespace::GPU_LEVEL;
+  }
+  if (memory_level != Data_Namespace::DISK_LEVEL &&
+      data_mgr.isBufferOnDevice(chunk_key, Data_Namespace::CPU_LEVEL, 0)) {
+    return Data_Namespace::CPU_LEVEL;
+  }
+  return Data_Namespace::DISK_LEVEL;
+}
+
 }  // namespace
 
 ColumnFetcher::ColumnFetcher(Executor* executor, const ColumnCacheMap& column_cache)
@@ -80,6 +98,11 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
                        fragment.physicalTableId,
                        hash_col.get_column_id(),
                        fragment.fragmentId};
+    auto query_profile = executor->getQueryProfile();
+    const auto source_mem_lvl =
+        query_profile ? get_chunk_source_level(
+                            catalog.getDataMgr(), chunk_key, effective_mem_lvl, device_id)
+                      : effective_mem_lvl;
     const auto chunk = Chunk_NS::Chunk::getChunk(
         cd,
         &catalog.getDataMgr(),
@@ -90,6 +113,9 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
         chunk_meta_it->second->numElements);
     chunks_owner.push_back(chunk);
     CHECK(chunk);
+    if (query_profile) {
+      query_profile->addBytesFetched(source_mem_lvl, chunk_meta_it->second->numBytes);
+    }
     auto ab = chunk->getBuffer();
     CHECK(ab->getMemoryPtr());
     col_buff = reinterpret_cast<int8_t*>(ab->getMemoryPtr());
@@ -234,6 +260,11 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_mutex));
     }
+    if (auto query_profile = executor_->getQueryProfile()) {
+      query_profile->addBytesFetched(
+          get_chunk_source_level(cat.getDataMgr(), chunk_key, memory_level, device_id),
+          chunk_meta_it->second->numBytes);
+    }
     chunk = Chunk_NS::Chunk::getChunk(
         cd,
         &cat.getDataMgr(),
@@ -411,6 +442,12 @@ const int8_t* ColumnFetcher::linearizeColumnFragments(
     CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
     ChunkKey chunk_key{
         cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
+    if (auto query_profile = executor_->getQueryProfile()) {
+      query_profile->addBytesFetched(
+          get_chunk_source_level(
+              cat.getDataMgr(), chunk_key, Data_Namespace::CPU_LEVEL, 0),
+          chunk_meta_it->second->numBytes);
+    }
     chunk = Chunk_NS::Chunk::getChunk(cd,
                                       &cat.getDataMgr(),
                                       chunk_key,
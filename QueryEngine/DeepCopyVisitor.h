@@ -240,4 +240,10 @@ class DeepCopyVisitor : public ScalarExprVisitor<std::shared_ptr<Analyzer::Expr>
   RetType visitOffsetInFragment(const Analyzer::OffsetInFragment*) const override {
     return makeExpr<Analyzer::OffsetInFragment>();
   }
+
+  RetType visitRangeOper(const Analyzer::RangeOper* range_oper) const override {
+    return makeExpr<Analyzer::RangeOper>(visit(range_oper->get_operand()),
+                                         visit(range_oper->get_distance()),
+                                         range_oper->is_geodesic());
+  }
 };
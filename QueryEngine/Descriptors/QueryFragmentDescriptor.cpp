@@ -154,7 +154,9 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     const auto& fragment = (*fragments)[i];
     const auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        executor->skipFragmentGeoBounds(table_desc, fragment, ra_exe_unit) ||
+        executor->skipFragmentJoinKeyRanges(table_desc, ra_exe_unit, fragment)) {
       continue;
     }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -387,7 +389,9 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        executor->skipFragmentGeoBounds(outer_table_desc, fragment, ra_exe_unit) ||
+        executor->skipFragmentJoinKeyRanges(outer_table_desc, ra_exe_unit, fragment)) {
       continue;
     }
     const int device_id =
@@ -26,6 +26,7 @@
 #include "ErrorHandling.h"
 #include "ExpressionRewrite.h"
 #include "ExternalCacheInvalidators.h"
+#include "GeoFragmentBounds.h"
 #include "GpuMemUtils.h"
 #include "InPlaceSort.h"
 #include "JoinHashTable/BaselineJoinHashTable.h"
@@ -44,7 +45,10 @@
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/ForeignStorage/ChunkReadAhead.h"
 #include "Parser/ParserNode.h"
+#include "Geospatial/Compression.h"
+#include "Shared/Metrics.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/checked_alloc.h"
@@ -58,6 +62,7 @@
 #include "StringDictionaryGenerations.h"
 
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 
@@ -70,6 +75,7 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <thread>
 
@@ -96,6 +102,11 @@ bool g_enable_left_join_filter_hoisting{true};
 bool g_optimize_row_initialization{true};
 bool g_enable_overlaps_hashjoin{true};
 bool g_enable_hashjoin_many_to_many{false};
+bool g_enable_distance_rangejoin{true};
+bool g_enable_polygon_index{true};
+bool g_enable_range_join{true};
+bool g_enable_runtime_join_filters{true};
+size_t g_foreign_table_read_ahead_threads{2};
 size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
 double g_overlaps_target_entries_per_bin{1.3};
 bool g_strip_join_covered_quals{false};
@@ -136,6 +147,7 @@ size_t g_approx_quantile_buffer{1000};
 size_t g_approx_quantile_centroids{300};
 
 extern bool g_cache_string_hash;
+extern bool g_enable_fsi;
 bool g_enable_multifrag_rs{false};
 
 int const Executor::max_gpu_count;
@@ -288,6 +300,11 @@ const std::shared_ptr<RowSetMemoryOwner> Executor::getRowSetMemoryOwner() const
   return row_set_mem_owner_;
 }
 
+PolygonIndexCache* Executor::getPolygonIndexCache() const {
+  CHECK(plan_state_);
+  return &plan_state_->polygon_index_cache_;
+}
+
 const TemporaryTables* Executor::getTemporaryTables() const {
   return temporary_tables_;
 }
@@ -1473,6 +1490,7 @@ TemporaryTable Executor::executeWorkUnitImpl(
         std::lock_guard<std::mutex> compilation_lock(compilation_mutex_);
         compilation_queue_time_ms_ += timer_stop(clock_begin);
 
+        auto compilation_clock_begin = timer_start();
         query_mem_desc_owned =
             query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                            crt_min_byte_width,
@@ -1493,6 +1511,14 @@ TemporaryTable Executor::executeWorkUnitImpl(
                                            render_info,
                                            this);
         CHECK(query_mem_desc_owned);
+        const auto compilation_ms = timer_stop(compilation_clock_begin);
+        static auto& compilation_latency = metrics::Registry::instance().histogram(
+            "omnisci_query_step_compilation_ms",
+            "Time to generate or fetch from the code cache the kernels of a query step.");
+        compilation_latency.observe(compilation_ms);
+        if (auto query_profile = getQueryProfile()) {
+          query_profile->addCompileTime(compilation_ms);
+        }
         crt_min_byte_width = query_comp_desc_owned->getMinByteWidth();
       } catch (CompilationRetryNoCompaction&) {
         crt_min_byte_width = MAX_BYTE_WIDTH_SUPPORTED;
@@ -1533,19 +1559,32 @@ TemporaryTable Executor::executeWorkUnitImpl(
                                      render_info,
                                      available_gpus,
                                      available_cpus);
+        if (auto query_profile = getQueryProfile()) {
+          // fragments of the outer tables which are not part of any kernel have been
+          // skipped using their metadata
+          const size_t outer_table_count =
+              ra_exe_unit.union_all ? query_infos.size() : size_t(1);
+          for (size_t i = 0; i < outer_table_count; ++i) {
+            query_profile->setOuterFragmentCount(query_infos[i].table_id,
+                                                 query_infos[i].info.fragments.size());
+          }
+        }
+        // destroyed, after the kernels return, before the tables are unlocked
+        const auto read_ahead =
+            startForeignTableReadAhead(kernels, ra_exe_unit, query_infos);
         if (g_use_tbb_pool) {
 #ifdef HAVE_TBB
           VLOG(1) << "Using TBB thread pool for kernel dispatch.";
-          launchKernels<threadpool::TbbThreadPool<void>>(shared_context,
-                                                         std::move(kernels));
+          launchKernels<threadpool::TbbThreadPool<void>>(
+              shared_context, std::move(kernels), read_ahead.get());
 #else
           throw std::runtime_error(
               "This build is not TBB enabled. Restart the server with "
               "\"enable-modern-thread-pool\" disabled.");
 #endif
         } else {
-          launchKernels<threadpool::FuturesThreadPool<void>>(shared_context,
-                                                             std::move(kernels));
+          launchKernels<threadpool::FuturesThreadPool<void>>(
+              shared_context, std::move(kernels), read_ahead.get());
         }
       } catch (QueryExecutionError& e) {
         if (eo.with_dynamic_watchdog && interrupted_.load() &&
@@ -1585,6 +1624,12 @@ TemporaryTable Executor::executeWorkUnitImpl(
                                              QuerySessionStatus::RUNNING_REDUCTION);
         }
       }
+      auto reduction_clock_begin = timer_start();
+      ScopeGuard record_reduction_time = [this, &reduction_clock_begin] {
+        if (auto query_profile = getQueryProfile()) {
+          query_profile->addReductionTime(timer_stop(reduction_clock_begin));
+        }
+      };
       try {
         return collectAllDeviceResults(shared_context,
                                        ra_exe_unit,
@@ -1608,8 +1653,16 @@ TemporaryTable Executor::executeWorkUnitImpl(
         order_map[ra_exe_unit.input_descs[i].getTableId()] = i;
       }
     }
-    return resultsUnion(shared_context, ra_exe_unit,
-        !eo.multifrag_result, eo.preserve_order, order_map);
+    auto union_clock_begin = timer_start();
+    auto results = resultsUnion(shared_context,
+                                ra_exe_unit,
+                                !eo.multifrag_result,
+                                eo.preserve_order,
+                                order_map);
+    if (auto query_profile = getQueryProfile()) {
+      query_profile->addReductionTime(timer_stop(union_clock_begin));
+    }
+    return results;
   } while (static_cast<size_t>(crt_min_byte_width) <= sizeof(int64_t));
 
   return std::make_shared<ResultSet>(std::vector<TargetInfo>{},
@@ -2204,9 +2257,113 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+/**
+ * Reads ahead, on the foreign storage read ahead threads, the chunks of the foreign
+ * tables in the fragments the kernels scan, in the order the kernels are launched. The
+ * variable length chunks are left to the kernels, which fetch them one at a time.
+ */
+std::unique_ptr<foreign_storage::ChunkReadAhead> Executor::startForeignTableReadAhead(
+    const std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos) {
+  if (!g_enable_fsi || !g_foreign_table_read_ahead_threads) {
+    return nullptr;
+  }
+  const auto& cat = *getCatalog();
+  std::unordered_map<int, const TableFragments*> foreign_table_fragments;
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id < 0) {
+      continue;
+    }
+    const auto td = cat.getMetadataForTable(query_info.table_id, false);
+    if (td && td->storageType == StorageType::FOREIGN_TABLE) {
+      foreign_table_fragments.emplace(query_info.table_id, &query_info.info.fragments);
+    }
+  }
+  if (foreign_table_fragments.empty()) {
+    return nullptr;
+  }
+  const int db_id = cat.getCurrentDB().dbId;
+  std::set<std::pair<int, size_t>> visited_fragments;
+  std::vector<std::vector<foreign_storage::ChunkToRead>> chunks_per_fragment;
+  for (const auto& kernel : kernels) {
+    for (const auto& fragments_per_table : kernel->getFragmentsList()) {
+      const auto table_id = fragments_per_table.table_id;
+      const auto fragments_it = foreign_table_fragments.find(table_id);
+      if (fragments_it == foreign_table_fragments.end()) {
+        continue;
+      }
+      for (const auto frag_id : fragments_per_table.fragment_ids) {
+        if (!visited_fragments.emplace(table_id, frag_id).second) {
+          continue;
+        }
+        CHECK_LT(frag_id, fragments_it->second->size());
+        const auto& fragment = (*fragments_it->second)[frag_id];
+        if (fragment.isEmptyPhysicalFragment()) {
+          continue;
+        }
+        std::vector<foreign_storage::ChunkToRead> chunks;
+        for (const auto& col_desc : ra_exe_unit.input_col_descs) {
+          if (col_desc->getScanDesc().getTableId() != table_id) {
+            continue;
+          }
+          const auto cd = get_column_descriptor(col_desc->getColId(), table_id, cat);
+          if (cd->isVirtualCol || cd->columnType.is_varlen_indeed()) {
+            continue;
+          }
+          const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+          const auto chunk_meta_it = chunk_metadata_map.find(cd->columnId);
+          if (chunk_meta_it == chunk_metadata_map.end()) {
+            continue;
+          }
+          chunks.push_back(
+              {{db_id, fragment.physicalTableId, cd->columnId, fragment.fragmentId},
+               chunk_meta_it->second->numBytes});
+        }
+        if (!chunks.empty()) {
+          chunks_per_fragment.push_back(std::move(chunks));
+        }
+      }
+    }
+  }
+  // a single fragment is fetched by the first kernel right away
+  if (chunks_per_fragment.size() < 2) {
+    return nullptr;
+  }
+  return std::make_unique<foreign_storage::ChunkReadAhead>(
+      &cat.getDataMgr(),
+      std::move(chunks_per_fragment),
+      g_foreign_table_read_ahead_threads);
+}
+
+namespace {
+
+// The chunks read ahead in the fragments a kernel has scanned no longer count against
+// the read ahead budget.
+void mark_fragments_scanned(foreign_storage::ChunkReadAhead& read_ahead,
+                            const FragmentsList& frag_list,
+                            const std::vector<InputTableInfo>& query_infos) {
+  for (const auto& fragments_per_table : frag_list) {
+    for (const auto& query_info : query_infos) {
+      if (query_info.table_id != fragments_per_table.table_id) {
+        continue;
+      }
+      for (const auto frag_id : fragments_per_table.fragment_ids) {
+        CHECK_LT(frag_id, query_info.info.fragments.size());
+        const auto& fragment = query_info.info.fragments[frag_id];
+        read_ahead.fragmentScanned(fragment.physicalTableId, fragment.fragmentId);
+      }
+      break;
+    }
+  }
+}
+
+}  // namespace
+
 template <typename THREAD_POOL>
 void Executor::launchKernels(SharedKernelContext& shared_context,
-                             std::vector<std::unique_ptr<ExecutionKernel>>&& kernels) {
+                             std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                             foreign_storage::ChunkReadAhead* read_ahead) {
   auto clock_begin = timer_start();
   std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
   kernel_queue_time_ms_ += timer_stop(clock_begin);
@@ -2216,12 +2373,17 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     thread_pool.spawn(
-        [this, &shared_context, parent_thread_id = logger::thread_id()](
+        [this, &shared_context, read_ahead, parent_thread_id = logger::thread_id()](
             ExecutionKernel* kernel, const size_t crt_kernel_idx) {
           CHECK(kernel);
           DEBUG_TIMER_NEW_THREAD(parent_thread_id);
           const size_t thread_idx = crt_kernel_idx % cpu_threads();
           kernel->run(this, thread_idx, shared_context);
+          if (read_ahead) {
+            mark_fragments_scanned(*read_ahead,
+                                   kernel->getFragmentsList(),
+                                   shared_context.getQueryInfos());
+          }
         },
         kernel.get(),
         kernel_idx++);
@@ -3528,6 +3690,147 @@ std::tuple<bool, int64_t, int64_t> get_hpt_overflow_underflow_safe_scaled_values
   return std::make_tuple(false, chunk_min, chunk_max);
 }
 
+// Counts the fragments skipped for the reason, "geo_bounds" or "join_key_range"
+void record_skipped_fragment(const std::string& reason) {
+  metrics::Registry::instance()
+      .counter("omnisci_skipped_fragments_total",
+               "Fragments skipped by the runtime fragment skipping, by reason.",
+               "reason=\"" + reason + "\"")
+      .increment();
+}
+
+// Geo predicates which can only be true if the bounding boxes of both arguments intersect
+bool implies_geo_bounds_intersection(const std::string& name) {
+  return boost::algorithm::starts_with(name, "ST_Contains_") ||
+         boost::algorithm::starts_with(name, "ST_cContains_") ||
+         boost::algorithm::starts_with(name, "ST_Intersects_");
+}
+
+// Returns the bounding box of a geo literal, given its coords
+std::optional<GeoBoundingBox> get_geo_literal_bounds(const Analyzer::Constant* coords) {
+  const auto& ti = coords->get_type_info();
+  if (coords->get_is_null() || !ti.is_array() || ti.get_subtype() != kTINYINT) {
+    return std::nullopt;
+  }
+  std::vector<int8_t> coords_bytes;
+  for (const auto& elem : coords->get_value_list()) {
+    const auto elem_const = dynamic_cast<const Analyzer::Constant*>(elem.get());
+    if (!elem_const) {
+      return std::nullopt;
+    }
+    coords_bytes.push_back(elem_const->get_constval().tinyintval);
+  }
+  const auto decompressed_coords = Geospatial::decompress_coords<double, SQLTypeInfo>(
+      ti, coords_bytes.data(), coords_bytes.size());
+  if (decompressed_coords->size() < 2) {
+    return std::nullopt;
+  }
+  GeoBoundingBox bounds{std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::lowest(),
+                        std::numeric_limits<double>::lowest()};
+  for (size_t i = 0; i + 1 < decompressed_coords->size(); i += 2) {
+    bounds.xmin = std::min(bounds.xmin, (*decompressed_coords)[i]);
+    bounds.ymin = std::min(bounds.ymin, (*decompressed_coords)[i + 1]);
+    bounds.xmax = std::max(bounds.xmax, (*decompressed_coords)[i]);
+    bounds.ymax = std::max(bounds.ymax, (*decompressed_coords)[i + 1]);
+  }
+  return bounds;
+}
+
+// The srid constants at the given positions of a geo function, all equal when the
+// geometries are not transformed.
+bool has_untransformed_srids(const Analyzer::FunctionOper* func_oper,
+                             const std::vector<size_t>& srid_positions) {
+  std::optional<int32_t> first_srid;
+  for (const auto i : srid_positions) {
+    const auto srid = dynamic_cast<const Analyzer::Constant*>(func_oper->getArg(i));
+    if (!srid || srid->get_type_info().get_type() != kINT) {
+      return false;
+    }
+    if (!first_srid) {
+      first_srid = srid->get_constval().intval;
+    } else if (*first_srid != srid->get_constval().intval) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The bounds column of a geometry with bounds, or the coords column of a point
+bool is_geo_bounds_or_point_coords(const SQLTypeInfo& ti) {
+  if (!ti.is_fixlen_array()) {
+    return false;
+  }
+  return (ti.get_subtype() == kDOUBLE && ti.get_size() == 4 * sizeof(double)) ||
+         (ti.get_subtype() == kTINYINT && (ti.get_size() == 2 * sizeof(int32_t) ||
+                                           ti.get_size() == 2 * sizeof(double)));
+}
+
+std::optional<double> get_numeric_constant(const Analyzer::Expr* expr) {
+  const auto constant = dynamic_cast<const Analyzer::Constant*>(expr);
+  if (!constant || constant->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& ti = constant->get_type_info();
+  const auto& datum = constant->get_constval();
+  switch (ti.get_type()) {
+    case kDOUBLE:
+      return datum.doubleval;
+    case kFLOAT:
+      return datum.floatval;
+    case kTINYINT:
+      return datum.tinyintval;
+    case kSMALLINT:
+      return datum.smallintval;
+    case kINT:
+      return datum.intval;
+    case kBIGINT:
+      return datum.bigintval;
+    case kDECIMAL:
+    case kNUMERIC:
+      return static_cast<double>(datum.bigintval) / exp_to_scale(ti.get_scale());
+    default:
+      return std::nullopt;
+  }
+}
+
+// Whether a value in [min, max] can satisfy "value op constant"
+bool range_may_satisfy(const double min,
+                       const double max,
+                       const SQLOps op,
+                       const double constant) {
+  switch (op) {
+    case kLT:
+      return min < constant;
+    case kLE:
+      return min <= constant;
+    case kGT:
+      return max > constant;
+    case kGE:
+      return max >= constant;
+    case kEQ:
+      return min <= constant && constant <= max;
+    default:
+      return true;
+  }
+}
+
+SQLOps commute_comparison(const SQLOps op) {
+  switch (op) {
+    case kLT:
+      return kGT;
+    case kLE:
+      return kGE;
+    case kGT:
+      return kLT;
+    case kGE:
+      return kLE;
+    default:
+      return op;
+  }
+}
+
 }  // namespace
 
 bool Executor::isFragmentFullyDeleted(
@@ -3705,6 +4008,203 @@ std::pair<bool, int64_t> Executor::skipFragment(
   return {false, -1};
 }
 
+/*
+ * Skips fragments which cannot satisfy a spatial filter on a geo column, given the
+ * bounding box of the geometries of the column in the fragment:
+ *  - a geo predicate between the column and a geo literal, e.g.
+ *    ST_Contains(ST_GeomFromText('POLYGON(...)'), pt) or ST_Intersects(poly, <viewport>),
+ *    when the box of the literal does not intersect the box of the fragment;
+ *  - a comparison of a coordinate accessor with a constant, e.g. the viewport filters
+ *    ST_X(pt) BETWEEN x0 AND x1 or ST_XMax(poly) >= x0, when no coordinate of the
+ *    fragment satisfies it.
+ */
+bool Executor::skipFragmentGeoBounds(const InputDescriptor& table_desc,
+                                     const Fragmenter_Namespace::FragmentInfo& fragment,
+                                     const RelAlgExecutionUnit& ra_exe_unit) {
+  const int table_id = table_desc.getTableId();
+  if (table_id < 0 || table_desc.getSourceType() != InputSourceType::TABLE) {
+    return false;
+  }
+  CHECK(catalog_);
+  // Box of the geometries of the column the geo argument comes from, nullopt when all
+  // of them are null
+  auto get_fragment_bounds =
+      [&](const Analyzer::ColumnVar* col) -> std::optional<GeoBoundingBox> {
+    const auto physical_cd =
+        get_column_descriptor(col->get_column_id(), table_id, *catalog_);
+    const ColumnDescriptor* geo_cd{nullptr};
+    for (int column_id = col->get_column_id() - 1; column_id > 0; --column_id) {
+      geo_cd = get_column_descriptor(column_id, table_id, *catalog_);
+      if (!geo_cd->isGeoPhyCol) {
+        break;
+      }
+    }
+    CHECK(geo_cd && geo_cd->columnType.is_geometry());
+    const auto chunk_meta_it = fragment.getChunkMetadataMap().find(col->get_column_id());
+    CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+    const ChunkKey chunk_key{catalog_->getCurrentDB().dbId,
+                             table_id,
+                             col->get_column_id(),
+                             fragment.fragmentId};
+    return GeoFragmentBounds::get(geo_cd,
+                                  physical_cd,
+                                  chunk_key,
+                                  *chunk_meta_it->second,
+                                  &catalog_->getDataMgr());
+  };
+  auto is_fragment_column = [table_id](const Analyzer::ColumnVar* col) {
+    return col->get_table_id() == table_id && col->get_rte_idx() == 0 &&
+           is_geo_bounds_or_point_coords(col->get_type_info());
+  };
+
+  for (const auto& qual : ra_exe_unit.quals) {
+    const auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(qual.get());
+    if (!func_oper || !implies_geo_bounds_intersection(func_oper->getName())) {
+      continue;
+    }
+    // compression and srid of both arguments, followed by the output srid
+    const auto arity = func_oper->getArity();
+    if (arity < 5 ||
+        !has_untransformed_srids(func_oper, {arity - 4, arity - 2, arity - 1})) {
+      // the literal is transformed, column bounds are in the input srid
+      continue;
+    }
+    const Analyzer::ColumnVar* geo_col{nullptr};
+    std::optional<GeoBoundingBox> literal_bounds;
+    for (size_t i = 0; i < arity - 5; i++) {
+      const auto arg = func_oper->getArg(i);
+      if (const auto col = dynamic_cast<const Analyzer::ColumnVar*>(arg)) {
+        if (is_fragment_column(col)) {
+          geo_col = col;
+        }
+      } else if (const auto coords = dynamic_cast<const Analyzer::Constant*>(arg)) {
+        if (coords->get_type_info().is_array() &&
+            coords->get_type_info().get_subtype() == kTINYINT) {
+          literal_bounds = get_geo_literal_bounds(coords);
+        }
+      }
+    }
+    if (!geo_col || !literal_bounds) {
+      continue;
+    }
+    const auto fragment_bounds = get_fragment_bounds(geo_col);
+    if (!fragment_bounds || !fragment_bounds->intersects(*literal_bounds)) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " of table " << table_id
+              << " outside of the " << func_oper->getName() << " literal bounds";
+      record_skipped_fragment("geo_bounds");
+      return true;
+    }
+  }
+
+  for (const auto& qual : ra_exe_unit.quals) {
+    const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual.get());
+    if (!bin_oper || !IS_COMPARISON(bin_oper->get_optype()) ||
+        bin_oper->get_qualifier() != kONE) {
+      continue;
+    }
+    auto op = bin_oper->get_optype();
+    auto func_oper =
+        dynamic_cast<const Analyzer::FunctionOper*>(bin_oper->get_left_operand());
+    auto constant = get_numeric_constant(bin_oper->get_right_operand());
+    if (!func_oper) {
+      func_oper = dynamic_cast<const Analyzer::FunctionOper*>(
+          bin_oper->get_right_operand());
+      constant = get_numeric_constant(bin_oper->get_left_operand());
+      op = commute_comparison(op);
+    }
+    if (!func_oper || !constant) {
+      continue;
+    }
+    const auto& name = func_oper->getName();
+    const bool is_x = name == "ST_X_Point" || name == "ST_XMin_Bounds" ||
+                      name == "ST_XMax_Bounds";
+    const bool is_y = name == "ST_Y_Point" || name == "ST_YMin_Bounds" ||
+                      name == "ST_YMax_Bounds";
+    if (!is_x && !is_y) {
+      continue;
+    }
+    // the input and output srids are the last two arguments
+    const auto arity = func_oper->getArity();
+    const auto geo_col = dynamic_cast<const Analyzer::ColumnVar*>(func_oper->getArg(0));
+    if (arity < 3 || !has_untransformed_srids(func_oper, {arity - 2, arity - 1}) ||
+        !geo_col || !is_fragment_column(geo_col)) {
+      continue;
+    }
+    // every coordinate accessor of a geometry, including its bounding box corners, is in
+    // the range of the box of the fragment
+    const auto fragment_bounds = get_fragment_bounds(geo_col);
+    if (!fragment_bounds ||
+        !range_may_satisfy(is_x ? fragment_bounds->xmin : fragment_bounds->ymin,
+                           is_x ? fragment_bounds->xmax : fragment_bounds->ymax,
+                           op,
+                           *constant)) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " of table " << table_id
+              << " outside of the " << name << " range";
+      record_skipped_fragment("geo_bounds");
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * Skips the outer fragments which can't have a match in the hash table of an inner join
+ * because the range of their join keys, from the chunk metadata, doesn't intersect the
+ * range of the keys of the inner rows. The hash tables are built by the time the
+ * fragments are assigned to the kernels. The outer rows of left joins are kept whether
+ * they have a match or not.
+ */
+bool Executor::skipFragmentJoinKeyRanges(
+    const InputDescriptor& table_desc,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  if (!g_enable_runtime_join_filters || !plan_state_ ||
+      table_desc.getNestLevel() != 0) {
+    return false;
+  }
+  const int table_id = table_desc.getTableId();
+  for (const auto& hash_table : plan_state_->join_info_.join_hash_tables_) {
+    const auto level_idx = hash_table->getInnerTableRteIdx() - 1;
+    if (level_idx < 0 ||
+        static_cast<size_t>(level_idx) >= ra_exe_unit.join_quals.size() ||
+        ra_exe_unit.join_quals[level_idx].type != JoinType::INNER) {
+      continue;
+    }
+    const auto key_range = hash_table->getKeyRange();
+    if (!key_range || key_range->outer_col->get_table_id() != table_id ||
+        key_range->outer_col->get_rte_idx() != 0) {
+      continue;
+    }
+    bool skip{key_range->min > key_range->max};  // no inner row
+    if (!skip) {
+      const auto outer_col = key_range->outer_col;
+      auto chunk_meta_it =
+          fragment.getChunkMetadataMap().find(outer_col->get_column_id());
+      if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+        continue;
+      }
+      const auto& chunk_type = outer_col->get_type_info();
+      const auto chunk_min =
+          extract_min_stat(chunk_meta_it->second->chunkStats, chunk_type);
+      const auto chunk_max =
+          extract_max_stat(chunk_meta_it->second->chunkStats, chunk_type);
+      if (chunk_min > chunk_max) {
+        // invalid metadata range, do not skip fragment
+        continue;
+      }
+      skip = chunk_max < key_range->min || chunk_min > key_range->max;
+    }
+    if (skip) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " of table " << table_id
+              << " outside of the key range of the " << hash_table->getHashJoinType()
+              << " hash join of level " << level_idx;
+      record_skipped_fragment("join_key_range");
+      return true;
+    }
+  }
+  return false;
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
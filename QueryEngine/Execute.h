@@ -31,6 +31,7 @@
 #include "LoopControlFlow/JoinLoop.h"
 #include "NvidiaKernel.h"
 #include "PlanState.h"
+#include "QueryProfile.h"
 #include "RelAlgExecutionUnit.h"
 #include "RelAlgTranslator.h"
 #include "StringDictionaryGenerations.h"
@@ -77,6 +78,10 @@
 using QueryCompilationDescriptorOwned = std::unique_ptr<QueryCompilationDescriptor>;
 class QueryMemoryDescriptor;
 using QueryMemoryDescriptorOwned = std::unique_ptr<QueryMemoryDescriptor>;
+
+namespace foreign_storage {
+class ChunkReadAhead;
+}  // namespace foreign_storage
 using QuerySessionId = std::string;
 using CurrentQueryStatus = std::pair<QuerySessionId, std::string>;
 using InterruptFlagMap = std::map<QuerySessionId, bool>;
@@ -427,6 +432,11 @@ class Executor {
 
   const std::shared_ptr<RowSetMemoryOwner> getRowSetMemoryOwner() const;
 
+  PolygonIndexCache* getPolygonIndexCache() const;
+
+  // Profile being collected for EXPLAIN ANALYZE, null when the query is not profiled.
+  QueryProfile* getQueryProfile() const { return query_profile_.get(); }
+
   Fragmenter_Namespace::TableInfo getTableInfo(const int table_id) const;
 
   const TableGeneration& getTableGeneration(const int table_id) const;
@@ -603,7 +613,17 @@ class Executor {
    */
   template <typename THREAD_POOL>
   void launchKernels(SharedKernelContext& shared_context,
-                     std::vector<std::unique_ptr<ExecutionKernel>>&& kernels);
+                     std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
+                     foreign_storage::ChunkReadAhead* read_ahead = nullptr);
+
+  /**
+   * Starts reading ahead the foreign table chunks the kernels scan, while they run.
+   * Returns null when there is nothing to read ahead.
+   */
+  std::unique_ptr<foreign_storage::ChunkReadAhead> startForeignTableReadAhead(
+      const std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& query_infos);
 
   std::vector<size_t> getTableFragmentIndices(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -806,6 +826,7 @@ class Executor {
       const JoinCondition& current_level_join_conditions,
       RelAlgExecutionUnit& ra_exe_unit,
       const CompilationOptions& co,
+      const ExecutionOptions& eo,
       const std::vector<InputTableInfo>& query_infos,
       ColumnCacheMap& column_cache,
       std::vector<std::string>& fail_reasons);
@@ -906,6 +927,14 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  bool skipFragmentGeoBounds(const InputDescriptor& table_desc,
+                             const Fragmenter_Namespace::FragmentInfo& fragment,
+                             const RelAlgExecutionUnit& ra_exe_unit);
+
+  bool skipFragmentJoinKeyRanges(const InputDescriptor& table_desc,
+                                 const RelAlgExecutionUnit& ra_exe_unit,
+                                 const Fragmenter_Namespace::FragmentInfo& fragment);
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -1059,6 +1088,9 @@ class Executor {
   int64_t kernel_queue_time_ms_ = 0;
   int64_t compilation_queue_time_ms_ = 0;
 
+  // Set by the RelAlgExecutor while it holds the execute mutex for a profiled query.
+  std::shared_ptr<QueryProfile> query_profile_;
+
   // Singleton instance used for an execution unit which is a project with window
   // functions.
   std::unique_ptr<WindowProjectNodeContext> window_project_node_context_owned_;
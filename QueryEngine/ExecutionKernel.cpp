@@ -26,6 +26,12 @@
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/SerializeToSql.h"
 
+#ifdef ENABLE_GEOS
+// Drops the geometries the GEOS runtime functions cached on the thread, see
+// NativeCodegen.cpp.
+void clear_geos_cached_geometries();
+#endif
+
 namespace {
 
 bool needs_skip_result(const ResultSetPtr& res) {
@@ -94,6 +100,11 @@ void ExecutionKernel::run(Executor* executor,
                           SharedKernelContext& shared_context) {
   DEBUG_TIMER("ExecutionKernel::run");
   INJECT_TIMER(kernel_run);
+  auto clock_begin = timer_start();
+#ifdef ENABLE_GEOS
+  // keyed by the buffers of the kernels the thread ran before
+  clear_geos_cached_geometries();
+#endif
   try {
     runImpl(executor, thread_idx, shared_context);
   } catch (const OutOfHostMemory& e) {
@@ -118,6 +129,38 @@ void ExecutionKernel::run(Executor* executor,
   } catch (const QueryExecutionError& e) {
     throw e;
   }
+  if (auto query_profile = executor->getQueryProfile()) {
+    recordProfile(*query_profile, thread_idx, shared_context, timer_stop(clock_begin));
+  }
+}
+
+void ExecutionKernel::recordProfile(QueryProfile& query_profile,
+                                    const size_t thread_idx,
+                                    const SharedKernelContext& shared_context,
+                                    const int64_t time_ms) const {
+  CHECK(!frag_list.empty());
+  const auto outer_table_id = frag_list[0].table_id;
+  const auto& outer_fragment_ids = frag_list[0].fragment_ids;
+  size_t rows_in{0};
+  for (const auto& table_info : shared_context.getQueryInfos()) {
+    if (table_info.table_id != outer_table_id) {
+      continue;
+    }
+    const auto& fragments = table_info.info.fragments;
+    for (const auto fragment_id : outer_fragment_ids) {
+      if (fragment_id < fragments.size()) {
+        rows_in += fragments[fragment_id].getNumTuples();
+      }
+    }
+    break;
+  }
+  query_profile.addKernel(outer_table_id,
+                          {chosen_device_type,
+                           chosen_device_id,
+                           thread_idx,
+                           outer_fragment_ids,
+                           rows_in,
+                           time_ms});
 }
 
 void ExecutionKernel::runImpl(Executor* executor,
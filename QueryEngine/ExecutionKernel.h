@@ -19,6 +19,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
+#include "QueryEngine/QueryProfile.h"
 
 class SharedKernelContext {
  public:
@@ -76,6 +77,8 @@ class ExecutionKernel {
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  const FragmentsList& getFragmentsList() const { return frag_list; }
+
  private:
   const RelAlgExecutionUnit& ra_exe_unit_;
   const ExecutorDeviceType chosen_device_type;
@@ -94,4 +97,9 @@ class ExecutionKernel {
   void runImpl(Executor* executor,
                const size_t thread_idx,
                SharedKernelContext& shared_context);
+
+  void recordProfile(QueryProfile& query_profile,
+                     const size_t thread_idx,
+                     const SharedKernelContext& shared_context,
+                     const int64_t time_ms) const;
 };
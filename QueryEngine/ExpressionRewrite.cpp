@@ -752,10 +752,125 @@ static const std::unordered_set<std::string> requires_many_to_many = {
     "ST_Intersects_MultiPolygon_MultiPolygon",
     "ST_Intersects_MultiPolygon_Polygon"};
 
+int32_t get_int_constant_arg(const Analyzer::FunctionOper* func_oper,
+                             const size_t arg_idx) {
+  const auto arg = dynamic_cast<const Analyzer::Constant*>(func_oper->getArg(arg_idx));
+  CHECK(arg);
+  return arg->get_constval().intval;
+}
+
+/**
+ * Rewrites a distance join between two point columns, ST_DWithin(a.pt, b.pt, d) or
+ * ST_Distance(a.pt, b.pt) <= d, to an overlaps join between the outer point and the inner
+ * point coords expanded by the distance. The original qual is kept to filter the
+ * candidate pairs.
+ */
+boost::optional<OverlapsJoinConjunction> rewrite_range_conjunction(
+    const std::shared_ptr<Analyzer::Expr> expr,
+    const Analyzer::FunctionOper* func_oper,
+    const Analyzer::Expr* distance,
+    const bool is_geodesic) {
+  // point, point, compression / srid of both, output srid
+  CHECK_GE(func_oper->getArity(), size_t(7));
+  const auto p0 = dynamic_cast<const Analyzer::ColumnVar*>(func_oper->getArg(0));
+  const auto p1 = dynamic_cast<const Analyzer::ColumnVar*>(func_oper->getArg(1));
+  if (!p0 || !p1 || p0->get_rte_idx() == p1->get_rte_idx()) {
+    return boost::none;
+  }
+  const auto output_srid = get_int_constant_arg(func_oper, 6);
+  if (get_int_constant_arg(func_oper, 3) != output_srid ||
+      get_int_constant_arg(func_oper, 5) != output_srid) {
+    VLOG(1) << "Range join not supported with transforms: " << func_oper->toString();
+    return boost::none;
+  }
+
+  const auto inner = p0->get_rte_idx() > p1->get_rte_idx() ? p0 : p1;
+  const auto outer = inner == p0 ? p1 : p0;
+  const auto& inner_ti = inner->get_type_info();
+  if (inner_ti.get_type() != kPOINT || outer->get_type_info().get_type() != kPOINT ||
+      inner->get_table_id() <= 0) {
+    // the hash table reads the physical coords column of the inner point
+    return boost::none;
+  }
+
+  auto distance_expr =
+      fold_expr(distance->deep_copy()->add_cast(SQLTypeInfo(kDOUBLE, false)).get());
+  const auto distance_const =
+      std::dynamic_pointer_cast<const Analyzer::Constant>(distance_expr);
+  if (!distance_const || distance_const->get_is_null() ||
+      distance_const->get_constval().doubleval < 0) {
+    VLOG(1) << "Range join requires a non-negative constant distance: "
+            << func_oper->toString();
+    return boost::none;
+  }
+
+  SQLTypeInfo coords_ti(kARRAY, inner_ti.get_notnull());
+  coords_ti.set_subtype(kTINYINT);
+  const bool is_compressed =
+      inner_ti.get_compression() == kENCODING_GEOINT && inner_ti.get_comp_param() == 32;
+  coords_ti.set_size(2 * (is_compressed ? sizeof(int32_t) : sizeof(double)));
+  auto inner_coords = makeExpr<Analyzer::ColumnVar>(
+      coords_ti, inner->get_table_id(), inner->get_column_id() + 1, inner->get_rte_idx());
+
+  DeepCopyVisitor deep_copy_visitor;
+  auto overlaps_oper = makeExpr<Analyzer::BinOper>(
+      kBOOLEAN,
+      kOVERLAPS,
+      kONE,
+      deep_copy_visitor.visit(outer),
+      makeExpr<Analyzer::RangeOper>(inner_coords, distance_expr, is_geodesic));
+
+  VLOG(1) << "Successfully converted to range join: " << overlaps_oper->toString();
+  return OverlapsJoinConjunction{{expr}, {overlaps_oper}};
+}
+
+boost::optional<OverlapsJoinConjunction> rewrite_range_conjunction(
+    const std::shared_ptr<Analyzer::Expr> expr) {
+  if (!g_enable_distance_rangejoin) {
+    return boost::none;
+  }
+  if (auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(expr.get())) {
+    if (func_oper->getName() == "ST_DWithin_Point_Point") {
+      CHECK_EQ(func_oper->getArity(), size_t(8));
+      return rewrite_range_conjunction(expr, func_oper, func_oper->getArg(7), false);
+    }
+    return boost::none;
+  }
+  auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(expr.get());
+  if (!bin_oper) {
+    return boost::none;
+  }
+  // distance <= d or d >= distance
+  auto optype = bin_oper->get_optype();
+  auto lhs = bin_oper->get_left_operand();
+  auto rhs = bin_oper->get_right_operand();
+  if (optype == kGE || optype == kGT) {
+    std::swap(lhs, rhs);
+    optype = optype == kGE ? kLE : kLT;
+  }
+  if (optype != kLE && optype != kLT) {
+    return boost::none;
+  }
+  auto func_oper = dynamic_cast<const Analyzer::FunctionOper*>(lhs);
+  if (!func_oper) {
+    return boost::none;
+  }
+  if (func_oper->getName() == "ST_Distance_Point_Point") {
+    return rewrite_range_conjunction(expr, func_oper, rhs, false);
+  }
+  if (func_oper->getName() == "ST_Distance_Point_Point_Geodesic") {
+    return rewrite_range_conjunction(expr, func_oper, rhs, true);
+  }
+  return boost::none;
+}
+
 }  // namespace
 
 boost::optional<OverlapsJoinConjunction> rewrite_overlaps_conjunction(
     const std::shared_ptr<Analyzer::Expr> expr) {
+  if (auto range_conjunction = rewrite_range_conjunction(expr)) {
+    return range_conjunction;
+  }
   auto func_oper = dynamic_cast<Analyzer::FunctionOper*>(expr.get());
   if (func_oper) {
     const auto needs_many_many = [func_oper]() {
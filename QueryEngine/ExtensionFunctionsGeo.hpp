@@ -513,6 +513,85 @@ DEVICE ALWAYS_INLINE bool tol_zero_template(const T x,
 
 enum class EdgeBehavior { kIncludePointOnEdge, kExcludePointOnEdge };
 
+/**
+ * Accounts for a single directed polygon edge (e0, e1) in the winding number of point p.
+ * Returns true if p lies on the edge, in which case the caller is expected to stop and
+ * return according to TEdgeBehavior. Only edges whose y-range contains p can update the
+ * winding number, which the prepared polygon index relies on to skip all other edges.
+ */
+template <typename T, EdgeBehavior TEdgeBehavior>
+DEVICE ALWAYS_INLINE bool winding_number_edge(const T e0x,
+                                              const T e0y,
+                                              const T e1x,
+                                              const T e1y,
+                                              const T px,
+                                              const T py,
+                                              int32_t& wn) {
+  constexpr bool include_point_on_edge =
+      TEdgeBehavior == EdgeBehavior::kIncludePointOnEdge;
+
+  auto get_epsilon = [=]() -> T {
+    if constexpr (std::is_floating_point<T>::value) {
+      const T edge_vec_magnitude = (e1x - e0x) * (e1x - e0x) + (e1y - e0y) * (e1y - e0y);
+      return 0.003 * edge_vec_magnitude;
+    } else {
+      return T(0);
+    }
+    return T{};  // https://stackoverflow.com/a/64561686/2700898
+  };
+
+  const T epsilon = get_epsilon();
+  DEBUG_STMT(printf("using epsilon value %e\n", (double)epsilon));
+
+  if constexpr (include_point_on_edge) {
+    const T xp = (px - e1x) * (e0y - e1y) - (py - e1y) * (e0x - e1x);
+    const T pt_vec_magnitude = (px - e0x) * (px - e0x) + (py - e0y) * (py - e0y);
+    const T edge_vec_magnitude = (e1x - e0x) * (e1x - e0x) + (e1y - e0y) * (e1y - e0y);
+    if (tol_zero_template(xp, epsilon) && (pt_vec_magnitude <= edge_vec_magnitude)) {
+      DEBUG_STMT(printf("point is on edge: %e && %e <= %e\n",
+                        (double)xp,
+                        (double)pt_vec_magnitude,
+                        (double)edge_vec_magnitude));
+      return true;
+    }
+  }
+
+  if (e0y <= py) {
+    if (e1y > py) {
+      // upward crossing
+      DEBUG_STMT(printf("upward crossing\n"));
+      const auto is_left_val = is_left(e0x, e0y, e1x, e1y, px, py);
+      DEBUG_STMT(printf("Left val %f and tol zero left val %d\n",
+                        (double)is_left_val,
+                        tol_zero_template(is_left_val, epsilon)));
+      if (UNLIKELY(tol_zero_template(is_left_val, epsilon))) {
+        // p is on the edge
+        return true;
+      } else if (is_left_val > T(0)) {  // p left of edge
+        // valid up intersection
+        DEBUG_STMT(printf("++wn\n"));
+        ++wn;
+      }
+    }
+  } else if (e1y <= py) {
+    // downward crossing
+    DEBUG_STMT(printf("downward crossing\n"));
+    const auto is_left_val = is_left(e0x, e0y, e1x, e1y, px, py);
+    DEBUG_STMT(printf("Left val %f and tol zero left val %d\n",
+                      (double)is_left_val,
+                      tol_zero_template(is_left_val, epsilon)));
+    if (UNLIKELY(tol_zero_template(is_left_val, epsilon))) {
+      // p is on the edge
+      return true;
+    } else if (is_left_val < T(0)) {  // p right of edge
+      // valid down intersection
+      DEBUG_STMT(printf("--wn\n"));
+      --wn;
+    }
+  }
+  return false;
+}
+
 /**
  * Computes whether the point p is inside the polygon poly using the winding number
  * algorithm.
@@ -577,65 +656,8 @@ DEVICE ALWAYS_INLINE bool point_in_polygon_winding_number(const int8_t* poly,
     DEBUG_STMT(printf("edge 0: %ld : %f, %f\n", e0_index, (double)e0x, (double)e0y));
     DEBUG_STMT(printf("edge 1: %ld : %f, %f\n", e1_index, (double)e1x, (double)e1y));
 
-    auto get_epsilon = [=]() -> T {
-      if constexpr (std::is_floating_point<T>::value) {
-        const T edge_vec_magnitude =
-            (e1x - e0x) * (e1x - e0x) + (e1y - e0y) * (e1y - e0y);
-        return 0.003 * edge_vec_magnitude;
-      } else {
-        return T(0);
-      }
-      return T{};  // https://stackoverflow.com/a/64561686/2700898
-    };
-
-    const T epsilon = get_epsilon();
-    DEBUG_STMT(printf("using epsilon value %e\n", (double)epsilon));
-
-    if constexpr (include_point_on_edge) {
-      const T xp = (px - e1x) * (e0y - e1y) - (py - e1y) * (e0x - e1x);
-      const T pt_vec_magnitude = (px - e0x) * (px - e0x) + (py - e0y) * (py - e0y);
-      const T edge_vec_magnitude = (e1x - e0x) * (e1x - e0x) + (e1y - e0y) * (e1y - e0y);
-      if (tol_zero_template(xp, epsilon) && (pt_vec_magnitude <= edge_vec_magnitude)) {
-        DEBUG_STMT(printf("point is on edge: %e && %e <= %e\n",
-                          (double)xp,
-                          (double)pt_vec_magnitude,
-                          (double)edge_vec_magnitude));
-        return include_point_on_edge;
-      }
-    }
-
-    if (e0y <= py) {
-      if (e1y > py) {
-        // upward crossing
-        DEBUG_STMT(printf("upward crossing\n"));
-        const auto is_left_val = is_left(e0x, e0y, e1x, e1y, px, py);
-        DEBUG_STMT(printf("Left val %f and tol zero left val %d\n",
-                          (double)is_left_val,
-                          tol_zero_template(is_left_val, epsilon)));
-        if (UNLIKELY(tol_zero_template(is_left_val, epsilon))) {
-          // p is on the edge
-          return include_point_on_edge;
-        } else if (is_left_val > T(0)) {  // p left of edge
-          // valid up intersection
-          DEBUG_STMT(printf("++wn\n"));
-          ++wn;
-        }
-      }
-    } else if (e1y <= py) {
-      // downward crossing
-      DEBUG_STMT(printf("downward crossing\n"));
-      const auto is_left_val = is_left(e0x, e0y, e1x, e1y, px, py);
-      DEBUG_STMT(printf("Left val %f and tol zero left val %d\n",
-                        (double)is_left_val,
-                        tol_zero_template(is_left_val, epsilon)));
-      if (UNLIKELY(tol_zero_template(is_left_val, epsilon))) {
-        // p is on the edge
-        return include_point_on_edge;
-      } else if (is_left_val < T(0)) {  // p right of edge
-        // valid down intersection
-        DEBUG_STMT(printf("--wn\n"));
-        --wn;
-      }
+    if (winding_number_edge<T, TEdgeBehavior>(e0x, e0y, e1x, e1y, px, py, wn)) {
+      return include_point_on_edge;
     }
 
     e0_index = e1_index;
@@ -19,9 +19,11 @@
 #include "ExtensionFunctions.hpp"
 #include "ExtensionFunctionsBinding.h"
 #include "ExtensionFunctionsWhitelist.h"
+#include "PolygonIndex.h"
 #include "TableFunctions/TableFunctions.hpp"
 
 #include <tuple>
+#include <unordered_set>
 
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -219,6 +221,218 @@ bool ext_func_call_requires_nullcheck(const Analyzer::FunctionOper* function_ope
   return false;
 }
 
+// Point-in-polygon functions which can probe a prepared polygon index on CPU. Only the
+// polygons probed by many rows are indexed: a literal, or the inner side of a join. The
+// index is cached for the work unit by polygon argument and inner row, which has to be
+// the same in every kernel, hence sharded inner tables are not indexed.
+bool is_polygon_index_candidate(const Analyzer::FunctionOper* function_oper,
+                                const std::string& ext_func_name,
+                                const Catalog_Namespace::Catalog* catalog) {
+  static const std::unordered_set<std::string> indexed_functions{
+      "ST_Contains_Polygon_Point",
+      "ST_cContains_Polygon_Point",
+      "ST_Contains_MultiPolygon_Point",
+      "ST_cContains_MultiPolygon_Point"};
+  if (!indexed_functions.count(ext_func_name)) {
+    return false;
+  }
+  CHECK_GT(function_oper->getArity(), size_t(0));
+  const auto poly_arg = function_oper->getArg(0);
+  if (dynamic_cast<const Analyzer::Constant*>(poly_arg)) {
+    return true;
+  }
+  const auto poly_col = dynamic_cast<const Analyzer::ColumnVar*>(poly_arg);
+  if (!poly_col || poly_col->get_rte_idx() == 0) {
+    return false;
+  }
+  if (poly_col->get_table_id() > 0) {
+    CHECK(catalog);
+    const auto td = catalog->getMetadataForTable(poly_col->get_table_id());
+    return td && td->nShards == 0;
+  }
+  return true;
+}
+
+// Polygons with fewer vertices are cheaper to probe directly than to index
+constexpr int64_t kMinPolygonIndexVertices{256};
+
+template <typename T>
+PolygonIndex<T> build_polygon_index(const int8_t* coords,
+                                    const std::vector<int32_t>& ring_sizes,
+                                    const std::vector<int32_t>& poly_num_rings,
+                                    const int32_t ic,
+                                    const int32_t isr,
+                                    const int32_t osr) {
+  PolygonIndex<T> index;
+  index.poly_num_rings = poly_num_rings;
+  index.rings.reserve(ring_sizes.size());
+  std::vector<T> ring_coords;
+  for (const auto ring_size : ring_sizes) {
+    ring_coords.resize(2 * ring_size);
+    for (int32_t i = 0; i < 2 * ring_size; i += 2) {
+      if constexpr (std::is_floating_point<T>::value) {
+        ring_coords[i] = coord_x(coords, i, ic, isr, osr);
+        ring_coords[i + 1] = coord_y(coords, i + 1, ic, isr, osr);
+      } else {
+        ring_coords[i] = compressed_coord(coords, i);
+        ring_coords[i + 1] = compressed_coord(coords, i + 1);
+      }
+    }
+    index.rings.emplace_back(ring_coords);
+    coords += 2 * ring_size * compression_unit_size(ic);
+  }
+  return index;
+}
+
+template <typename T>
+bool ring_index_contains_point(const RingSlabIndex<T>& ring, const T px, const T py) {
+  int32_t wn = 0;
+  const auto [edges_begin, edges_end] = ring.getEdges(py);
+  for (auto edge = edges_begin; edge != edges_end; ++edge) {
+    if (winding_number_edge<T, EdgeBehavior::kExcludePointOnEdge>(
+            edge->x0, edge->y0, edge->x1, edge->y1, px, py, wn)) {
+      return false;
+    }
+  }
+  return wn != 0;
+}
+
+// Same semantics as Contains_MultiPolygon_Point_Impl: the point is contained if it is
+// inside the exterior ring and outside of all the holes of any of the polygons.
+template <typename T>
+bool polygon_index_contains_point(const PolygonIndex<T>& index,
+                                  const int8_t* p,
+                                  const int32_t ic2,
+                                  const int32_t isr2,
+                                  const int32_t osr) {
+  T px, py;
+  if constexpr (std::is_floating_point<T>::value) {
+    px = coord_x(p, 0, ic2, isr2, osr);
+    py = coord_y(p, 1, ic2, isr2, osr);
+  } else {
+    px = compressed_coord(p, 0);
+    py = compressed_coord(p, 1);
+  }
+  size_t exterior_ring = 0;
+  for (const auto num_rings : index.poly_num_rings) {
+    const auto rings_begin = index.rings.begin() + exterior_ring;
+    const auto rings_end = rings_begin + num_rings;
+    exterior_ring += num_rings;
+    if (num_rings == 0 || !ring_index_contains_point(*rings_begin, px, py)) {
+      continue;
+    }
+    if (std::none_of(rings_begin + 1, rings_end, [px, py](const auto& hole) {
+          return ring_index_contains_point(hole, px, py);
+        })) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+bool contains_multipolygon_point_indexed(const int64_t exec,
+                                         const int32_t polygon_id,
+                                         const int64_t polygon_row,
+                                         const int8_t* mpoly_coords,
+                                         const int64_t mpoly_coords_size,
+                                         const int32_t* mpoly_ring_sizes,
+                                         const int64_t mpoly_num_rings,
+                                         const int32_t* mpoly_poly_sizes,
+                                         const int64_t mpoly_num_polys,
+                                         const double* mpoly_bounds,
+                                         const int64_t mpoly_bounds_size,
+                                         const int8_t* p,
+                                         const int64_t psize,
+                                         const int32_t ic1,
+                                         const int32_t isr1,
+                                         const int32_t ic2,
+                                         const int32_t isr2,
+                                         const int32_t osr) {
+  const auto mpoly_num_coords = mpoly_coords_size / compression_unit_size(ic1);
+  if (mpoly_num_coords < 2 * kMinPolygonIndexVertices) {
+    return Contains_MultiPolygon_Point_Impl<T, EdgeBehavior::kExcludePointOnEdge>(
+        mpoly_coords,
+        mpoly_coords_size,
+        mpoly_ring_sizes,
+        mpoly_num_rings,
+        mpoly_poly_sizes,
+        mpoly_num_polys,
+        mpoly_bounds,
+        mpoly_bounds_size,
+        p,
+        psize,
+        ic1,
+        isr1,
+        ic2,
+        isr2,
+        osr);
+  }
+  if (mpoly_num_polys <= 0) {
+    return false;
+  }
+  if (mpoly_bounds && !box_contains_point(mpoly_bounds,
+                                          mpoly_bounds_size,
+                                          coord_x(p, 0, ic2, isr2, osr),
+                                          coord_y(p, 1, ic2, isr2, osr))) {
+    return false;
+  }
+  auto polygon_index_cache = reinterpret_cast<Executor*>(exec)->getPolygonIndexCache();
+  const auto index = polygon_index_cache->getOrBuild<T>({polygon_id, polygon_row}, [&]() {
+    return build_polygon_index<T>(
+        mpoly_coords,
+        std::vector<int32_t>(mpoly_ring_sizes, mpoly_ring_sizes + mpoly_num_rings),
+        std::vector<int32_t>(mpoly_poly_sizes, mpoly_poly_sizes + mpoly_num_polys),
+        ic1,
+        isr1,
+        osr);
+  });
+  return polygon_index_contains_point(*index, p, ic2, isr2, osr);
+}
+
+template <typename T>
+bool contains_polygon_point_indexed(const int64_t exec,
+                                    const int32_t polygon_id,
+                                    const int64_t polygon_row,
+                                    const int8_t* poly_coords,
+                                    const int64_t poly_coords_size,
+                                    const int32_t* poly_ring_sizes,
+                                    const int64_t poly_num_rings,
+                                    const double* poly_bounds,
+                                    const int64_t poly_bounds_size,
+                                    const int8_t* p,
+                                    const int64_t psize,
+                                    const int32_t ic1,
+                                    const int32_t isr1,
+                                    const int32_t ic2,
+                                    const int32_t isr2,
+                                    const int32_t osr) {
+  // A polygon is indexed as a multipolygon of one, without ring sizes all the
+  // coordinates form the exterior ring
+  const int32_t poly_num_coords = poly_coords_size / compression_unit_size(ic1);
+  const int32_t exterior_ring_size = poly_num_coords / 2;
+  const auto ring_sizes = poly_num_rings > 0 ? poly_ring_sizes : &exterior_ring_size;
+  const int32_t num_rings = poly_num_rings > 0 ? poly_num_rings : 1;
+  return contains_multipolygon_point_indexed<T>(exec,
+                                                polygon_id,
+                                                polygon_row,
+                                                poly_coords,
+                                                poly_coords_size,
+                                                ring_sizes,
+                                                num_rings,
+                                                &num_rings,
+                                                1,
+                                                poly_bounds,
+                                                poly_bounds_size,
+                                                p,
+                                                psize,
+                                                ic1,
+                                                isr1,
+                                                ic2,
+                                                isr2,
+                                                osr);
+}
+
 }  // namespace
 
 extern "C" RUNTIME_EXPORT void register_buffer_with_executor_rsm(int64_t exec,
@@ -229,6 +443,154 @@ extern "C" RUNTIME_EXPORT void register_buffer_with_executor_rsm(int64_t exec,
   }
 }
 
+extern "C" RUNTIME_EXPORT bool ST_Contains_Polygon_Point_Indexed(
+    const int64_t exec,
+    const int32_t polygon_id,
+    const int64_t polygon_row,
+    const int8_t* poly_coords,
+    const int64_t poly_coords_size,
+    const int32_t* poly_ring_sizes,
+    const int64_t poly_num_rings,
+    const double* poly_bounds,
+    const int64_t poly_bounds_size,
+    const int8_t* p,
+    const int64_t psize,
+    const int32_t ic1,
+    const int32_t isr1,
+    const int32_t ic2,
+    const int32_t isr2,
+    const int32_t osr) {
+  return contains_polygon_point_indexed<double>(exec,
+                                                polygon_id,
+                                                polygon_row,
+                                                poly_coords,
+                                                poly_coords_size,
+                                                poly_ring_sizes,
+                                                poly_num_rings,
+                                                poly_bounds,
+                                                poly_bounds_size,
+                                                p,
+                                                psize,
+                                                ic1,
+                                                isr1,
+                                                ic2,
+                                                isr2,
+                                                osr);
+}
+
+extern "C" RUNTIME_EXPORT bool ST_cContains_Polygon_Point_Indexed(
+    const int64_t exec,
+    const int32_t polygon_id,
+    const int64_t polygon_row,
+    const int8_t* poly_coords,
+    const int64_t poly_coords_size,
+    const int32_t* poly_ring_sizes,
+    const int64_t poly_num_rings,
+    const double* poly_bounds,
+    const int64_t poly_bounds_size,
+    const int8_t* p,
+    const int64_t psize,
+    const int32_t ic1,
+    const int32_t isr1,
+    const int32_t ic2,
+    const int32_t isr2,
+    const int32_t osr) {
+  return contains_polygon_point_indexed<int64_t>(exec,
+                                                 polygon_id,
+                                                 polygon_row,
+                                                 poly_coords,
+                                                 poly_coords_size,
+                                                 poly_ring_sizes,
+                                                 poly_num_rings,
+                                                 poly_bounds,
+                                                 poly_bounds_size,
+                                                 p,
+                                                 psize,
+                                                 ic1,
+                                                 isr1,
+                                                 ic2,
+                                                 isr2,
+                                                 osr);
+}
+
+extern "C" RUNTIME_EXPORT bool ST_Contains_MultiPolygon_Point_Indexed(
+    const int64_t exec,
+    const int32_t polygon_id,
+    const int64_t polygon_row,
+    const int8_t* mpoly_coords,
+    const int64_t mpoly_coords_size,
+    const int32_t* mpoly_ring_sizes,
+    const int64_t mpoly_num_rings,
+    const int32_t* mpoly_poly_sizes,
+    const int64_t mpoly_num_polys,
+    const double* mpoly_bounds,
+    const int64_t mpoly_bounds_size,
+    const int8_t* p,
+    const int64_t psize,
+    const int32_t ic1,
+    const int32_t isr1,
+    const int32_t ic2,
+    const int32_t isr2,
+    const int32_t osr) {
+  return contains_multipolygon_point_indexed<double>(exec,
+                                                     polygon_id,
+                                                     polygon_row,
+                                                     mpoly_coords,
+                                                     mpoly_coords_size,
+                                                     mpoly_ring_sizes,
+                                                     mpoly_num_rings,
+                                                     mpoly_poly_sizes,
+                                                     mpoly_num_polys,
+                                                     mpoly_bounds,
+                                                     mpoly_bounds_size,
+                                                     p,
+                                                     psize,
+                                                     ic1,
+                                                     isr1,
+                                                     ic2,
+                                                     isr2,
+                                                     osr);
+}
+
+extern "C" RUNTIME_EXPORT bool ST_cContains_MultiPolygon_Point_Indexed(
+    const int64_t exec,
+    const int32_t polygon_id,
+    const int64_t polygon_row,
+    const int8_t* mpoly_coords,
+    const int64_t mpoly_coords_size,
+    const int32_t* mpoly_ring_sizes,
+    const int64_t mpoly_num_rings,
+    const int32_t* mpoly_poly_sizes,
+    const int64_t mpoly_num_polys,
+    const double* mpoly_bounds,
+    const int64_t mpoly_bounds_size,
+    const int8_t* p,
+    const int64_t psize,
+    const int32_t ic1,
+    const int32_t isr1,
+    const int32_t ic2,
+    const int32_t isr2,
+    const int32_t osr) {
+  return contains_multipolygon_point_indexed<int64_t>(exec,
+                                                      polygon_id,
+                                                      polygon_row,
+                                                      mpoly_coords,
+                                                      mpoly_coords_size,
+                                                      mpoly_ring_sizes,
+                                                      mpoly_num_rings,
+                                                      mpoly_poly_sizes,
+                                                      mpoly_num_polys,
+                                                      mpoly_bounds,
+                                                      mpoly_bounds_size,
+                                                      p,
+                                                      psize,
+                                                      ic1,
+                                                      isr1,
+                                                      ic2,
+                                                      isr2,
+                                                      osr);
+}
+
 llvm::Value* CodeGenerator::codegenFunctionOper(
     const Analyzer::FunctionOper* function_oper,
     const CompilationOptions& co) {
@@ -357,8 +719,25 @@ llvm::Value* CodeGenerator::codegenFunctionOper(
     args.insert(args.begin(), buffer_ret);
   }
 
+  auto ext_func_name = ext_func_sig.getName();
+  if (co.device_type == ExecutorDeviceType::CPU && g_enable_polygon_index &&
+      is_polygon_index_candidate(
+          function_oper, ext_func_name, executor()->getCatalog())) {
+    // Probe a polygon index built once per work unit instead of walking all the edges
+    const auto poly_arg = function_oper->getArg(0);
+    const auto polygon_row = dynamic_cast<const Analyzer::ColumnVar*>(poly_arg)
+                                 ? posArg(poly_arg)
+                                 : cgen_state_->llInt(int64_t(0));
+    const auto polygon_id = plan_state_->polygon_index_cache_.registerPolygonArg();
+    args.insert(args.begin(),
+                {cgen_state_->llInt(reinterpret_cast<int64_t>(executor())),
+                 cgen_state_->llInt(polygon_id),
+                 polygon_row});
+    ext_func_name += "_Indexed";
+  }
+
   const auto ext_call = cgen_state_->emitExternalCall(
-      ext_func_sig.getName(), ret_ty, args, {}, ret_ti.is_buffer());
+      ext_func_name, ret_ty, args, {}, ret_ti.is_buffer());
   auto ext_call_nullcheck = endArgsNullcheck(
       bbs, ret_ti.is_buffer() ? buffer_ret : ext_call, null_buffer_ptr, function_oper);
 
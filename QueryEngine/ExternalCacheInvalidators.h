@@ -25,12 +25,15 @@
  */
 
 // Classes that are involved in needing a cache invalidated
+#include "GeoFragmentBounds.h"
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JoinHashTable/PerfectJoinHashTable.h"
 
-using UpdateTriggeredCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using UpdateTriggeredCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                         BaselineJoinHashTable,
+                                                         PerfectJoinHashTable,
+                                                         GeoFragmentBounds>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
 // Note that this is functionally the same as the above two invalidators. The
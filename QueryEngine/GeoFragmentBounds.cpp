@@ -0,0 +1,162 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/GeoFragmentBounds.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "Geospatial/Compression.h"
+#include "Shared/InlineNullValues.h"
+
+namespace {
+
+class BoundingBoxBuilder {
+ public:
+  void add(const double x, const double y) { add(x, y, x, y); }
+
+  void add(const double xmin, const double ymin, const double xmax, const double ymax) {
+    box_.xmin = std::min(box_.xmin, xmin);
+    box_.ymin = std::min(box_.ymin, ymin);
+    box_.xmax = std::max(box_.xmax, xmax);
+    box_.ymax = std::max(box_.ymax, ymax);
+    empty_ = false;
+  }
+
+  std::optional<GeoBoundingBox> get() const {
+    return empty_ ? std::nullopt : std::make_optional(box_);
+  }
+
+ private:
+  GeoBoundingBox box_{std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest()};
+  bool empty_{true};
+};
+
+template <typename T>
+T read_unaligned(const int8_t* ptr) {
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+std::optional<GeoBoundingBox> GeoFragmentBounds::get(
+    const ColumnDescriptor* geo_cd,
+    const ColumnDescriptor* physical_cd,
+    const ChunkKey& chunk_key,
+    const ChunkMetadata& chunk_metadata,
+    Data_Namespace::DataMgr* data_mgr) {
+  const size_t num_elements = chunk_metadata.numElements;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = cache_.find(chunk_key);
+    if (it != cache_.end() && it->second->num_elements == num_elements) {
+      lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+      return it->second->box;
+    }
+  }
+  // computed outside of the lock, two queries may compute the same box
+  const auto box = compute(geo_cd, physical_cd, chunk_key, chunk_metadata, data_mgr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(chunk_key);
+  if (it != cache_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+    it->second->num_elements = num_elements;
+    it->second->box = box;
+    return box;
+  }
+  lru_list_.push_front({chunk_key, num_elements, box});
+  cache_.emplace(chunk_key, lru_list_.begin());
+  if (cache_.size() > kMaxCachedFragments) {
+    cache_.erase(lru_list_.back().chunk_key);
+    lru_list_.pop_back();
+  }
+  return box;
+}
+
+std::optional<GeoBoundingBox> GeoFragmentBounds::compute(
+    const ColumnDescriptor* geo_cd,
+    const ColumnDescriptor* physical_cd,
+    const ChunkKey& chunk_key,
+    const ChunkMetadata& chunk_metadata,
+    Data_Namespace::DataMgr* data_mgr) {
+  const auto& geo_ti = geo_cd->columnType;
+  const auto& physical_ti = physical_cd->columnType;
+  CHECK(physical_ti.is_fixlen_array());
+  const size_t row_size = physical_ti.get_size();
+  auto chunk = Chunk_NS::Chunk::getChunk(physical_cd,
+                                         data_mgr,
+                                         chunk_key,
+                                         Data_Namespace::CPU_LEVEL,
+                                         0,
+                                         chunk_metadata.numBytes,
+                                         chunk_metadata.numElements);
+  const int8_t* data = chunk->getBuffer()->getMemoryPtr();
+  BoundingBoxBuilder builder;
+  if (geo_ti.get_type() == kPOINT) {
+    const bool is_compressed = geo_ti.get_compression() == kENCODING_GEOINT;
+    CHECK_EQ(row_size, 2 * (is_compressed ? sizeof(int32_t) : sizeof(double)));
+    for (size_t i = 0; i < chunk_metadata.numElements; ++i) {
+      const auto coords = data + i * row_size;
+      if (Geospatial::is_null_point(geo_ti, coords, row_size)) {
+        continue;
+      }
+      if (is_compressed) {
+        builder.add(Geospatial::decompress_longitude_coord_geoint32(
+                        read_unaligned<int32_t>(coords)),
+                    Geospatial::decompress_lattitude_coord_geoint32(
+                        read_unaligned<int32_t>(coords + sizeof(int32_t))));
+      } else {
+        builder.add(read_unaligned<double>(coords),
+                    read_unaligned<double>(coords + sizeof(double)));
+      }
+    }
+  } else {
+    // xmin, ymin, xmax, ymax of every geometry
+    CHECK_EQ(row_size, 4 * sizeof(double));
+    for (size_t i = 0; i < chunk_metadata.numElements; ++i) {
+      const auto bounds = data + i * row_size;
+      const auto xmin = read_unaligned<double>(bounds);
+      if (xmin == NULL_ARRAY_DOUBLE) {
+        continue;
+      }
+      const auto ymin = read_unaligned<double>(bounds + sizeof(double));
+      const auto xmax = read_unaligned<double>(bounds + 2 * sizeof(double));
+      const auto ymax = read_unaligned<double>(bounds + 3 * sizeof(double));
+      if (!std::isfinite(xmin) || !std::isfinite(ymin) || !std::isfinite(xmax) ||
+          !std::isfinite(ymax)) {
+        // a box which cannot be trusted, the fragment is never skipped
+        return GeoBoundingBox{std::numeric_limits<double>::lowest(),
+                              std::numeric_limits<double>::lowest(),
+                              std::numeric_limits<double>::max(),
+                              std::numeric_limits<double>::max()};
+      }
+      builder.add(xmin, ymin, xmax, ymax);
+    }
+  }
+  return builder.get();
+}
+
+std::mutex GeoFragmentBounds::mutex_;
+std::list<GeoFragmentBounds::CachedBounds> GeoFragmentBounds::lru_list_;
+std::map<ChunkKey, std::list<GeoFragmentBounds::CachedBounds>::iterator>
+    GeoFragmentBounds::cache_;
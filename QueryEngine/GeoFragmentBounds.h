@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    GeoFragmentBounds.h
+ * @brief   Bounding boxes of the geometries of a geo column in a fragment, used to skip
+ *          the fragments which cannot satisfy a spatial filter.
+ *
+ * The chunk metadata of the physical geo columns does not hold separate x and y ranges:
+ * the bounds column statistics merge all four bounding box coordinates, and the coords
+ * column statistics are over its compressed bytes. The box of a fragment is computed
+ * once from the bounds column, or from the coords column of points, and cached until
+ * the fragment changes. The cache holds the boxes of the most recently used fragments.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include "DataMgr/Chunk/Chunk.h"
+#include "Shared/sqltypes.h"
+
+struct GeoBoundingBox {
+  double xmin;
+  double ymin;
+  double xmax;
+  double ymax;
+
+  bool intersects(const GeoBoundingBox& other) const {
+    return xmin <= other.xmax && other.xmin <= xmax && ymin <= other.ymax &&
+           other.ymin <= ymax;
+  }
+};
+
+class GeoFragmentBounds {
+ public:
+  // Bounding box of the non-null geometries of a fragment, given the bounds column of a
+  // geometry with bounds or the coords column of a point. Returns nullopt when all the
+  // geometries are null.
+  static std::optional<GeoBoundingBox> get(const ColumnDescriptor* geo_cd,
+                                           const ColumnDescriptor* physical_cd,
+                                           const ChunkKey& chunk_key,
+                                           const ChunkMetadata& chunk_metadata,
+                                           Data_Namespace::DataMgr* data_mgr);
+
+  static auto getCacheInvalidator() -> std::function<void()> {
+    return []() -> void {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_.clear();
+      lru_list_.clear();
+    };
+  }
+
+  static size_t getCacheSize() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+  }
+
+  static constexpr size_t kMaxCachedFragments{65536};
+
+ private:
+  static std::optional<GeoBoundingBox> compute(const ColumnDescriptor* geo_cd,
+                                               const ColumnDescriptor* physical_cd,
+                                               const ChunkKey& chunk_key,
+                                               const ChunkMetadata& chunk_metadata,
+                                               Data_Namespace::DataMgr* data_mgr);
+
+  struct CachedBounds {
+    ChunkKey chunk_key;
+    size_t num_elements;
+    std::optional<GeoBoundingBox> box;
+  };
+
+  // Keyed by chunk key, the box holds for the element count it was computed at:
+  // appends to a fragment change its element count and replace the box, updates,
+  // deletes and table drops clear the cache. Past kMaxCachedFragments, the least
+  // recently used box is evicted.
+  static std::mutex mutex_;
+  static std::list<CachedBounds> lru_list_;  // most recently used first
+  static std::map<ChunkKey, std::list<CachedBounds>::iterator> cache_;
+};
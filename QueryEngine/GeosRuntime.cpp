@@ -18,8 +18,7 @@
 
 #ifndef __CUDACC__
 
-#include <cstdarg>
-#include <mutex>
+#include <cstring>
 
 #include "Geospatial/Compression.h"
 #include "Geospatial/Types.h"
@@ -34,59 +33,17 @@ using namespace Geospatial;
 
 using WKB = std::vector<uint8_t>;
 
-#define MAX_GEOS_MESSAGE_LEN 200
-
-static std::mutex geos_log_info_mutex;
-static std::mutex geos_log_error_mutex;
-
-// called by GEOS on notice
-static void geos_notice_handler(const char* fmt, ...) {
-  char buffer[MAX_GEOS_MESSAGE_LEN];
-  va_list args;
-  va_start(args, fmt);
-  vsnprintf(buffer, MAX_GEOS_MESSAGE_LEN, fmt, args);
-  va_end(args);
-  {
-    std::lock_guard<std::mutex> guard(geos_log_info_mutex);
-    LOG(INFO) << "GEOS Notice: " << std::string(buffer);
-  }
-}
-
-// called by GEOS on error
-static void geos_error_handler(const char* fmt, ...) {
-  va_list args;
-  char buffer[MAX_GEOS_MESSAGE_LEN];
-  va_start(args, fmt);
-  vsnprintf(buffer, MAX_GEOS_MESSAGE_LEN, fmt, args);
-  va_end(args);
-  {
-    std::lock_guard<std::mutex> guard(geos_log_error_mutex);
-    LOG(ERROR) << "GEOS Error: " << std::string(buffer);
-  }
-}
-
-GEOSContextHandle_t create_context() {
-#if GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR < 5
-  GEOSContextHandle_t context = initGEOS_r(geos_notice_handler, geos_error_handler);
-  CHECK(context);
-  return context;
-#else
-  GEOSContextHandle_t context = GEOS_init_r();
-  CHECK(context);
-  GEOSContext_setNoticeHandler_r(context, geos_notice_handler);
-  GEOSContext_setErrorHandler_r(context, geos_error_handler);
-  return context;
-#endif
-}
-
-void destroy_context(GEOSContextHandle_t context) {
-  CHECK(context);
-#if GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR < 5
-  finishGEOS_r(context);
-#else
-  GEOS_finish_r(context);
-#endif
-}
+// GEOS state of the kernel thread, kept by the server across rows and queries: the
+// GEOS context of the thread, and the geometry last converted from every argument in the
+// current kernel
+extern "C" GEOSContextHandle_t get_geos_thread_context();
+extern "C" GEOSGeometry* get_geos_cached_geometry(const int32_t arg_idx,
+                                                  const int8_t* key,
+                                                  const int64_t key_size);
+extern "C" void set_geos_cached_geometry(const int32_t arg_idx,
+                                         const int8_t* key,
+                                         const int64_t key_size,
+                                         GEOSGeometry* geometry);
 
 bool toWkb(WKB& wkb,
            int type,  // internal geometry type
@@ -163,6 +120,356 @@ bool toWkb(WKB& wkb,
   return false;
 }
 
+// Builds a GEOS coordinate sequence from interleaved x, y coords, closing the sequence
+// with the first point if requested. Ownership is passed to the caller.
+GEOSCoordSequence* create_coord_seq(GEOSContextHandle_t context,
+                                    const double* coords,
+                                    const size_t num_points,
+                                    const bool close) {
+  if (num_points == 0) {
+    return nullptr;
+  }
+  const auto seq_size = num_points + (close ? 1 : 0);
+  auto seq = GEOSCoordSeq_create_r(context, seq_size, 2);
+  if (!seq) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < seq_size; i++) {
+    const auto j = i % num_points;
+    if (!GEOSCoordSeq_setX_r(context, seq, i, coords[2 * j]) ||
+        !GEOSCoordSeq_setY_r(context, seq, i, coords[2 * j + 1])) {
+      GEOSCoordSeq_destroy_r(context, seq);
+      return nullptr;
+    }
+  }
+  return seq;
+}
+
+// Builds a GEOS polygon out of the given number of rings, stored as open rings.
+// Advances the coords and ring size pointers past the consumed rings.
+GEOSGeometry* create_polygon(GEOSContextHandle_t context,
+                             const double*& coords,
+                             const int32_t*& ring_sizes,
+                             const int32_t num_rings) {
+  if (num_rings <= 0) {
+    return nullptr;
+  }
+  std::vector<GEOSGeometry*> rings;
+  for (int32_t r = 0; r < num_rings; r++) {
+    const auto ring_size = *ring_sizes++;
+    auto seq = create_coord_seq(context, coords, ring_size, /*close=*/true);
+    coords += 2 * ring_size;
+    auto ring = seq ? GEOSGeom_createLinearRing_r(context, seq) : nullptr;
+    if (!ring) {
+      for (auto created_ring : rings) {
+        GEOSGeom_destroy_r(context, created_ring);
+      }
+      return nullptr;
+    }
+    rings.push_back(ring);
+  }
+  auto poly =
+      GEOSGeom_createPolygon_r(context, rings[0], rings.data() + 1, num_rings - 1);
+  if (!poly) {
+    // GEOS validates the rings before taking ownership of them
+    for (auto created_ring : rings) {
+      GEOSGeom_destroy_r(context, created_ring);
+    }
+  }
+  return poly;
+}
+
+// Conversion from internal representation straight to a GEOS geometry, skipping the
+// WKB round trip. Mirrors toWkb for geometries which don't need a planar transform.
+GEOSGeometry* toGeos(GEOSContextHandle_t context,
+                     int type,  // internal geometry type
+                     int8_t* coords,
+                     int64_t coords_size,
+                     int32_t* meta1,      // e.g. ring_sizes
+                     int64_t meta1_size,  // e.g. num_rings
+                     int32_t* meta2,      // e.g. rings (number of rings in each poly)
+                     int64_t meta2_size,  // e.g. num_polys
+                     int32_t ic) {
+  // decompressed double coords
+  auto cv = Geospatial::decompress_coords<double, int32_t>(ic, coords, coords_size);
+  const double* cv_data = cv->data();
+  const size_t num_points = cv->size() / 2;
+  if (static_cast<SQLTypes>(type) == kPOINT) {
+    if (num_points != 1) {
+      return nullptr;
+    }
+    auto seq = create_coord_seq(context, cv_data, num_points, /*close=*/false);
+    return seq ? GEOSGeom_createPoint_r(context, seq) : nullptr;
+  }
+  if (static_cast<SQLTypes>(type) == kLINESTRING) {
+    auto seq = create_coord_seq(context, cv_data, num_points, /*close=*/false);
+    return seq ? GEOSGeom_createLineString_r(context, seq) : nullptr;
+  }
+  const int32_t* ring_sizes = meta1;
+  if (static_cast<SQLTypes>(type) == kPOLYGON) {
+    return create_polygon(context, cv_data, ring_sizes, meta1_size);
+  }
+  if (static_cast<SQLTypes>(type) == kMULTIPOLYGON) {
+    // Recognize GEOMETRYCOLLECTION EMPTY encoding, see toWkb
+    if (meta1_size == 1 && meta2_size == 1) {
+      const std::vector<double> ecv = {0.0, 0.0, 0.00000012345, 0.0, 0.0, 0.00000012345};
+      if (*cv == ecv) {
+        return GEOSGeom_createEmptyCollection_r(context, GEOS_GEOMETRYCOLLECTION);
+      }
+    }
+    std::vector<GEOSGeometry*> polys;
+    for (int64_t p = 0; p < meta2_size; p++) {
+      auto poly = create_polygon(context, cv_data, ring_sizes, meta2[p]);
+      if (!poly) {
+        for (auto created_poly : polys) {
+          GEOSGeom_destroy_r(context, created_poly);
+        }
+        return nullptr;
+      }
+      polys.push_back(poly);
+    }
+    return GEOSGeom_createCollection_r(
+        context, GEOS_MULTIPOLYGON, polys.data(), polys.size());
+  }
+  return nullptr;
+}
+
+// Buffers and sizes a geometry argument gets converted from, compared as bytes.
+struct GeometryCacheKey {
+  const int8_t* coords;
+  int64_t coords_size;
+  const int32_t* meta1;
+  int64_t meta1_size;
+  const int32_t* meta2;
+  int64_t meta2_size;
+  int32_t type;
+  int32_t ic;
+};
+
+// GEOS geometry of the given runtime function argument. The geometry last converted
+// from every argument is cached by the thread, keyed by the buffers and sizes of the
+// argument, which makes a literal argument converted once per kernel rather than once
+// per row. The buffers of a kernel stay put while it runs and the thread drops the
+// cached geometries when it starts a kernel, except for points, cheap to convert, which
+// a row may generate in the same stack buffer as the previous row. The geometry is
+// owned by the thread, the caller must not destroy it.
+const GEOSGeometry* get_geometry(GEOSContextHandle_t context,
+                                 int32_t arg_idx,
+                                 int type,
+                                 int8_t* coords,
+                                 int64_t coords_size,
+                                 int32_t* meta1,
+                                 int64_t meta1_size,
+                                 int32_t* meta2,
+                                 int64_t meta2_size,
+                                 int32_t ic) {
+  GeometryCacheKey key{};
+  key.coords = coords;
+  key.coords_size = coords_size;
+  key.meta1 = meta1;
+  key.meta1_size = meta1_size;
+  key.meta2 = meta2;
+  key.meta2_size = meta2_size;
+  key.type = type;
+  key.ic = ic;
+  const auto key_bytes = reinterpret_cast<const int8_t*>(&key);
+  if (static_cast<SQLTypes>(type) != kPOINT) {
+    if (auto g = get_geos_cached_geometry(arg_idx, key_bytes, sizeof(key))) {
+      return g;
+    }
+  }
+  auto g = toGeos(
+      context, type, coords, coords_size, meta1, meta1_size, meta2, meta2_size, ic);
+  if (g) {
+    set_geos_cached_geometry(arg_idx, key_bytes, sizeof(key), g);
+  }
+  return g;
+}
+
+// Appends a ring as an open ring in the orientation OmniSci stores it in: CCW for
+// exterior rings and CW for interior ones. Returns the number of points added.
+int32_t append_ring(GEOSContextHandle_t context,
+                    const GEOSGeometry* ring,
+                    const bool exterior,
+                    std::vector<double>& coords) {
+  auto seq = GEOSGeom_getCoordSeq_r(context, ring);
+  unsigned int num_points = 0;
+  if (!seq || !GEOSCoordSeq_getSize_r(context, seq, &num_points)) {
+    return -1;
+  }
+  std::vector<double> ring_coords(2 * num_points);
+  for (unsigned int i = 0; i < num_points; i++) {
+    if (!GEOSCoordSeq_getX_r(context, seq, i, &ring_coords[2 * i]) ||
+        !GEOSCoordSeq_getY_r(context, seq, i, &ring_coords[2 * i + 1])) {
+      return -1;
+    }
+  }
+  // Store all rings as open rings
+  if (num_points > 0 && ring_coords[0] == ring_coords[2 * num_points - 2] &&
+      ring_coords[1] == ring_coords[2 * num_points - 1]) {
+    ring_coords.resize(2 * --num_points);
+  }
+  if (num_points < 3) {
+    return -1;
+  }
+  double signed_area = 0.0;
+  for (unsigned int i = 0; i < num_points; i++) {
+    const auto j = (i + 1) % num_points;
+    signed_area += ring_coords[2 * i] * ring_coords[2 * j + 1] -
+                   ring_coords[2 * j] * ring_coords[2 * i + 1];
+  }
+  const bool is_ccw = signed_area > 0.0;
+  if (is_ccw == exterior) {
+    coords.insert(coords.end(), ring_coords.begin(), ring_coords.end());
+  } else {
+    // Reverse the winding order, keeping the first point in place
+    coords.push_back(ring_coords[0]);
+    coords.push_back(ring_coords[1]);
+    for (unsigned int i = num_points - 1; i > 0; i--) {
+      coords.push_back(ring_coords[2 * i]);
+      coords.push_back(ring_coords[2 * i + 1]);
+    }
+  }
+  return static_cast<int32_t>(num_points);
+}
+
+bool append_polygon(GEOSContextHandle_t context,
+                    const GEOSGeometry* poly,
+                    std::vector<double>& coords,
+                    std::vector<int32_t>& ring_sizes,
+                    std::vector<int32_t>& poly_rings) {
+  const auto exterior_ring = GEOSGetExteriorRing_r(context, poly);
+  const auto num_interior_rings = GEOSGetNumInteriorRings_r(context, poly);
+  if (!exterior_ring || num_interior_rings < 0) {
+    return false;
+  }
+  auto ring_size = append_ring(context, exterior_ring, /*exterior=*/true, coords);
+  if (ring_size < 0) {
+    return false;
+  }
+  ring_sizes.push_back(ring_size);
+  for (int r = 0; r < num_interior_rings; r++) {
+    const auto interior_ring = GEOSGetInteriorRingN_r(context, poly, r);
+    ring_size = interior_ring
+                    ? append_ring(context, interior_ring, /*exterior=*/false, coords)
+                    : -1;
+    if (ring_size < 0) {
+      return false;
+    }
+    ring_sizes.push_back(ring_size);
+  }
+  poly_rings.push_back(num_interior_rings + 1);
+  return true;
+}
+
+// Copies result components into malloced buffers, caller is responsible for freeing.
+void export_result(const std::vector<double>& coords,
+                   const std::vector<int32_t>& ring_sizes,
+                   const std::vector<int32_t>& poly_rings,
+                   int* result_type,
+                   int8_t** result_coords,
+                   int64_t* result_coords_size,
+                   int32_t** result_meta1,
+                   int64_t* result_meta1_size,
+                   int32_t** result_meta2,
+                   int64_t* result_meta2_size) {
+  // TODO: consider using a single buffer to hold all components,
+  // instead of allocating and registering each component buffer separately
+
+  *result_type = static_cast<int>(kMULTIPOLYGON);
+
+  *result_coords = nullptr;
+  int64_t size = coords.size() * sizeof(double);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, coords.data(), size);
+    *result_coords = reinterpret_cast<int8_t*>(buf);
+  }
+  *result_coords_size = size;
+
+  *result_meta1 = nullptr;
+  size = ring_sizes.size() * sizeof(int32_t);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, ring_sizes.data(), size);
+    *result_meta1 = reinterpret_cast<int32_t*>(buf);
+  }
+  *result_meta1_size = ring_sizes.size();
+
+  *result_meta2 = nullptr;
+  size = poly_rings.size() * sizeof(int32_t);
+  if (size > 0) {
+    auto buf = checked_malloc(size);
+    std::memcpy(buf, poly_rings.data(), size);
+    *result_meta2 = reinterpret_cast<int32_t*>(buf);
+  }
+  *result_meta2_size = poly_rings.size();
+}
+
+// Conversion from a GEOS geometry straight to internal representation, skipping the
+// WKB round trip. Mirrors fromWkb for results which don't need a transform back.
+bool fromGeos(GEOSContextHandle_t context,
+              const GEOSGeometry* g,
+              int* result_type,
+              int8_t** result_coords,
+              int64_t* result_coords_size,
+              int32_t** result_meta1,
+              int64_t* result_meta1_size,
+              int32_t** result_meta2,
+              int64_t* result_meta2_size) {
+  std::vector<double> coords{};
+  std::vector<int32_t> ring_sizes{};
+  std::vector<int32_t> poly_rings{};
+
+  // Forcing MULTIPOLYGON result until we can handle any geo, see fromWkb
+  const auto is_empty = GEOSisEmpty_r(context, g);
+  const auto type = GEOSGeomTypeId_r(context, g);
+  if (is_empty == 1) {
+    coords = {0.0, 0.0, 0.00000012345, 0.0, 0.0, 0.00000012345};
+    ring_sizes.push_back(3);
+    poly_rings.push_back(1);
+  } else if (is_empty != 0) {
+    return false;
+  } else if (type == GEOS_POINT) {
+    double x, y;
+    auto seq = GEOSGeom_getCoordSeq_r(context, g);
+    if (!seq || !GEOSCoordSeq_getX_r(context, seq, 0, &x) ||
+        !GEOSCoordSeq_getY_r(context, seq, 0, &y)) {
+      return false;
+    }
+    // Generate a tiny polygon around the point, make it a multipolygon
+    coords = {x, y, x + 0.0000001, y, x, y + 0.0000001};
+    ring_sizes.push_back(3);
+    poly_rings.push_back(1);
+  } else if (type == GEOS_POLYGON) {
+    if (!append_polygon(context, g, coords, ring_sizes, poly_rings)) {
+      return false;
+    }
+  } else if (type == GEOS_MULTIPOLYGON) {
+    const auto num_polys = GEOSGetNumGeometries_r(context, g);
+    for (int p = 0; p < num_polys; p++) {
+      const auto poly = GEOSGetGeometryN_r(context, g, p);
+      if (!poly || !append_polygon(context, poly, coords, ring_sizes, poly_rings)) {
+        return false;
+      }
+    }
+  } else {
+    return false;
+  }
+
+  export_result(coords,
+                ring_sizes,
+                poly_rings,
+                result_type,
+                result_coords,
+                result_coords_size,
+                result_meta1,
+                result_meta1_size,
+                result_meta2,
+                result_meta2_size);
+  return true;
+}
+
 // Conversion form wkb to internal vector representation.
 // Each vector components is malloced, caller is reponsible for freeing.
 bool fromWkb(WKB& wkb,
@@ -216,38 +523,16 @@ bool fromWkb(WKB& wkb,
     return false;
   }
 
-  // TODO: consider using a single buffer to hold all components,
-  // instead of allocating and registering each component buffer separately
-
-  *result_type = static_cast<int>(kMULTIPOLYGON);
-
-  *result_coords = nullptr;
-  int64_t size = coords.size() * sizeof(double);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, coords.data(), size);
-    *result_coords = reinterpret_cast<int8_t*>(buf);
-  }
-  *result_coords_size = size;
-
-  *result_meta1 = nullptr;
-  size = ring_sizes.size() * sizeof(int32_t);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, ring_sizes.data(), size);
-    *result_meta1 = reinterpret_cast<int32_t*>(buf);
-  }
-  *result_meta1_size = ring_sizes.size();
-
-  *result_meta2 = nullptr;
-  size = poly_rings.size() * sizeof(int32_t);
-  if (size > 0) {
-    auto buf = checked_malloc(size);
-    std::memcpy(buf, poly_rings.data(), size);
-    *result_meta2 = reinterpret_cast<int32_t*>(buf);
-  }
-  *result_meta2_size = poly_rings.size();
-
+  export_result(coords,
+                ring_sizes,
+                poly_rings,
+                result_type,
+                result_coords,
+                result_coords_size,
+                result_meta1,
+                result_meta1_size,
+                result_meta2,
+                result_meta2_size);
   return true;
 }
 
@@ -304,40 +589,32 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_Wkb(
   // What if intersection is empty? Return null buffer pointers? Return false?
   // What if geos fails?
 
-  WKB wkb1{};
-  if (!toWkb(wkb1,
-             arg1_type,
-             arg1_coords,
-             arg1_coords_size,
-             arg1_meta1,
-             arg1_meta1_size,
-             arg1_meta2,
-             arg1_meta2_size,
-             arg1_ic,
-             nullptr)) {
-    return false;
-  }
-  WKB wkb2{};
-  if (!toWkb(wkb2,
-             arg2_type,
-             arg2_coords,
-             arg2_coords_size,
-             arg2_meta1,
-             arg2_meta1_size,
-             arg2_meta2,
-             arg2_meta2_size,
-             arg2_ic,
-             nullptr)) {
-    return false;
-  }
   auto status = false;
-  auto context = create_context();
+  auto context = get_geos_thread_context();
   if (!context) {
     return status;
   }
-  auto* g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+  auto* g1 = get_geometry(context,
+                          0,
+                          arg1_type,
+                          arg1_coords,
+                          arg1_coords_size,
+                          arg1_meta1,
+                          arg1_meta1_size,
+                          arg1_meta2,
+                          arg1_meta2_size,
+                          arg1_ic);
   if (g1) {
-    auto* g2 = GEOSGeomFromWKB_buf_r(context, wkb2.data(), wkb2.size());
+    auto* g2 = get_geometry(context,
+                            1,
+                            arg2_type,
+                            arg2_coords,
+                            arg2_coords_size,
+                            arg2_meta1,
+                            arg2_meta1_size,
+                            arg2_meta2,
+                            arg2_meta2_size,
+                            arg2_ic);
     if (g2) {
       GEOSGeometry* g = nullptr;
       if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kINTERSECTION) {
@@ -349,28 +626,19 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_Wkb(
       }
       g = postprocess(context, g);
       if (g) {
-        size_t wkb_size = 0ULL;
-        auto wkb_buf = GEOSGeomToWKB_buf_r(context, g, &wkb_size);
-        if (wkb_buf && wkb_size > 0ULL) {
-          WKB wkb(wkb_buf, wkb_buf + wkb_size);
-          free(wkb_buf);
-          status = fromWkb(wkb,
-                           result_type,
-                           result_coords,
-                           result_coords_size,
-                           result_meta1,
-                           result_meta1_size,
-                           result_meta2,
-                           result_meta2_size,
-                           nullptr);
-        }
+        status = fromGeos(context,
+                          g,
+                          result_type,
+                          result_coords,
+                          result_coords_size,
+                          result_meta1,
+                          result_meta1_size,
+                          result_meta2,
+                          result_meta2_size);
         GEOSGeom_destroy_r(context, g);
       }
-      GEOSGeom_destroy_r(context, g2);
     }
-    GEOSGeom_destroy_r(context, g1);
   }
-  destroy_context(context);
   return status;
 #else
   return false;
@@ -406,27 +674,42 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_double(
     // running geos operation, back-project the result to 4326
     best_planar_srid_ptr = &best_planar_srid;
   }
-  WKB wkb1{};
-  // Project to best planar srid before running certain geos ops
-  if (!toWkb(wkb1,
-             arg1_type,
-             arg1_coords,
-             arg1_coords_size,
-             arg1_meta1,
-             arg1_meta1_size,
-             arg1_meta2,
-             arg1_meta2_size,
-             arg1_ic,
-             best_planar_srid_ptr)) {
-    return false;
-  }
-
   auto status = false;
-  auto context = create_context();
+  auto context = get_geos_thread_context();
   if (!context) {
     return status;
   }
-  auto* g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+  // Owned by the thread unless reprojected
+  const GEOSGeometry* g1 = nullptr;
+  GEOSGeometry* projected_g1 = nullptr;
+  if (best_planar_srid_ptr) {
+    WKB wkb1{};
+    // Project to best planar srid before running certain geos ops
+    if (toWkb(wkb1,
+              arg1_type,
+              arg1_coords,
+              arg1_coords_size,
+              arg1_meta1,
+              arg1_meta1_size,
+              arg1_meta2,
+              arg1_meta2_size,
+              arg1_ic,
+              best_planar_srid_ptr)) {
+      projected_g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+      g1 = projected_g1;
+    }
+  } else {
+    g1 = get_geometry(context,
+                      0,
+                      arg1_type,
+                      arg1_coords,
+                      arg1_coords_size,
+                      arg1_meta1,
+                      arg1_meta1_size,
+                      arg1_meta2,
+                      arg1_meta2_size,
+                      arg1_ic);
+  }
   if (g1) {
     GEOSGeometry* g = nullptr;
     if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kBUFFER) {
@@ -435,27 +718,40 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb_double(
     }
     g = postprocess(context, g);
     if (g) {
-      size_t wkb_size = 0ULL;
-      auto wkb_buf = GEOSGeomToWKB_buf_r(context, g, &wkb_size);
-      if (wkb_buf && wkb_size > 0ULL) {
-        WKB wkb(wkb_buf, wkb_buf + wkb_size);
-        free(wkb_buf);
-        // Back-project the result from planar to 4326 if necessary
-        status = fromWkb(wkb,
-                         result_type,
-                         result_coords,
-                         result_coords_size,
-                         result_meta1,
-                         result_meta1_size,
-                         result_meta2,
-                         result_meta2_size,
-                         best_planar_srid_ptr);
+      if (best_planar_srid_ptr) {
+        size_t wkb_size = 0ULL;
+        auto wkb_buf = GEOSGeomToWKB_buf_r(context, g, &wkb_size);
+        if (wkb_buf && wkb_size > 0ULL) {
+          WKB wkb(wkb_buf, wkb_buf + wkb_size);
+          free(wkb_buf);
+          // Back-project the result from planar to 4326
+          status = fromWkb(wkb,
+                           result_type,
+                           result_coords,
+                           result_coords_size,
+                           result_meta1,
+                           result_meta1_size,
+                           result_meta2,
+                           result_meta2_size,
+                           best_planar_srid_ptr);
+        }
+      } else {
+        status = fromGeos(context,
+                          g,
+                          result_type,
+                          result_coords,
+                          result_coords_size,
+                          result_meta1,
+                          result_meta1_size,
+                          result_meta2,
+                          result_meta2_size);
       }
       GEOSGeom_destroy_r(context, g);
     }
-    GEOSGeom_destroy_r(context, g1);
   }
-  destroy_context(context);
+  if (projected_g1) {
+    GEOSGeom_destroy_r(context, projected_g1);
+  }
   return status;
 #else
   return false;
@@ -476,26 +772,25 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb(
     int32_t arg_srid,
     bool* result) {
 #ifndef __CUDACC__
-  WKB wkb1{};
-  if (!result || !toWkb(wkb1,
-                        arg_type,
-                        arg_coords,
-                        arg_coords_size,
-                        arg_meta1,
-                        arg_meta1_size,
-                        arg_meta2,
-                        arg_meta2_size,
-                        arg_ic,
-                        nullptr)) {
+  if (!result) {
     return false;
   }
 
   auto status = false;
-  auto context = create_context();
+  auto context = get_geos_thread_context();
   if (!context) {
     return status;
   }
-  auto* g1 = GEOSGeomFromWKB_buf_r(context, wkb1.data(), wkb1.size());
+  auto* g1 = get_geometry(context,
+                          0,
+                          arg_type,
+                          arg_coords,
+                          arg_coords_size,
+                          arg_meta1,
+                          arg_meta1_size,
+                          arg_meta2,
+                          arg_meta2_size,
+                          arg_ic);
   if (g1) {
     if (static_cast<GeoBase::GeoOp>(op) == GeoBase::GeoOp::kISEMPTY) {
       *result = GEOSisEmpty_r(context, g1);
@@ -504,9 +799,7 @@ extern "C" RUNTIME_EXPORT bool Geos_Wkb(
       *result = GEOSisValid_r(context, g1);
       status = true;
     }
-    GEOSGeom_destroy_r(context, g1);
   }
-  destroy_context(context);
   return status;
 #else
   return false;
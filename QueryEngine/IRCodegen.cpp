@@ -18,12 +18,14 @@
 #include "CodeGenerator.h"
 #include "Execute.h"
 #include "ExternalExecutor.h"
+#include "JoinHashTable/RangeJoinHashTable.h"
 #include "MaxwellCodegenPatch.h"
 #include "RelAlgTranslator.h"
 
 // Driver methods for the IR generation.
 
 extern bool g_enable_left_join_filter_hoisting;
+extern bool g_enable_range_join;
 
 std::vector<llvm::Value*> CodeGenerator::codegen(const Analyzer::Expr* expr,
                                                  const bool fetch_columns,
@@ -299,13 +301,19 @@ std::vector<JoinLoop> Executor::buildJoinLoops(
             current_level_join_conditions.type == JoinType::LEFT) {
           JoinCondition join_condition{{first_qual}, current_level_join_conditions.type};
 
-          return buildCurrentLevelHashTable(
-              join_condition, ra_exe_unit, co, query_infos, column_cache, fail_reasons);
+          return buildCurrentLevelHashTable(join_condition,
+                                            ra_exe_unit,
+                                            co,
+                                            eo,
+                                            query_infos,
+                                            column_cache,
+                                            fail_reasons);
         }
       }
       return buildCurrentLevelHashTable(current_level_join_conditions,
                                         ra_exe_unit,
                                         co,
+                                        eo,
                                         query_infos,
                                         column_cache,
                                         fail_reasons);
@@ -660,6 +668,7 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
     const JoinCondition& current_level_join_conditions,
     RelAlgExecutionUnit& ra_exe_unit,
     const CompilationOptions& co,
+    const ExecutionOptions& eo,
     const std::vector<InputTableInfo>& query_infos,
     ColumnCacheMap& column_cache,
     std::vector<std::string>& fail_reasons) {
@@ -702,6 +711,32 @@ std::shared_ptr<HashJoin> Executor::buildCurrentLevelHashTable(
       }
     }
   }
+  if (!current_level_hash_table && g_enable_range_join &&
+      current_level_join_conditions.type == JoinType::INNER) {
+    // All the quals have been added as filters, which the range join relies on since it
+    // can match more inner rows than the inequalities do. When the query may fall back
+    // to the loop join, the range join is only built if it is expected to be cheaper,
+    // from the inner row count and the span of the keys.
+    const auto memory_level = co.device_type == ExecutorDeviceType::GPU
+                                  ? MemoryLevel::GPU_LEVEL
+                                  : MemoryLevel::CPU_LEVEL;
+    try {
+      auto range_join_hash_table =
+          RangeJoinHashTable::getInstance(current_level_join_conditions.quals,
+                                          query_infos,
+                                          memory_level,
+                                          deviceCountForMemoryLevel(memory_level),
+                                          eo.allow_loop_joins,
+                                          column_cache,
+                                          this);
+      plan_state_->join_info_.join_hash_tables_.push_back(range_join_hash_table);
+      plan_state_->join_info_.equi_join_tautologies_.push_back(
+          range_join_hash_table->getRepresentativeQual());
+      current_level_hash_table = range_join_hash_table;
+    } catch (const HashJoinFail& e) {
+      fail_reasons.emplace_back(e.what());
+    }
+  }
   return current_level_hash_table;
 }
 
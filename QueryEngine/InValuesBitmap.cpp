@@ -26,22 +26,16 @@
 #include "Logger/Logger.h"
 #include "RuntimeFunctions.h"
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <algorithm>
 #include <limits>
 
-using checked_int64_t = boost::multiprecision::number<
-    boost::multiprecision::cpp_int_backend<64,
-                                           64,
-                                           boost::multiprecision::signed_magnitude,
-                                           boost::multiprecision::checked,
-                                           void>>;
-
 InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
                                const int64_t null_val,
                                const Data_Namespace::MemoryLevel memory_level,
                                const int device_count,
                                Data_Namespace::DataMgr* data_mgr)
-    : rhs_has_null_(false)
+    : hash_set_capacity_log2_(0)
+    , rhs_has_null_(false)
     , null_val_(null_val)
     , memory_level_(memory_level)
     , device_count_(device_count)
@@ -57,11 +51,13 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
   }
   min_val_ = std::numeric_limits<int64_t>::max();
   max_val_ = std::numeric_limits<int64_t>::min();
+  size_t non_null_count{0};
   for (const auto value : values) {
     if (value == null_val) {
       rhs_has_null_ = true;
       continue;
     }
+    ++non_null_count;
     if (value < min_val_) {
       min_val_ = value;
     }
@@ -75,40 +71,66 @@ InValuesBitmap::InValuesBitmap(const std::vector<int64_t>& values,
     CHECK(rhs_has_null_);
     return;
   }
-  const int64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000LL};
-  const auto bitmap_sz_bits =
-      static_cast<int64_t>(checked_int64_t(max_val_) - min_val_ + 1);
-  if (bitmap_sz_bits > MAX_BITMAP_BITS) {
-    throw FailedToCreateBitmap();
+  // Keep the hash set at most half full, which bounds the probe sequences.
+  int64_t capacity_log2{1};
+  while ((size_t(1) << capacity_log2) < 2 * non_null_count) {
+    ++capacity_log2;
   }
-  const auto bitmap_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
-  auto cpu_bitset = static_cast<int8_t*>(checked_calloc(bitmap_sz_bytes, 1));
-  for (const auto value : values) {
-    if (value == null_val) {
-      continue;
+  const size_t hash_set_sz_bytes = (size_t(1) << capacity_log2) * sizeof(int64_t);
+  const uint64_t MAX_BITMAP_BITS{8 * 1000 * 1000 * 1000ULL};
+  const auto bitmap_sz_bits =
+      static_cast<uint64_t>(max_val_) - static_cast<uint64_t>(min_val_) + 1;
+  const bool use_hash_set = bitmap_sz_bits == 0 || bitmap_sz_bits > MAX_BITMAP_BITS ||
+                            bitmap_bits_to_bytes(bitmap_sz_bits) > hash_set_sz_bytes;
+  int8_t* cpu_buffer{nullptr};
+  size_t buffer_sz_bytes{0};
+  if (use_hash_set) {
+    hash_set_capacity_log2_ = capacity_log2;
+    buffer_sz_bytes = hash_set_sz_bytes;
+    cpu_buffer = static_cast<int8_t*>(checked_malloc(buffer_sz_bytes));
+    auto slots = reinterpret_cast<int64_t*>(cpu_buffer);
+    std::fill(slots, slots + (size_t(1) << capacity_log2), null_val);
+    const uint64_t slot_mask = (uint64_t(1) << capacity_log2) - 1;
+    for (const auto value : values) {
+      if (value == null_val) {
+        continue;
+      }
+      auto slot = in_values_hash_slot(value, capacity_log2);
+      while (slots[slot] != null_val && slots[slot] != value) {
+        slot = (slot + 1) & slot_mask;
+      }
+      slots[slot] = value;
+    }
+  } else {
+    buffer_sz_bytes = bitmap_bits_to_bytes(bitmap_sz_bits);
+    cpu_buffer = static_cast<int8_t*>(checked_calloc(buffer_sz_bytes, 1));
+    for (const auto value : values) {
+      if (value == null_val) {
+        continue;
+      }
+      agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_buffer), value, min_val_);
     }
-    agg_count_distinct_bitmap(reinterpret_cast<int64_t*>(&cpu_bitset), value, min_val_);
   }
 #ifdef HAVE_CUDA
   if (memory_level_ == Data_Namespace::GPU_LEVEL) {
     for (int device_id = 0; device_id < device_count_; ++device_id) {
       gpu_buffers_.emplace_back(
-          CudaAllocator::allocGpuAbstractBuffer(data_mgr, bitmap_sz_bytes, device_id));
-      auto gpu_bitset = gpu_buffers_.back()->getMemoryPtr();
+          CudaAllocator::allocGpuAbstractBuffer(data_mgr, buffer_sz_bytes, device_id));
+      auto gpu_buffer = gpu_buffers_.back()->getMemoryPtr();
       copy_to_gpu(data_mgr,
-                  reinterpret_cast<CUdeviceptr>(gpu_bitset),
-                  cpu_bitset,
-                  bitmap_sz_bytes,
+                  reinterpret_cast<CUdeviceptr>(gpu_buffer),
+                  cpu_buffer,
+                  buffer_sz_bytes,
                   device_id);
-      bitsets_.push_back(gpu_bitset);
+      bitsets_.push_back(gpu_buffer);
     }
-    free(cpu_bitset);
+    free(cpu_buffer);
   } else {
-    bitsets_.push_back(cpu_bitset);
+    bitsets_.push_back(cpu_buffer);
   }
 #else
   CHECK_EQ(1, device_count_);
-  bitsets_.push_back(cpu_bitset);
+  bitsets_.push_back(cpu_buffer);
 #endif  // HAVE_CUDA
 }
 
@@ -143,27 +165,51 @@ llvm::Value* InValuesBitmap::codegen(llvm::Value* needle, Executor* executor) co
   const auto needle_i64 = executor->cgen_state_->castToTypeIn(needle, 64);
   const auto null_bool_val =
       static_cast<int8_t>(inline_int_null_val(SQLTypeInfo(kBOOLEAN, false)));
+  llvm::Value* found{nullptr};
   if (bitsets_.empty()) {
-    return executor->cgen_state_->emitCall("bit_is_set",
-                                           {executor->cgen_state_->llInt(int64_t(0)),
-                                            needle_i64,
-                                            executor->cgen_state_->llInt(int64_t(0)),
-                                            executor->cgen_state_->llInt(int64_t(0)),
-                                            executor->cgen_state_->llInt(null_val_),
-                                            executor->cgen_state_->llInt(null_bool_val)});
+    found = executor->cgen_state_->emitCall(
+        "bit_is_set",
+        {executor->cgen_state_->llInt(int64_t(0)),
+         needle_i64,
+         executor->cgen_state_->llInt(int64_t(0)),
+         executor->cgen_state_->llInt(int64_t(0)),
+         executor->cgen_state_->llInt(null_val_),
+         executor->cgen_state_->llInt(null_bool_val)});
+  } else {
+    CodeGenerator code_generator(executor);
+    const auto bitset_handle_lvs =
+        code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
+    CHECK_EQ(size_t(1), bitset_handle_lvs.size());
+    const auto bitset_handle_lv =
+        executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64);
+    if (hash_set_capacity_log2_) {
+      found = executor->cgen_state_->emitCall(
+          "value_in_hash_set",
+          {bitset_handle_lv,
+           needle_i64,
+           executor->cgen_state_->llInt(hash_set_capacity_log2_),
+           executor->cgen_state_->llInt(null_val_),
+           executor->cgen_state_->llInt(null_bool_val)});
+    } else {
+      found = executor->cgen_state_->emitCall(
+          "bit_is_set",
+          {bitset_handle_lv,
+           needle_i64,
+           executor->cgen_state_->llInt(min_val_),
+           executor->cgen_state_->llInt(max_val_),
+           executor->cgen_state_->llInt(null_val_),
+           executor->cgen_state_->llInt(null_bool_val)});
+    }
+  }
+  if (!rhs_has_null_) {
+    return found;
   }
-  CodeGenerator code_generator(executor);
-  const auto bitset_handle_lvs =
-      code_generator.codegenHoistedConstants(constants, kENCODING_NONE, 0);
-  CHECK_EQ(size_t(1), bitset_handle_lvs.size());
-  return executor->cgen_state_->emitCall(
-      "bit_is_set",
-      {executor->cgen_state_->castToTypeIn(bitset_handle_lvs.front(), 64),
-       needle_i64,
-       executor->cgen_state_->llInt(min_val_),
-       executor->cgen_state_->llInt(max_val_),
-       executor->cgen_state_->llInt(null_val_),
-       executor->cgen_state_->llInt(null_bool_val)});
+  // A value not found in a right hand side containing NULL compares as NULL.
+  auto& ir_builder = executor->cgen_state_->ir_builder_;
+  return ir_builder.CreateSelect(
+      ir_builder.CreateICmpEQ(found, executor->cgen_state_->llInt(int8_t(0))),
+      executor->cgen_state_->llInt(null_bool_val),
+      found);
 }
 
 bool InValuesBitmap::isEmpty() const {
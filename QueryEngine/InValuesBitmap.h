@@ -29,16 +29,14 @@
 #include <llvm/IR/Value.h>
 
 #include <cstdint>
-#include <stdexcept>
 #include <vector>
 
 class Executor;
 
-class FailedToCreateBitmap : public std::runtime_error {
- public:
-  FailedToCreateBitmap() : std::runtime_error("FailedToCreateBitmap") {}
-};
-
+// Membership test for the right hand side of IN. Values dense over their range are
+// stored as a bitmap, sparse ones as an open addressing hash set probed through
+// value_in_hash_set(). Following SQL, a value which isn't found tests NULL rather than
+// false when the right hand side contains NULL, which NOT IN depends on.
 class InValuesBitmap {
  public:
   InValuesBitmap(const std::vector<int64_t>& values,
@@ -58,7 +56,8 @@ class InValuesBitmap {
 
  private:
   std::vector<Data_Namespace::AbstractBuffer*> gpu_buffers_;
-  std::vector<int8_t*> bitsets_;
+  std::vector<int8_t*> bitsets_;  // the bitmap or the hash set slots, per device
+  int64_t hash_set_capacity_log2_;  // zero when stored as a bitmap
   bool rhs_has_null_;
   int64_t min_val_;
   int64_t max_val_;
@@ -864,6 +864,7 @@ std::shared_ptr<HashTable> BaselineJoinHashTable::initHashTableOnCpuFromCache(
   VLOG(1) << "Checking CPU hash table cache.";
   CHECK(hash_table_cache_);
   auto hash_table_opt = (hash_table_cache_->get(key));
+  record_hash_table_cache_lookup(hash_table_opt.has_value());
   return hash_table_opt ? *hash_table_opt : nullptr;
 }
 
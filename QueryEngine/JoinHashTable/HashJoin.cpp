@@ -30,7 +30,8 @@ extern bool g_enable_overlaps_hashjoin;
 
 void ColumnsForDevice::setBucketInfo(
     const std::vector<double>& inverse_bucket_sizes_for_dimension,
-    const std::vector<InnerOuter> inner_outer_pairs) {
+    const std::vector<InnerOuter> inner_outer_pairs,
+    const OverlapsRangeInfo& range_info) {
   join_buckets.clear();
 
   CHECK_EQ(inner_outer_pairs.size(), join_columns.size());
@@ -40,6 +41,13 @@ void ColumnsForDevice::setBucketInfo(
     const auto inner_col = inner_outer_pair.first;
     const auto& ti = inner_col->get_type_info();
     const auto elem_ti = ti.get_elem_type();
+    if (range_info.is_range_join) {
+      // raw point coords, decoded by the key handler
+      CHECK(elem_ti.get_type() == kTINYINT);
+      join_buckets.emplace_back(JoinBucketInfo{
+          inverse_bucket_sizes_for_dimension, !range_info.is_compressed, range_info});
+      continue;
+    }
     CHECK(elem_ti.is_fp());
 
     join_buckets.emplace_back(JoinBucketInfo{inverse_bucket_sizes_for_dimension,
@@ -572,6 +580,16 @@ InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
                                  const Catalog_Namespace::Catalog& cat,
                                  const TemporaryTables* temporary_tables,
                                  const bool is_overlaps_join) {
+  // For range joins the inner point coords are wrapped with the join distance.
+  const Analyzer::Expr* range_operand{nullptr};
+  if (is_overlaps_join) {
+    if (const auto range_oper = dynamic_cast<const Analyzer::RangeOper*>(lhs)) {
+      lhs = range_operand = range_oper->get_operand();
+    } else if (const auto range_oper = dynamic_cast<const Analyzer::RangeOper*>(rhs)) {
+      rhs = range_operand = range_oper->get_operand();
+    }
+  }
+  const bool is_range_join = range_operand != nullptr;
   const auto& lhs_ti = lhs->get_type_info();
   const auto& rhs_ti = rhs->get_type_info();
   if (!is_overlaps_join) {
@@ -658,7 +676,18 @@ InnerOuter normalize_column_pair(const Analyzer::Expr* lhs,
       (lhs_cast || rhs_cast)) {
     throw HashJoinFail("Cannot use hash join for given expression");
   }
-  if (is_overlaps_join) {
+  if (is_range_join) {
+    if (inner_col != range_operand) {
+      throw HashJoinFail("Range join distance must apply to the inner column");
+    }
+    if (!(inner_col_real_ti.is_fixlen_array() &&
+          inner_col_real_ti.get_elem_type().get_type() == kTINYINT)) {
+      throw HashJoinFail("Range join only supported for inner point coords columns");
+    }
+    if (outer_col_ti.get_type() != kPOINT) {
+      throw HashJoinFail("Range join only supported for outer columns of type point");
+    }
+  } else if (is_overlaps_join) {
     if (!inner_col_real_ti.is_array()) {
       throw HashJoinFail(
           "Overlaps join only supported for inner columns with array type");
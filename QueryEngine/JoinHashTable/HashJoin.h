@@ -18,6 +18,7 @@
 
 #include <llvm/IR/Value.h>
 #include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -83,7 +84,8 @@ struct ColumnsForDevice {
   const std::vector<std::shared_ptr<void>> malloc_owner;
 
   void setBucketInfo(const std::vector<double>& bucket_sizes_for_dimension,
-                     const std::vector<InnerOuter> inner_outer_pairs);
+                     const std::vector<InnerOuter> inner_outer_pairs,
+                     const OverlapsRangeInfo& range_info = {});
 };
 
 struct HashJoinMatchingSet {
@@ -98,6 +100,14 @@ struct CompositeKeyInfo {
   std::vector<ChunkKey> cache_key_chunks;  // used for the cache key
 };
 
+//! Range of the keys of the inner rows of a join on a single column, comparable with the
+//! chunk metadata of the outer column.
+struct JoinKeyRange {
+  const Analyzer::ColumnVar* outer_col;
+  int64_t min;
+  int64_t max;
+};
+
 class DeviceAllocator;
 
 class HashJoin {
@@ -158,6 +168,9 @@ class HashJoin {
 
   virtual std::string getHashJoinType() const = 0;
 
+  //! Used to skip the outer fragments which can't have any match, unavailable by default.
+  virtual std::optional<JoinKeyRange> getKeyRange() const { return std::nullopt; }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
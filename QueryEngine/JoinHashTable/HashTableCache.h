@@ -21,6 +21,19 @@
 #include <vector>
 
 #include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+
+// Counts a lookup of a join hash table about to be built, probes made for other reasons
+// (e.g. tuple count estimates) are not counted.
+inline void record_hash_table_cache_lookup(const bool hit) {
+  static auto& hits = metrics::Registry::instance().counter(
+      "omnisci_hash_table_cache_hits_total",
+      "Join hash table cache lookups which found a hash table.");
+  static auto& misses = metrics::Registry::instance().counter(
+      "omnisci_hash_table_cache_misses_total",
+      "Join hash table cache lookups which required building a hash table.");
+  (hit ? hits : misses).increment();
+}
 
 template <class K, class V>
 class HashTableCache {
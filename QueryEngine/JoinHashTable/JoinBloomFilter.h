@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    JoinBloomFilter.h
+ * @brief   Bloom filter of the keys of a join hash table.
+ *
+ * A perfect hash table over a sparse key range is mostly empty slots, and probing it
+ * with the outer keys which have no match misses the cache on every row. The filter is
+ * a fraction of the size of the table and stays in cache: the outer keys it rejects
+ * never touch the table.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "QueryEngine/JoinHashTable/Runtime/JoinBloomFilterInl.h"
+
+class JoinBloomFilter {
+ public:
+  // Bits per key, for a false positive rate under 0.5% with three hashes.
+  static constexpr size_t kBitsPerKey{16};
+  // The filter is only worth probing when it is that many times smaller than the table.
+  static constexpr size_t kMinTableSizeRatio{8};
+  // Tables smaller than that are cache resident anyway.
+  static constexpr size_t kMinTableBytes{1 << 20};
+
+  explicit JoinBloomFilter(const size_t key_count) {
+    size_t bit_count = 512;
+    while (bit_count < key_count * kBitsPerKey) {
+      bit_count *= 2;
+    }
+    words_.resize(bit_count / 64);
+    bit_mask_ = bit_count - 1;
+  }
+
+  void add(const int64_t key) {
+    join_bloom_filter_add_impl(words_.data(), bit_mask_, key);
+  }
+
+  bool mayContain(const int64_t key) const {
+    return join_bloom_filter_may_contain_impl(words_.data(), bit_mask_, key);
+  }
+
+  const uint64_t* getWords() const { return words_.data(); }
+
+  uint64_t getBitMask() const { return bit_mask_; }
+
+  size_t getSizeInBytes() const { return words_.size() * sizeof(uint64_t); }
+
+ private:
+  std::vector<uint64_t> words_;
+  uint64_t bit_mask_;
+};
@@ -507,8 +507,51 @@ std::ostream& operator<<(std::ostream& os, const BucketSizeTuner& tuner) {
   return os;
 }
 
+// Sizes the buckets to the extent of the boxes the inner points are expanded to, which
+// puts a planar box in two buckets per dimension. Geodesic buckets follow the latitude
+// extent, so boxes span more longitude buckets away from the equator and every one of
+// them around the poles.
+double get_range_bucket_size(const OverlapsRangeInfo& range_info) {
+  CHECK(range_info.is_range_join);
+  constexpr double kMinBucketSize{1e-7};
+  double extent = 2 * range_info.distance;
+  if (range_info.is_geodesic) {
+    // degrees of latitude, boxes are wider in longitude away from the equator
+    constexpr double kEarthRadiusMeters{6371000.0};
+    constexpr double kRadiansToDegrees{57.29577951308232};
+    extent = extent / kEarthRadiusMeters * kRadiansToDegrees;
+  }
+  return std::max(extent, kMinBucketSize);
+}
+
 }  // namespace
 
+OverlapsRangeInfo OverlapsJoinHashTable::getRangeInfo(
+    const Analyzer::BinOper* condition,
+    const std::vector<InnerOuter>& inner_outer_pairs) {
+  CHECK(condition);
+  auto range_oper =
+      dynamic_cast<const Analyzer::RangeOper*>(condition->get_right_operand());
+  if (!range_oper) {
+    range_oper = dynamic_cast<const Analyzer::RangeOper*>(condition->get_left_operand());
+  }
+  if (!range_oper) {
+    return {};
+  }
+  CHECK_EQ(inner_outer_pairs.size(), size_t(1));
+  const auto distance =
+      dynamic_cast<const Analyzer::Constant*>(range_oper->get_distance());
+  CHECK(distance && distance->get_type_info().get_type() == kDOUBLE);
+  CHECK(!distance->get_is_null());
+  const auto& inner_ti = inner_outer_pairs.front().first->get_type_info();
+  OverlapsRangeInfo range_info;
+  range_info.is_range_join = true;
+  range_info.is_compressed = inner_ti.get_size() == 2 * sizeof(int32_t);
+  range_info.is_geodesic = range_oper->is_geodesic();
+  range_info.distance = distance->get_constval().doubleval;
+  return range_info;
+}
+
 void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
   auto timer = DEBUG_TIMER(__func__);
   CHECK(layoutRequiresAdditionalBuffers(layout));
@@ -608,7 +651,37 @@ void OverlapsJoinHashTable::reifyWithLayout(const HashType layout) {
     return false;
   };
 
-  if (overlaps_threshold_override) {
+  if (range_info_.is_range_join) {
+    // the bucket size follows from the join distance, no need to tune. The distance
+    // doubles as the bucket threshold so tables for different distances are cached
+    // separately.
+    if (overlaps_threshold_override) {
+      VLOG(1) << "Ignoring overlaps bucket threshold hint for range join";
+    }
+    const std::vector<double> inverse_bucket_sizes(
+        /*count=*/2, /*value=*/1.0 / get_range_bucket_size(range_info_));
+    auto [entry_count, emitted_keys_count] =
+        computeHashTableCounts(shard_count,
+                               inverse_bucket_sizes,
+                               columns_per_device,
+                               overlaps_max_table_size_bytes,
+                               range_info_.distance);
+    setInverseBucketSizeInfo(inverse_bucket_sizes, columns_per_device, device_count_);
+    const size_t hash_table_size = calculateHashTableSize(
+        inverse_bucket_sizes.size(), emitted_keys_count, entry_count);
+    if (hash_table_size > overlaps_max_table_size_bytes) {
+      throw OverlapsHashTableTooBig(overlaps_max_table_size_bytes);
+    }
+    reifyImpl(columns_per_device,
+              query_info,
+              layout,
+              shard_count,
+              entry_count,
+              emitted_keys_count,
+              skip_hashtable_caching,
+              overlaps_max_table_size_bytes,
+              range_info_.distance);
+  } else if (overlaps_threshold_override) {
     // compute bucket sizes based on the user provided threshold
     BucketSizeTuner tuner(/*initial_threshold=*/*overlaps_threshold_override,
                           /*step=*/1.0,
@@ -899,8 +972,8 @@ std::pair<size_t, size_t> OverlapsJoinHashTable::approximateTupleCount(
   // re-compute bucket counts per device based on global bucket size
   for (size_t device_id = 0; device_id < columns_per_device.size(); ++device_id) {
     auto& columns_for_device = columns_per_device[device_id];
-    columns_for_device.setBucketInfo(inverse_bucket_sizes_for_dimension,
-                                     inner_outer_pairs_);
+    columns_for_device.setBucketInfo(
+        inverse_bucket_sizes_for_dimension, inner_outer_pairs_, range_info_);
   }
 
   // Number of keys must match dimension of buckets
@@ -993,7 +1066,8 @@ std::pair<size_t, size_t> OverlapsJoinHashTable::approximateTupleCount(
           const auto key_handler =
               OverlapsKeyHandler(inverse_bucket_sizes_for_dimension.size(),
                                  join_columns_gpu,
-                                 reinterpret_cast<double*>(inverse_bucket_sizes_gpu));
+                                 reinterpret_cast<double*>(inverse_bucket_sizes_gpu),
+                                 columns_for_device.join_buckets[0].range_info);
           const auto key_handler_gpu =
               transfer_flat_object_to_gpu(key_handler, allocator);
           approximate_distinct_tuples_on_device_overlaps(
@@ -1056,8 +1130,8 @@ void OverlapsJoinHashTable::setInverseBucketSizeInfo(
   CHECK_EQ(columns_per_device.size(), size_t(device_count));
   for (size_t device_id = 0; device_id < device_count; ++device_id) {
     auto& columns_for_device = columns_per_device[device_id];
-    columns_for_device.setBucketInfo(inverse_bucket_sizes_for_dimension_,
-                                     inner_outer_pairs_);
+    columns_for_device.setBucketInfo(
+        inverse_bucket_sizes_for_dimension_, inner_outer_pairs_, range_info_);
   }
 }
 
@@ -1235,7 +1309,8 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnCpu(
   const auto key_handler =
       OverlapsKeyHandler(key_component_count,
                          &join_columns[0],
-                         join_bucket_info[0].inverse_bucket_sizes_for_dimension.data());
+                         join_bucket_info[0].inverse_bucket_sizes_for_dimension.data(),
+                         join_bucket_info[0].range_info);
   const auto catalog = executor_->getCatalog();
   BaselineJoinHashTableBuilder builder(catalog);
   const auto err = builder.initHashTableOnCpu(&key_handler,
@@ -1293,7 +1368,8 @@ std::shared_ptr<BaselineHashTable> OverlapsJoinHashTable::initHashTableOnGpu(
       inverse_bucket_sizes_for_dimension, allocator);
   const auto key_handler = OverlapsKeyHandler(inverse_bucket_sizes_for_dimension.size(),
                                               join_columns_gpu,
-                                              inverse_bucket_sizes_gpu);
+                                              inverse_bucket_sizes_gpu,
+                                              join_bucket_info[0].range_info);
 
   const auto err = builder.initHashTableOnGpu(&key_handler,
                                               join_columns,
@@ -1711,6 +1787,7 @@ std::shared_ptr<HashTable> OverlapsJoinHashTable::initHashTableOnCpuFromCache(
   VLOG(1) << "Checking CPU hash table cache.";
   CHECK(hash_table_cache_);
   auto hash_table_opt = hash_table_cache_->getWithKey(key);
+  record_hash_table_cache_lookup(hash_table_opt.has_value());
   if (hash_table_opt) {
     CHECK(inverse_bucket_sizes_for_dimension_ ==
           hash_table_opt->first.inverse_bucket_sizes);
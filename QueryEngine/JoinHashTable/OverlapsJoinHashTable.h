@@ -99,7 +99,8 @@ class OverlapsJoinHashTable : public HashJoin {
       , executor_(executor)
       , column_cache_(column_cache)
       , inner_outer_pairs_(inner_outer_pairs)
-      , device_count_(device_count) {
+      , device_count_(device_count)
+      , range_info_(getRangeInfo(condition_.get(), inner_outer_pairs_)) {
     CHECK_GT(device_count_, 0);
     hash_tables_for_device_.resize(std::max(device_count_, 1));
     query_hint_ = RegisteredQueryHint::defaults();
@@ -137,6 +138,11 @@ class OverlapsJoinHashTable : public HashJoin {
   }
 
  protected:
+  //! Range info for distance joins, i.e. when the inner operand of the overlaps qual is
+  //! a RangeOper over point coords.
+  static OverlapsRangeInfo getRangeInfo(const Analyzer::BinOper* condition,
+                                        const std::vector<InnerOuter>& inner_outer_pairs);
+
   void reify(const HashType preferred_layout);
 
   void reifyWithLayout(const HashType layout);
@@ -350,6 +356,8 @@ class OverlapsJoinHashTable : public HashJoin {
   std::vector<InnerOuter> inner_outer_pairs_;
   const int device_count_;
 
+  const OverlapsRangeInfo range_info_;
+
   std::vector<double> inverse_bucket_sizes_for_dimension_;
 
   std::optional<HashType>
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "QueryEngine/JoinHashTable/HashTable.h"
+#include "QueryEngine/JoinHashTable/JoinBloomFilter.h"
 
 class PerfectHashTable : public HashTable {
  public:
@@ -85,10 +86,18 @@ class PerfectHashTable : public HashTable {
 
   size_t getEmittedKeysCount() const override { return emitted_keys_count_; }
 
+  // Filter of the keys of the table, only set on the CPU tables worth filtering.
+  void setBloomFilter(std::unique_ptr<JoinBloomFilter> bloom_filter) {
+    bloom_filter_ = std::move(bloom_filter);
+  }
+
+  const JoinBloomFilter* getBloomFilter() const { return bloom_filter_.get(); }
+
  private:
   Data_Namespace::AbstractBuffer* gpu_hash_table_buff_{nullptr};
   const Catalog_Namespace::Catalog* catalog_;
   std::vector<int32_t> cpu_hash_table_buff_;
+  std::unique_ptr<JoinBloomFilter> bloom_filter_;
 
   HashType layout_;
   size_t entry_count_;         // number of keys in the hash table
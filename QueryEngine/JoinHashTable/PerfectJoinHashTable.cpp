@@ -30,6 +30,8 @@
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
+extern bool g_enable_runtime_join_filters;
+
 std::unique_ptr<HashTableCache<PerfectJoinHashTable::JoinHashTableCacheKey,
                                PerfectJoinHashTable::HashTableCacheValue>>
     PerfectJoinHashTable::hash_table_cache_ =
@@ -530,6 +532,7 @@ int PerfectJoinHashTable::initHashTableForDevice(
                                               executor_);
           hash_table = builder.getHashTable();
         }
+        buildBloomFilter(hash_table.get(), inner_col, hash_join_invalid_val);
       } else {
         if (layout == HashType::OneToOne &&
             hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU) >
@@ -656,6 +659,7 @@ std::shared_ptr<PerfectHashTable> PerfectJoinHashTable::initHashTableOnCpuFromCa
                                   chunk_key,
                                   qual_bin_oper_->get_optype()};
   auto hash_table_opt = (hash_table_cache_->get(cache_key));
+  record_hash_table_cache_lookup(hash_table_opt.has_value());
   return hash_table_opt ? *hash_table_opt : nullptr;
 }
 
@@ -741,6 +745,27 @@ std::vector<llvm::Value*> PerfectJoinHashTable::getHashJoinArgs(
         executor_->cgen_state_->llInt(hash_entry_info.bucket_normalization));
   }
 
+  const auto bloom_filter =
+      g_enable_runtime_join_filters && co.device_type == ExecutorDeviceType::CPU
+          ? getBloomFilter()
+          : nullptr;
+  if (bloom_filter) {
+    // The keys rejected by the filter are moved below the range of the table, the probe
+    // then returns no match without loading a slot.
+    auto& key_lv = hash_join_idx_args[1];
+    const auto may_contain_lv = executor_->cgen_state_->emitCall(
+        "join_bloom_filter_may_contain",
+        {executor_->cgen_state_->llInt(
+             reinterpret_cast<int64_t>(bloom_filter->getWords())),
+         executor_->cgen_state_->llInt(static_cast<int64_t>(bloom_filter->getBitMask())),
+         key_lv});
+    key_lv = executor_->cgen_state_->ir_builder_.CreateSelect(
+        executor_->cgen_state_->ir_builder_.CreateICmpNE(
+            may_contain_lv, executor_->cgen_state_->llInt(int8_t(0))),
+        key_lv,
+        executor_->cgen_state_->llInt(col_range_.getIntMin() - 1));
+  }
+
   return hash_join_idx_args;
 }
 
@@ -980,3 +1005,84 @@ size_t PerfectJoinHashTable::shardCount() const {
 bool PerfectJoinHashTable::isBitwiseEq() const {
   return qual_bin_oper_->get_optype() == kBW_EQ;
 }
+
+void PerfectJoinHashTable::buildBloomFilter(PerfectHashTable* hash_table,
+                                            const Analyzer::ColumnVar* inner_col,
+                                            const int32_t invalid_slot_val) const {
+  CHECK(hash_table);
+  const auto& ti = inner_col->get_type_info();
+  // The slot of a key must be its offset from the minimum, which rules out bucketized,
+  // sharded and dictionary encoded keys. The keys rejected go below the minimum.
+  if (!g_enable_runtime_join_filters || isBitwiseEq() || shardCount() ||
+      !(ti.is_integer() || ti.is_decimal() || ti.is_time()) || ti.get_type() == kDATE ||
+      col_range_.getIntMin() == std::numeric_limits<int64_t>::min()) {
+    return;
+  }
+  const auto entry_count = hash_table->getEntryCount();
+  const auto table_bytes = entry_count * sizeof(int32_t);
+  if (table_bytes < JoinBloomFilter::kMinTableBytes) {
+    return;
+  }
+  const auto slots = reinterpret_cast<const int32_t*>(hash_table->getCpuBuffer());
+  const bool is_one_to_many = hash_table->getLayout() == HashType::OneToMany;
+  // the row counts of a one to many table follow the offsets
+  auto has_key = [&](const size_t slot) {
+    return is_one_to_many ? slots[entry_count + slot] > 0
+                          : slots[slot] != invalid_slot_val;
+  };
+  size_t key_count{0};
+  for (size_t slot = 0; slot < entry_count; ++slot) {
+    key_count += has_key(slot);
+  }
+  auto bloom_filter = std::make_unique<JoinBloomFilter>(key_count);
+  if (bloom_filter->getSizeInBytes() * JoinBloomFilter::kMinTableSizeRatio >
+      table_bytes) {
+    return;
+  }
+  const auto min_key = col_range_.getIntMin();
+  for (size_t slot = 0; slot < entry_count; ++slot) {
+    if (has_key(slot)) {
+      bloom_filter->add(min_key + static_cast<int64_t>(slot));
+    }
+  }
+  VLOG(1) << "Built a " << bloom_filter->getSizeInBytes() << " bytes Bloom filter of "
+          << key_count << " keys for the " << table_bytes
+          << " bytes perfect hash table of " << inner_col->toString();
+  hash_table->setBloomFilter(std::move(bloom_filter));
+}
+
+const JoinBloomFilter* PerfectJoinHashTable::getBloomFilter() const {
+  if (hash_tables_for_device_.empty()) {
+    return nullptr;
+  }
+  const auto hash_table =
+      std::dynamic_pointer_cast<PerfectHashTable>(hash_tables_for_device_.front());
+  return hash_table ? hash_table->getBloomFilter() : nullptr;
+}
+
+std::optional<JoinKeyRange> PerfectJoinHashTable::getKeyRange() const {
+  if (isBitwiseEq() || inner_outer_pairs_.empty()) {
+    // null keys match each other
+    return std::nullopt;
+  }
+  const auto inner_col = inner_outer_pairs_.front().first;
+  const auto outer_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(inner_outer_pairs_.front().second);
+  if (!outer_col) {
+    return std::nullopt;
+  }
+  // The range is only comparable with the metadata of an outer column holding the same
+  // values, unlike dictionary ids of another dictionary or dates in days.
+  const auto& inner_ti = inner_col->get_type_info();
+  const auto& outer_ti = outer_col->get_type_info();
+  const bool same_values =
+      (inner_ti.is_integer() && outer_ti.is_integer()) ||
+      ((inner_ti.is_decimal() || inner_ti.is_time()) && inner_ti.get_type() != kDATE &&
+       inner_ti.get_type() == outer_ti.get_type() &&
+       inner_ti.get_scale() == outer_ti.get_scale() &&
+       inner_ti.get_dimension() == outer_ti.get_dimension());
+  if (!same_values) {
+    return std::nullopt;
+  }
+  return JoinKeyRange{outer_col, col_range_.getIntMin(), col_range_.getIntMax()};
+}
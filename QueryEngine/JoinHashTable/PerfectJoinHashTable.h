@@ -97,6 +97,8 @@ class PerfectJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Perfect"; }
 
+  std::optional<JoinKeyRange> getKeyRange() const override;
+
   static auto getHashTableCache() { return hash_table_cache_.get(); }
 
   static auto getCacheInvalidator() -> std::function<void()> {
@@ -182,6 +184,14 @@ class PerfectJoinHashTable : public HashJoin {
 
   bool isBitwiseEq() const;
 
+  //! Sets the Bloom filter of a CPU table built on a sparse key range, whose probes
+  //! would mostly miss the cache.
+  void buildBloomFilter(PerfectHashTable* hash_table,
+                        const Analyzer::ColumnVar* inner_col,
+                        const int32_t invalid_slot_val) const;
+
+  const JoinBloomFilter* getBloomFilter() const;
+
   size_t getComponentBufferSize() const noexcept override;
 
   HashTable* getHashTableForDevice(const size_t device_id) const;
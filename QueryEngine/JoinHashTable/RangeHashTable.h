@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "QueryEngine/JoinHashTable/HashTable.h"
+
+//! The inner rows of a range join sorted on their key: the buffer holds the entry_count
+//! keys, as 64 bits integers, followed by the matching row ids, as 32 bits integers.
+class RangeHashTable : public HashTable {
+ public:
+  // CPU + GPU constructor
+  RangeHashTable(const Catalog_Namespace::Catalog* catalog,
+                 const ExecutorDeviceType device_type,
+                 const size_t entry_count)
+      : catalog_(catalog), entry_count_(entry_count) {
+    if (device_type == ExecutorDeviceType::CPU) {
+      cpu_hash_table_buff_.resize(entry_count_ + (entry_count_ + 1) / 2);
+    }
+  }
+
+  ~RangeHashTable() {
+    CHECK(catalog_);
+    auto& data_mgr = catalog_->getDataMgr();
+    if (gpu_hash_table_buff_) {
+      data_mgr.free(gpu_hash_table_buff_);
+    }
+  }
+
+  void allocateGpuMemory(const int device_id) {
+    CHECK(catalog_);
+    auto& data_mgr = catalog_->getDataMgr();
+    CHECK_GE(device_id, 0);
+    CHECK(!gpu_hash_table_buff_);
+    // an empty table still needs a valid pointer
+    const auto entries = std::max(entry_count_ + (entry_count_ + 1) / 2, size_t(1));
+    gpu_hash_table_buff_ = CudaAllocator::allocGpuAbstractBuffer(
+        &data_mgr, entries * sizeof(int64_t), device_id);
+  }
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType device_type) const override {
+    if (device_type == ExecutorDeviceType::CPU) {
+      return cpu_hash_table_buff_.size() *
+             sizeof(decltype(cpu_hash_table_buff_)::value_type);
+    } else {
+      return gpu_hash_table_buff_ ? gpu_hash_table_buff_->reservedSize() : 0;
+    }
+  }
+
+  HashType getLayout() const override { return HashType::OneToMany; }
+
+  int8_t* getCpuBuffer() override {
+    return reinterpret_cast<int8_t*>(cpu_hash_table_buff_.data());
+  }
+
+  int8_t* getGpuBuffer() const override {
+    return gpu_hash_table_buff_ ? gpu_hash_table_buff_->getMemoryPtr() : nullptr;
+  }
+
+  size_t getEntryCount() const override { return entry_count_; }
+
+  size_t getEmittedKeysCount() const override { return entry_count_; }
+
+  int64_t* getKeys() { return cpu_hash_table_buff_.data(); }
+
+  int32_t* getRowIds() {
+    return reinterpret_cast<int32_t*>(cpu_hash_table_buff_.data() + entry_count_);
+  }
+
+ private:
+  Data_Namespace::AbstractBuffer* gpu_hash_table_buff_{nullptr};
+  const Catalog_Namespace::Catalog* catalog_;
+  std::vector<int64_t> cpu_hash_table_buff_;
+
+  size_t entry_count_;  // number of inner rows with a non-null key
+};
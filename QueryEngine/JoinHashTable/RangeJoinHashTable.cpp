@@ -0,0 +1,562 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/RangeJoinHashTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "Shared/thread_count.h"
+
+extern unsigned g_trivial_loop_join_threshold;
+
+namespace {
+
+// Integers, decimals and times, whose values are compared as 64 bits integers.
+bool is_range_join_type(const SQLTypeInfo& ti) {
+  return (ti.is_integer() || ti.is_decimal() || ti.is_time()) &&
+         get_join_column_type_kind(ti) != Unsigned;
+}
+
+bool same_range_join_type(const SQLTypeInfo& lhs, const SQLTypeInfo& rhs) {
+  return lhs.get_type() == rhs.get_type() && lhs.get_scale() == rhs.get_scale() &&
+         (!lhs.is_timestamp() || lhs.get_dimension() == rhs.get_dimension());
+}
+
+int get_max_rte_idx(const Analyzer::Expr* expr) {
+  std::set<int> rte_idx_set;
+  expr->collect_rte_idx(rte_idx_set);
+  return rte_idx_set.empty() ? -1 : *rte_idx_set.rbegin();
+}
+
+int64_t get_key_span(const int64_t min_key, const int64_t max_key) {
+  int64_t key_span;
+  if (__builtin_sub_overflow(max_key, min_key, &key_span)) {
+    key_span = std::numeric_limits<int64_t>::max();
+  }
+  return key_span;
+}
+
+// The loop join compares every outer row with every inner row. The range join sorts the
+// inner rows, then every outer row does two binary searches and goes through the rows
+// between them.
+bool is_range_join_cheaper(const size_t inner_row_count,
+                           const size_t outer_row_count,
+                           const double searched_fraction) {
+  const double inner_rows = inner_row_count;
+  const double outer_rows = outer_row_count;
+  const double log_inner_rows = std::log2(std::max(inner_rows, 2.));
+  const double range_join_cost =
+      inner_rows * log_inner_rows +
+      outer_rows * (2 * log_inner_rows + searched_fraction * inner_rows);
+  return range_join_cost < outer_rows * inner_rows;
+}
+
+}  // namespace
+
+std::shared_ptr<RangeJoinHashTable> RangeJoinHashTable::getInstance(
+    const std::list<std::shared_ptr<Analyzer::Expr>>& join_quals,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_count,
+    const bool loop_join_allowed,
+    ColumnCacheMap& column_cache,
+    Executor* executor) {
+  decltype(std::chrono::steady_clock::now()) ts1, ts2;
+  if (VLOGGING(1)) {
+    ts1 = std::chrono::steady_clock::now();
+  }
+  int inner_rte_idx{-1};
+  for (const auto& join_qual : join_quals) {
+    inner_rte_idx = std::max(inner_rte_idx, get_max_rte_idx(join_qual.get()));
+  }
+  if (inner_rte_idx <= 0) {
+    throw HashJoinFail("No inner table column found for a range join");
+  }
+  const auto catalog = executor->getCatalog();
+  CHECK(catalog);
+  std::vector<std::shared_ptr<Analyzer::ColumnVar>> inner_cols;
+  std::vector<Bound> bounds;
+  for (const auto& join_qual : join_quals) {
+    const auto qual_bin_oper = std::dynamic_pointer_cast<Analyzer::BinOper>(join_qual);
+    if (!qual_bin_oper || qual_bin_oper->get_qualifier() != kONE) {
+      continue;
+    }
+    const auto optype = qual_bin_oper->get_optype();
+    if (optype != kLT && optype != kLE && optype != kGT && optype != kGE) {
+      continue;
+    }
+    auto inner_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(qual_bin_oper->get_left_operand());
+    auto outer_expr = qual_bin_oper->get_right_operand();
+    bool is_lower = optype == kGT || optype == kGE;
+    if (!inner_col || inner_col->get_rte_idx() != inner_rte_idx) {
+      inner_col =
+          dynamic_cast<const Analyzer::ColumnVar*>(qual_bin_oper->get_right_operand());
+      outer_expr = qual_bin_oper->get_left_operand();
+      is_lower = !is_lower;
+    }
+    if (!inner_col || inner_col->get_rte_idx() != inner_rte_idx ||
+        get_max_rte_idx(outer_expr) >= inner_rte_idx) {
+      continue;
+    }
+    const auto& inner_ti = inner_col->get_type_info();
+    if (!is_range_join_type(inner_ti) ||
+        !same_range_join_type(inner_ti, outer_expr->get_type_info())) {
+      continue;
+    }
+    const auto inner_cd = get_column_descriptor_maybe(
+        inner_col->get_column_id(), inner_col->get_table_id(), *catalog);
+    if (inner_cd && inner_cd->isVirtualCol) {
+      continue;
+    }
+    if (get_shard_count(qual_bin_oper.get(), executor)) {
+      throw HashJoinFail("Range joins on shard keys are not supported");
+    }
+    const auto col_it = std::find_if(
+        inner_cols.begin(),
+        inner_cols.end(),
+        [inner_col](const std::shared_ptr<Analyzer::ColumnVar>& col) {
+          return col->get_column_id() == inner_col->get_column_id();
+        });
+    const size_t col_idx = col_it - inner_cols.begin();
+    if (col_it == inner_cols.end()) {
+      inner_cols.push_back(
+          std::dynamic_pointer_cast<Analyzer::ColumnVar>(inner_col->deep_copy()));
+    }
+    bounds.push_back({qual_bin_oper,
+                      col_idx,
+                      outer_expr,
+                      is_lower,
+                      optype == kLT || optype == kGT,
+                      0});
+  }
+  if (bounds.empty()) {
+    throw HashJoinFail("No inequality found for a range join");
+  }
+  const auto inner_table_id = inner_cols.front()->get_table_id();
+  const auto& query_info = get_inner_query_info(inner_table_id, query_infos).info;
+  if (query_info.getNumTuplesUpperBound() <= g_trivial_loop_join_threshold) {
+    throw HashJoinFail("Inner table small enough for a loop join");
+  }
+  if (query_info.getNumTuplesUpperBound() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw HashJoinFail("Too many rows in the inner table for a range join");
+  }
+
+  // The key is the column with the most bounds.
+  std::vector<size_t> bound_counts(inner_cols.size());
+  for (const auto& bound : bounds) {
+    ++bound_counts[bound.col_idx];
+  }
+  const size_t key_col_idx =
+      std::max_element(bound_counts.begin(), bound_counts.end()) - bound_counts.begin();
+  std::swap(inner_cols.front(), inner_cols[key_col_idx]);
+  for (auto& bound : bounds) {
+    if (bound.col_idx == key_col_idx) {
+      bound.col_idx = 0;
+    } else if (bound.col_idx == 0) {
+      bound.col_idx = key_col_idx;
+    }
+  }
+
+  VLOG(1) << "Building range join table on " << inner_cols.front()->toString();
+  auto join_hash_table =
+      std::shared_ptr<RangeJoinHashTable>(new RangeJoinHashTable(std::move(inner_cols),
+                                                                 std::move(bounds),
+                                                                 query_infos,
+                                                                 memory_level,
+                                                                 device_count,
+                                                                 loop_join_allowed,
+                                                                 column_cache,
+                                                                 executor));
+  try {
+    join_hash_table->reify();
+  } catch (const TableMustBeReplicated& e) {
+    // Throw a runtime error to abort the query
+    join_hash_table->freeHashBufferMemory();
+    throw std::runtime_error(e.what());
+  } catch (const HashJoinFail& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const ColumnarConversionNotSupported& e) {
+    throw HashJoinFail(std::string("Could not build a range join table | ") + e.what());
+  } catch (const OutOfMemory& e) {
+    throw HashJoinFail(
+        std::string("Ran out of memory while building a range join table | ") +
+        e.what());
+  } catch (const std::exception& e) {
+    throw std::runtime_error(
+        std::string("Fatal error while attempting to build hash tables for join: ") +
+        e.what());
+  }
+  if (VLOGGING(1)) {
+    ts2 = std::chrono::steady_clock::now();
+    VLOG(1) << "Built range join table with "
+            << join_hash_table->getHashTableForDevice(0)->getEntryCount()
+            << " entries in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count()
+            << " ms";
+  }
+  return join_hash_table;
+}
+
+void RangeJoinHashTable::reify() {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto catalog = executor_->getCatalog();
+  CHECK(catalog);
+  HashJoin::checkHashJoinReplicationConstraint(getInnerTableId(), 0, executor_);
+  const auto& query_info = get_inner_query_info(getInnerTableId(), query_infos_).info;
+  const int thread_count = cpu_threads();
+
+  // The table is built on CPU once and copied to every device.
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::shared_ptr<void>> malloc_owner;
+  std::vector<std::vector<int64_t>> values_per_col;
+  for (const auto& inner_col : inner_cols_) {
+    const auto join_column = fetchJoinColumn(inner_col.get(),
+                                             query_info.fragments,
+                                             Data_Namespace::CPU_LEVEL,
+                                             0,
+                                             chunks_owner,
+                                             nullptr,
+                                             malloc_owner,
+                                             executor_,
+                                             &column_cache_);
+    const auto& ti = inner_col->get_type_info();
+    const JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                       0,
+                                       0,
+                                       inline_fixed_encoding_null_val(ti),
+                                       false,
+                                       0,
+                                       get_join_column_type_kind(ti)};
+    values_per_col.emplace_back(join_column.num_elems);
+    decode_join_column_on_cpu(
+        values_per_col.back().data(), join_column, type_info, thread_count);
+  }
+
+  // Rows with a null in any of the columns compared can't match.
+  const auto null_val = inline_int_null_value<int64_t>();
+  const auto& keys = values_per_col.front();
+  std::vector<std::pair<int64_t, int32_t>> entries;
+  entries.reserve(keys.size());
+  std::vector<std::optional<std::pair<int64_t, int64_t>>> diff_ranges(
+      inner_cols_.size());
+  std::vector<bool> diff_overflows(inner_cols_.size());
+  int64_t min_key{std::numeric_limits<int64_t>::max()};
+  int64_t max_key{std::numeric_limits<int64_t>::min()};
+  for (size_t row = 0; row < keys.size(); ++row) {
+    if (std::any_of(values_per_col.begin(),
+                    values_per_col.end(),
+                    [row, null_val](const std::vector<int64_t>& values) {
+                      return values[row] == null_val;
+                    })) {
+      continue;
+    }
+    entries.emplace_back(keys[row], static_cast<int32_t>(row));
+    min_key = std::min(min_key, keys[row]);
+    max_key = std::max(max_key, keys[row]);
+    for (size_t col_idx = 1; col_idx < values_per_col.size(); ++col_idx) {
+      int64_t diff;
+      if (__builtin_sub_overflow(values_per_col[col_idx][row], keys[row], &diff)) {
+        diff_overflows[col_idx] = true;
+        continue;
+      }
+      auto& diff_range = diff_ranges[col_idx];
+      diff_range = diff_range ? std::make_pair(std::min(diff_range->first, diff),
+                                               std::max(diff_range->second, diff))
+                              : std::make_pair(diff, diff);
+    }
+  }
+  for (size_t col_idx = 1; col_idx < diff_ranges.size(); ++col_idx) {
+    if (diff_overflows[col_idx]) {
+      diff_ranges[col_idx].reset();
+    }
+  }
+  values_per_col.clear();
+  if (entries.empty()) {
+    min_key = max_key = 0;
+  }
+  setBoundOffsets(diff_ranges, min_key, max_key);
+  if (bounds_.empty()) {
+    throw HashJoinFail("The inequalities can't narrow the inner rows to match");
+  }
+  if (loop_join_allowed_) {
+    const auto outer_row_count = query_infos_.front().info.getNumTuplesUpperBound();
+    const auto searched_fraction = estimateSearchedFraction(min_key, max_key);
+    VLOG(1) << "Range join expected to search " << searched_fraction
+            << " of the " << entries.size() << " inner rows for each of the "
+            << outer_row_count << " outer rows";
+    if (!is_range_join_cheaper(entries.size(), outer_row_count, searched_fraction)) {
+      throw HashJoinFail("A loop join is expected to be cheaper than a range join");
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+
+  auto hash_table = std::make_shared<RangeHashTable>(
+      catalog, ExecutorDeviceType::CPU, entries.size());
+  auto table_keys = hash_table->getKeys();
+  auto table_row_ids = hash_table->getRowIds();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    table_keys[i] = entries[i].first;
+    table_row_ids[i] = entries[i].second;
+  }
+  if (memory_level_ == Data_Namespace::GPU_LEVEL) {
+#ifdef HAVE_CUDA
+    auto& data_mgr = catalog->getDataMgr();
+    for (int device_id = 0; device_id < device_count_; ++device_id) {
+      auto gpu_hash_table = std::make_shared<RangeHashTable>(
+          catalog, ExecutorDeviceType::GPU, entries.size());
+      gpu_hash_table->allocateGpuMemory(device_id);
+      const auto buffer_size =
+          hash_table->getHashTableBufferSize(ExecutorDeviceType::CPU);
+      if (buffer_size) {
+        copy_to_gpu(&data_mgr,
+                    reinterpret_cast<CUdeviceptr>(gpu_hash_table->getGpuBuffer()),
+                    hash_table->getCpuBuffer(),
+                    buffer_size,
+                    device_id);
+      }
+      hash_tables_for_device_[device_id] = std::move(gpu_hash_table);
+    }
+#else
+    UNREACHABLE();
+#endif
+  } else {
+    CHECK_EQ(device_count_, 1);
+    hash_tables_for_device_[0] = std::move(hash_table);
+  }
+}
+
+void RangeJoinHashTable::setBoundOffsets(
+    const std::vector<std::optional<std::pair<int64_t, int64_t>>>& diff_ranges,
+    const int64_t min_key,
+    const int64_t max_key) {
+  const auto key_span = get_key_span(min_key, max_key);
+  std::vector<Bound> bounds;
+  for (auto& bound : bounds_) {
+    const int64_t strict_offset = bound.is_strict ? 1 : 0;
+    if (bound.col_idx == 0) {
+      bound.offset = bound.is_lower ? strict_offset : -strict_offset;
+      bounds.push_back(bound);
+      continue;
+    }
+    const auto& diff_range = diff_ranges[bound.col_idx];
+    int64_t diff_span;
+    if (!diff_range ||
+        __builtin_sub_overflow(diff_range->second, diff_range->first, &diff_span) ||
+        diff_span >= key_span) {
+      // the key is anywhere within the whole range given the column
+      continue;
+    }
+    // col >= value implies key >= value - max(col - key), col <= value implies
+    // key <= value - min(col - key)
+    if (bound.is_lower
+            ? __builtin_sub_overflow(strict_offset, diff_range->second, &bound.offset)
+            : __builtin_sub_overflow(-strict_offset, diff_range->first, &bound.offset)) {
+      continue;
+    }
+    bounds.push_back(bound);
+  }
+  bounds_.swap(bounds);
+}
+
+double RangeJoinHashTable::estimateSearchedFraction(const int64_t min_key,
+                                                    const int64_t max_key) const {
+  bool has_lower_bound{false};
+  bool has_upper_bound{false};
+  std::optional<int64_t> search_width;
+  for (const auto& lower_bound : bounds_) {
+    if (!lower_bound.is_lower) {
+      has_upper_bound = true;
+      continue;
+    }
+    has_lower_bound = true;
+    for (const auto& upper_bound : bounds_) {
+      int64_t width;
+      if (upper_bound.is_lower || !(*lower_bound.outer_expr == *upper_bound.outer_expr) ||
+          __builtin_sub_overflow(upper_bound.offset, lower_bound.offset, &width)) {
+        continue;
+      }
+      search_width = search_width ? std::min(*search_width, width) : width;
+    }
+  }
+  if (!has_lower_bound || !has_upper_bound) {
+    // open on one side, half of the keys on average
+    return 0.5;
+  }
+  if (!search_width) {
+    // how far apart the outer expressions of the bounds are isn't known, assume close
+    return 0.;
+  }
+  const double key_span = get_key_span(min_key, max_key);
+  return std::clamp((static_cast<double>(*search_width) + 1) / (key_span + 1), 0., 1.);
+}
+
+#define LL_CONTEXT executor_->cgen_state_->context_
+#define LL_BUILDER executor_->cgen_state_->ir_builder_
+#define LL_INT(v) executor_->cgen_state_->llInt(v)
+
+HashJoinMatchingSet RangeJoinHashTable::codegenMatchingSet(const CompilationOptions& co,
+                                                           const size_t index) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto hash_table = getHashTableForDevice(size_t(0));
+  CHECK(hash_table);
+  const auto entry_count = static_cast<int64_t>(hash_table->getEntryCount());
+  auto hash_ptr = HashJoin::codegenHashTableLoad(index, executor_);
+  if (hash_ptr->getType()->isPointerTy()) {
+    hash_ptr = LL_BUILDER.CreatePtrToInt(hash_ptr, llvm::Type::getInt64Ty(LL_CONTEXT));
+  } else {
+    CHECK(hash_ptr->getType()->isIntegerTy(64));
+  }
+  CodeGenerator code_generator(executor_);
+  llvm::Value* lower_bound_lv = LL_INT(std::numeric_limits<int64_t>::min());
+  llvm::Value* upper_bound_lv = LL_INT(std::numeric_limits<int64_t>::max());
+  for (const auto& bound : bounds_) {
+    const auto outer_lvs = code_generator.codegen(bound.outer_expr, true, co);
+    CHECK_EQ(size_t(1), outer_lvs.size());
+    const auto outer_logical_ti =
+        get_logical_type_info(bound.outer_expr->get_type_info());
+    const auto bound_lv = executor_->cgen_state_->emitCall(
+        bound.is_lower ? "range_join_lower_bound" : "range_join_upper_bound",
+        {executor_->cgen_state_->castToTypeIn(outer_lvs.front(), 64),
+         LL_INT(inline_fixed_encoding_null_val(outer_logical_ti)),
+         LL_INT(bound.offset)});
+    if (bound.is_lower) {
+      lower_bound_lv = LL_BUILDER.CreateSelect(
+          LL_BUILDER.CreateICmpSGT(bound_lv, lower_bound_lv), bound_lv, lower_bound_lv);
+    } else {
+      upper_bound_lv = LL_BUILDER.CreateSelect(
+          LL_BUILDER.CreateICmpSLT(bound_lv, upper_bound_lv), bound_lv, upper_bound_lv);
+    }
+  }
+  const auto keys_lv =
+      LL_BUILDER.CreateIntToPtr(hash_ptr, llvm::Type::getInt64PtrTy(LL_CONTEXT));
+  const auto lower_idx_lv = executor_->cgen_state_->emitCall(
+      "range_join_lower_idx", {keys_lv, LL_INT(entry_count), lower_bound_lv});
+  const auto upper_idx_lv = executor_->cgen_state_->emitCall(
+      "range_join_upper_idx", {keys_lv, LL_INT(entry_count), upper_bound_lv});
+  const auto row_count_lv =
+      LL_BUILDER.CreateSelect(LL_BUILDER.CreateICmpSGT(upper_idx_lv, lower_idx_lv),
+                              LL_BUILDER.CreateSub(upper_idx_lv, lower_idx_lv),
+                              LL_INT(int64_t(0)));
+  const auto rowid_base_i32 = LL_BUILDER.CreateIntToPtr(
+      LL_BUILDER.CreateAdd(hash_ptr, LL_INT(static_cast<int64_t>(payloadBufferOff()))),
+      llvm::Type::getInt32PtrTy(LL_CONTEXT));
+  const auto rowid_ptr_i32 = LL_BUILDER.CreateGEP(rowid_base_i32, lower_idx_lv);
+  return {rowid_ptr_i32, row_count_lv, lower_idx_lv};
+}
+
+#undef LL_INT
+#undef LL_BUILDER
+#undef LL_CONTEXT
+
+size_t RangeJoinHashTable::payloadBufferOff() const noexcept {
+  const auto hash_table = getHashTableForDevice(size_t(0));
+  return hash_table ? hash_table->getEntryCount() * sizeof(int64_t) : 0;
+}
+
+size_t RangeJoinHashTable::getComponentBufferSize() const noexcept {
+  const auto hash_table = getHashTableForDevice(size_t(0));
+  return hash_table ? hash_table->getEntryCount() * sizeof(int32_t) : 0;
+}
+
+namespace {
+
+// The keys and the row ids of a range join table, copied from the device if needed.
+std::pair<std::vector<int64_t>, std::vector<int32_t>> get_range_join_entries(
+    const HashJoin* hash_join,
+    const ExecutorDeviceType device_type,
+    const int device_id,
+    const Executor* executor) {
+  const auto hash_table = hash_join->getHashTableForDevice(device_id);
+  if (!hash_table) {
+    return {};
+  }
+  const auto entry_count = hash_table->getEntryCount();
+  const auto buffer = reinterpret_cast<const int8_t*>(
+      hash_join->getJoinHashBuffer(device_type, device_id));
+  std::vector<int64_t> keys(entry_count);
+  std::vector<int32_t> row_ids(entry_count);
+  if (!entry_count) {
+    return {keys, row_ids};
+  }
+#ifdef HAVE_CUDA
+  if (device_type == ExecutorDeviceType::GPU) {
+    auto& data_mgr = executor->getCatalog()->getDataMgr();
+    copy_from_gpu(&data_mgr,
+                  keys.data(),
+                  reinterpret_cast<CUdeviceptr>(buffer),
+                  entry_count * sizeof(int64_t),
+                  device_id);
+    copy_from_gpu(&data_mgr,
+                  row_ids.data(),
+                  reinterpret_cast<CUdeviceptr>(buffer + entry_count * sizeof(int64_t)),
+                  entry_count * sizeof(int32_t),
+                  device_id);
+    return {keys, row_ids};
+  }
+#endif  // HAVE_CUDA
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  std::memcpy(keys.data(), buffer, entry_count * sizeof(int64_t));
+  std::memcpy(row_ids.data(),
+              buffer + entry_count * sizeof(int64_t),
+              entry_count * sizeof(int32_t));
+  return {keys, row_ids};
+}
+
+}  // namespace
+
+std::string RangeJoinHashTable::toString(const ExecutorDeviceType device_type,
+                                         const int device_id,
+                                         bool raw) const {
+  const auto [keys, row_ids] =
+      get_range_join_entries(this, device_type, device_id, executor_);
+  std::ostringstream oss;
+  oss << "| range " << inner_cols_.front()->toString() << " |";
+  for (size_t i = 0; i < keys.size(); ++i) {
+    oss << " " << keys[i] << ": " << row_ids[i] << " |";
+  }
+  return oss.str();
+}
+
+DecodedJoinHashBufferSet RangeJoinHashTable::toSet(const ExecutorDeviceType device_type,
+                                                   const int device_id) const {
+  const auto [keys, row_ids] =
+      get_range_join_entries(this, device_type, device_id, executor_);
+  DecodedJoinHashBufferSet entries;
+  for (size_t i = 0; i < keys.size();) {
+    DecodedJoinHashBufferEntry entry{{keys[i]}, {}};
+    for (; i < keys.size() && keys[i] == entry.key.front(); ++i) {
+      entry.payload.insert(row_ids[i]);
+    }
+    entries.insert(std::move(entry));
+  }
+  return entries;
+}
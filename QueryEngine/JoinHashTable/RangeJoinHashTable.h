@@ -0,0 +1,163 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RangeJoinHashTable.h
+ * @brief   Join on inequalities (<, <=, >, >=, BETWEEN) between columns of the inner
+ *          table and expressions of the outer tables.
+ *
+ * The inner rows are sorted on one of the columns compared, the key column, and every
+ * outer row binary searches the range of keys within its bounds. The other inner
+ * columns compared bound the key through the range of their difference with it, which
+ * makes interval joins such as `a.start <= b.ts AND b.ts < a.end` work: the end bounds
+ * the start by the longest interval. The rows found are a superset of the matches, the
+ * join conditions are still evaluated on them as filters.
+ */
+
+#pragma once
+
+#include "Analyzer/Analyzer.h"
+#include "Catalog/Catalog.h"
+#include "DataMgr/Allocators/CudaAllocator.h"
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/JoinHashTable/RangeHashTable.h"
+
+#include <list>
+#include <memory>
+#include <optional>
+
+class RangeJoinHashTable : public HashJoin {
+ public:
+  //! Make the table for the inequalities among the join quals of a level, throws
+  //! HashJoinFail when they can't be used or when a loop join is expected to be cheaper.
+  //! The cost of the loop join is only considered when the query can fall back to it.
+  static std::shared_ptr<RangeJoinHashTable> getInstance(
+      const std::list<std::shared_ptr<Analyzer::Expr>>& join_quals,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_count,
+      const bool loop_join_allowed,
+      ColumnCacheMap& column_cache,
+      Executor* executor);
+
+  //! The qual standing for the join when looking up the table by inner table.
+  std::shared_ptr<Analyzer::BinOper> getRepresentativeQual() const {
+    CHECK(!bounds_.empty());
+    return bounds_.front().qual;
+  }
+
+  std::string toString(const ExecutorDeviceType device_type,
+                       const int device_id = 0,
+                       bool raw = false) const override;
+
+  DecodedJoinHashBufferSet toSet(const ExecutorDeviceType device_type,
+                                 const int device_id) const override;
+
+  llvm::Value* codegenSlot(const CompilationOptions&, const size_t) override {
+    UNREACHABLE();
+    return nullptr;
+  }
+
+  HashJoinMatchingSet codegenMatchingSet(const CompilationOptions&,
+                                         const size_t) override;
+
+  int getInnerTableId() const noexcept override {
+    return inner_cols_.front()->get_table_id();
+  }
+
+  int getInnerTableRteIdx() const noexcept override {
+    return inner_cols_.front()->get_rte_idx();
+  }
+
+  HashType getHashType() const noexcept override { return HashType::OneToMany; }
+
+  Data_Namespace::MemoryLevel getMemoryLevel() const noexcept override {
+    return memory_level_;
+  }
+
+  int getDeviceCount() const noexcept override { return device_count_; }
+
+  size_t offsetBufferOff() const noexcept override { return 0; }
+
+  size_t countBufferOff() const noexcept override { return 0; }
+
+  size_t payloadBufferOff() const noexcept override;
+
+  std::string getHashJoinType() const final { return "Range"; }
+
+  virtual ~RangeJoinHashTable() {}
+
+ private:
+  //! `inner_cols_[col_idx] >= outer_expr` for lower bounds, `<=` for upper bounds, `>`
+  //! and `<` when strict. Once the table is built, offset is what to add to the value
+  //! of outer_expr to get the bound on the key column.
+  struct Bound {
+    std::shared_ptr<Analyzer::BinOper> qual;
+    size_t col_idx;
+    const Analyzer::Expr* outer_expr;
+    bool is_lower;
+    bool is_strict;
+    int64_t offset;
+  };
+
+  RangeJoinHashTable(std::vector<std::shared_ptr<Analyzer::ColumnVar>> inner_cols,
+                     std::vector<Bound> bounds,
+                     const std::vector<InputTableInfo>& query_infos,
+                     const Data_Namespace::MemoryLevel memory_level,
+                     const int device_count,
+                     const bool loop_join_allowed,
+                     ColumnCacheMap& column_cache,
+                     Executor* executor)
+      : inner_cols_(std::move(inner_cols))
+      , bounds_(std::move(bounds))
+      , query_infos_(query_infos)
+      , memory_level_(memory_level)
+      , device_count_(device_count)
+      , loop_join_allowed_(loop_join_allowed)
+      , column_cache_(column_cache)
+      , executor_(executor) {
+    CHECK(!inner_cols_.empty());
+    CHECK_GT(device_count_, 0);
+    hash_tables_for_device_.resize(device_count_);
+  }
+
+  void reify();
+
+  //! Sets the offsets of the bounds from the range of the difference of the other inner
+  //! columns with the key column, unset when it overflows, and drops the bounds which
+  //! can't narrow the key range.
+  void setBoundOffsets(
+      const std::vector<std::optional<std::pair<int64_t, int64_t>>>& diff_ranges,
+      const int64_t min_key,
+      const int64_t max_key);
+
+  //! Fraction of the inner rows an outer row is expected to search, the width between
+  //! its bounds over the span of the keys, once the bound offsets are set.
+  double estimateSearchedFraction(const int64_t min_key, const int64_t max_key) const;
+
+  size_t getComponentBufferSize() const noexcept override;
+
+  // the key column first
+  std::vector<std::shared_ptr<Analyzer::ColumnVar>> inner_cols_;
+  std::vector<Bound> bounds_;
+  const std::vector<InputTableInfo>& query_infos_;
+  const Data_Namespace::MemoryLevel memory_level_;
+  const int device_count_;
+  const bool loop_join_allowed_;
+  ColumnCacheMap& column_cache_;
+  Executor* executor_;
+};
@@ -17,6 +17,7 @@
 #ifndef QUERYENGINE_HASHJOINKEYHANDLERS_H
 #define QUERYENGINE_HASHJOINKEYHANDLERS_H
 
+#include "Geospatial/CompressionRuntime.h"
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 #include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
 #include "Shared/SqlTypesLayout.h"
@@ -129,10 +130,12 @@ struct GenericKeyHandler {
 struct OverlapsKeyHandler {
   OverlapsKeyHandler(const size_t key_dims_count,
                      const JoinColumn* join_column,  // always 1 column
-                     const double* bucket_sizes_for_dimension)
+                     const double* bucket_sizes_for_dimension,
+                     const OverlapsRangeInfo range_info = {})
       : key_dims_count_(key_dims_count)
       , join_column_(join_column)
-      , bucket_sizes_for_dimension_(bucket_sizes_for_dimension) {}
+      , bucket_sizes_for_dimension_(bucket_sizes_for_dimension)
+      , range_info_(range_info) {}
 
   template <typename T, typename KEY_BUFF_HANDLER>
   DEVICE int operator()(JoinColumnIterator* join_column_iterators,
@@ -141,9 +144,16 @@ struct OverlapsKeyHandler {
     // TODO(adb): hard-coding the 2D case w/ bounds for now. Should support n-dims with a
     // check to ensure we are not exceeding maximum number of dims for coalesced keys
     double bounds[4];
-    for (size_t j = 0; j < 2 * key_dims_count_; j++) {
-      bounds[j] =
-          SUFFIX(fixed_width_double_decode_noinline)(join_column_iterators->ptr(), j);
+    if (range_info_.is_range_join) {
+      if (!getRangeBounds(join_column_iterators->ptr(), bounds)) {
+        // null points never match, do not emit any keys
+        return 0;
+      }
+    } else {
+      for (size_t j = 0; j < 2 * key_dims_count_; j++) {
+        bounds[j] =
+            SUFFIX(fixed_width_double_decode_noinline)(join_column_iterators->ptr(), j);
+      }
     }
 
     const auto x_bucket_sz = bucket_sizes_for_dimension_[0];
@@ -167,6 +177,61 @@ struct OverlapsKeyHandler {
     return 0;
   }
 
+  // Expands the inner point at point_ptr to the box containing all points within the
+  // range distance. Returns false for null points.
+  DEVICE bool getRangeBounds(const int8_t* point_ptr, double* bounds) const {
+    double x, y;
+    if (range_info_.is_compressed) {
+      const auto compressed_coords = reinterpret_cast<const int32_t*>(point_ptr);
+      if (Geospatial::is_null_point_longitude_geoint32(compressed_coords[0])) {
+        return false;
+      }
+      x = Geospatial::decompress_longitude_coord_geoint32(compressed_coords[0]);
+      y = Geospatial::decompress_lattitude_coord_geoint32(compressed_coords[1]);
+    } else {
+      const auto coords = reinterpret_cast<const double*>(point_ptr);
+      if (coords[0] == NULL_ARRAY_DOUBLE) {
+        return false;
+      }
+      x = coords[0];
+      y = coords[1];
+    }
+
+    if (!range_info_.is_geodesic) {
+      bounds[0] = x - range_info_.distance;
+      bounds[1] = y - range_info_.distance;
+      bounds[2] = x + range_info_.distance;
+      bounds[3] = y + range_info_.distance;
+      return true;
+    }
+
+    // Bounding box of a spherical cap. The radius is a bit smaller than the one used by
+    // distance_in_meters, which errs on the side of larger boxes.
+    constexpr double kEarthRadiusMeters{6371000.0};
+    constexpr double kRadiansToDegrees{57.29577951308232};
+    const double angular_distance = range_info_.distance / kEarthRadiusMeters;
+    const double lat_delta = angular_distance * kRadiansToDegrees;
+    bounds[1] = y - lat_delta;
+    bounds[3] = y + lat_delta;
+    const double cos_lat = cos(y / kRadiansToDegrees);
+    const double sin_distance = sin(angular_distance);
+    if (bounds[1] <= -90.0 || bounds[3] >= 90.0 || sin_distance >= cos_lat) {
+      // the cap contains a pole, all longitudes are in range
+      bounds[0] = -180.0;
+      bounds[2] = 180.0;
+      return true;
+    }
+    const double lon_delta = asin(sin_distance / cos_lat) * kRadiansToDegrees;
+    bounds[0] = x - lon_delta;
+    bounds[2] = x + lon_delta;
+    if (bounds[0] < -180.0 || bounds[2] > 180.0) {
+      // do not bother splitting boxes crossing the antimeridian
+      bounds[0] = -180.0;
+      bounds[2] = 180.0;
+    }
+    return true;
+  }
+
   DEVICE size_t get_number_of_columns() const { return 1; }
 
   DEVICE size_t get_key_component_count() const { return key_dims_count_; }
@@ -178,6 +243,7 @@ struct OverlapsKeyHandler {
   const size_t key_dims_count_;
   const JoinColumn* join_column_;
   const double* bucket_sizes_for_dimension_;
+  const OverlapsRangeInfo range_info_;
 };
 
 #endif  // QUERYENGINE_HASHJOINKEYHANDLERS_H
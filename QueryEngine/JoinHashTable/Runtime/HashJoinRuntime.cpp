@@ -1780,7 +1780,8 @@ void fill_one_to_many_baseline_hash_table(
             const auto key_handler = OverlapsKeyHandler(
                 join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.size(),
                 &join_column_per_key[0],
-                join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data());
+                join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data(),
+                join_buckets_per_key[0].range_info);
             count_matches_baseline(count_buff,
                                    composite_key_dict,
                                    hash_entry_count,
@@ -1862,7 +1863,8 @@ void fill_one_to_many_baseline_hash_table(
             const auto key_handler = OverlapsKeyHandler(
                 join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.size(),
                 &join_column_per_key[0],
-                join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data());
+                join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data(),
+                join_buckets_per_key[0].range_info);
             SUFFIX(fill_row_ids_baseline)
             (buff,
              composite_key_dict,
@@ -2033,7 +2035,8 @@ void approximate_distinct_tuples_overlaps(
           const auto key_handler = OverlapsKeyHandler(
               join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.size(),
               &join_column_per_key[0],
-              join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data());
+              join_buckets_per_key[0].inverse_bucket_sizes_for_dimension.data(),
+              join_buckets_per_key[0].range_info);
           approximate_distinct_tuples_impl(hll_buffer,
                                            row_counts.data(),
                                            b,
@@ -2084,4 +2087,24 @@ void compute_bucket_sizes_on_cpu(std::vector<double>& bucket_sizes_for_dimension
   }
 }
 
+void decode_join_column_on_cpu(int64_t* buff,
+                               const JoinColumn& join_column,
+                               const JoinColumnTypeInfo& type_info,
+                               const int thread_count) {
+  std::vector<std::future<void>> threads;
+  for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+      JoinColumnTyped col{&join_column, &type_info};
+      for (auto item : col.slice(thread_idx, thread_count)) {
+        buff[item.index] =
+            item.element == type_info.null_val ? inline_int_null_value<int64_t>()
+                                               : item.element;
+      }
+    }));
+  }
+  for (auto& child : threads) {
+    child.get();
+  }
+}
+
 #endif  // ifndef __CUDACC__
@@ -132,9 +132,20 @@ inline ColumnType get_join_column_type_kind(const SQLTypeInfo& ti) {
   }
 }
 
+//! For range (distance) overlaps joins the inner join column holds points rather than
+//! bounding boxes. Each point is expanded to the box covering everything within the
+//! distance before it is assigned to buckets.
+struct OverlapsRangeInfo {
+  bool is_range_join{false};
+  bool is_compressed{false};  // GEOINT32 compressed coordinates
+  bool is_geodesic{false};    // distance in meters, coordinates in WGS84 lon / lat
+  double distance{0.0};
+};
+
 struct JoinBucketInfo {
   std::vector<double> inverse_bucket_sizes_for_dimension;
   bool is_double;  // TODO(adb): assume float otherwise (?)
+  OverlapsRangeInfo range_info{};
 };
 
 int fill_hash_join_buff_bucketized(int32_t* buff,
@@ -396,4 +407,11 @@ void compute_bucket_sizes_on_device(double* bucket_sizes_buffer,
                                     const JoinColumnTypeInfo* type_info,
                                     const double* bucket_size_thresholds);
 
+//! Decodes the values of the column to 64 bits, one per row, with the nulls turned into
+//! the 64 bits null sentinel.
+void decode_join_column_on_cpu(int64_t* buff,
+                               const JoinColumn& join_column,
+                               const JoinColumnTypeInfo& type_info,
+                               const int thread_count);
+
 #endif  // QUERYENGINE_HASHJOINRUNTIME_H
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    JoinBloomFilterInl.h
+ * @brief   Bit positions of the keys of a join Bloom filter, shared by the host code
+ *          building the filter and the runtime function probing it.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "QueryEngine/MurmurHash1Inl.h"
+#include "Shared/funcannotations.h"
+
+// Number of bits set for each key.
+#define JOIN_BLOOM_FILTER_HASH_COUNT 3
+
+// The bit count is a power of two, bit_mask is the bit count minus one. The positions
+// are derived from a single hash by double hashing.
+FORCE_INLINE DEVICE uint64_t join_bloom_filter_bit(const uint64_t hash,
+                                                   const int i,
+                                                   const uint64_t bit_mask) {
+  return (hash + i * ((hash >> 32) | 1)) & bit_mask;
+}
+
+FORCE_INLINE DEVICE void join_bloom_filter_add_impl(uint64_t* words,
+                                                    const uint64_t bit_mask,
+                                                    const int64_t key) {
+  const auto hash = MurmurHash64AImpl(&key, sizeof(key), 0);
+  for (int i = 0; i < JOIN_BLOOM_FILTER_HASH_COUNT; ++i) {
+    const auto bit = join_bloom_filter_bit(hash, i, bit_mask);
+    words[bit >> 6] |= uint64_t(1) << (bit & 63);
+  }
+}
+
+FORCE_INLINE DEVICE bool join_bloom_filter_may_contain_impl(const uint64_t* words,
+                                                            const uint64_t bit_mask,
+                                                            const int64_t key) {
+  const auto hash = MurmurHash64AImpl(&key, sizeof(key), 0);
+  for (int i = 0; i < JOIN_BLOOM_FILTER_HASH_COUNT; ++i) {
+    const auto bit = join_bloom_filter_bit(hash, i, bit_mask);
+    if (!(words[bit >> 6] & (uint64_t(1) << (bit & 63)))) {
+      return false;
+    }
+  }
+  return true;
+}
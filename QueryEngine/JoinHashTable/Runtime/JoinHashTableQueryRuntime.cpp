@@ -20,6 +20,7 @@
 
 #include "Geospatial/CompressionRuntime.h"
 #include "QueryEngine/CompareKeysInl.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinBloomFilterInl.h"
 #include "QueryEngine/MurmurHash.h"
 
 DEVICE bool compare_to_key(const int8_t* entry,
@@ -354,3 +355,79 @@ get_num_buckets_for_bounds(const int8_t* range_bytes,
 
   return num_buckets;
 }
+
+// Range join tables hold the sorted keys of the inner rows followed by their row ids.
+// The bounds on a column other than the key are turned into bounds on the key by adding
+// an offset, which saturates: the rows found by the search may be a superset of the
+// matches, never a subset. A null bound matches no row.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_lower_bound(const int64_t value,
+                       const int64_t null_val,
+                       const int64_t offset) {
+  if (value == null_val || (offset > 0 && value > INT64_MAX - offset)) {
+    return INT64_MAX;
+  }
+  if (offset < 0 && value < INT64_MIN - offset) {
+    return INT64_MIN;
+  }
+  return value + offset;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_upper_bound(const int64_t value,
+                       const int64_t null_val,
+                       const int64_t offset) {
+  if (value == null_val || (offset < 0 && value < INT64_MIN - offset)) {
+    return INT64_MIN;
+  }
+  if (offset > 0 && value > INT64_MAX - offset) {
+    return INT64_MAX;
+  }
+  return value + offset;
+}
+
+// Index of the first key not less than the bound.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_lower_idx(const int64_t* keys,
+                     const int64_t entry_count,
+                     const int64_t bound) {
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] < bound) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Index of the first key greater than the bound.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+range_join_upper_idx(const int64_t* keys,
+                     const int64_t entry_count,
+                     const int64_t bound) {
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    if (keys[mid] <= bound) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Whether the key may be in the Bloom filter of a join hash table, the keys rejected have
+// no match and the probe of the table can be skipped.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int8_t
+join_bloom_filter_may_contain(const int64_t bloom_filter_buff,
+                              const int64_t bit_mask,
+                              const int64_t key) {
+  return join_bloom_filter_may_contain_impl(
+      reinterpret_cast<const uint64_t*>(bloom_filter_buff), bit_mask, key);
+}
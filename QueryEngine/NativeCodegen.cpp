@@ -26,6 +26,7 @@
 #include "OSDependent/omnisci_path.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/Metrics.h"
 #include "StreamingTopN.h"
 
 #if LLVM_VERSION_MAJOR < 9
@@ -86,6 +87,9 @@ extern std::unique_ptr<llvm::Module> g_rt_geos_module;
 
 #include <llvm/Support/DynamicLibrary.h>
 
+#include <array>
+#include <cstdarg>
+
 #ifndef GEOS_LIBRARY_FILENAME
 #error Configuration should include GEOS library file name
 #endif
@@ -118,7 +122,143 @@ void load_geos_dynamic_library() {
   }
 }
 
+constexpr size_t kMaxGeosMessageLen{200};
+
+// called by GEOS on notice
+void geos_notice_handler(const char* fmt, ...) {
+  char buffer[kMaxGeosMessageLen];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buffer, kMaxGeosMessageLen, fmt, args);
+  va_end(args);
+  LOG(INFO) << "GEOS Notice: " << std::string(buffer);
+}
+
+// called by GEOS on error
+void geos_error_handler(const char* fmt, ...) {
+  char buffer[kMaxGeosMessageLen];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buffer, kMaxGeosMessageLen, fmt, args);
+  va_end(args);
+  LOG(ERROR) << "GEOS Error: " << std::string(buffer);
+}
+
+template <typename FUNC>
+FUNC get_geos_function(const char* name) {
+  auto func = reinterpret_cast<FUNC>(geos_dynamic_library.getAddressOfSymbol(name));
+  CHECK(func) << "GEOS function " << name << " not found";
+  return func;
+}
+
+/**
+ * GEOS state of a kernel thread, used by the GEOS runtime functions. The runtime is
+ * linked into every query module and can't keep state across rows itself. The state
+ * holds the GEOS context of the thread and, for every geometry argument, the geometry
+ * last converted from it along with the key of the buffers it was converted from, so a
+ * literal is converted once per kernel. The geometries are dropped when the thread
+ * starts a kernel, as the buffers of another kernel may sit at the same addresses. The
+ * state lives until the thread exits.
+ */
+class GeosThreadState {
+ public:
+  static GeosThreadState& get() {
+    thread_local GeosThreadState state;
+    return state;
+  }
+
+  void* getContext() {
+    if (!context_) {
+      using MessageHandler = void (*)(const char*, ...);
+      using InitFunc = void* (*)(MessageHandler, MessageHandler);
+      static const auto init_geos = get_geos_function<InitFunc>("initGEOS_r");
+      context_ = init_geos(geos_notice_handler, geos_error_handler);
+      CHECK(context_);
+    }
+    return context_;
+  }
+
+  void* getGeometry(const int32_t arg_idx, const int8_t* key, const int64_t key_size) {
+    const auto& cached = geometries_.at(arg_idx);
+    if (cached.geometry && cached.key.size() == static_cast<size_t>(key_size) &&
+        std::equal(cached.key.begin(), cached.key.end(), key)) {
+      return cached.geometry;
+    }
+    return nullptr;
+  }
+
+  void setGeometry(const int32_t arg_idx,
+                   const int8_t* key,
+                   const int64_t key_size,
+                   void* geometry) {
+    auto& cached = geometries_.at(arg_idx);
+    destroyGeometry(cached.geometry);
+    cached.key.assign(key, key + key_size);
+    cached.geometry = geometry;
+  }
+
+  void clearGeometries() {
+    for (auto& cached : geometries_) {
+      destroyGeometry(cached.geometry);
+      cached.key.clear();
+      cached.geometry = nullptr;
+    }
+  }
+
+  ~GeosThreadState() {
+    if (!context_) {
+      return;
+    }
+    for (auto& cached : geometries_) {
+      destroyGeometry(cached.geometry);
+    }
+    using FinishFunc = void (*)(void*);
+    static const auto finish_geos = get_geos_function<FinishFunc>("finishGEOS_r");
+    finish_geos(context_);
+  }
+
+ private:
+  void destroyGeometry(void* geometry) {
+    if (!geometry) {
+      return;
+    }
+    CHECK(context_);
+    using DestroyFunc = void (*)(void*, void*);
+    static const auto destroy = get_geos_function<DestroyFunc>("GEOSGeom_destroy_r");
+    destroy(context_, geometry);
+  }
+
+  struct CachedGeometry {
+    std::vector<int8_t> key;
+    void* geometry{nullptr};
+  };
+
+  void* context_{nullptr};
+  std::array<CachedGeometry, 2> geometries_;
+};
+
 }  // namespace
+
+extern "C" RUNTIME_EXPORT void* get_geos_thread_context() {
+  return GeosThreadState::get().getContext();
+}
+
+extern "C" RUNTIME_EXPORT void* get_geos_cached_geometry(const int32_t arg_idx,
+                                                         const int8_t* key,
+                                                         const int64_t key_size) {
+  return GeosThreadState::get().getGeometry(arg_idx, key, key_size);
+}
+
+extern "C" RUNTIME_EXPORT void set_geos_cached_geometry(const int32_t arg_idx,
+                                                        const int8_t* key,
+                                                        const int64_t key_size,
+                                                        void* geometry) {
+  GeosThreadState::get().setGeometry(arg_idx, key, key_size, geometry);
+}
+
+void clear_geos_cached_geometries() {
+  GeosThreadState::get().clearGeometries();
+}
 #endif
 
 namespace {
@@ -371,14 +511,49 @@ void verify_function_ir(const llvm::Function* func) {
   }
 }
 
+namespace {
+
+struct CodeCacheMetrics {
+  metrics::Counter& hits;
+  metrics::Counter& misses;
+  metrics::Counter& evictions;
+};
+
+CodeCacheMetrics make_code_cache_metrics(const std::string& labels) {
+  auto& registry = metrics::Registry::instance();
+  return {registry.counter("omnisci_code_cache_hits_total",
+                           "Code cache lookups which found a compiled kernel.",
+                           labels),
+          registry.counter("omnisci_code_cache_misses_total",
+                           "Code cache lookups which required compiling a kernel.",
+                           labels),
+          registry.counter("omnisci_code_cache_evictions_total",
+                           "Compiled kernels evicted from the code cache.",
+                           labels)};
+}
+
+CodeCacheMetrics& get_code_cache_metrics(const bool gpu) {
+  static auto cpu_metrics = make_code_cache_metrics("device=\"cpu\"");
+  static auto gpu_metrics = make_code_cache_metrics("device=\"gpu\"");
+  return gpu ? gpu_metrics : cpu_metrics;
+}
+
+}  // namespace
+
 std::shared_ptr<CompilationContext> Executor::getCodeFromCache(const CodeCacheKey& key,
                                                                const CodeCache& cache) {
   auto it = cache.find(key);
+  if (auto query_profile = getQueryProfile()) {
+    query_profile->addCodeCacheLookup(it != cache.cend());
+  }
+  auto& cache_metrics = get_code_cache_metrics(&cache == &gpu_code_cache_);
   if (it != cache.cend()) {
+    cache_metrics.hits.increment();
     delete cgen_state_->module_;
     cgen_state_->module_ = it->second.second;
     return it->second.first;
   }
+  cache_metrics.misses.increment();
   return {};
 }
 
@@ -386,9 +561,14 @@ void Executor::addCodeToCache(const CodeCacheKey& key,
                               std::shared_ptr<CompilationContext> compilation_context,
                               llvm::Module* module,
                               CodeCache& cache) {
+  const bool new_key = cache.find(key) == cache.cend();
+  const auto size_before = cache.size();
   cache.put(key,
             std::make_pair<std::shared_ptr<CompilationContext>, decltype(module)>(
                 std::move(compilation_context), std::move(module)));
+  if (new_key && cache.size() <= size_before) {
+    get_code_cache_metrics(&cache == &gpu_code_cache_).evictions.increment();
+  }
 }
 
 namespace {
@@ -776,6 +956,14 @@ declare i1 @string_like_simple(i8*, i32, i8*, i32);
 declare i1 @string_ilike_simple(i8*, i32, i8*, i32);
 declare i8 @string_like_simple_nullable(i8*, i32, i8*, i32, i8);
 declare i8 @string_ilike_simple_nullable(i8*, i32, i8*, i32, i8);
+declare i1 @string_like_prefix(i8*, i32, i8*, i32);
+declare i1 @string_ilike_prefix(i8*, i32, i8*, i32);
+declare i8 @string_like_prefix_nullable(i8*, i32, i8*, i32, i8);
+declare i8 @string_ilike_prefix_nullable(i8*, i32, i8*, i32, i8);
+declare i1 @string_like_suffix(i8*, i32, i8*, i32);
+declare i1 @string_ilike_suffix(i8*, i32, i8*, i32);
+declare i8 @string_like_suffix_nullable(i8*, i32, i8*, i32, i8);
+declare i8 @string_ilike_suffix_nullable(i8*, i32, i8*, i32, i8);
 declare i1 @string_lt(i8*, i32, i8*, i32);
 declare i1 @string_le(i8*, i32, i8*, i32);
 declare i1 @string_gt(i8*, i32, i8*, i32);
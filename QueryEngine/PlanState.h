@@ -21,6 +21,7 @@
 #include "Analyzer/Analyzer.h"
 #include "QueryEngine/Descriptors/InputDescriptors.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/PolygonIndex.h"
 
 class Executor;
 
@@ -65,6 +66,7 @@ struct PlanState {
   const DeletedColumnsMap deleted_columns_;
   const std::vector<InputTableInfo>& query_infos_;
   const Executor* executor_;
+  PolygonIndexCache polygon_index_cache_;
 
   void allocateLocalColumnIds(
       const std::list<std::shared_ptr<const InputColDescriptor>>& global_col_ids);
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+#include "Shared/mapd_shared_mutex.h"
+
+/**
+ * Horizontal slab decomposition of a single polygon ring. Every edge is bucketed into
+ * the slabs overlapped by its y-range, so a winding number probe only visits the edges
+ * of the slab holding the point rather than walking the whole ring.
+ */
+template <typename T>
+class RingSlabIndex {
+ public:
+  struct Edge {
+    T x0;
+    T y0;
+    T x1;
+    T y1;
+  };
+
+  // Takes the interleaved x, y vertex coordinates of a ring, the closing edge from the
+  // last vertex back to the first one is implied.
+  explicit RingSlabIndex(const std::vector<T>& coords) {
+    CHECK_EQ(coords.size() % 2, size_t(0));
+    const size_t num_edges = coords.size() / 2;
+    if (num_edges == 0) {
+      return;
+    }
+    auto get_edge = [&coords, num_edges](const size_t i) -> Edge {
+      const size_t j = (i + 1) % num_edges;
+      return {coords[2 * i], coords[2 * i + 1], coords[2 * j], coords[2 * j + 1]};
+    };
+
+    y_min_ = y_max_ = coords[1];
+    double total_dy{0};
+    for (size_t i = 0; i < num_edges; ++i) {
+      const auto edge = get_edge(i);
+      y_min_ = std::min(y_min_, edge.y0);
+      y_max_ = std::max(y_max_, edge.y0);
+      total_dy += std::abs(static_cast<double>(edge.y1) - static_cast<double>(edge.y0));
+    }
+
+    // The total y extent of the edges over the ring height is the average number of
+    // edges crossed by a horizontal line, which is the least number of edges any slab
+    // can hold. Size the slabs to get close to it while keeping the bucketed edge
+    // copies within a small multiple of the ring size.
+    const double height = static_cast<double>(y_max_) - static_cast<double>(y_min_);
+    size_t num_slabs{1};
+    if (height > 0) {
+      const double crossings = std::max(total_dy / height, 1.0);
+      num_slabs = std::clamp(
+          static_cast<size_t>(kEdgeCopiesPerEdge * num_edges / crossings),
+          size_t(1),
+          num_edges);
+      slab_scale_ = num_slabs / height;
+    }
+
+    offsets_.assign(num_slabs + 1, 0);
+    for (size_t i = 0; i < num_edges; ++i) {
+      const auto [first_slab, last_slab] = getSlabRange(get_edge(i));
+      for (size_t slab = first_slab; slab <= last_slab; ++slab) {
+        ++offsets_[slab + 1];
+      }
+    }
+    for (size_t slab = 0; slab < num_slabs; ++slab) {
+      offsets_[slab + 1] += offsets_[slab];
+    }
+    edges_.resize(offsets_.back());
+    auto fill_pos = offsets_;
+    for (size_t i = 0; i < num_edges; ++i) {
+      const auto edge = get_edge(i);
+      const auto [first_slab, last_slab] = getSlabRange(edge);
+      for (size_t slab = first_slab; slab <= last_slab; ++slab) {
+        edges_[fill_pos[slab]++] = edge;
+      }
+    }
+  }
+
+  // Returns the edges which may cross the horizontal line through y, in no particular
+  // order. The range is empty if y is outside of the ring.
+  std::pair<const Edge*, const Edge*> getEdges(const T y) const {
+    if (edges_.empty() || y < y_min_ || y > y_max_) {
+      return {nullptr, nullptr};
+    }
+    const auto slab = getSlab(y);
+    return {edges_.data() + offsets_[slab], edges_.data() + offsets_[slab + 1]};
+  }
+
+ private:
+  // Slab lookup is monotonic in y, so a y within the edge y-range always maps to one of
+  // the slabs the edge has been bucketed into.
+  size_t getSlab(const T y) const {
+    const auto slab = static_cast<size_t>(
+        (static_cast<double>(y) - static_cast<double>(y_min_)) * slab_scale_);
+    return std::min(slab, offsets_.size() - 2);
+  }
+
+  std::pair<size_t, size_t> getSlabRange(const Edge& edge) const {
+    return {getSlab(std::min(edge.y0, edge.y1)), getSlab(std::max(edge.y0, edge.y1))};
+  }
+
+  static constexpr size_t kEdgeCopiesPerEdge{3};
+
+  T y_min_{0};
+  T y_max_{0};
+  double slab_scale_{0};
+  std::vector<size_t> offsets_;
+  std::vector<Edge> edges_;
+};
+
+/**
+ * Prepared form of a polygon or multipolygon for point-in-polygon tests. Holds a slab
+ * index for every ring and the number of rings of every polygon, exterior ring first.
+ */
+template <typename T>
+struct PolygonIndex {
+  std::vector<RingSlabIndex<T>> rings;
+  std::vector<int32_t> poly_num_rings;
+};
+
+/**
+ * Prepared polygons of the work unit being executed. Only the polygons probed by many
+ * rows are indexed: literals, and the polygons of the inner table of a join, probed by
+ * every outer row reaching them. A polygon is keyed by an id given to the polygon
+ * argument at code generation and by its row in the inner table, zero for literals.
+ * Neither depends on where the coordinates are loaded, which changes from a kernel to
+ * another. Polygons are indexed lazily by their first probe and shared by all kernels.
+ */
+class PolygonIndexCache {
+ public:
+  using Key = std::pair<int32_t, int64_t>;
+
+  int32_t registerPolygonArg() { return next_polygon_arg_id_++; }
+
+  template <typename T, typename BUILDER>
+  const PolygonIndex<T>* getOrBuild(const Key& key, BUILDER build) {
+    auto& indexes = getIndexes<T>();
+    {
+      mapd_shared_lock<mapd_shared_mutex> read_lock(mutex_);
+      const auto it = indexes.find(key);
+      if (it != indexes.end()) {
+        return it->second.get();
+      }
+    }
+    // Build outside of the lock, kernels racing on the same polygon keep the first index
+    auto index = std::make_unique<PolygonIndex<T>>(build());
+    static auto& built_indexes = metrics::Registry::instance().counter(
+        "omnisci_polygon_indexes_built_total",
+        "Polygons indexed for point-in-polygon tests.");
+    built_indexes.increment();
+    mapd_unique_lock<mapd_shared_mutex> write_lock(mutex_);
+    return indexes.emplace(key, std::move(index)).first->second.get();
+  }
+
+ private:
+  template <typename T>
+  using IndexMap =
+      std::unordered_map<Key, std::unique_ptr<PolygonIndex<T>>, boost::hash<Key>>;
+
+  template <typename T>
+  IndexMap<T>& getIndexes() {
+    if constexpr (std::is_floating_point<T>::value) {
+      return fp_indexes_;
+    } else {
+      return compressed_indexes_;
+    }
+  }
+
+  std::atomic<int32_t> next_polygon_arg_id_{0};
+  mapd_shared_mutex mutex_;
+  IndexMap<double> fp_indexes_;
+  IndexMap<int64_t> compressed_indexes_;
+};
@@ -22,6 +22,9 @@
 #include <queue>
 #include <thread>
 
+#include "Shared/Metrics.h"
+#include "Shared/measure.h"
+
 /**
  * QueryDispatchQueue maintains a list of pending queries and dispatches those queries as
  * Executors become available
@@ -59,7 +62,8 @@ class QueryDispatchQueue {
     std::unique_lock<decltype(queue_mutex_)> lock(queue_mutex_);
 
     LOG(INFO) << "Dispatching query with " << queue_.size() << " queries in the queue.";
-    queue_.push(task);
+    queue_.push({task, timer_start()});
+    getQueueDepthGauge().set(queue_.size());
     lock.unlock();
     cv_.notify_all();
   }
@@ -86,8 +90,10 @@ class QueryDispatchQueue {
       }
 
       if (!queue_.empty()) {
-        auto task = queue_.front();
+        auto [task, enqueue_clock_begin] = queue_.front();
         queue_.pop();
+        getQueueDepthGauge().set(queue_.size());
+        getQueueWaitHistogram().observe(timer_stop(enqueue_clock_begin));
 
         LOG(INFO) << "Worker " << worker_idx
                   << " running query and returning control. There are now "
@@ -102,12 +108,27 @@ class QueryDispatchQueue {
     }
   }
 
+  static metrics::Gauge& getQueueDepthGauge() {
+    static auto& depth = metrics::Registry::instance().gauge(
+        "omnisci_dispatch_queue_depth", "Queries waiting in the dispatch queue.");
+    return depth;
+  }
+
+  static metrics::Histogram& getQueueWaitHistogram() {
+    static auto& wait = metrics::Registry::instance().histogram(
+        "omnisci_dispatch_queue_wait_ms",
+        "Time queries spent in the dispatch queue before running.");
+    return wait;
+  }
+
   std::mutex queue_mutex_;
   std::condition_variable cv_;
 
   std::mutex update_delete_mutex_;
 
   bool threads_should_exit_{false};
-  std::queue<std::shared_ptr<Task>> queue_;
+  // tasks with the time they were submitted at
+  std::queue<std::pair<std::shared_ptr<Task>, std::chrono::steady_clock::time_point>>
+      queue_;
   std::vector<std::thread> workers_;
 };
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryProfile.h"
+
+#include <algorithm>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "Logger/Logger.h"
+
+size_t QueryProfile::StepProfile::getRowsIn() const {
+  size_t rows_in{0};
+  for (const auto& kernel : kernels) {
+    rows_in += kernel.rows_in;
+  }
+  return rows_in;
+}
+
+size_t QueryProfile::StepProfile::getFragmentsSkipped() const {
+  size_t fragment_count{0};
+  for (const auto& [table_id, count] : outer_fragment_counts) {
+    fragment_count += count;
+  }
+  return fragment_count > scanned_fragments.size()
+             ? fragment_count - scanned_fragments.size()
+             : 0;
+}
+
+void QueryProfile::beginStep(const unsigned node_id, const std::string& node) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  open_steps_.push_back(steps_.size());
+  steps_.emplace_back();
+  steps_.back().node_id = node_id;
+  steps_.back().node = node;
+}
+
+void QueryProfile::endStep(const int64_t total_ms, const size_t rows_out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(!open_steps_.empty());
+  auto& step = steps_[open_steps_.back()];
+  step.total_ms = total_ms;
+  step.rows_out = rows_out;
+  open_steps_.pop_back();
+}
+
+void QueryProfile::addCompileTime(const int64_t time_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    step->compile_ms += time_ms;
+  }
+}
+
+void QueryProfile::addCodeCacheLookup(const bool hit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    ++(hit ? step->code_cache_hits : step->code_cache_misses);
+  }
+}
+
+void QueryProfile::setOuterFragmentCount(const int table_id,
+                                         const size_t fragment_count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    auto& count = step->outer_fragment_counts[table_id];
+    count = std::max(count, fragment_count);
+  }
+}
+
+void QueryProfile::addKernel(const int outer_table_id, KernelProfile&& kernel) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    for (const auto fragment_id : kernel.fragment_ids) {
+      step->scanned_fragments.emplace(outer_table_id, fragment_id);
+    }
+    step->kernels.push_back(std::move(kernel));
+  }
+}
+
+void QueryProfile::addReductionTime(const int64_t time_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    step->reduction_ms += time_ms;
+  }
+}
+
+void QueryProfile::addBytesFetched(const Data_Namespace::MemoryLevel memory_level,
+                                   const size_t num_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto step = getCurrentStep()) {
+    step->bytes_fetched[memory_level] += num_bytes;
+  }
+}
+
+void QueryProfile::setResultConversionTime(const int64_t time_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  result_conversion_ms_ = time_ms;
+}
+
+std::vector<QueryProfile::StepProfile> QueryProfile::getSteps() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return steps_;
+}
+
+std::string QueryProfile::toString() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("steps");
+  writer.StartArray();
+  for (const auto& step : steps_) {
+    writer.StartObject();
+    writer.Key("node_id");
+    writer.Uint(step.node_id);
+    writer.Key("node");
+    writer.String(step.node.c_str());
+    writer.Key("total_ms");
+    writer.Int64(step.total_ms);
+    writer.Key("compile_ms");
+    writer.Int64(step.compile_ms);
+    writer.Key("code_cache_hits");
+    writer.Uint64(step.code_cache_hits);
+    writer.Key("code_cache_misses");
+    writer.Uint64(step.code_cache_misses);
+    writer.Key("fragments_scanned");
+    writer.Uint64(step.scanned_fragments.size());
+    writer.Key("fragments_skipped");
+    writer.Uint64(step.getFragmentsSkipped());
+    writer.Key("rows_in");
+    writer.Uint64(step.getRowsIn());
+    writer.Key("rows_out");
+    writer.Uint64(step.rows_out);
+    writer.Key("reduction_ms");
+    writer.Int64(step.reduction_ms);
+    writer.Key("bytes_fetched");
+    writer.StartObject();
+    writer.Key("disk");
+    writer.Uint64(step.bytes_fetched[Data_Namespace::DISK_LEVEL]);
+    writer.Key("cpu");
+    writer.Uint64(step.bytes_fetched[Data_Namespace::CPU_LEVEL]);
+    writer.Key("gpu");
+    writer.Uint64(step.bytes_fetched[Data_Namespace::GPU_LEVEL]);
+    writer.EndObject();
+    writer.Key("kernels");
+    writer.StartArray();
+    for (const auto& kernel : step.kernels) {
+      writer.StartObject();
+      writer.Key("device_type");
+      writer.String(kernel.device_type == ExecutorDeviceType::GPU ? "GPU" : "CPU");
+      writer.Key("device_id");
+      writer.Int(kernel.device_id);
+      writer.Key("thread_idx");
+      writer.Uint64(kernel.thread_idx);
+      writer.Key("fragment_ids");
+      writer.StartArray();
+      for (const auto fragment_id : kernel.fragment_ids) {
+        writer.Uint64(fragment_id);
+      }
+      writer.EndArray();
+      writer.Key("rows_in");
+      writer.Uint64(kernel.rows_in);
+      writer.Key("time_ms");
+      writer.Int64(kernel.time_ms);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.Key("result_conversion_ms");
+  writer.Int64(result_conversion_ms_);
+  writer.EndObject();
+  return buffer.GetString();
+}
+
+QueryProfile::StepProfile* QueryProfile::getCurrentStep() {
+  return open_steps_.empty() ? nullptr : &steps_[open_steps_.back()];
+}
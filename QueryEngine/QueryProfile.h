@@ -0,0 +1,99 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryProfile.h
+ * @brief   Runtime profile of a query collected for EXPLAIN ANALYZE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataMgr/MemoryLevel.h"
+#include "QueryEngine/CompilationOptions.h"
+
+/**
+ * Collects the runtime profile of every relational algebra step of a query. The profile
+ * is attached to the executor for the duration of the query and written to by the
+ * compilation, kernel, reduction and column fetch paths, possibly from several kernel
+ * threads at once. Statistics recorded outside of a step are dropped.
+ */
+class QueryProfile {
+ public:
+  struct KernelProfile {
+    ExecutorDeviceType device_type;
+    int device_id;
+    size_t thread_idx;
+    std::vector<size_t> fragment_ids;
+    size_t rows_in;
+    int64_t time_ms;
+  };
+
+  struct StepProfile {
+    unsigned node_id;
+    std::string node;
+    int64_t total_ms{0};
+    int64_t compile_ms{0};
+    int64_t reduction_ms{0};
+    size_t code_cache_hits{0};
+    size_t code_cache_misses{0};
+    // outer table id to its number of fragments and the fragments actually scanned
+    std::map<int, size_t> outer_fragment_counts;
+    std::set<std::pair<int, size_t>> scanned_fragments;
+    size_t rows_out{0};
+    std::vector<KernelProfile> kernels;
+    // indexed by the Data_Namespace::MemoryLevel the chunks were fetched from
+    std::array<size_t, 3> bytes_fetched{};
+
+    size_t getRowsIn() const;
+    size_t getFragmentsSkipped() const;
+  };
+
+  // Steps may nest, e.g. a subquery executed while its parent step is open. Statistics
+  // go to the innermost open step.
+  void beginStep(const unsigned node_id, const std::string& node);
+  void endStep(const int64_t total_ms, const size_t rows_out);
+
+  void addCompileTime(const int64_t time_ms);
+  void addCodeCacheLookup(const bool hit);
+  void setOuterFragmentCount(const int table_id, const size_t fragment_count);
+  void addKernel(const int outer_table_id, KernelProfile&& kernel);
+  void addReductionTime(const int64_t time_ms);
+  void addBytesFetched(const Data_Namespace::MemoryLevel memory_level,
+                       const size_t num_bytes);
+  void setResultConversionTime(const int64_t time_ms);
+
+  std::vector<StepProfile> getSteps() const;
+
+  // Serializes the profile as a JSON document, one entry per step in execution order.
+  std::string toString() const;
+
+ private:
+  StepProfile* getCurrentStep();
+
+  mutable std::mutex mutex_;
+  std::vector<StepProfile> steps_;
+  std::vector<size_t> open_steps_;
+  int64_t result_conversion_ms_{0};
+};
@@ -35,6 +35,7 @@
 
 extern bool g_cluster;
 extern bool g_enable_union;
+extern bool g_enable_filter_project_fusion;
 
 namespace {
 
@@ -2630,6 +2631,9 @@ void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
   simplify_sort(nodes_);
   sink_projected_boolean_expr_to_join(nodes_);
   eliminate_identical_copy(nodes_);
+  if (g_enable_filter_project_fusion) {
+    sink_filters_below_projects(nodes_);
+  }
   fold_filters(nodes_);
   std::vector<const RelAlgNode*> filtered_left_deep_joins;
   std::vector<const RelAlgNode*> left_deep_joins;
@@ -21,12 +21,14 @@
 #include "QueryEngine/CalciteDeserializerUtils.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/DeepCopyVisitor.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/ExtensionFunctionsBinding.h"
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/FromTableReordering.h"
+#include "QueryEngine/MurmurHash.h"
 #include "QueryEngine/QueryPhysicalInputsCollector.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
@@ -34,7 +36,9 @@
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "QueryEngine/Visitors/RexSubQueryIdCollector.h"
 #include "QueryEngine/WindowContext.h"
+#include "Shared/Metrics.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
 #include "Shared/misc.h"
@@ -44,17 +48,28 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <numeric>
 
 bool g_skip_intermediate_count{true};
 bool g_enable_interop{false};
 bool g_enable_union{false};
+bool g_enable_concurrent_subqueries{false};
+bool g_enable_filter_project_fusion{true};
+size_t g_max_groupby_retry_partitions{64};
+size_t g_groupby_partition_bytes{64 * 1024 * 1024};
 
 extern bool g_enable_bump_allocator;
 
 namespace {
 
+// Stride between the executor ids of the query executors and the ids of the executors
+// they own for running subqueries concurrently, see executeSubqueries()
+constexpr Executor::ExecutorId kSubqueryExecutorIdBase{1 << 16};
+
 bool node_is_aggregate(const RelAlgNode* ra) {
   const auto compound = dynamic_cast<const RelCompound*>(ra);
   const auto aggregate = dynamic_cast<const RelAggregate*>(ra);
@@ -354,6 +369,10 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   // so we acquire executor lock in here to make sure that this executor holds
   // all necessary resources and at the same time protect them against other executor
   auto lock = acquire_execute_mutex(executor_);
+  // the profile is only attached while holding the execute mutex, queries queued on the
+  // same executor must not record into it
+  executor_->query_profile_ = query_profile_;
+  ScopeGuard detach_query_profile = [this] { executor_->query_profile_.reset(); };
 
   if (!render_info && !query_session.empty() && eo.allow_runtime_query_interrupt &&
       !validate_or_explain_query) {
@@ -444,19 +463,122 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   timer_setup.stop();
 
   // Dispatch the subqueries first
+  executeSubqueries(co, eo);
+  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+}
+
+void RelAlgExecutor::executeSubqueries(const CompilationOptions& co,
+                                       const ExecutionOptions& eo) {
+  std::vector<std::shared_ptr<RexSubQuery>> pending_subqueries;
   for (auto subquery : getSubqueries()) {
     const auto subquery_ra = subquery->getRelAlg();
     CHECK(subquery_ra);
-    if (subquery_ra->hasContextData()) {
-      continue;
+    if (!subquery_ra->hasContextData()) {
+      pending_subqueries.push_back(subquery);
     }
+  }
+
+  auto execute_subquery = [this, &co, &eo](Executor* executor,
+                                           const std::shared_ptr<RexSubQuery>& subquery) {
     // Execute the subquery and cache the result.
-    RelAlgExecutor ra_executor(executor_, cat_, query_state_);
-    RaExecutionSequence subquery_seq(subquery_ra);
+    RelAlgExecutor ra_executor(executor, cat_, query_state_);
+    RaExecutionSequence subquery_seq(subquery->getRelAlg());
     auto result = ra_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
     subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
+  };
+
+  if (!g_enable_concurrent_subqueries || pending_subqueries.size() < 2) {
+    for (const auto& subquery : pending_subqueries) {
+      execute_subquery(executor_, subquery);
+    }
+    return;
+  }
+
+  // A subquery can only run once the subqueries nested in it have their results, run
+  // the subqueries in waves of the ones with no pending nested subquery.
+  std::unordered_map<unsigned, RexSubQueryIdCollector::Ids> nested_subquery_ids;
+  std::unordered_set<unsigned> pending_subquery_ids;
+  for (const auto& subquery : pending_subqueries) {
+    nested_subquery_ids.emplace(
+        subquery->getId(),
+        RexSubQueryIdCollector::getLiveRexSubQueryIds(subquery->getRelAlg()));
+    pending_subquery_ids.insert(subquery->getId());
+  }
+
+  // The subqueries of a wave share the CPU budget of the query. The first one runs on the
+  // executor of the query, every other one on an executor owned by it for the duration
+  // of the query, with an id derived from the query executor id so that it cannot be
+  // used by any other query.
+  const size_t max_concurrent_subqueries =
+      std::min(pending_subqueries.size(), static_cast<size_t>(cpu_threads()));
+  std::vector<std::shared_ptr<Executor>> subquery_executors;
+  for (size_t i = 1; i < max_concurrent_subqueries; ++i) {
+    CHECK_LT(i, kSubqueryExecutorIdBase);
+    SystemParameters system_parameters;
+    system_parameters.cuda_block_size = executor_->block_size_x_;
+    system_parameters.cuda_grid_size = executor_->grid_size_x_;
+    system_parameters.max_gpu_slab_size = executor_->max_gpu_slab_size_;
+    subquery_executors.push_back(Executor::getExecutor(
+        (executor_->getExecutorId() + 1) * kSubqueryExecutorIdBase + i,
+        executor_->debug_dir_,
+        executor_->debug_file_,
+        system_parameters));
+  }
+
+  // The subquery executors see the same tables, column ranges and string dictionary
+  // generations as the query executor and allocate from its row set memory owner, so
+  // their results can be consumed by the query.
+  for (const auto& subquery_executor : subquery_executors) {
+    subquery_executor->setCatalog(&cat_);
+    subquery_executor->row_set_mem_owner_ = executor_->row_set_mem_owner_;
+    subquery_executor->agg_col_range_cache_ = executor_->agg_col_range_cache_;
+    subquery_executor->table_generations_ = executor_->table_generations_;
+  }
+  ScopeGuard reset_subquery_executors = [&subquery_executors] {
+    for (const auto& subquery_executor : subquery_executors) {
+      subquery_executor->row_set_mem_owner_ = nullptr;
+      subquery_executor->clearMetaInfoCache();
+    }
+  };
+
+  while (!pending_subqueries.empty()) {
+    std::vector<std::shared_ptr<RexSubQuery>> ready_subqueries;
+    std::vector<std::shared_ptr<RexSubQuery>> blocked_subqueries;
+    for (const auto& subquery : pending_subqueries) {
+      const auto& nested_ids = nested_subquery_ids[subquery->getId()];
+      const bool is_ready = std::none_of(
+          nested_ids.begin(), nested_ids.end(), [&pending_subquery_ids](const auto id) {
+            return pending_subquery_ids.count(id);
+          });
+      (is_ready ? ready_subqueries : blocked_subqueries).push_back(subquery);
+    }
+    CHECK(!ready_subqueries.empty());
+
+    VLOG(1) << "Executing " << ready_subqueries.size() << " independent subqueries";
+    for (size_t batch_start = 0; batch_start < ready_subqueries.size();
+         batch_start += max_concurrent_subqueries) {
+      const auto batch_end =
+          std::min(batch_start + max_concurrent_subqueries, ready_subqueries.size());
+      std::vector<std::future<void>> subquery_futures;
+      for (size_t i = batch_start + 1; i < batch_end; ++i) {
+        auto subquery_executor = subquery_executors[i - batch_start - 1].get();
+        const auto& subquery = ready_subqueries[i];
+        subquery_futures.emplace_back(std::async(
+            std::launch::async, [&execute_subquery, subquery_executor, subquery] {
+              execute_subquery(subquery_executor, subquery);
+            }));
+      }
+      execute_subquery(executor_, ready_subqueries[batch_start]);
+      for (auto& subquery_future : subquery_futures) {
+        subquery_future.get();
+      }
+    }
+
+    for (const auto& subquery : ready_subqueries) {
+      pending_subquery_ids.erase(subquery->getId());
+    }
+    pending_subqueries.swap(blocked_subqueries);
   }
-  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
 }
 
 AggregatedColRange RelAlgExecutor::computeColRangesCache() {
@@ -694,6 +816,22 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
   CHECK(exec_desc_ptr);
   auto& exec_desc = *exec_desc_ptr;
   const auto body = exec_desc.getBody();
+  auto query_profile = executor_->getQueryProfile();
+  if (query_profile) {
+    query_profile->beginStep(body->getId(), body->toString());
+  }
+  auto step_clock_begin = timer_start();
+  ScopeGuard end_profile_step = [query_profile, &exec_desc, &step_clock_begin] {
+    if (!query_profile) {
+      return;
+    }
+    const auto& result = exec_desc.getResult();
+    size_t rows_out{0};
+    if (!result.empty() && result.getTable().getFragCount() == 1 && result.getRows()) {
+      rows_out = result.getRows()->rowCount();
+    }
+    query_profile->endStep(timer_stop(step_clock_begin), rows_out);
+  };
   if (body->isNop()) {
     handleNop(exec_desc);
     return;
@@ -2746,6 +2884,43 @@ size_t groups_approx_upper_bound(const std::vector<InputTableInfo>& table_infos)
   return std::max(max_num_groups, size_t(1));
 }
 
+// Baseline hash entries hold the keys followed by one 8-byte slot per target, two for
+// AVG.
+size_t get_groupby_entry_bytes(const RelAlgExecutionUnit& ra_exe_unit) {
+  size_t entry_bytes = ra_exe_unit.groupby_exprs.size() * sizeof(int64_t);
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    entry_bytes +=
+        (agg_expr && agg_expr->get_aggtype() == kAVG ? 2 : 1) * sizeof(int64_t);
+  }
+  return entry_bytes;
+}
+
+/**
+ * Returns the number of key partitions a CPU group by with the given groups buffer entry
+ * estimate gets aggregated in, such that the hash table of a partition fits in
+ * g_groupby_partition_bytes. Probing a hash table much larger than the CPU caches misses
+ * them on almost every row, while the partitions add a single projection of the input,
+ * see RelAlgExecutor::executePartitionedGroupBy(). Returns 1 if the group by isn't worth
+ * partitioning or g_groupby_partition_bytes is 0.
+ */
+size_t get_groupby_partition_count(const RelAlgExecutionUnit& ra_exe_unit,
+                                   const size_t groups_buffer_entry_guess,
+                                   const ExecutorDeviceType device_type) {
+  if (!g_groupby_partition_bytes || device_type != ExecutorDeviceType::CPU ||
+      ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front()) {
+    return 1;
+  }
+  const auto hash_table_bytes =
+      groups_buffer_entry_guess * get_groupby_entry_bytes(ra_exe_unit);
+  size_t partition_count{1};
+  while (2 * partition_count <= g_max_groupby_retry_partitions &&
+         hash_table_bytes / partition_count > g_groupby_partition_bytes) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
 /**
  * Determines whether a query needs to compute the size of its output buffer. Returns
  * true for projection queries with no LIMIT or a LIMIT that exceeds the high scan limit
@@ -2974,6 +3149,21 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
                                          column_cache),
               targets_meta};
     } catch (const QueryExecutionError& e) {
+      if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM && !render_info &&
+          co.device_type == ExecutorDeviceType::CPU) {
+        // the groups of a CPU group by may still fit in host memory a partition at a time
+        auto partitioned_result =
+            executePartitionedGroupBy(ra_exe_unit,
+                                      table_infos,
+                                      targets_meta,
+                                      co,
+                                      eo,
+                                      local_groups_buffer_entry_guess,
+                                      2);
+        if (partitioned_result) {
+          return *partitioned_result;
+        }
+      }
       handlePersistentError(e.getErrorCode());
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
@@ -2987,12 +3177,34 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   };
 
+  // Group by queries with too many groups for their hash tables to stay in the CPU
+  // caches get aggregated in key partitions, see get_groupby_partition_count().
+  auto execute_with_cardinality_estimation =
+      [&](const size_t groups_buffer_entry_guess) -> ExecutionResult {
+    const auto partition_count = get_groupby_partition_count(
+        ra_exe_unit, groups_buffer_entry_guess, co.device_type);
+    if (partition_count > 1 && !render_info && !eo.just_explain && !eo.just_validate) {
+      auto partitioned_result = executePartitionedGroupBy(
+          ra_exe_unit,
+          table_infos,
+          targets_meta,
+          co,
+          eo,
+          groups_buffer_entry_guess,
+          partition_count);
+      if (partitioned_result) {
+        return *partitioned_result;
+      }
+    }
+    return execute_and_handle_errors(groups_buffer_entry_guess, true);
+  };
+
   auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
     if (cached_cardinality.first && card >= 0) {
-      result = execute_and_handle_errors(card, true);
+      result = execute_with_cardinality_estimation(card);
     } else {
       result = execute_and_handle_errors(
           max_groups_buffer_entry_guess,
@@ -3003,13 +3215,13 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
     if (cached_cardinality.first && card >= 0) {
-      result = execute_and_handle_errors(card, true);
+      result = execute_with_cardinality_estimation(card);
     } else {
       const auto estimated_groups_buffer_entry_guess =
           2 * std::min(groups_approx_upper_bound(table_infos),
                        getNDVEstimation(work_unit, e.range(), is_agg, co, eo));
       CHECK_GT(estimated_groups_buffer_entry_guess, size_t(0));
-      result = execute_and_handle_errors(estimated_groups_buffer_entry_guess, true);
+      result = execute_with_cardinality_estimation(estimated_groups_buffer_entry_guess);
       if (!(eo.just_validate || eo.just_explain)) {
         executor_->addToCardinalityCache(cache_key, estimated_groups_buffer_entry_guess);
       }
@@ -3229,14 +3441,43 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
         CHECK(max_groups_buffer_entry_guess);
         // Only allow two iterations of increasingly large entry guesses up to a maximum
         // of 512MB per column per kernel
-        if (g_enable_watchdog || iteration_ctr > 1) {
+        if (g_enable_watchdog) {
           throw std::runtime_error("Query ran out of output slots in the result");
         }
+        if (iteration_ctr > 1) {
+          auto partitioned_result =
+              executePartitionedGroupBy(ra_exe_unit,
+                                        table_infos,
+                                        targets_meta,
+                                        co_cpu,
+                                        eo_no_multifrag,
+                                        max_groups_buffer_entry_guess,
+                                        2);
+          if (!partitioned_result) {
+            throw std::runtime_error("Query ran out of output slots in the result");
+          }
+          partitioned_result->setQueueTime(queue_time_ms);
+          return *partitioned_result;
+        }
         max_groups_buffer_entry_guess *= 2;
         LOG(WARNING) << "Query ran out of slots in the output buffer, retrying with max "
                         "groups buffer entry "
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
+      } else if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM) {
+        auto partitioned_result =
+            executePartitionedGroupBy(ra_exe_unit,
+                                      table_infos,
+                                      targets_meta,
+                                      co_cpu,
+                                      eo_no_multifrag,
+                                      max_groups_buffer_entry_guess,
+                                      2);
+        if (partitioned_result) {
+          partitioned_result->setQueueTime(queue_time_ms);
+          return *partitioned_result;
+        }
+        handlePersistentError(e.getErrorCode());
       } else {
         handlePersistentError(e.getErrorCode());
       }
@@ -3248,6 +3489,551 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+namespace {
+
+// Id of the temporary table holding the partitions of the input of a group by, away from
+// the ids of the temporary tables holding the results of the query steps.
+constexpr int kGroupByPartitionsTableId{std::numeric_limits<int32_t>::min() / 2};
+
+// Rewrites the column references of the group by targets to the columns of the table
+// holding the partitions, where they follow the group by keys. Collects the referenced
+// columns for the projection which fills the partitions.
+class GroupByPartitionColumnRewriter : public DeepCopyVisitor {
+ public:
+  GroupByPartitionColumnRewriter(const size_t key_count) : key_count_(key_count) {}
+
+  const std::vector<std::shared_ptr<Analyzer::Expr>>& getColumns() const {
+    return columns_;
+  }
+
+ protected:
+  RetType visitColumnVar(const Analyzer::ColumnVar* col_var) const override {
+    const auto col_key = std::make_tuple(
+        col_var->get_table_id(), col_var->get_column_id(), col_var->get_rte_idx());
+    auto it = col_ids_.find(col_key);
+    if (it == col_ids_.end()) {
+      it = col_ids_.emplace(col_key, key_count_ + columns_.size()).first;
+      columns_.push_back(col_var->deep_copy());
+    }
+    return makeExpr<Analyzer::ColumnVar>(
+        col_var->get_type_info(), kGroupByPartitionsTableId, it->second, 0);
+  }
+
+ private:
+  const size_t key_count_;
+  mutable std::map<std::tuple<int, int, int>, int> col_ids_;
+  mutable std::vector<std::shared_ptr<Analyzer::Expr>> columns_;
+};
+
+// The partitions hold fixed width values only, in 8-byte slots.
+bool is_partitionable_type(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_decimal() || ti.is_time() || ti.is_boolean() ||
+         ti.is_fp() || (ti.is_string() && ti.get_compression() == kENCODING_DICT);
+}
+
+// Returns the slot of a row of a column batch as a row-wise projection kernel stores it:
+// integers and string ids sign extended, floating point numbers as doubles.
+int64_t get_partition_slot(const ResultSetColumnBatch& column, const size_t row) {
+  double fp_value{0};
+  switch (column.format) {
+    case ResultSetColumnBatch::Format::Int:
+      return column.isNull(row) ? inline_int_null_val(column.type)
+                                : column.int_values[row];
+    case ResultSetColumnBatch::Format::Fp:
+      fp_value =
+          column.isNull(row) ? inline_fp_null_val(column.type) : column.fp_values[row];
+      break;
+    case ResultSetColumnBatch::Format::TargetValue: {
+      const auto scalar_value =
+          boost::get<ScalarTargetValue>(&column.target_values[row]);
+      CHECK(scalar_value);
+      if (const auto int_value = boost::get<int64_t>(scalar_value)) {
+        return *int_value;
+      }
+      if (const auto float_value = boost::get<float>(scalar_value)) {
+        fp_value = *float_value;
+      } else {
+        const auto double_value = boost::get<double>(scalar_value);
+        CHECK(double_value);
+        fp_value = *double_value;
+      }
+      break;
+    }
+  }
+  int64_t slot;
+  std::memcpy(&slot, &fp_value, sizeof(slot));
+  return slot;
+}
+
+// The rows of a partition are a key slot, which only marks the entry as used, followed
+// by one slot per column. A partition holds its rows in chunks, one per scatter worker.
+using PartitionSlots = std::vector<std::vector<int64_t>>;
+
+void append_partition_row(std::vector<int64_t>& chunk_slots,
+                          const int64_t* row_slots,
+                          const size_t col_count) {
+  chunk_slots.push_back(chunk_slots.size() / (col_count + 1));
+  chunk_slots.insert(chunk_slots.end(), row_slots, row_slots + col_count);
+}
+
+uint64_t get_partition_hash(const int64_t* row_slots, const size_t key_count) {
+  return MurmurHash64A(row_slots, key_count * sizeof(int64_t), 0);
+}
+
+// Scatters the rows of a projection in the partitions on the first partition_bits bits
+// of the hashes of their keys. The workers, up to one per chunk of the partitions, fetch
+// batches from the shared cursor of the rows and append to their own chunk of every
+// partition.
+void scatter_partition_rows(const ResultSet& rows,
+                            const size_t key_count,
+                            const size_t partition_bits,
+                            std::vector<PartitionSlots>& partitions_slots) {
+  CHECK_GE(partition_bits, size_t(1));
+  CHECK_EQ(partitions_slots.size(), size_t(1) << partition_bits);
+  const size_t col_count = rows.colCount();
+  const size_t worker_count = std::max(
+      std::min(partitions_slots.front().size(),
+               rows.entryCount() / ResultSet::kDefaultBatchRowCount),
+      size_t(1));
+  std::vector<std::future<void>> scatter_threads;
+  for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+    scatter_threads.push_back(std::async(std::launch::async, [&, worker_idx] {
+      std::vector<int64_t> row_slots(col_count);
+      while (true) {
+        const auto batch = rows.getNextBatch(
+            ResultSet::kDefaultBatchRowCount, /*translate_strings=*/false, false);
+        if (batch.empty()) {
+          break;
+        }
+        for (size_t row = 0; row < batch.row_count; ++row) {
+          for (size_t col = 0; col < col_count; ++col) {
+            row_slots[col] = get_partition_slot(batch.columns[col], row);
+          }
+          const auto hash = get_partition_hash(row_slots.data(), key_count);
+          append_partition_row(
+              partitions_slots[hash >> (64 - partition_bits)][worker_idx],
+              row_slots.data(),
+              col_count);
+        }
+      }
+    }));
+  }
+  for (auto& scatter_thread : scatter_threads) {
+    scatter_thread.wait();
+  }
+  for (auto& scatter_thread : scatter_threads) {
+    scatter_thread.get();
+  }
+}
+
+// Builds a partition as a row-wise projection result set, laid out like the output of a
+// projection kernel.
+ResultSetPtr make_partition_result_set(const PartitionSlots& partition_slots,
+                                       const std::vector<TargetInfo>& targets,
+                                       const Executor* executor,
+                                       const Catalog_Namespace::Catalog& cat) {
+  const size_t row_slot_count = targets.size() + 1;
+  size_t slot_count{0};
+  for (const auto& chunk_slots : partition_slots) {
+    CHECK_EQ(chunk_slots.size() % row_slot_count, size_t(0));
+    slot_count += chunk_slots.size();
+  }
+  QueryMemoryDescriptor query_mem_desc(
+      QueryDescriptionType::Projection, 0, 0, false, {sizeof(int64_t)});
+  query_mem_desc.setEntryCount(slot_count / row_slot_count);
+  for (size_t i = 0; i < targets.size(); ++i) {
+    query_mem_desc.addColSlotInfo({std::make_tuple(8, 8)});
+  }
+  CHECK_EQ(query_mem_desc.getRowSize(), row_slot_count * sizeof(int64_t));
+  auto rows = std::make_shared<ResultSet>(targets,
+                                          ExecutorDeviceType::CPU,
+                                          query_mem_desc,
+                                          executor->getRowSetMemoryOwner(),
+                                          &cat,
+                                          executor->blockSize(),
+                                          executor->gridSize());
+  if (slot_count) {
+    auto buffer = reinterpret_cast<int64_t*>(
+        rows->allocateStorage()->getUnderlyingBuffer());
+    for (const auto& chunk_slots : partition_slots) {
+      std::memcpy(buffer, chunk_slots.data(), chunk_slots.size() * sizeof(int64_t));
+      buffer += chunk_slots.size();
+    }
+  }
+  return rows;
+}
+
+struct GroupByPartition {
+  ResultSetPtr rows;
+  // the partition holds the rows whose key hashes start with the same hash_bits bits
+  size_t hash_bits;
+};
+
+// Splits a partition in two on the next bit of the key hashes.
+std::pair<GroupByPartition, GroupByPartition> split_partition(
+    const GroupByPartition& partition,
+    const size_t key_count,
+    const Executor* executor,
+    const Catalog_Namespace::Catalog& cat) {
+  const auto& targets = partition.rows->getTargetInfos();
+  const size_t col_count = targets.size();
+  std::array<PartitionSlots, 2> children_slots{PartitionSlots(1), PartitionSlots(1)};
+  if (partition.rows->getStorage()) {
+    const auto slots = reinterpret_cast<const int64_t*>(
+        partition.rows->getStorage()->getUnderlyingBuffer());
+    for (size_t entry = 0; entry < partition.rows->entryCount(); ++entry) {
+      const auto row_slots = slots + entry * (col_count + 1) + 1;
+      const auto hash = get_partition_hash(row_slots, key_count);
+      append_partition_row(
+          children_slots[(hash >> (63 - partition.hash_bits)) & 1].front(),
+          row_slots,
+          col_count);
+    }
+  }
+  return {{make_partition_result_set(children_slots[0], targets, executor, cat),
+           partition.hash_bits + 1},
+          {make_partition_result_set(children_slots[1], targets, executor, cat),
+           partition.hash_bits + 1}};
+}
+
+size_t log2_floor(size_t n) {
+  size_t bits{0};
+  while (n >>= 1) {
+    ++bits;
+  }
+  return bits;
+}
+
+// Returns the number of partitions, a power of two, for the hash tables of the
+// partitions aggregated at once, one per CPU thread, to fit in available_bytes.
+size_t get_groupby_memory_partition_count(const RelAlgExecutionUnit& ra_exe_unit,
+                                          const size_t groups_buffer_entry_guess,
+                                          const size_t available_bytes) {
+  const auto hash_table_bytes =
+      groups_buffer_entry_guess * get_groupby_entry_bytes(ra_exe_unit);
+  const size_t kernel_count = cpu_threads();
+  size_t partition_count{1};
+  while (2 * partition_count <= g_max_groupby_retry_partitions &&
+         hash_table_bytes / partition_count * std::min(kernel_count, partition_count) >
+             available_bytes) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
+}  // namespace
+
+std::optional<ExecutionResult> RelAlgExecutor::executePartitionedGroupBy(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    const size_t max_groups_buffer_entry_guess,
+    const size_t partition_count) {
+  CHECK_GE(partition_count, size_t(2));
+  if (g_max_groupby_retry_partitions < 2 || ra_exe_unit.union_all ||
+      ra_exe_unit.estimator || ra_exe_unit.groupby_exprs.empty() ||
+      !ra_exe_unit.groupby_exprs.front()) {
+    return std::nullopt;
+  }
+  auto timer = DEBUG_TIMER(__func__);
+
+  // The group by keys and the columns the targets reference get projected once, with the
+  // filters and the joins of the work unit, then scattered in partitions on the hash of
+  // the whole key. The partitions are the fragments of a temporary table the group by
+  // runs on.
+  const size_t key_count = ra_exe_unit.groupby_exprs.size();
+  GroupByPartitionColumnRewriter rewriter(key_count);
+  std::vector<Analyzer::Expr*> partition_target_exprs;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    target_exprs_owned_.push_back(rewriter.visit(target_expr));
+    partition_target_exprs.push_back(target_exprs_owned_.back().get());
+  }
+  std::vector<Analyzer::Expr*> projected_exprs;
+  std::list<std::shared_ptr<Analyzer::Expr>> partition_groupby_exprs;
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    target_exprs_owned_.push_back(groupby_expr->deep_copy());
+    projected_exprs.push_back(target_exprs_owned_.back().get());
+    partition_groupby_exprs.push_back(
+        makeExpr<Analyzer::ColumnVar>(groupby_expr->get_type_info(),
+                                      kGroupByPartitionsTableId,
+                                      partition_groupby_exprs.size(),
+                                      0));
+  }
+  for (const auto& column : rewriter.getColumns()) {
+    target_exprs_owned_.push_back(column);
+    projected_exprs.push_back(column.get());
+  }
+  for (const auto projected_expr : projected_exprs) {
+    if (!is_partitionable_type(projected_expr->get_type_info())) {
+      return std::nullopt;
+    }
+  }
+
+  const RelAlgExecutionUnit projection_exe_unit{ra_exe_unit.input_descs,
+                                                ra_exe_unit.input_col_descs,
+                                                ra_exe_unit.simple_quals,
+                                                ra_exe_unit.quals,
+                                                ra_exe_unit.join_quals,
+                                                {nullptr},
+                                                projected_exprs,
+                                                nullptr,
+                                                {{}, SortAlgorithm::Default, 0, 0},
+                                                0,
+                                                ra_exe_unit.query_hint,
+                                                false,
+                                                std::nullopt,
+                                                ra_exe_unit.query_state};
+  // the partitions are filled from the values, not from lazily fetched row positions
+  auto projection_co = co;
+  projection_co.allow_lazy_fetch = false;
+
+  // Enough partitions for the hash tables of the partitions aggregated at once to fit in
+  // the host memory the partitions of the input leave available, unless it's unknown.
+  const auto& outer_table_info = table_infos.front().info;
+  const size_t input_bytes = outer_table_info.getNumTuplesUpperBound() *
+                             (projected_exprs.size() + 1) * sizeof(int64_t);
+  const auto free_bytes = cat_.getDataMgr().getSystemMemoryUsage().free;
+  const size_t available_bytes = free_bytes > input_bytes ? free_bytes - input_bytes : 0;
+  const auto memory_partition_count =
+      free_bytes ? get_groupby_memory_partition_count(
+                       ra_exe_unit, max_groups_buffer_entry_guess, available_bytes)
+                 : size_t(1);
+  const auto partition_bits =
+      log2_floor(std::max(partition_count, memory_partition_count));
+
+  // The fragments of the outer table get projected a batch at a time, one per CPU
+  // thread, and scattered before the next batch, so that the input is only held whole
+  // in the partitions.
+  std::vector<size_t> outer_fragment_indices = eo.outer_fragment_indices;
+  if (outer_fragment_indices.empty()) {
+    outer_fragment_indices.resize(outer_table_info.fragments.size());
+    std::iota(outer_fragment_indices.begin(), outer_fragment_indices.end(), 0);
+  }
+  const size_t batch_fragment_count = cpu_threads();
+  std::vector<PartitionSlots> partitions_slots(size_t(1) << partition_bits,
+                                               PartitionSlots(batch_fragment_count));
+  std::vector<TargetInfo> targets;
+  for (size_t batch_begin = 0; batch_begin < outer_fragment_indices.size();
+       batch_begin += batch_fragment_count) {
+    const auto batch_end =
+        std::min(batch_begin + batch_fragment_count, outer_fragment_indices.size());
+    const ExecutionOptions projection_eo{
+        eo.output_columnar_hint,
+        eo.allow_multifrag,
+        false,
+        eo.allow_loop_joins,
+        eo.with_watchdog,
+        eo.jit_debug,
+        false,
+        eo.with_dynamic_watchdog,
+        eo.dynamic_watchdog_time_limit,
+        false,
+        false,
+        eo.gpu_input_mem_limit_percent,
+        eo.allow_runtime_query_interrupt,
+        eo.running_query_interrupt_freq,
+        eo.pending_query_interrupt_freq,
+        eo.executor_type,
+        {outer_fragment_indices.begin() + batch_begin,
+         outer_fragment_indices.begin() + batch_end}};
+    ResultSetPtr projected_rows;
+    try {
+      size_t projection_entry_guess{0};
+      ColumnCacheMap column_cache;
+      auto projected_table = executor_->executeWorkUnit(projection_entry_guess,
+                                                        false,
+                                                        table_infos,
+                                                        projection_exe_unit,
+                                                        projection_co,
+                                                        projection_eo,
+                                                        cat_,
+                                                        nullptr,
+                                                        false,
+                                                        column_cache);
+      CHECK_EQ(projected_table.getFragCount(), 1);
+      projected_rows = projected_table[0];
+    } catch (const QueryExecutionError& e) {
+      LOG(INFO) << "Unable to project the input of the partitioned group by: "
+                << getErrorMessageFromCode(e.getErrorCode());
+      return std::nullopt;
+    }
+    if (targets.empty()) {
+      targets = projected_rows->getTargetInfos();
+      CHECK_EQ(targets.size(), projected_exprs.size());
+      for (size_t i = 0; i < targets.size(); ++i) {
+        if (!(targets[i].sql_type == projected_exprs[i]->get_type_info())) {
+          return std::nullopt;
+        }
+      }
+    }
+    scatter_partition_rows(*projected_rows, key_count, partition_bits, partitions_slots);
+  }
+  if (targets.empty()) {
+    return std::nullopt;
+  }
+
+  const size_t col_count = targets.size();
+  std::vector<GroupByPartition> partitions;
+  for (auto& partition_slots : partitions_slots) {
+    const auto rows =
+        make_partition_result_set(partition_slots, targets, executor_, cat_);
+    PartitionSlots().swap(partition_slots);
+    if (rows->entryCount()) {
+      partitions.push_back({rows, partition_bits});
+    }
+  }
+  if (partitions.empty()) {
+    return std::nullopt;
+  }
+
+  std::list<std::shared_ptr<const InputColDescriptor>> partition_input_col_descs;
+  for (size_t col_id = 0; col_id < col_count; ++col_id) {
+    partition_input_col_descs.push_back(
+        std::make_shared<const InputColDescriptor>(col_id, kGroupByPartitionsTableId, 0));
+  }
+  const RelAlgExecutionUnit partition_exe_unit{
+      {InputDescriptor(kGroupByPartitionsTableId, 0)},
+      partition_input_col_descs,
+      {},
+      {},
+      {},
+      partition_groupby_exprs,
+      partition_target_exprs,
+      nullptr,
+      ra_exe_unit.sort_info,
+      0,
+      ra_exe_unit.query_hint,
+      false,
+      std::nullopt,
+      ra_exe_unit.query_state};
+  ScopeGuard erase_partitions = [this] {
+    eraseFromTemporaryTables(kGroupByPartitionsTableId);
+  };
+
+  LOG(INFO) << "Aggregating the group by in " << partitions.size()
+            << " key partitions, split up to " << g_max_groupby_retry_partitions
+            << " partitions if they run out of host memory.";
+  // The partitions are the fragments of the temporary table, each gets its own kernel on
+  // the CPU thread pool. The kernels hold disjoint groups, their results are kept apart
+  // rather than reduced. When a kernel runs out of host memory or output slots, which
+  // one isn't known, so all the partitions get split in two on the next bit of the key
+  // hash, without projecting the input again.
+  const auto max_partition_bits = log2_floor(g_max_groupby_retry_partitions);
+  std::vector<ResultSetPtr> partition_results;
+  while (partition_results.empty()) {
+    std::vector<ResultSetPtr> fragments;
+    size_t min_hash_bits{max_partition_bits};
+    size_t max_partition_rows{0};
+    for (const auto& partition : partitions) {
+      fragments.push_back(partition.rows);
+      min_hash_bits = std::min(min_hash_bits, partition.hash_bits);
+      max_partition_rows = std::max(max_partition_rows, partition.rows->entryCount());
+    }
+    eraseFromTemporaryTables(kGroupByPartitionsTableId);
+    addTemporaryTable(kGroupByPartitionsTableId, TemporaryTable(fragments));
+    const auto partition_table_infos = get_table_infos(partition_exe_unit, executor_);
+    // a partition holds about its share of the groups and at most one per row
+    auto partition_entry_guess =
+        max_groups_buffer_entry_guess
+            ? std::min(std::max(max_groups_buffer_entry_guess >> min_hash_bits,
+                                size_t(1)),
+                       max_partition_rows)
+            : max_partition_rows;
+    const ExecutionOptions partition_eo{eo.output_columnar_hint,
+                                        false,
+                                        false,
+                                        eo.allow_loop_joins,
+                                        eo.with_watchdog,
+                                        eo.jit_debug,
+                                        false,
+                                        eo.with_dynamic_watchdog,
+                                        eo.dynamic_watchdog_time_limit,
+                                        false,
+                                        false,
+                                        eo.gpu_input_mem_limit_percent,
+                                        eo.allow_runtime_query_interrupt,
+                                        eo.running_query_interrupt_freq,
+                                        eo.pending_query_interrupt_freq,
+                                        eo.executor_type,
+                                        {},
+                                        /*multifrag_result=*/true};
+    try {
+      // not an aggregate for the executor, which would reduce the kernel results
+      ColumnCacheMap column_cache;
+      auto partition_table = executor_->executeWorkUnit(partition_entry_guess,
+                                                        false,
+                                                        partition_table_infos,
+                                                        partition_exe_unit,
+                                                        co,
+                                                        partition_eo,
+                                                        cat_,
+                                                        nullptr,
+                                                        true,
+                                                        column_cache);
+      for (int frag_id = 0; frag_id < partition_table.getFragCount(); ++frag_id) {
+        partition_results.push_back(partition_table[frag_id]);
+      }
+      CHECK(!partition_results.empty());
+    } catch (const QueryExecutionError& e) {
+      const bool out_of_memory = e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM ||
+                                 e.getErrorCode() < 0;
+      if (!out_of_memory || min_hash_bits >= max_partition_bits) {
+        // the caller decides between retrying without partitions and giving up
+        if (e.getErrorCode() >= 0) {
+          handlePersistentError(e.getErrorCode());
+        }
+        return std::nullopt;
+      }
+      std::vector<GroupByPartition> split_partitions;
+      for (const auto& partition : partitions) {
+        if (partition.hash_bits >= max_partition_bits) {
+          split_partitions.push_back(partition);
+          continue;
+        }
+        auto children = split_partition(partition, key_count, executor_, cat_);
+        for (const auto& child : {children.first, children.second}) {
+          if (child.rows->entryCount()) {
+            split_partitions.push_back(child);
+          }
+        }
+      }
+      partitions = std::move(split_partitions);
+    }
+  }
+  VLOG(1) << "Partitioned group by finished in " << partitions.size() << " partitions.";
+  metrics::Registry::instance()
+      .counter("omnisci_groupby_partitions_total",
+               "Key partitions aggregated by partitioned group by queries.")
+      .increment(partitions.size());
+
+  // Partitions hold disjoint groups, stitch them together without a reduction. The
+  // storages get iterated with the layout of the first one, so they must all have it.
+  // Entry counts may differ, the query memory descriptor comparison ignores them.
+  CHECK(!partition_results.empty());
+  const auto first_with_storage =
+      std::find_if(partition_results.begin(),
+                   partition_results.end(),
+                   [](const ResultSetPtr& rows) { return rows->getStorage(); });
+  if (first_with_storage == partition_results.end()) {
+    return ExecutionResult{partition_results.front(), targets_meta};
+  }
+  auto result = *first_with_storage;
+  for (auto it = std::next(first_with_storage); it != partition_results.end(); ++it) {
+    if ((*it)->getStorage() &&
+        !((*it)->getQueryMemDesc() == result->getQueryMemDesc())) {
+      LOG(INFO) << "Partitions of the group by got different output buffer layouts, "
+                   "giving up on partitioning.";
+      return std::nullopt;
+    }
+  }
+  for (auto it = std::next(first_with_storage); it != partition_results.end(); ++it) {
+    result->append(**it);
+  }
+  return ExecutionResult{result, targets_meta};
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
@@ -30,6 +30,7 @@
 #include "ThriftHandler/QueryState.h"
 
 #include <ctime>
+#include <optional>
 #include <sstream>
 
 #include "StorageIOFacility.h"
@@ -153,12 +154,22 @@ class RelAlgExecutor : private StorageIOFacility {
 
   void executePostExecutionCallback();
 
+  // Collects the runtime profile of every step into the given profile (EXPLAIN ANALYZE).
+  void setQueryProfile(std::shared_ptr<QueryProfile> query_profile) {
+    query_profile_ = std::move(query_profile);
+  }
+
  private:
   ExecutionResult executeRelAlgQueryNoRetry(const CompilationOptions& co,
                                             const ExecutionOptions& eo,
                                             const bool just_explain_plan,
                                             RenderInfo* render_info);
 
+  // Executes the uncorrelated subqueries of the query and caches their results. With
+  // concurrent subqueries enabled, independent subqueries run in parallel on dedicated
+  // executors.
+  void executeSubqueries(const CompilationOptions& co, const ExecutionOptions& eo);
+
   void executeRelAlgStep(const RaExecutionSequence& seq,
                          const size_t step_idx,
                          const CompilationOptions&,
@@ -300,6 +311,25 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Projects the group by keys and the columns the targets use once, a batch of outer
+  // fragments at a time, scatters the rows in at least partition_count partitions on the
+  // hash of the whole key, more if the hash tables wouldn't fit in the available host
+  // memory, and aggregates the partitions concurrently, a kernel each, splitting them
+  // again if they still don't fit.
+  // Used for group by queries which ran out of host memory and for the ones with too many
+  // groups for the hash tables to stay in the CPU caches. The entry guess is for all the
+  // groups, the partitions get their share of it. Returns nullopt if the work unit can't
+  // be partitioned, e.g. for a target or key of variable length, or the partitions can't
+  // be stitched together.
+  std::optional<ExecutionResult> executePartitionedGroupBy(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      const size_t max_groups_buffer_entry_guess,
+      const size_t partition_count);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -377,6 +407,7 @@ class RelAlgExecutor : private StorageIOFacility {
 
   std::unique_ptr<TransactionParameters> dml_transaction_parameters_;
   std::optional<std::function<void()>> post_execution_callback_;
+  std::shared_ptr<QueryProfile> query_profile_;
 
   friend class PendingExecutionClosure;
 };
@@ -1520,6 +1520,86 @@ void fold_filters(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept {
   }
 }
 
+namespace {
+
+class RexProjectionInliner : public RexDeepCopyVisitor {
+ public:
+  RexProjectionInliner(const RelProject* project) : project_(project) {}
+
+  RetType visitInput(const RexInput* input) const override {
+    CHECK_EQ(project_, input->getSourceNode());
+    return RexDeepCopyVisitor::visit(project_->getProjectAt(input->getIndex()));
+  }
+
+ private:
+  const RelProject* project_;
+};
+
+}  // namespace
+
+// Swaps a filter with the computed projection below it, inlining the projected
+// expressions into the filter condition. The filter then runs right on top of the
+// projection source and gets coalesced with the projection, and the aggregate after it
+// if any, into a single step rather than filtering the materialized projection.
+void sink_filters_below_projects(
+    std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept {
+  std::unordered_map<const RelAlgNode*, std::shared_ptr<RelAlgNode>> deconst_mapping;
+  for (auto node : nodes) {
+    deconst_mapping.insert(std::make_pair(node.get(), node));
+  }
+
+  auto web = build_du_web(nodes);
+  for (size_t filter_idx = 0; filter_idx < nodes.size(); ++filter_idx) {
+    auto filter = std::dynamic_pointer_cast<RelFilter>(nodes[filter_idx]);
+    if (!filter) {
+      continue;
+    }
+    CHECK_EQ(filter->inputCount(), size_t(1));
+    auto project_it = deconst_mapping.find(filter->getInput(0));
+    if (project_it == deconst_mapping.end()) {
+      continue;
+    }
+    auto project = std::dynamic_pointer_cast<RelProject>(project_it->second);
+    if (!project || project->isNop() || project->isSimple() ||
+        project->hasWindowFunctionExpr()) {
+      continue;
+    }
+    // Join conditions are built from the filters on top of the joins, leave those alone
+    auto source = project->getAndOwnInput(0);
+    if (dynamic_cast<const RelJoin*>(source.get()) ||
+        dynamic_cast<const RelLeftDeepInnerJoin*>(source.get())) {
+      continue;
+    }
+    auto project_usrs_it = web.find(project.get());
+    CHECK(project_usrs_it != web.end());
+    if (project_usrs_it->second.size() != size_t(1)) {
+      continue;
+    }
+    const auto project_idx = static_cast<size_t>(
+        std::find(nodes.begin(), nodes.end(), project_it->second) - nodes.begin());
+    CHECK_LT(project_idx, filter_idx);
+
+    LOG(INFO) << "ID=" << filter->getId() << " " << filter->toString()
+              << " sunk below ID=" << project->getId() << " " << project->toString();
+    RexProjectionInliner inliner(project.get());
+    auto new_condition = inliner.visit(filter->getCondition());
+    filter->setCondition(new_condition);
+    filter->RelAlgNode::replaceInput(project, source);
+    auto filter_usrs_it = web.find(filter.get());
+    CHECK(filter_usrs_it != web.end());
+    for (auto usr : filter_usrs_it->second) {
+      auto usr_it = deconst_mapping.find(usr);
+      CHECK(usr_it != deconst_mapping.end());
+      usr_it->second->replaceInput(filter, project);
+    }
+    project->replaceInput(source, filter);
+
+    // Keep the nodes topologically sorted, the filter now precedes the projection
+    std::swap(nodes[project_idx], nodes[filter_idx]);
+    web = build_du_web(nodes);
+  }
+}
+
 std::vector<const RexScalar*> find_hoistable_conditions(const RexScalar* condition,
                                                         const RelAlgNode* source,
                                                         const size_t first_col_idx,
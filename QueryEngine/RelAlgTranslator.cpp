@@ -37,6 +37,7 @@
 extern bool g_enable_watchdog;
 
 bool g_enable_experimental_string_functions = false;
+size_t g_max_integer_set_size{1 << 25};
 
 namespace {
 
@@ -616,7 +617,11 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInOper(
 
 namespace {
 
-const size_t g_max_integer_set_size{1 << 25};
+void throw_integer_set_too_large() {
+  throw std::runtime_error(
+      "Unable to handle 'expr IN (subquery)', subquery returned more than " +
+      std::to_string(g_max_integer_set_size) + " rows.");
+}
 
 void fill_dictionary_encoded_in_vals(
     std::vector<int64_t>& in_vals,
@@ -647,8 +652,7 @@ void fill_dictionary_encoded_in_vals(
     }
     if (UNLIKELY(g_enable_watchdog && (in_vals.size() & 1023) == 0 &&
                  total_in_vals_count.fetch_add(1024) >= g_max_integer_set_size)) {
-      throw std::runtime_error(
-          "Unable to handle 'expr IN (subquery)', subquery returned 30M+ rows.");
+      throw_integer_set_too_large();
     }
   }
 }
@@ -665,8 +669,7 @@ void fill_integer_in_vals(std::vector<int64_t>& in_vals,
       in_vals.push_back(row.value);
       if (UNLIKELY(g_enable_watchdog && (in_vals.size() & 1023) == 0 &&
                    total_in_vals_count.fetch_add(1024) >= g_max_integer_set_size)) {
-        throw std::runtime_error(
-            "Unable to handle 'expr IN (subquery)', subquery returned 30M+ rows.");
+        throw_integer_set_too_large();
       }
     }
   }
@@ -706,8 +709,7 @@ void fill_dictionary_encoded_in_vals(
         in_vals.push_back(row.value);
         if (UNLIKELY(g_enable_watchdog && (in_vals.size() & 1023) == 0 &&
                      total_in_vals_count.fetch_add(1024) >= g_max_integer_set_size)) {
-          throw std::runtime_error(
-              "Unable to handle 'expr IN (subquery)', subquery returned 30M+ rows.");
+          throw_integer_set_too_large();
         }
       } else {
         has_nulls = true;
@@ -749,8 +751,7 @@ void fill_dictionary_encoded_in_vals(
       in_vals.push_back(dest_id);
       if (UNLIKELY(g_enable_watchdog && (in_vals.size() & 1023) == 0 &&
                    total_in_vals_count.fetch_add(1024) >= g_max_integer_set_size)) {
-        throw std::runtime_error(
-            "Unable to handle 'expr IN (subquery)', subquery returned 30M+ rows.");
+        throw_integer_set_too_large();
       }
     }
   }
@@ -46,6 +46,7 @@ extern bool g_use_tbb_pool;
 
 size_t g_parallel_top_min = 100e3;
 size_t g_parallel_top_max = 20e6;  // In effect only with g_enable_watchdog.
+size_t g_parallel_sort_min = 100e3;
 
 void ResultSet::keepFirstN(const size_t n) {
   CHECK_EQ(-1, cached_row_count_);
@@ -539,6 +540,10 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
     if (g_enable_watchdog && Executor::baseline_threshold < entryCount()) {
       throw WatchdogException("Sorting the result would be too slow");
     }
+    if (!top_n && g_parallel_sort_min < entryCount() && cpu_threads() > 1) {
+      parallelSort(order_entries, executor);
+      return;
+    }
     permutation_.resize(query_mem_desc_.getEntryCount());
     // PermutationView is used to share common API with parallelTop().
     PermutationView pv(permutation_.data(), 0, permutation_.size());
@@ -635,6 +640,84 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   permutation_.shrink_to_fit();
 }
 
+// Full sort as a parallel merge sort: the non-empty entries of nthreads intervals are
+// sorted concurrently, then the sorted runs are merged pairwise, with the merges of every
+// round running concurrently as well.
+void ResultSet::parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                             const Executor* executor) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t nthreads = cpu_threads();
+
+  permutation_.resize(query_mem_desc_.getEntryCount());
+  std::vector<PermutationView> permutation_views(nthreads);
+  const auto init_interval = [this, &permutation_views](const auto interval) {
+    PermutationView pv(permutation_.data() + interval.begin, 0, interval.size());
+    permutation_views[interval.index] =
+        initPermutationBuffer(pv, interval.begin, interval.end);
+  };
+  threadpool::FuturesThreadPool<void> init_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    init_threads.spawn(init_interval, interval);
+  }
+  init_threads.join();
+
+  // Left-copy the non-empty entries of every interval into one contiguous range, which
+  // keeps the boundaries of the runs to sort.
+  std::vector<size_t> run_bounds{0};
+  for (const auto& pv : permutation_views) {
+    std::copy(pv.begin(), pv.end(), permutation_.begin() + run_bounds.back());
+    run_bounds.push_back(run_bounds.back() + pv.size());
+  }
+  permutation_.resize(run_bounds.back());
+  permutation_.shrink_to_fit();
+
+  // A single comparator for all the entries, see the note on its constructor cost in
+  // parallelTop(). Its materialized columns are only read while comparing, so it's
+  // shared by the threads below, by reference since it's expensive to copy.
+  PermutationView pv(permutation_.data(), permutation_.size());
+  const auto compare = createComparator(order_entries, pv, executor, false);
+  const auto compare_ref = [&compare](const PermutationIdx lhs,
+                                      const PermutationIdx rhs) {
+    return compare(lhs, rhs);
+  };
+
+  threadpool::FuturesThreadPool<void> sort_threads;
+  for (size_t run = 0; run + 1 < run_bounds.size(); ++run) {
+    const auto begin = run_bounds[run];
+    const auto end = run_bounds[run + 1];
+    sort_threads.spawn([this, &compare_ref, begin, end] {
+      std::sort(permutation_.begin() + begin, permutation_.begin() + end, compare_ref);
+    });
+  }
+  sort_threads.join();
+
+  Permutation merged(permutation_.size());
+  while (run_bounds.size() > 2) {
+    std::vector<size_t> merged_run_bounds;
+    threadpool::FuturesThreadPool<void> merge_threads;
+    const size_t run_count = run_bounds.size() - 1;
+    for (size_t run = 0; run < run_count; run += 2) {
+      const auto begin = run_bounds[run];
+      const auto mid = run_bounds[run + 1];
+      // the last run of an odd count is merged with an empty one, i.e. just copied
+      const auto end = run + 1 < run_count ? run_bounds[run + 2] : mid;
+      merged_run_bounds.push_back(begin);
+      merge_threads.spawn([this, &merged, &compare_ref, begin, mid, end] {
+        std::merge(permutation_.begin() + begin,
+                   permutation_.begin() + mid,
+                   permutation_.begin() + mid,
+                   permutation_.begin() + end,
+                   merged.begin() + begin,
+                   compare_ref);
+      });
+    }
+    merge_threads.join();
+    merged_run_bounds.push_back(run_bounds.back());
+    permutation_.swap(merged);
+    run_bounds.swap(merged_run_bounds);
+  }
+}
+
 std::pair<size_t, size_t> ResultSet::getStorageIndex(const size_t entry_idx) const {
   size_t fixedup_entry_idx = entry_idx;
   auto entry_count = storage_->query_mem_desc_.getEntryCount();
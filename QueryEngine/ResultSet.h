@@ -35,6 +35,7 @@
 #include <atomic>
 #include <functional>
 #include <list>
+#include <optional>
 
 /*
  * Stores the underlying buffer and the meta-data for a result set. The buffer
@@ -91,6 +92,49 @@ class Executor;
 
 class ResultSet;
 
+class StringDictionaryProxy;
+
+// One column of a batch of rows returned by ResultSet::getNextBatch(). Integer, boolean,
+// date and time, decimal and dictionary encoded string columns are decoded into
+// int_values or fp_values, with their nulls flagged in null_map. The other columns
+// (arrays, geo, none encoded strings, AVG, COUNT DISTINCT etc.) keep the TargetValue
+// getNextRow() returns for every row in target_values.
+struct ResultSetColumnBatch {
+  enum class Format { Int, Fp, TargetValue };
+
+  SQLTypeInfo type;
+  Format format{Format::TargetValue};
+  // Also holds the ids of dictionary encoded strings and the unscaled decimals.
+  std::vector<int64_t> int_values;
+  std::vector<double> fp_values;
+  std::vector<int8_t> null_map;
+  std::vector<TargetValue> target_values;
+  // Set for dictionary encoded strings when the batch has been fetched with string
+  // translation, see getString().
+  const StringDictionaryProxy* string_dict_proxy{nullptr};
+
+  size_t size() const {
+    return format == Format::TargetValue ? target_values.size() : null_map.size();
+  }
+
+  bool isNull(const size_t row) const {
+    CHECK(format != Format::TargetValue);
+    return null_map[row];
+  }
+
+  std::string getString(const size_t row) const;
+
+  // Returns the value of the given row as getNextRow() would.
+  TargetValue getTargetValue(const size_t row) const;
+};
+
+struct ResultSetBatch {
+  size_t row_count{0};
+  std::vector<ResultSetColumnBatch> columns;
+
+  bool empty() const { return row_count == 0; }
+};
+
 class ResultSetRowIterator {
  public:
   using value_type = std::vector<TargetValue>;
@@ -236,6 +280,14 @@ class ResultSet {
   std::vector<TargetValue> getNextRow(const bool translate_strings,
                                       const bool decimal_to_double) const;
 
+  // Fetches up to max_rows rows from the same cursor as getNextRow(), decoded column by
+  // column. Returns an empty batch once all the rows have been fetched.
+  ResultSetBatch getNextBatch(const size_t max_rows,
+                              const bool translate_strings,
+                              const bool decimal_to_double) const;
+
+  static constexpr size_t kDefaultBatchRowCount{4096};
+
   size_t getCurrentRowBufferIndex() const;
 
   std::vector<TargetValue> getRowAt(const size_t index) const;
@@ -435,6 +487,10 @@ class ResultSet {
  private:
   void advanceCursorToNextEntry(ResultSetRowIterator& iter) const;
 
+  // Advances the getNextRow() cursor past the next row and returns its entry index, or
+  // nothing once all the rows have been fetched.
+  std::optional<size_t> advanceCursorToNextRow() const;
+
   std::vector<TargetValue> getNextRowImpl(const bool translate_strings,
                                           const bool decimal_to_double) const;
 
@@ -512,6 +568,9 @@ class ResultSet {
                               const bool decimal_to_double,
                               const size_t entry_buff_idx) const;
 
+  StringDictionaryProxy* getStringDictProxyForTarget(
+      const SQLTypeInfo& chosen_type) const;
+
   TargetValue makeVarlenTargetValue(const int8_t* ptr1,
                                     const int8_t compact_sz1,
                                     const int8_t* ptr2,
@@ -697,6 +756,9 @@ class ResultSet {
                    const size_t top_n,
                    const Executor* executor);
 
+  void parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                    const Executor* executor);
+
   void baselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                     const size_t top_n,
                     const Executor* executor);
@@ -38,6 +38,7 @@
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace {
@@ -318,27 +319,36 @@ std::vector<TargetValue> ResultSet::getNextRowUnlocked(
 
 std::vector<TargetValue> ResultSet::getNextRowImpl(const bool translate_strings,
                                                    const bool decimal_to_double) const {
+  const auto entry_buff_idx = advanceCursorToNextRow();
+  if (!entry_buff_idx) {
+    return {};
+  }
+
+  auto row = getRowAt(*entry_buff_idx, translate_strings, decimal_to_double, false);
+  CHECK(!row.empty());
+
+  return row;
+}
+
+std::optional<size_t> ResultSet::advanceCursorToNextRow() const {
   size_t entry_buff_idx = 0;
   do {
     if (keep_first_ && fetched_so_far_ >= drop_first_ + keep_first_) {
-      return {};
+      return std::nullopt;
     }
 
     entry_buff_idx = advanceCursorToNextEntry();
 
     if (crt_row_buff_idx_ >= entryCount()) {
       CHECK_EQ(entryCount(), crt_row_buff_idx_);
-      return {};
+      return std::nullopt;
     }
     ++crt_row_buff_idx_;
     ++fetched_so_far_;
 
   } while (drop_first_ && fetched_so_far_ <= drop_first_);
 
-  auto row = getRowAt(entry_buff_idx, translate_strings, decimal_to_double, false);
-  CHECK(!row.empty());
-
-  return row;
+  return entry_buff_idx;
 }
 
 namespace {
@@ -366,6 +376,41 @@ int64_t int_resize_cast(const int64_t ival, const size_t sz) {
   return 0;
 }
 
+// Returns the width of the scalar value makeTargetValue() reads from a slot or key of
+// compact_sz bytes.
+int8_t get_actual_compact_size(const int8_t compact_sz,
+                               const TargetInfo& target_info,
+                               const QueryMemoryDescriptor& query_mem_desc) {
+  auto actual_compact_sz = compact_sz;
+  const auto& type_info = target_info.sql_type;
+  if (type_info.get_type() == kFLOAT && !query_mem_desc.forceFourByteFloat()) {
+    if (query_mem_desc.isLogicalSizedColumnsAllowed()) {
+      actual_compact_sz = sizeof(float);
+    } else {
+      actual_compact_sz = sizeof(double);
+    }
+    if (target_info.is_agg &&
+        (target_info.agg_kind == kAVG || target_info.agg_kind == kSUM ||
+         target_info.agg_kind == kMIN || target_info.agg_kind == kMAX ||
+         target_info.agg_kind == kSINGLE_VALUE)) {
+      // The above listed aggregates use two floats in a single 8-byte slot. Set the
+      // padded size to 4 bytes to properly read each value.
+      actual_compact_sz = sizeof(float);
+    }
+  }
+  if (get_compact_type(target_info).is_date_in_days()) {
+    // Dates encoded in days are converted to 8 byte values on read.
+    actual_compact_sz = sizeof(int64_t);
+  }
+
+  // String dictionary keys are read as 32-bit values regardless of encoding
+  if (type_info.is_string() && type_info.get_compression() == kENCODING_DICT &&
+      type_info.get_comp_param()) {
+    actual_compact_sz = sizeof(int32_t);
+  }
+  return actual_compact_sz;
+}
+
 }  // namespace
 
 void ResultSet::RowWiseTargetAccessor::initializeOffsetsForStorage() {
@@ -1725,33 +1770,9 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
                                        const bool translate_strings,
                                        const bool decimal_to_double,
                                        const size_t entry_buff_idx) const {
-  auto actual_compact_sz = compact_sz;
+  const auto actual_compact_sz =
+      get_actual_compact_size(compact_sz, target_info, query_mem_desc_);
   const auto& type_info = target_info.sql_type;
-  if (type_info.get_type() == kFLOAT && !query_mem_desc_.forceFourByteFloat()) {
-    if (query_mem_desc_.isLogicalSizedColumnsAllowed()) {
-      actual_compact_sz = sizeof(float);
-    } else {
-      actual_compact_sz = sizeof(double);
-    }
-    if (target_info.is_agg &&
-        (target_info.agg_kind == kAVG || target_info.agg_kind == kSUM ||
-         target_info.agg_kind == kMIN || target_info.agg_kind == kMAX ||
-         target_info.agg_kind == kSINGLE_VALUE)) {
-      // The above listed aggregates use two floats in a single 8-byte slot. Set the
-      // padded size to 4 bytes to properly read each value.
-      actual_compact_sz = sizeof(float);
-    }
-  }
-  if (get_compact_type(target_info).is_date_in_days()) {
-    // Dates encoded in days are converted to 8 byte values on read.
-    actual_compact_sz = sizeof(int64_t);
-  }
-
-  // String dictionary keys are read as 32-bit values regardless of encoding
-  if (type_info.is_string() && type_info.get_compression() == kENCODING_DICT &&
-      type_info.get_comp_param()) {
-    actual_compact_sz = sizeof(int32_t);
-  }
 
   auto ival = read_int_from_buff(ptr, actual_compact_sz);
   const auto& chosen_type = get_compact_type(target_info);
@@ -1818,17 +1839,7 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
           NULL_INT) {  // TODO(alex): this isn't nice, fix it
         return NullableString(nullptr);
       }
-      StringDictionaryProxy* sdp{nullptr};
-      if (!chosen_type.get_comp_param()) {
-        sdp = row_set_mem_owner_->getLiteralStringDictProxy();
-      } else {
-        sdp = catalog_
-                  ? row_set_mem_owner_->getOrAddStringDictProxy(
-                        chosen_type.get_comp_param(), /*with_generation=*/false, catalog_)
-                  : row_set_mem_owner_->getStringDictProxy(
-                        chosen_type.get_comp_param());  // unit tests bypass the catalog
-      }
-      return NullableString(sdp->getString(ival));
+      return NullableString(getStringDictProxyForTarget(chosen_type)->getString(ival));
     } else {
       return static_cast<int64_t>(static_cast<int32_t>(ival));
     }
@@ -1853,6 +1864,17 @@ TargetValue ResultSet::makeTargetValue(const int8_t* ptr,
   return TargetValue(int64_t(0));
 }
 
+StringDictionaryProxy* ResultSet::getStringDictProxyForTarget(
+    const SQLTypeInfo& chosen_type) const {
+  if (!chosen_type.get_comp_param()) {
+    return row_set_mem_owner_->getLiteralStringDictProxy();
+  }
+  return catalog_ ? row_set_mem_owner_->getOrAddStringDictProxy(
+                        chosen_type.get_comp_param(), /*with_generation=*/false, catalog_)
+                  : row_set_mem_owner_->getStringDictProxy(
+                        chosen_type.get_comp_param());  // unit tests bypass the catalog
+}
+
 // Gets the TargetValue stored at position local_entry_idx in the col1_ptr and col2_ptr
 // column buffers. The second column is only used for AVG.
 // the global_entry_idx is passed to makeTargetValue to be used for
@@ -2028,6 +2050,390 @@ TargetValue ResultSet::getTargetValueFromBufferRowwise(
                          entry_buff_idx);
 }
 
+namespace {
+
+// A scalar target decoded by ResultSet::getNextBatch(), with the address of its value in
+// every row of the batch.
+struct BatchScalarTarget {
+  size_t target_idx;
+  size_t slot_idx;
+  int32_t key_idx;  // group by key which holds the value, -1 if it's in a slot
+  int8_t compact_sz;
+  std::vector<const int8_t*> value_ptrs;
+};
+
+// Whether getNextBatch() decodes the target itself, which is the case for the targets
+// makeTargetValue() reads as a single integer or float.
+bool is_batch_scalar_target(const TargetInfo& target_info,
+                            const std::vector<ColumnLazyFetchInfo>& lazy_fetch_info,
+                            const size_t target_idx) {
+  if (target_info.sql_type.is_geometry() || target_info.agg_kind == kAVG ||
+      target_info.agg_kind == kAPPROX_MEDIAN || is_real_str_or_array(target_info) ||
+      is_distinct_target(target_info)) {
+    return false;
+  }
+  if (!lazy_fetch_info.empty() && lazy_fetch_info[target_idx].is_lazily_fetched) {
+    return false;
+  }
+  const auto chosen_type = get_compact_type(target_info);
+  return chosen_type.is_fp() || chosen_type.is_integer() || chosen_type.is_boolean() ||
+         chosen_type.is_time() || chosen_type.is_timeinterval() ||
+         chosen_type.is_decimal() ||
+         (chosen_type.is_string() && chosen_type.get_compression() == kENCODING_DICT);
+}
+
+template <typename T>
+void decode_fp_column(const std::vector<const int8_t*>& value_ptrs,
+                      const bool is_float,
+                      ResultSetColumnBatch& column) {
+  auto& values = column.fp_values;
+  auto& null_map = column.null_map;
+  values.resize(value_ptrs.size());
+  null_map.resize(value_ptrs.size());
+  for (size_t i = 0; i < value_ptrs.size(); ++i) {
+    const auto val = *reinterpret_cast<const T*>(value_ptrs[i]);
+    if (is_float) {
+      const auto fval = static_cast<float>(val);
+      values[i] = fval;
+      null_map[i] = fval == NULL_FLOAT;
+    } else {
+      values[i] = val;
+      null_map[i] = val == NULL_DOUBLE;
+    }
+  }
+}
+
+template <typename T>
+void decode_int_column(const std::vector<const int8_t*>& value_ptrs,
+                       const SQLTypeInfo& chosen_type,
+                       const SQLTypeInfo& type_info,
+                       ResultSetColumnBatch& column) {
+  auto& values = column.int_values;
+  auto& null_map = column.null_map;
+  values.resize(value_ptrs.size());
+  null_map.resize(value_ptrs.size());
+  const auto stored_null_val = inline_int_null_val(chosen_type);
+  const auto null_val = inline_int_null_val(type_info);
+  const auto logical_size = chosen_type.get_logical_size();
+  for (size_t i = 0; i < value_ptrs.size(); ++i) {
+    const int64_t ival = *reinterpret_cast<const T*>(value_ptrs[i]);
+    const bool is_null = stored_null_val == int_resize_cast(ival, logical_size);
+    values[i] = is_null ? null_val : ival;
+    null_map[i] = is_null;
+  }
+}
+
+template <typename T>
+void decode_dict_string_column(const std::vector<const int8_t*>& value_ptrs,
+                               ResultSetColumnBatch& column) {
+  auto& values = column.int_values;
+  auto& null_map = column.null_map;
+  values.resize(value_ptrs.size());
+  null_map.resize(value_ptrs.size());
+  for (size_t i = 0; i < value_ptrs.size(); ++i) {
+    const auto string_id =
+        static_cast<int32_t>(*reinterpret_cast<const T*>(value_ptrs[i]));
+    values[i] = string_id;
+    null_map[i] = string_id == NULL_INT;
+  }
+}
+
+template <typename T>
+void decode_decimal_column(const std::vector<const int8_t*>& value_ptrs,
+                           const TargetInfo& target_info,
+                           const bool decimal_to_double,
+                           ResultSetColumnBatch& column) {
+  const auto& chosen_type = get_compact_type(target_info);
+  const auto null_val =
+      inline_int_null_val(SQLTypeInfo(decimal_to_int_type(chosen_type), false));
+  // see makeTargetValue() for the null sentinels of the decimal aggregates
+  const auto agg_null_val =
+      target_info.is_agg &&
+              (target_info.agg_kind == kAVG || target_info.agg_kind == kSUM ||
+               target_info.agg_kind == kMIN || target_info.agg_kind == kMAX)
+          ? inline_int_null_val(SQLTypeInfo(kBIGINT, false))
+          : null_val;
+  auto& null_map = column.null_map;
+  null_map.resize(value_ptrs.size());
+  if (decimal_to_double) {
+    auto& values = column.fp_values;
+    values.resize(value_ptrs.size());
+    const double scale = exp_to_scale(chosen_type.get_scale());
+    for (size_t i = 0; i < value_ptrs.size(); ++i) {
+      const int64_t ival = *reinterpret_cast<const T*>(value_ptrs[i]);
+      const bool is_null = ival == agg_null_val || ival == null_val;
+      values[i] = is_null ? NULL_DOUBLE : static_cast<double>(ival) / scale;
+      null_map[i] = is_null;
+    }
+  } else {
+    auto& values = column.int_values;
+    values.resize(value_ptrs.size());
+    for (size_t i = 0; i < value_ptrs.size(); ++i) {
+      const int64_t ival = *reinterpret_cast<const T*>(value_ptrs[i]);
+      values[i] = ival;
+      null_map[i] = ival == null_val;
+    }
+  }
+}
+
+// Calls decode_fn with a null pointer of the integer type of the given width.
+template <typename DECODE_FN>
+void dispatch_on_int_width(const int8_t width, DECODE_FN decode_fn) {
+  switch (width) {
+    case 8:
+      decode_fn(static_cast<const int64_t*>(nullptr));
+      break;
+    case 4:
+      decode_fn(static_cast<const int32_t*>(nullptr));
+      break;
+    case 2:
+      decode_fn(static_cast<const int16_t*>(nullptr));
+      break;
+    case 1:
+      decode_fn(static_cast<const int8_t*>(nullptr));
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+}  // namespace
+
+std::string ResultSetColumnBatch::getString(const size_t row) const {
+  CHECK(string_dict_proxy);
+  CHECK(!null_map[row]);
+  return string_dict_proxy->getString(int_values[row]);
+}
+
+TargetValue ResultSetColumnBatch::getTargetValue(const size_t row) const {
+  switch (format) {
+    case Format::Int:
+      if (string_dict_proxy) {
+        return null_map[row] ? NullableString(nullptr) : NullableString(getString(row));
+      }
+      return int_values[row];
+    case Format::Fp:
+      if (type.get_type() == kFLOAT) {
+        return static_cast<float>(fp_values[row]);
+      }
+      return fp_values[row];
+    case Format::TargetValue:
+      return target_values[row];
+  }
+  UNREACHABLE();
+  return TargetValue(nullptr);
+}
+
+ResultSetBatch ResultSet::getNextBatch(const size_t max_rows,
+                                       const bool translate_strings,
+                                       const bool decimal_to_double) const {
+  CHECK_GT(max_rows, size_t(0));
+  std::lock_guard<std::mutex> lock(row_iteration_mutex_);
+  ResultSetBatch batch;
+  if (just_explain_) {
+    if (!fetched_so_far_) {
+      fetched_so_far_ = 1;
+      batch.row_count = 1;
+      batch.columns.resize(1);
+      batch.columns.front().type = SQLTypeInfo(kTEXT, false);
+      batch.columns.front().target_values.emplace_back(explanation_);
+    }
+    return batch;
+  }
+  if (!storage_) {
+    return batch;
+  }
+
+  std::vector<size_t> entry_buff_idxs;
+  entry_buff_idxs.reserve(std::min(max_rows, entryCount()));
+  while (entry_buff_idxs.size() < max_rows) {
+    const auto entry_buff_idx = advanceCursorToNextRow();
+    if (!entry_buff_idx) {
+      break;
+    }
+    entry_buff_idxs.push_back(*entry_buff_idx);
+  }
+  if (entry_buff_idxs.empty()) {
+    return batch;
+  }
+  batch.row_count = entry_buff_idxs.size();
+  batch.columns.resize(targets_.size());
+
+  // Split the targets into the scalars decoded below and the ones left to getRowAt().
+  const bool output_columnar = query_mem_desc_.didOutputColumnar();
+  std::vector<BatchScalarTarget> scalar_targets;
+  std::vector<bool> targets_to_skip(targets_.size(), true);
+  bool has_fallback_targets{false};
+  std::vector<size_t> rowwise_slot_offsets;
+  size_t slot_idx{0};
+  size_t rowwise_slot_offset{0};
+  for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+    const auto& target_info = targets_[target_idx];
+    batch.columns[target_idx].type = target_info.sql_type;
+    if (is_batch_scalar_target(target_info, lazy_fetch_info_, target_idx)) {
+      BatchScalarTarget scalar_target{target_idx, slot_idx, -1, 0, {}};
+      scalar_target.compact_sz = query_mem_desc_.getPaddedSlotWidthBytes(slot_idx);
+      if (!output_columnar && query_mem_desc_.isSingleColumnGroupByWithPerfectHash() &&
+          !query_mem_desc_.hasKeylessHash() && !target_info.is_agg) {
+        // see getTargetValueFromBufferRowwise()
+        scalar_target.compact_sz = query_mem_desc_.getLogicalSlotWidthBytes(slot_idx);
+      }
+      if (query_mem_desc_.targetGroupbyIndicesSize() > 0 &&
+          query_mem_desc_.getTargetGroupbyIndex(target_idx) >= 0) {
+        scalar_target.key_idx = query_mem_desc_.getTargetGroupbyIndex(target_idx);
+        scalar_target.compact_sz = query_mem_desc_.getEffectiveKeyWidth();
+      }
+      scalar_target.value_ptrs.reserve(batch.row_count);
+      scalar_targets.push_back(std::move(scalar_target));
+      rowwise_slot_offsets.push_back(rowwise_slot_offset);
+    } else {
+      targets_to_skip[target_idx] = false;
+      has_fallback_targets = true;
+    }
+    if (!output_columnar) {
+      rowwise_slot_offset = advance_target_ptr_row_wise(rowwise_slot_offset,
+                                                        target_info,
+                                                        slot_idx,
+                                                        query_mem_desc_,
+                                                        separate_varlen_storage_valid_);
+    }
+    slot_idx = advance_slot(slot_idx, target_info, separate_varlen_storage_valid_);
+  }
+
+  // Columnar buffers place the slots at offsets which depend on the entry count of
+  // every storage, computed on first use.
+  std::vector<std::vector<size_t>> columnar_slot_offsets(1 + appended_storage_.size());
+  auto get_columnar_slot_offsets = [&](const StorageLookupResult& storage_lookup_result)
+      -> const std::vector<size_t>& {
+    auto& slot_offsets = columnar_slot_offsets[storage_lookup_result.storage_idx];
+    if (slot_offsets.empty()) {
+      const auto& storage_query_mem_desc =
+          storage_lookup_result.storage_ptr->query_mem_desc_;
+      auto col_offset = storage_query_mem_desc.getColOffInBytes(0);
+      size_t crt_slot_idx{0};
+      auto scalar_target_it = scalar_targets.begin();
+      for (const auto& target_info : targets_) {
+        if (scalar_target_it != scalar_targets.end() &&
+            scalar_target_it->slot_idx == crt_slot_idx) {
+          slot_offsets.push_back(col_offset);
+          ++scalar_target_it;
+        }
+        col_offset = advance_target_ptr_col_wise(col_offset,
+                                                 target_info,
+                                                 crt_slot_idx,
+                                                 storage_query_mem_desc,
+                                                 separate_varlen_storage_valid_);
+        crt_slot_idx =
+            advance_slot(crt_slot_idx, target_info, separate_varlen_storage_valid_);
+      }
+      CHECK_EQ(slot_offsets.size(), scalar_targets.size());
+    }
+    return slot_offsets;
+  };
+
+  // Gather the address of every scalar value, row by row.
+  if (!scalar_targets.empty()) {
+    const auto key_width = query_mem_desc_.getEffectiveKeyWidth();
+    const auto key_bytes_with_padding =
+        output_columnar ? 0 : align_to_int64(get_key_bytes_rowwise(query_mem_desc_));
+    for (const auto entry_buff_idx : entry_buff_idxs) {
+      const auto storage_lookup_result = findStorage(entry_buff_idx);
+      const auto local_entry_idx = storage_lookup_result.fixedup_entry_idx;
+      const int8_t* buff = storage_lookup_result.storage_ptr->buff_;
+      CHECK(buff);
+      if (output_columnar) {
+        const auto& slot_offsets = get_columnar_slot_offsets(storage_lookup_result);
+        for (size_t i = 0; i < scalar_targets.size(); ++i) {
+          auto& scalar_target = scalar_targets[i];
+          const auto col_ptr =
+              scalar_target.key_idx < 0
+                  ? buff + slot_offsets[i]
+                  : buff + scalar_target.key_idx * query_mem_desc_.getEntryCount() *
+                               key_width;
+          scalar_target.value_ptrs.push_back(
+              columnar_elem_ptr(local_entry_idx, col_ptr, scalar_target.compact_sz));
+        }
+      } else {
+        const auto keys_ptr = row_ptr_rowwise(buff, query_mem_desc_, local_entry_idx);
+        const auto rowwise_target_ptr = keys_ptr + key_bytes_with_padding;
+        for (size_t i = 0; i < scalar_targets.size(); ++i) {
+          auto& scalar_target = scalar_targets[i];
+          scalar_target.value_ptrs.push_back(
+              scalar_target.key_idx < 0
+                  ? rowwise_target_ptr + rowwise_slot_offsets[i]
+                  : keys_ptr + scalar_target.key_idx * key_width);
+        }
+      }
+    }
+  }
+
+  // Decode the scalar targets one column at a time.
+  for (const auto& scalar_target : scalar_targets) {
+    const auto& target_info = targets_[scalar_target.target_idx];
+    const auto chosen_type = get_compact_type(target_info);
+    const auto actual_compact_sz =
+        get_actual_compact_size(scalar_target.compact_sz, target_info, query_mem_desc_);
+    const auto& value_ptrs = scalar_target.value_ptrs;
+    auto& column = batch.columns[scalar_target.target_idx];
+    if (chosen_type.is_fp()) {
+      column.format = ResultSetColumnBatch::Format::Fp;
+      const bool is_float = chosen_type.get_type() == kFLOAT;
+      switch (actual_compact_sz) {
+        case 8:
+          decode_fp_column<double>(value_ptrs, is_float, column);
+          break;
+        case 4:
+          CHECK(is_float);
+          decode_fp_column<float>(value_ptrs, is_float, column);
+          break;
+        default:
+          CHECK(false);
+      }
+    } else if (chosen_type.is_string()) {
+      column.format = ResultSetColumnBatch::Format::Int;
+      if (translate_strings) {
+        column.string_dict_proxy = getStringDictProxyForTarget(chosen_type);
+      }
+      dispatch_on_int_width(actual_compact_sz, [&](auto type_ptr) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(type_ptr)>>;
+        decode_dict_string_column<T>(value_ptrs, column);
+      });
+    } else if (chosen_type.is_decimal()) {
+      column.format = decimal_to_double ? ResultSetColumnBatch::Format::Fp
+                                        : ResultSetColumnBatch::Format::Int;
+      dispatch_on_int_width(actual_compact_sz, [&](auto type_ptr) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(type_ptr)>>;
+        decode_decimal_column<T>(value_ptrs, target_info, decimal_to_double, column);
+      });
+    } else {
+      column.format = ResultSetColumnBatch::Format::Int;
+      dispatch_on_int_width(actual_compact_sz, [&](auto type_ptr) {
+        using T = std::remove_cv_t<std::remove_pointer_t<decltype(type_ptr)>>;
+        decode_int_column<T>(value_ptrs, chosen_type, target_info.sql_type, column);
+      });
+    }
+  }
+
+  if (has_fallback_targets) {
+    for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+      if (!targets_to_skip[target_idx]) {
+        batch.columns[target_idx].target_values.reserve(batch.row_count);
+      }
+    }
+    for (const auto entry_buff_idx : entry_buff_idxs) {
+      auto row = getRowAt(
+          entry_buff_idx, translate_strings, decimal_to_double, false, targets_to_skip);
+      CHECK_EQ(row.size(), targets_.size());
+      for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+        if (!targets_to_skip[target_idx]) {
+          batch.columns[target_idx].target_values.push_back(std::move(row[target_idx]));
+        }
+      }
+    }
+  }
+  return batch;
+}
+
 // Returns true iff the entry at position entry_idx in buff contains a valid row.
 bool ResultSetStorage::isEmptyEntry(const size_t entry_idx, const int8_t* buff) const {
   if (QueryDescriptionType::NonGroupedAggregate ==
@@ -378,6 +378,35 @@ extern "C" ALWAYS_INLINE int8_t bit_is_set(const int64_t bitset,
              : 0;
 }
 
+extern "C" ALWAYS_INLINE uint64_t in_values_hash_slot(const int64_t val,
+                                                     const int64_t capacity_log2) {
+  return (static_cast<uint64_t>(val) * 0x9E3779B97F4A7C15ULL) >> (64 - capacity_log2);
+}
+
+// Probes the open addressing hash set built by InValuesBitmap for sparse values. Empty
+// slots hold the null value, which is never inserted.
+extern "C" ALWAYS_INLINE int8_t value_in_hash_set(const int64_t hash_set,
+                                                  const int64_t val,
+                                                  const int64_t capacity_log2,
+                                                  const int64_t null_val,
+                                                  const int8_t null_bool_val) {
+  if (val == null_val) {
+    return null_bool_val;
+  }
+  const auto slots = reinterpret_cast<const int64_t*>(hash_set);
+  const uint64_t slot_mask = (uint64_t(1) << capacity_log2) - 1;
+  for (uint64_t slot = in_values_hash_slot(val, capacity_log2);;
+       slot = (slot + 1) & slot_mask) {
+    const auto slot_val = slots[slot];
+    if (slot_val == val) {
+      return 1;
+    }
+    if (slot_val == null_val) {
+      return 0;
+    }
+  }
+}
+
 extern "C" ALWAYS_INLINE int64_t agg_sum(int64_t* agg, const int64_t val) {
   const auto old = *agg;
   *agg += val;
@@ -137,6 +137,10 @@ class ScalarExprVisitor {
     if (offset_in_fragment) {
       return visitOffsetInFragment(offset_in_fragment);
     }
+    const auto range_oper = dynamic_cast<const Analyzer::RangeOper*>(expr);
+    if (range_oper) {
+      return visitRangeOper(range_oper);
+    }
     const auto agg = dynamic_cast<const Analyzer::AggExpr*>(expr);
     if (agg) {
       return visitAggExpr(agg);
@@ -328,6 +332,13 @@ class ScalarExprVisitor {
     return defaultResult();
   }
 
+  virtual T visitRangeOper(const Analyzer::RangeOper* range_oper) const {
+    T result = defaultResult();
+    result = aggregateResult(result, visit(range_oper->get_operand()));
+    result = aggregateResult(result, visit(range_oper->get_distance()));
+    return result;
+  }
+
   virtual T visitAggExpr(const Analyzer::AggExpr* agg) const {
     T result = defaultResult();
     return aggregateResult(result, visit(agg->get_arg()));
@@ -23,6 +23,8 @@
 
 #include <boost/locale/conversion.hpp>
 
+#include <optional>
+
 extern "C" RUNTIME_EXPORT uint64_t string_decode(int8_t* chunk_iter_, int64_t pos) {
   auto chunk_iter = reinterpret_cast<ChunkIter*>(chunk_iter_);
   VarlenDatum vd;
@@ -58,6 +60,9 @@ extern "C" RUNTIME_EXPORT int32_t string_compress(const int64_t ptr_and_len,
 
 extern "C" RUNTIME_EXPORT int32_t lower_encoded(int32_t string_id,
                                                 int64_t string_dict_proxy_address) {
+  if (string_id == NULL_INT) {
+    return NULL_INT;
+  }
   StringDictionaryProxy* string_dict_proxy =
       reinterpret_cast<StringDictionaryProxy*>(string_dict_proxy_address);
   auto str = string_dict_proxy->getString(string_id);
@@ -122,10 +127,101 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LowerExpr* expr,
       str_id_lv[0],
       cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
 
-  return cgen_state_->emitExternalCall(
+  // Lower casing every string of the dictionary only pays off when the query lower cases
+  // about as many rows, a small scan of a large dictionary lower cases its rows instead.
+  constexpr size_t kMaxStringsPerRow{4};
+  const size_t row_count =
+      plan_state_->query_infos_.empty()
+          ? 0
+          : plan_state_->query_infos_.front().info.getNumTuplesUpperBound();
+  const auto lower_id_map =
+      row_count * kMaxStringsPerRow >=
+              static_cast<size_t>(string_dictionary_proxy->getGeneration())
+          ? string_dictionary_proxy->getLowerIdMap()
+          : nullptr;
+  if (!lower_id_map) {
+    return cgen_state_->emitExternalCall(
+        "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+  }
+  // The strings of the dictionary have been lower cased once, the rows only look up the
+  // id of the lower case string. Nulls and transient ids, negative, are out of the map
+  // range as unsigned, and the strings whose lower case string isn't in the dictionary
+  // are mapped to INVALID_STR_ID: they go through the lower case of the string instead,
+  // which only adds the transient strings of the rows which get there.
+  auto& ir_builder = cgen_state_->ir_builder_;
+  const auto in_map_lv = ir_builder.CreateICmpULT(
+      str_id_lv[0], cgen_state_->llInt(static_cast<int32_t>(lower_id_map->size())));
+  const auto in_map_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "lower.in_map", cgen_state_->current_func_);
+  const auto not_in_map_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "lower.not_in_map", cgen_state_->current_func_);
+  const auto lower_done_bb = llvm::BasicBlock::Create(
+      cgen_state_->context_, "lower.done", cgen_state_->current_func_);
+  ir_builder.CreateCondBr(in_map_lv, in_map_bb, not_in_map_bb);
+  ir_builder.SetInsertPoint(in_map_bb);
+  const auto lower_id_map_lv = ir_builder.CreateIntToPtr(
+      cgen_state_->llInt(reinterpret_cast<int64_t>(lower_id_map->data())),
+      llvm::Type::getInt32PtrTy(cgen_state_->context_));
+  const auto mapped_id_lv =
+      ir_builder.CreateLoad(ir_builder.CreateGEP(lower_id_map_lv, str_id_lv[0]));
+  const auto is_mapped_lv = ir_builder.CreateICmpNE(
+      mapped_id_lv, cgen_state_->llInt(StringDictionary::INVALID_STR_ID));
+  ir_builder.CreateCondBr(is_mapped_lv, lower_done_bb, not_in_map_bb);
+  ir_builder.SetInsertPoint(not_in_map_bb);
+  const auto lowered_id_lv = cgen_state_->emitExternalCall(
       "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+  ir_builder.CreateBr(lower_done_bb);
+  ir_builder.SetInsertPoint(lower_done_bb);
+  auto lower_id_phi = ir_builder.CreatePHI(get_int_type(32, cgen_state_->context_), 2);
+  lower_id_phi->addIncoming(mapped_id_lv, in_map_bb);
+  lower_id_phi->addIncoming(lowered_id_lv, not_in_map_bb);
+  return lower_id_phi;
 }
 
+namespace {
+
+struct AnchoredLikePattern {
+  std::string literal;
+  bool is_prefix;
+};
+
+// Recognizes the LIKE patterns made of a literal and a single '%' wildcard, at their end
+// or at their start, and returns the literal with its escape characters removed. The
+// patterns with a '%' wildcard at both ends are already simple LIKE expressions.
+std::optional<AnchoredLikePattern> get_anchored_like_pattern(const std::string& pattern,
+                                                             const char escape_char) {
+  std::string literal;
+  bool leading_wildcard{false};
+  bool trailing_wildcard{false};
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == escape_char) {
+      if (++i == pattern.size()) {
+        return std::nullopt;
+      }
+      literal.push_back(pattern[i]);
+    } else if (c == '%') {
+      if (i == 0) {
+        leading_wildcard = true;
+      } else if (i == pattern.size() - 1) {
+        trailing_wildcard = true;
+      } else {
+        return std::nullopt;
+      }
+    } else if (c == '_' || c == '[' || c == ']') {
+      return std::nullopt;
+    } else {
+      literal.push_back(c);
+    }
+  }
+  if (leading_wildcard == trailing_wildcard) {
+    return std::nullopt;
+  }
+  return AnchoredLikePattern{literal, trailing_wildcard};
+}
+
+}  // namespace
+
 llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -168,15 +264,29 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
       throw QueryMustRunOnCpu();
     }
   }
-  auto like_expr_arg_lvs = codegen(expr->get_like_expr(), true, co);
+  std::string fn_name{expr->get_is_ilike() ? "string_ilike" : "string_like"};
+  std::vector<llvm::Value*> like_expr_arg_lvs;
+  const auto anchored_pattern =
+      expr->get_is_simple()
+          ? std::nullopt
+          : get_anchored_like_pattern(*pattern->get_constval().stringval, escape_char);
+  if (anchored_pattern) {
+    // prefix and suffix patterns are matched by comparing the literal in place
+    Datum literal_datum;
+    literal_datum.stringval = new std::string(anchored_pattern->literal);
+    const Analyzer::Constant literal(pattern->get_type_info(), false, literal_datum);
+    like_expr_arg_lvs = codegen(&literal, true, co);
+    fn_name += anchored_pattern->is_prefix ? "_prefix" : "_suffix";
+  } else {
+    like_expr_arg_lvs = codegen(expr->get_like_expr(), true, co);
+  }
   CHECK_EQ(size_t(3), like_expr_arg_lvs.size());
   const bool is_nullable{!expr->get_arg()->get_type_info().get_notnull()};
   std::vector<llvm::Value*> str_like_args{
       str_lv[1], str_lv[2], like_expr_arg_lvs[1], like_expr_arg_lvs[2]};
-  std::string fn_name{expr->get_is_ilike() ? "string_ilike" : "string_like"};
   if (expr->get_is_simple()) {
     fn_name += "_simple";
-  } else {
+  } else if (!anchored_pattern) {
     str_like_args.push_back(cgen_state_->llInt(int8_t(escape_char)));
   }
   if (is_nullable) {
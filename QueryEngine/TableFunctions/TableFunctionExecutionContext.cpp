@@ -21,6 +21,10 @@
 #include "QueryEngine/ColumnFetcher.h"
 #include "QueryEngine/GpuMemUtils.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
+#include "Shared/thread_count.h"
+
+#include <future>
+#include <numeric>
 
 namespace {
 
@@ -48,6 +52,51 @@ const int8_t* create_literal_buffer(T literal,
   return nullptr;
 }
 
+const int8_t* create_constant_buffer(
+    const Analyzer::Constant* constant_val,
+    const ExecutorDeviceType device_type,
+    std::vector<std::unique_ptr<char[]>>& literals_owner,
+    CudaAllocator* gpu_allocator) {
+  // TODO(adb): Unify literal handling with rest of system, either in Codegen or as a
+  // separate serialization component
+  const auto const_val_datum = constant_val->get_constval();
+  const auto& ti = constant_val->get_type_info();
+  if (ti.is_fp()) {
+    switch (get_bit_width(ti)) {
+      case 32:
+        return create_literal_buffer(
+            const_val_datum.floatval, device_type, literals_owner, gpu_allocator);
+      case 64:
+        return create_literal_buffer(
+            const_val_datum.doubleval, device_type, literals_owner, gpu_allocator);
+      default:
+        UNREACHABLE();
+    }
+  } else if (ti.is_integer()) {
+    switch (get_bit_width(ti)) {
+      case 8:
+        return create_literal_buffer(
+            const_val_datum.tinyintval, device_type, literals_owner, gpu_allocator);
+      case 16:
+        return create_literal_buffer(
+            const_val_datum.smallintval, device_type, literals_owner, gpu_allocator);
+      case 32:
+        return create_literal_buffer(
+            const_val_datum.intval, device_type, literals_owner, gpu_allocator);
+      case 64:
+        return create_literal_buffer(
+            const_val_datum.bigintval, device_type, literals_owner, gpu_allocator);
+      default:
+        UNREACHABLE();
+    }
+  } else {
+    throw std::runtime_error("Literal value " + constant_val->toString() +
+                             " is not yet supported.");
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
 size_t get_output_row_count(const TableFunctionExecutionUnit& exe_unit,
                             size_t input_element_count) {
   size_t allocated_output_row_count = 0;
@@ -79,6 +128,10 @@ ResultSetPtr TableFunctionExecutionContext::execute(
     const ExecutorDeviceType device_type,
     Executor* executor) {
   CHECK(compilation_context);
+  if (device_type == ExecutorDeviceType::CPU && exe_unit.table_func.isParallel()) {
+    return launchParallelCpuCode(
+        exe_unit, table_infos, compilation_context, column_fetcher, executor);
+  }
   std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
   std::vector<std::unique_ptr<char[]>> literals_owner;
 
@@ -143,61 +196,9 @@ ResultSetPtr TableFunctionExecutionContext::execute(
       }
       col_sizes.push_back(buf_elem_count);
     } else if (const auto& constant_val = dynamic_cast<Analyzer::Constant*>(input_expr)) {
-      // TODO(adb): Unify literal handling with rest of system, either in Codegen or as a
-      // separate serialization component
       col_sizes.push_back(0);
-      const auto const_val_datum = constant_val->get_constval();
-      const auto& ti = constant_val->get_type_info();
-      if (ti.is_fp()) {
-        switch (get_bit_width(ti)) {
-          case 32:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.floatval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          case 64:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.doubleval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          default:
-            UNREACHABLE();
-        }
-      } else if (ti.is_integer()) {
-        switch (get_bit_width(ti)) {
-          case 8:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.tinyintval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          case 16:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.smallintval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          case 32:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.intval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          case 64:
-            col_buf_ptrs.push_back(create_literal_buffer(const_val_datum.bigintval,
-                                                         device_type,
-                                                         literals_owner,
-                                                         device_allocator.get()));
-            break;
-          default:
-            UNREACHABLE();
-        }
-      } else {
-        throw std::runtime_error("Literal value " + constant_val->toString() +
-                                 " is not yet supported.");
-      }
+      col_buf_ptrs.push_back(create_constant_buffer(
+          constant_val, device_type, literals_owner, device_allocator.get()));
     }
   }
   CHECK_EQ(col_buf_ptrs.size(), exe_unit.input_exprs.size());
@@ -309,6 +310,219 @@ ResultSetPtr TableFunctionExecutionContext::launchCpuCode(
   return query_buffers->getResultSetOwned(0);
 }
 
+ResultSetPtr TableFunctionExecutionContext::launchParallelCpuCode(
+    const TableFunctionExecutionUnit& exe_unit,
+    const std::vector<InputTableInfo>& table_infos,
+    const TableFunctionCompilationContext* compilation_context,
+    const ColumnFetcher& column_fetcher,
+    Executor* executor) {
+  auto timer = DEBUG_TIMER(__func__);
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::unique_ptr<char[]>> literals_owner;
+
+  // The column inputs of a table function come from a single cursor, fetch them one
+  // fragment at a time instead of linearizing the whole input.
+  const InputTableInfo* table_info{nullptr};
+  std::vector<size_t> elem_sizes(exe_unit.input_exprs.size(), 0);
+  std::vector<const int8_t*> literal_bufs(exe_unit.input_exprs.size(), nullptr);
+  for (size_t i = 0; i < exe_unit.input_exprs.size(); ++i) {
+    const auto input_expr = exe_unit.input_exprs[i];
+    if (auto col_var = dynamic_cast<Analyzer::ColumnVar*>(input_expr)) {
+      const auto table_id = col_var->get_table_id();
+      auto table_info_it = std::find_if(
+          table_infos.begin(), table_infos.end(), [&table_id](const auto& info) {
+            return info.table_id == table_id;
+          });
+      CHECK(table_info_it != table_infos.end());
+      CHECK(!table_info || table_info == &*table_info_it);
+      table_info = &*table_info_it;
+      elem_sizes[i] = input_expr->get_type_info().get_elem_type().get_size();
+    } else if (const auto& constant_val = dynamic_cast<Analyzer::Constant*>(input_expr)) {
+      literal_bufs[i] = create_constant_buffer(
+          constant_val, ExecutorDeviceType::CPU, literals_owner, nullptr);
+    }
+  }
+  CHECK(table_info);
+
+  // fragment buffers of the column inputs, literal buffers are shared by all fragments
+  std::vector<std::vector<const int8_t*>> frag_col_bufs;
+  std::vector<size_t> frag_elem_counts;
+  for (const auto& fragment : table_info->info.fragments) {
+    std::vector<const int8_t*> col_bufs;
+    std::optional<size_t> elem_count;
+    for (size_t i = 0; i < exe_unit.input_exprs.size(); ++i) {
+      if (auto col_var = dynamic_cast<Analyzer::ColumnVar*>(exe_unit.input_exprs[i])) {
+        auto [col_buf, buf_elem_count] =
+            ColumnFetcher::getOneColumnFragment(executor,
+                                                *col_var,
+                                                fragment,
+                                                Data_Namespace::MemoryLevel::CPU_LEVEL,
+                                                /*device_id=*/0,
+                                                /*device_allocator=*/nullptr,
+                                                /*thread_idx=*/0,
+                                                chunks_owner,
+                                                column_fetcher.columnarized_table_cache_);
+        CHECK(!elem_count || *elem_count == buf_elem_count);
+        elem_count = buf_elem_count;
+        col_bufs.push_back(col_buf);
+      } else {
+        col_bufs.push_back(literal_bufs[i]);
+      }
+    }
+    if (elem_count && *elem_count > 0) {
+      frag_col_bufs.push_back(std::move(col_bufs));
+      frag_elem_counts.push_back(*elem_count);
+    }
+  }
+
+  // Split the fragments into partitions of roughly equal size, so that a single large
+  // fragment (e.g. a columnarized subquery result) still uses all the threads.
+  struct Partition {
+    size_t frag_idx;
+    size_t row_offset;
+    size_t row_count;
+  };
+  const size_t thread_count = cpu_threads();
+  const size_t total_elem_count =
+      std::accumulate(frag_elem_counts.begin(), frag_elem_counts.end(), size_t(0));
+  const size_t partition_size =
+      std::max((total_elem_count + thread_count - 1) / thread_count, size_t(1));
+  std::vector<Partition> partitions;
+  for (size_t frag_idx = 0; frag_idx < frag_elem_counts.size(); ++frag_idx) {
+    for (size_t row_offset = 0; row_offset < frag_elem_counts[frag_idx];
+         row_offset += partition_size) {
+      partitions.push_back(
+          {frag_idx,
+           row_offset,
+           std::min(partition_size, frag_elem_counts[frag_idx] - row_offset)});
+    }
+  }
+
+  // Every partition is called with its own inputs, offset into the fragment buffers, and
+  // its own output buffer.
+  struct PartitionCall {
+    std::vector<const int8_t*> col_buf_ptrs;
+    std::vector<int64_t> col_sizes;
+    std::vector<std::vector<const int8_t*>> col_list_bufs;
+    std::vector<int64_t> output_buffer;
+    size_t allocated_output_row_count;
+    int64_t output_row_count;
+  };
+  const auto num_out_columns = exe_unit.target_exprs.size();
+  std::vector<PartitionCall> calls(partitions.size());
+  for (size_t partition_idx = 0; partition_idx < partitions.size(); ++partition_idx) {
+    const auto& partition = partitions[partition_idx];
+    const auto& col_bufs = frag_col_bufs[partition.frag_idx];
+    auto& call = calls[partition_idx];
+    int col_index = -1;
+    for (size_t i = 0; i < exe_unit.input_exprs.size(); ++i) {
+      const auto& ti = exe_unit.input_exprs[i]->get_type_info();
+      if (!dynamic_cast<Analyzer::ColumnVar*>(exe_unit.input_exprs[i])) {
+        call.col_buf_ptrs.push_back(col_bufs[i]);
+        call.col_sizes.push_back(0);
+        continue;
+      }
+      const auto col_buf = col_bufs[i] + partition.row_offset * elem_sizes[i];
+      if (ti.is_column_list()) {
+        if (col_index == -1) {
+          call.col_list_bufs.push_back({});
+          call.col_list_bufs.back().reserve(ti.get_dimension());
+        }
+        col_index++;
+        call.col_list_bufs.back().push_back(col_buf);
+        if (col_index + 1 == ti.get_dimension()) {
+          col_index = -1;
+        }
+        call.col_buf_ptrs.push_back(
+            reinterpret_cast<const int8_t*>(call.col_list_bufs.back().data()));
+      } else {
+        call.col_buf_ptrs.push_back(col_buf);
+      }
+      call.col_sizes.push_back(partition.row_count);
+    }
+    call.allocated_output_row_count = get_output_row_count(exe_unit, partition.row_count);
+    call.output_buffer.resize(num_out_columns * call.allocated_output_row_count);
+  }
+
+  auto run_partition = [&exe_unit, compilation_context, num_out_columns](
+                           PartitionCall& call) {
+    std::vector<int64_t*> output_col_buf_ptrs;
+    for (size_t i = 0; i < num_out_columns; i++) {
+      output_col_buf_ptrs.emplace_back(call.output_buffer.data() +
+                                       i * call.allocated_output_row_count);
+    }
+    call.output_row_count = call.allocated_output_row_count;
+    const auto err = compilation_context->getFuncPtr()(
+        reinterpret_cast<const int8_t**>(call.col_buf_ptrs.data()),
+        call.col_sizes.data(),
+        output_col_buf_ptrs.data(),
+        &call.output_row_count);
+    if (err) {
+      throw std::runtime_error("Error executing table function: " + std::to_string(err));
+    }
+    if (call.output_row_count < 0 ||
+        static_cast<size_t>(call.output_row_count) > call.allocated_output_row_count) {
+      call.output_row_count = call.allocated_output_row_count;
+    }
+  };
+  std::vector<std::future<void>> workers;
+  for (size_t worker_idx = 0; worker_idx < std::min(thread_count, calls.size());
+       ++worker_idx) {
+    workers.emplace_back(std::async(
+        std::launch::async, [&calls, &run_partition, worker_idx, thread_count] {
+          for (size_t i = worker_idx; i < calls.size(); i += thread_count) {
+            run_partition(calls[i]);
+          }
+        }));
+  }
+  for (auto& worker : workers) {
+    worker.wait();
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+
+  // concatenate the outputs of the partitions, in partition order
+  size_t output_row_count{0};
+  for (const auto& call : calls) {
+    output_row_count += call.output_row_count;
+  }
+  QueryMemoryDescriptor query_mem_desc(executor,
+                                       output_row_count,
+                                       QueryDescriptionType::Projection,
+                                       /*is_table_function=*/true);
+  query_mem_desc.setOutputColumnar(true);
+  for (size_t i = 0; i < num_out_columns; i++) {
+    // All outputs padded to 8 bytes
+    query_mem_desc.addColSlotInfo({std::make_tuple(8, 8)});
+  }
+  auto query_buffers = std::make_unique<QueryMemoryInitializer>(
+      exe_unit,
+      query_mem_desc,
+      /*device_id=*/0,
+      ExecutorDeviceType::CPU,
+      output_row_count,
+      std::vector<std::vector<const int8_t*>>{
+          calls.empty() ? std::vector<const int8_t*>{} : calls.front().col_buf_ptrs},
+      std::vector<std::vector<uint64_t>>{{0}},  // frag offsets
+      row_set_mem_owner_,
+      nullptr,
+      executor);
+  auto group_by_buffers_ptr = query_buffers->getGroupByBuffersPtr();
+  CHECK(group_by_buffers_ptr);
+  auto output_buffers_ptr = reinterpret_cast<int64_t*>(group_by_buffers_ptr[0]);
+  for (size_t i = 0; i < num_out_columns; i++) {
+    auto dst = output_buffers_ptr + i * output_row_count;
+    for (const auto& call : calls) {
+      std::memcpy(dst,
+                  call.output_buffer.data() + i * call.allocated_output_row_count,
+                  call.output_row_count * sizeof(int64_t));
+      dst += call.output_row_count;
+    }
+  }
+  return query_buffers->getResultSetOwned(0);
+}
+
 namespace {
 enum {
   ERROR_BUFFER,
@@ -48,6 +48,14 @@ class TableFunctionExecutionContext {
                              std::vector<int64_t>& col_sizes,
                              const size_t elem_count,
                              Executor* executor);
+  // Calls a parallel table function once per partition of its input rows, on several
+  // threads, and concatenates the outputs of the calls.
+  ResultSetPtr launchParallelCpuCode(
+      const TableFunctionExecutionUnit& exe_unit,
+      const std::vector<InputTableInfo>& table_infos,
+      const TableFunctionCompilationContext* compilation_context,
+      const ColumnFetcher& column_fetcher,
+      Executor* executor);
   ResultSetPtr launchGpuCode(const TableFunctionExecutionUnit& exe_unit,
                              const TableFunctionCompilationContext* compilation_context,
                              std::vector<const int8_t*>& col_buf_ptrs,
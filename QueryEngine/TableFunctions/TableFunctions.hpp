@@ -51,6 +51,27 @@ EXTENSION_NOINLINE int32_t row_copier(const Column<double>& input_col,
   return output_row_count;
 }
 
+// clang-format off
+/*
+  UDTF: row_copier_parallel__cpu_(Column<double>, RowMultiplier) -> Column<double> | parallel
+*/
+// clang-format on
+EXTENSION_NOINLINE int32_t row_copier_parallel__cpu_(const Column<double>& input_col,
+                                                     int copy_multiplier,
+                                                     Column<double>& output_col) {
+  int32_t output_row_count = copy_multiplier * input_col.getSize();
+  if (output_col.getSize() != output_row_count) {
+    return -1;
+  }
+  // the input is only a partition of the rows, so copies of a row are kept adjacent
+  for (int64_t i = 0; i < input_col.getSize(); i++) {
+    for (int c = 0; c < copy_multiplier; c++) {
+      output_col[i * copy_multiplier + c] = input_col[i];
+    }
+  }
+  return output_row_count;
+}
+
 /*
   UDTF: row_adder(RowMultiplier<1>, Cursor<ColumnDouble, ColumnDouble>) -> ColumnDouble
 */
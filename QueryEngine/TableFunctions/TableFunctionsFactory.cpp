@@ -144,7 +144,12 @@ void TableFunctionsFactory::add(const std::string& name,
                                 const std::vector<ExtArgumentType>& input_args,
                                 const std::vector<ExtArgumentType>& output_args,
                                 const std::vector<ExtArgumentType>& sql_args,
-                                bool is_runtime) {
+                                bool is_runtime,
+                                bool is_parallel) {
+  if (is_parallel && sizer.type != OutputBufferSizeType::kUserSpecifiedRowMultiplier) {
+    throw std::runtime_error("Parallel table function " + name +
+                             " must use the RowMultiplier output sizer");
+  }
   for (auto it = functions_.begin(); it != functions_.end();) {
     if (it->second.getName() == name) {
       if (it->second.isRuntime()) {
@@ -159,7 +164,8 @@ void TableFunctionsFactory::add(const std::string& name,
       ++it;
     }
   }
-  auto tf = TableFunction(name, sizer, input_args, output_args, sql_args, is_runtime);
+  auto tf = TableFunction(
+      name, sizer, input_args, output_args, sql_args, is_runtime, is_parallel);
   functions_.emplace(name, tf);
 }
 
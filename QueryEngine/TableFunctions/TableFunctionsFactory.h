@@ -79,6 +79,15 @@
     run-time function. Run-time functions can be overwitten or removed
     by users. Load-time functions cannot be redefined in run-time.
 
+  - a boolean flag specifying the table function can be executed in
+    parallel. A parallel table function is called on the CPU once per
+    partition of its input rows, from several threads, and the outputs
+    of the calls are concatenated. This is only valid for functions
+    whose output rows depend on one input row at a time, so the
+    function must use the RowMultiplier sizer and must not rely on
+    the order of its output rows. A parallel function is declared by
+    appending `| parallel` to its UDTF specification.
+
   Future notes:
 
   - introduce a list of output column names. Currently, the names of
@@ -161,13 +170,15 @@ class TableFunction {
                 const std::vector<ExtArgumentType>& input_args,
                 const std::vector<ExtArgumentType>& output_args,
                 const std::vector<ExtArgumentType>& sql_args,
-                bool is_runtime)
+                bool is_runtime,
+                bool is_parallel = false)
       : name_(name)
       , output_sizer_(output_sizer)
       , input_args_(input_args)
       , output_args_(output_args)
       , sql_args_(sql_args)
-      , is_runtime_(is_runtime) {}
+      , is_runtime_(is_runtime)
+      , is_parallel_(is_parallel) {}
 
   std::vector<ExtArgumentType> getArgs(const bool ensure_column = false) const {
     std::vector<ExtArgumentType> args;
@@ -234,6 +245,8 @@ class TableFunction {
 
   bool isRuntime() const { return is_runtime_; }
 
+  bool isParallel() const { return is_parallel_; }
+
   inline bool isGPU() const {
     return (name_.find("_cpu_", name_.find("__")) == std::string::npos);
   }
@@ -250,6 +263,7 @@ class TableFunction {
     result += "], [";
     result += ExtensionFunctionsWhitelist::toString(sql_args_);
     result += "], is_runtime=" + std::string((is_runtime_ ? "true" : "false"));
+    result += ", is_parallel=" + std::string((is_parallel_ ? "true" : "false"));
     result += ", sizer=" + ::toString(output_sizer_);
     result += ")";
     return result;
@@ -271,6 +285,7 @@ class TableFunction {
   const std::vector<ExtArgumentType> output_args_;
   const std::vector<ExtArgumentType> sql_args_;
   const bool is_runtime_;
+  const bool is_parallel_;
 };
 
 class TableFunctionsFactory {
@@ -280,7 +295,8 @@ class TableFunctionsFactory {
                   const std::vector<ExtArgumentType>& input_args,
                   const std::vector<ExtArgumentType>& output_args,
                   const std::vector<ExtArgumentType>& sql_args,
-                  bool is_runtime = false);
+                  bool is_runtime = false,
+                  bool is_parallel = false);
 
   static std::vector<TableFunction> get_table_funcs(const std::string& name,
                                                     const bool is_gpu);
@@ -22,9 +22,14 @@
 #include "QueryEngine/Execute.h"
 #include "Shared/misc.h"
 #include "Shared/scope.h"
+#include "Shared/thread_count.h"
+
+#include <future>
 
 // By default, when rows are deleted, vacuum fragments with a least 10% deleted rows
 float g_vacuum_min_selectivity{0.1};
+// By default, OPTIMIZE TABLE vacuums every fragment with deleted rows
+float g_optimize_vacuum_min_selectivity{0};
 
 TableOptimizer::TableOptimizer(const TableDescriptor* td,
                                Executor* executor,
@@ -427,7 +432,7 @@ void TableOptimizer::vacuumDeletedRows() const {
   const auto shards = cat_.getPhysicalTablesDescriptors(td_);
   try {
     for (const auto shard : shards) {
-      vacuumFragments(shard);
+      vacuumFragments(shard, {}, g_optimize_vacuum_min_selectivity);
     }
     cat_.checkpoint(table_id);
   } catch (...) {
@@ -443,7 +448,8 @@ void TableOptimizer::vacuumDeletedRows() const {
 }
 
 void TableOptimizer::vacuumFragments(const TableDescriptor* td,
-                                     const std::set<int>& fragment_ids) const {
+                                     const std::set<int>& fragment_ids,
+                                     const float min_selectivity) const {
   // "if not a table that supports delete return,  nothing more to do"
   const ColumnDescriptor* cd = cat_.getDeletedColumn(td);
   if (nullptr == cd) {
@@ -453,33 +459,81 @@ void TableOptimizer::vacuumFragments(const TableDescriptor* td,
   ChunkKey chunk_key_prefix = {cat_.getDatabaseId(), td->tableId, cd->columnId};
   ChunkMetadataVector chunk_metadata_vec;
   cat_.getDataMgr().getChunkMetadataVecForKeyPrefix(chunk_metadata_vec, chunk_key_prefix);
+  ChunkMetadataVector candidate_chunks;
   for (auto& [chunk_key, chunk_metadata] : chunk_metadata_vec) {
     auto fragment_id = chunk_key[CHUNK_KEY_FRAGMENT_IDX];
     // If delete has occurred, only vacuum fragments that are in the fragment_ids set.
     // Empty fragment_ids set implies all fragments.
     if (chunk_metadata->chunkStats.max.tinyintval == 1 &&
         (fragment_ids.empty() || shared::contains(fragment_ids, fragment_id))) {
-      UpdelRoll updel_roll;
-      updel_roll.catalog = &cat_;
-      updel_roll.logicalTableId = cat_.getLogicalTableId(td->tableId);
-      updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
-      updel_roll.table_descriptor = td;
       CHECK_EQ(cd->columnId, chunk_key[CHUNK_KEY_COLUMN_IDX]);
-      const auto chunk = Chunk_NS::Chunk::getChunk(cd,
-                                                   &cat_.getDataMgr(),
-                                                   chunk_key,
-                                                   updel_roll.memoryLevel,
-                                                   0,
-                                                   chunk_metadata->numBytes,
-                                                   chunk_metadata->numElements);
-      td->fragmenter->compactRows(&cat_,
-                                  td,
-                                  fragment_id,
-                                  td->fragmenter->getVacuumOffsets(chunk),
-                                  updel_roll.memoryLevel,
-                                  updel_roll);
-      updel_roll.stageUpdate();
+      candidate_chunks.emplace_back(chunk_key, chunk_metadata);
+    }
+  }
+  if (candidate_chunks.empty()) {
+    return;
+  }
+
+  // Fragments are compacted concurrently, every fragment already compacts its columns
+  // in parallel, so bound the number of fragments in flight by the column count. This
+  // also bounds the number of fragments held in CPU memory at once.
+  const auto column_count =
+      cat_.getAllColumnMetadataForTable(td->tableId, true, false, true).size();
+  const size_t fragments_per_batch = std::max(
+      size_t(1), static_cast<size_t>(cpu_threads()) / std::max(column_count, size_t(1)));
+
+  size_t vacuumed_fragment_count{0};
+  for (size_t batch_start = 0; batch_start < candidate_chunks.size();
+       batch_start += fragments_per_batch) {
+    const auto batch_end =
+        std::min(batch_start + fragments_per_batch, candidate_chunks.size());
+    std::vector<std::unique_ptr<UpdelRoll>> updel_rolls;
+    std::vector<std::future<bool>> compaction_futures;
+    for (size_t i = batch_start; i < batch_end; ++i) {
+      auto updel_roll = updel_rolls.emplace_back(std::make_unique<UpdelRoll>()).get();
+      updel_roll->catalog = &cat_;
+      updel_roll->logicalTableId = cat_.getLogicalTableId(td->tableId);
+      updel_roll->memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+      updel_roll->table_descriptor = td;
+      compaction_futures.emplace_back(std::async(std::launch::async, [&, i, updel_roll] {
+        const auto& [chunk_key, chunk_metadata] = candidate_chunks[i];
+        const auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                                     &cat_.getDataMgr(),
+                                                     chunk_key,
+                                                     updel_roll->memoryLevel,
+                                                     0,
+                                                     chunk_metadata->numBytes,
+                                                     chunk_metadata->numElements);
+        const auto vacuum_offsets = td->fragmenter->getVacuumOffsets(chunk);
+        // Fragments with a deleted rows percentage below the threshold are left as is
+        if (vacuum_offsets.empty() ||
+            vacuum_offsets.size() < min_selectivity * chunk_metadata->numElements) {
+          return false;
+        }
+        td->fragmenter->compactRows(&cat_,
+                                    td,
+                                    chunk_key[CHUNK_KEY_FRAGMENT_IDX],
+                                    vacuum_offsets,
+                                    updel_roll->memoryLevel,
+                                    *updel_roll);
+        return true;
+      }));
+    }
+
+    std::vector<bool> compacted;
+    for (auto& compaction_future : compaction_futures) {
+      compacted.emplace_back(compaction_future.get());
+    }
+    for (size_t i = 0; i < updel_rolls.size(); ++i) {
+      if (compacted[i]) {
+        updel_rolls[i]->stageUpdate();
+        vacuumed_fragment_count++;
+      }
     }
+    LOG(INFO) << "Vacuum of table " << td->tableName << ": processed " << batch_end
+              << " of " << candidate_chunks.size()
+              << " fragments with deleted rows, compacted " << vacuumed_fragment_count
+              << " fragments";
   }
 }
 
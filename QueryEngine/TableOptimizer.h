@@ -61,7 +61,9 @@ class TableOptimizer {
    * When a row is deleted, a boolean deleted system column is set to true. Vacuuming
    * removes all deleted rows from a fragment. Note that vacuuming is a checkpointing
    * operation, so data on disk will increase even though the number of rows for the
-   * current epoch has decreased.
+   * current epoch has decreased. Fragments are compacted in parallel and fragments with
+   * a deleted rows percentage below the configured OPTIMIZE vacuum selectivity threshold
+   * are skipped.
    */
   void vacuumDeletedRows() const;
 
@@ -87,7 +89,8 @@ class TableOptimizer {
                                       const std::set<int>& fragment_ids) const;
 
   void vacuumFragments(const TableDescriptor* td,
-                       const std::set<int>& fragment_ids = {}) const;
+                       const std::set<int>& fragment_ids = {},
+                       const float min_selectivity = 0) const;
 
   DeletedColumnStats getDeletedColumnStats(
       const TableDescriptor* td,
@@ -1,7 +1,7 @@
 """Given a list of input files, scan for lines containing UDTF
 specification statements in the following form:
 
-  UDTF: function_name(<arguments>) -> <output column types>
+  UDTF: function_name(<arguments>) -> <output column types> [| <annotations>]
 
 where <arguments> is a comma-separated list of argument types. The
 argument types specifications are:
@@ -21,6 +21,10 @@ argument types specifications are:
 
 The output column types is a comma-separated list of column types, see above.
 
+The optional annotations are a comma-separated list of:
+    parallel - the function may be called in parallel over partitions
+               of its input rows, see TableFunctionsFactory.h
+
 In addition, the following equivalents are suppored:
   Column<T> == ColumnT
   ColumnList<T> == ColumnListT
@@ -138,7 +142,12 @@ for input_file in sys.argv[1:-1]:
         outputs = line[j+1:]
         if outputs.startswith('->'):
             outputs = outputs[2:]
+        outputs, _, annotations = outputs.partition('|')
         outputs = outputs.split(',')
+        annotations = [a for a in annotations.split(',') if a]
+        for a in annotations:
+            if a != 'parallel':
+                raise ValueError('`%s`: unknown annotation `%s`' % (line, a))
         args = []
         while args_line:
             i = args_line.find(',')
@@ -210,7 +219,10 @@ for input_file in sys.argv[1:-1]:
         input_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(input_types))
         output_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(output_types))
         sql_types = 'std::vector<ExtArgumentType>{%s}' % (', '.join(sql_types)) 
-        add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
+        if 'parallel' in annotations:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s, /*is_runtime=*/false, /*is_parallel=*/true);' % (name, sizer, input_types, output_types, sql_types)
+        else:
+            add = 'TableFunctionsFactory::add("%s", %s, %s, %s, %s);' % (name, sizer, input_types, output_types, sql_types)
         add_stmts.append(add)
 
 content = '''
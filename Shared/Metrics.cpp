@@ -0,0 +1,213 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/Metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <tuple>
+
+#include "Logger/Logger.h"
+
+namespace metrics {
+
+const std::vector<double> kLatencyBucketsMs{
+    1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000};
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds_(bounds)
+    , bucket_counts_(std::make_unique<std::atomic<uint64_t>[]>(bounds.size() + 1)) {
+  CHECK(std::is_sorted(bounds_.begin(), bounds_.end()));
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    bucket_counts_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::observe(const double value) {
+  // buckets are inclusive of their upper bound
+  const size_t bucket =
+      std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+  bucket_counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  auto sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<uint64_t> Histogram::getCumulativeCounts() const {
+  std::vector<uint64_t> counts(bounds_.size() + 1);
+  uint64_t total{0};
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    total += bucket_counts_[i].load(std::memory_order_relaxed);
+    counts[i] = total;
+  }
+  return counts;
+}
+
+Registry& Registry::instance() {
+  static Registry registry;
+  return registry;
+}
+
+Registry::Series& Registry::getSeries(const std::string& name,
+                                      const std::string& help,
+                                      const Type type,
+                                      const std::string& labels) {
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(name, Family{help, type, {}}).first;
+  }
+  CHECK(it->second.type == type) << "Metric " << name << " registered with two types";
+  return it->second.series[labels];
+}
+
+Counter& Registry::counter(const std::string& name,
+                           const std::string& help,
+                           const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& series = getSeries(name, help, Type::Counter, labels);
+  if (!series.counter) {
+    series.counter = std::make_unique<Counter>();
+  }
+  return *series.counter;
+}
+
+Gauge& Registry::gauge(const std::string& name,
+                       const std::string& help,
+                       const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& series = getSeries(name, help, Type::Gauge, labels);
+  if (!series.gauge) {
+    series.gauge = std::make_unique<Gauge>();
+  }
+  return *series.gauge;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const std::string& help,
+                               const std::vector<double>& bounds,
+                               const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& series = getSeries(name, help, Type::Histogram, labels);
+  if (!series.histogram) {
+    series.histogram = std::make_unique<Histogram>(bounds);
+  }
+  return *series.histogram;
+}
+
+size_t Registry::addCallbackGauge(const std::string& name,
+                                  const std::string& help,
+                                  const std::string& labels,
+                                  std::function<double()> callback) {
+  std::lock_guard<std::mutex> lock(callback_mutex_);
+  const auto handle = next_callback_handle_++;
+  callback_gauges_[{name, labels}] = CallbackGauge{help, std::move(callback), handle};
+  return handle;
+}
+
+void Registry::removeCallbackGauge(const size_t handle) {
+  std::lock_guard<std::mutex> lock(callback_mutex_);
+  for (auto it = callback_gauges_.begin(); it != callback_gauges_.end(); ++it) {
+    if (it->second.handle == handle) {
+      callback_gauges_.erase(it);
+      return;
+    }
+  }
+}
+
+namespace {
+
+std::string format_value(const double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.17g", value);
+  return buffer;
+}
+
+std::string series_name(const std::string& name, const std::string& labels) {
+  return labels.empty() ? name : name + "{" + labels + "}";
+}
+
+std::string bucket_labels(const std::string& labels, const std::string& bound) {
+  return (labels.empty() ? std::string() : labels + ",") + "le=\"" + bound + "\"";
+}
+
+void write_header(std::ostringstream& oss,
+                  const std::string& name,
+                  const std::string& help,
+                  const std::string& type) {
+  oss << "# HELP " << name << " " << help << "\n";
+  oss << "# TYPE " << name << " " << type << "\n";
+}
+
+}  // namespace
+
+std::string Registry::toPrometheusText() const {
+  std::ostringstream oss;
+  {
+    // evaluate the callbacks first, see callback_mutex_
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    std::string current_name;
+    for (const auto& [key, callback_gauge] : callback_gauges_) {
+      const auto& [name, labels] = key;
+      if (name != current_name) {
+        write_header(oss, name, callback_gauge.help, "gauge");
+        current_name = name;
+      }
+      oss << series_name(name, labels) << " "
+          << format_value(callback_gauge.callback()) << "\n";
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [name, family] : families_) {
+    switch (family.type) {
+      case Type::Counter:
+        write_header(oss, name, family.help, "counter");
+        for (const auto& [labels, series] : family.series) {
+          oss << series_name(name, labels) << " " << series.counter->value() << "\n";
+        }
+        break;
+      case Type::Gauge:
+        write_header(oss, name, family.help, "gauge");
+        for (const auto& [labels, series] : family.series) {
+          oss << series_name(name, labels) << " " << series.gauge->value() << "\n";
+        }
+        break;
+      case Type::Histogram:
+        write_header(oss, name, family.help, "histogram");
+        for (const auto& [labels, series] : family.series) {
+          const auto& histogram = *series.histogram;
+          const auto& bounds = histogram.getBounds();
+          const auto counts = histogram.getCumulativeCounts();
+          for (size_t i = 0; i < bounds.size(); ++i) {
+            oss << series_name(name + "_bucket",
+                               bucket_labels(labels, format_value(bounds[i])))
+                << " " << counts[i] << "\n";
+          }
+          oss << series_name(name + "_bucket", bucket_labels(labels, "+Inf")) << " "
+              << counts.back() << "\n";
+          oss << series_name(name + "_sum", labels) << " "
+              << format_value(histogram.getSum()) << "\n";
+          oss << series_name(name + "_count", labels) << " " << histogram.getCount()
+              << "\n";
+        }
+        break;
+    }
+  }
+  return oss.str();
+}
+
+}  // namespace metrics
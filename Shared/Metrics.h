@@ -0,0 +1,161 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    Metrics.h
+ * @brief   Process wide registry of engine metrics, exposed in the Prometheus text
+ *          format.
+ *
+ * Metrics are created once, usually into a function local static reference, and then
+ * updated with relaxed atomics on the hot path:
+ *
+ *   static auto& hits = metrics::Registry::instance().counter(
+ *       "omnisci_code_cache_hits_total", "Code cache lookups which found a kernel.");
+ *   hits.increment();
+ *
+ * Values owned by other subsystems, such as buffer pool sizes, are registered as
+ * callback gauges and only evaluated when the registry is scraped.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+class Counter {
+ public:
+  void increment(const uint64_t value = 1) {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+ public:
+  void set(const int64_t value) { value_.store(value, std::memory_order_relaxed); }
+
+  void add(const int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+class Histogram {
+ public:
+  // Upper bounds of the buckets, in increasing order. An implicit +Inf bucket follows.
+  explicit Histogram(const std::vector<double>& bounds);
+
+  void observe(const double value);
+
+  const std::vector<double>& getBounds() const { return bounds_; }
+  // Cumulative count of the observations in every bucket, +Inf bucket last.
+  std::vector<uint64_t> getCumulativeCounts() const;
+  uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+  double getSum() const { return sum_.load(std::memory_order_relaxed); }
+
+ private:
+  const std::vector<double> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> bucket_counts_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<double> sum_{0};
+};
+
+// Bucket bounds for latencies measured in milliseconds.
+extern const std::vector<double> kLatencyBucketsMs;
+
+class Registry {
+ public:
+  static Registry& instance();
+
+  // Returns the metric registered under the name and labels, creating it on first use.
+  // Labels are given in the Prometheus syntax without braces, e.g. level="cpu".
+  Counter& counter(const std::string& name,
+                   const std::string& help,
+                   const std::string& labels = {});
+  Gauge& gauge(const std::string& name,
+               const std::string& help,
+               const std::string& labels = {});
+  Histogram& histogram(const std::string& name,
+                       const std::string& help,
+                       const std::vector<double>& bounds = kLatencyBucketsMs,
+                       const std::string& labels = {});
+
+  // Registers a gauge evaluated at scrape time, replacing any callback registered for
+  // the same name and labels. Returns a handle for removeCallbackGauge().
+  size_t addCallbackGauge(const std::string& name,
+                          const std::string& help,
+                          const std::string& labels,
+                          std::function<double()> callback);
+  // Removes the callback gauge, unless it has been replaced by another registration.
+  void removeCallbackGauge(const size_t handle);
+
+  // Renders all the metrics in the Prometheus text exposition format.
+  std::string toPrometheusText() const;
+
+ private:
+  enum class Type { Counter, Gauge, Histogram };
+
+  struct Series {
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  struct Family {
+    std::string help;
+    Type type;
+    std::map<std::string, Series> series;  // keyed by labels
+  };
+
+  Series& getSeries(const std::string& name,
+                    const std::string& help,
+                    const Type type,
+                    const std::string& labels);
+
+  struct CallbackGauge {
+    std::string help;
+    std::function<double()> callback;
+    size_t handle;
+  };
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+
+  // Callbacks take locks of the subsystems they report on, which may in turn create
+  // metrics while holding them, so they are guarded by a mutex of their own and never
+  // evaluated while holding mutex_.
+  mutable std::mutex callback_mutex_;
+  // keyed by name and labels
+  std::map<std::pair<std::string, std::string>, CallbackGauge> callback_gauges_;
+  size_t next_callback_handle_{1};
+};
+
+}  // namespace metrics
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/MetricsServer.h"
+
+#include <chrono>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "Logger/Logger.h"
+#include "Shared/Metrics.h"
+
+namespace metrics {
+
+namespace {
+
+using boost::asio::ip::tcp;
+
+// Bounds the request head so that a client cannot grow the buffer without limit.
+constexpr size_t kMaxRequestSize{8192};
+// Bounds the lifetime of a connection so that a stalled client does not hold it open.
+constexpr std::chrono::seconds kConnectionTimeout{10};
+
+// Reads the request head of a single HTTP request and answers it, the connection is
+// closed after the response or once the deadline expires.
+class Connection : public std::enable_shared_from_this<Connection> {
+ public:
+  explicit Connection(tcp::socket socket)
+      : socket_(std::move(socket))
+      , deadline_(socket_.get_executor())
+      , request_(kMaxRequestSize) {}
+
+  void start() {
+    auto self = shared_from_this();
+    deadline_.expires_after(kConnectionTimeout);
+    deadline_.async_wait([self](const boost::system::error_code& ec) {
+      if (ec != boost::asio::error::operation_aborted) {
+        boost::system::error_code ignored;
+        self->socket_.close(ignored);
+      }
+    });
+    boost::asio::async_read_until(
+        socket_,
+        request_,
+        "\r\n\r\n",
+        [self](const boost::system::error_code& ec, const size_t) {
+          if (!ec) {
+            self->respond();
+          } else if (ec == boost::asio::error::not_found) {
+            // the request head does not fit in the buffer
+            self->respond("431 Request Header Fields Too Large");
+          } else {
+            self->deadline_.cancel();
+          }
+        });
+  }
+
+ private:
+  void respond() {
+    std::istream request_stream(&request_);
+    std::string method;
+    std::string target;
+    request_stream >> method >> target;
+    if (method != "GET") {
+      respond("405 Method Not Allowed");
+    } else if (target != "/metrics" && !boost::starts_with(target, "/metrics?")) {
+      respond("404 Not Found");
+    } else {
+      respond("200 OK", Registry::instance().toPrometheusText());
+    }
+  }
+
+  void respond(const std::string& status, const std::string& body = {}) {
+    response_ = "HTTP/1.1 " + status +
+                "\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: " +
+                std::to_string(body.size()) +
+                "\r\n"
+                "Connection: close\r\n\r\n" +
+                body;
+    auto self = shared_from_this();
+    boost::asio::async_write(
+        socket_,
+        boost::asio::buffer(response_),
+        [self](const boost::system::error_code&, const size_t) {
+          self->deadline_.cancel();
+          boost::system::error_code ignored;
+          self->socket_.shutdown(tcp::socket::shutdown_both, ignored);
+        });
+  }
+
+  tcp::socket socket_;
+  boost::asio::steady_timer deadline_;
+  boost::asio::streambuf request_;
+  std::string response_;
+};
+
+}  // namespace
+
+MetricsServer::MetricsServer(const std::string& address, const int port)
+    : acceptor_(io_context_,
+                tcp::endpoint(boost::asio::ip::make_address(address), port)) {
+  accept();
+  thread_ = std::thread([this] { io_context_.run(); });
+  LOG(INFO) << "Serving metrics on " << address << ":" << getPort() << "/metrics";
+}
+
+MetricsServer::~MetricsServer() {
+  io_context_.stop();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void MetricsServer::accept() {
+  acceptor_.async_accept([this](const boost::system::error_code& ec,
+                                tcp::socket socket) {
+    if (!ec) {
+      std::make_shared<Connection>(std::move(socket))->start();
+    }
+    if (acceptor_.is_open()) {
+      accept();
+    }
+  });
+}
+
+}  // namespace metrics
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    MetricsServer.h
+ * @brief   Minimal HTTP server answering GET /metrics with the metrics registry.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <boost/asio.hpp>
+
+namespace metrics {
+
+class MetricsServer {
+ public:
+  // Starts serving on the given address and port from a background thread. Throws if
+  // the port cannot be bound.
+  MetricsServer(const std::string& address, const int port);
+
+  ~MetricsServer();
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  int getPort() const { return acceptor_.local_endpoint().port(); }
+
+ private:
+  void accept();
+
+  boost::asio::io_context io_context_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  std::thread thread_;
+};
+
+}  // namespace metrics
@@ -57,6 +57,8 @@ class LruCache {
 
   const_list_iterator_t cend() const { return (cache_items_list_.cend()); }
 
+  size_t size() const { return cache_items_map_.size(); }
+
   void clear() {
     cache_items_list_.clear();
     cache_items_map_.clear();
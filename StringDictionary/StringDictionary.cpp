@@ -19,9 +19,12 @@
 #include <tbb/parallel_for.h>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/locale/conversion.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <algorithm>
 #include <future>
 #include <iostream>
+#include <iterator>
 #include <string_view>
 #include <thread>
 
@@ -88,6 +91,7 @@ string_dict_hash_t hash_string(const std::string_view& str) {
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+bool g_enable_stringdict_trigram_index{false};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -124,6 +128,10 @@ StringDictionary::StringDictionary(const std::string& folder,
         (storage_path / boost::filesystem::path("DictPayload")).string();
     payload_fd_ = checked_open(payload_path.c_str(), recover);
     offset_fd_ = checked_open(offsets_path_.c_str(), recover);
+    if (!recover) {
+      // the strings were truncated, so is the trigram index built from them
+      boost::filesystem::remove(storage_path / boost::filesystem::path("DictTrigrams"));
+    }
     payload_file_size_ = omnisci::file_size(payload_fd_);
     offset_file_size_ = omnisci::file_size(offset_fd_);
   }
@@ -629,6 +637,14 @@ bool is_like(const std::string& str,
                                         escape));
 }
 
+// Threads are only worth starting for a few thousand strings each, which matters for
+// the short candidate lists of the trigram index.
+int get_check_worker_count(const size_t check_count) {
+  constexpr size_t kMinStringsPerWorker{4096};
+  return std::max(
+      1, std::min(cpu_threads(), static_cast<int>(check_count / kMinStringsPerWorker)));
+}
+
 }  // namespace
 
 std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
@@ -647,22 +663,27 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
   }
   std::vector<int32_t> result;
   std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
+  CHECK_LE(generation, str_count_);
+  // only the candidates found by the trigram index, if any, need to be checked
+  const auto candidates = getTrigramCandidatesUnlocked(
+      TrigramIndex::getLikeSubstrings(pattern, is_simple, escape), generation);
+  const size_t check_count = candidates ? candidates->size() : generation;
+  int worker_count = get_check_worker_count(check_count);
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
-  CHECK_LE(generation, str_count_);
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
-                          generation,
+                          &candidates,
+                          check_count,
                           icase,
                           is_simple,
                           escape,
                           worker_idx,
                           worker_count,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
+      for (size_t i = worker_idx; i < check_count; i += worker_count) {
+        const int32_t string_id = candidates ? (*candidates)[i] : i;
         const auto str = getStringUnlocked(string_id);
         if (is_like(str, pattern, icase, is_simple, escape)) {
           worker_results[worker_idx].push_back(string_id);
@@ -919,20 +940,24 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   }
   std::vector<int32_t> result;
   std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
+  CHECK_LE(generation, str_count_);
+  const auto candidates = getTrigramCandidatesUnlocked(
+      TrigramIndex::getRegexpSubstrings(pattern), generation);
+  const size_t check_count = candidates ? candidates->size() : generation;
+  int worker_count = get_check_worker_count(check_count);
   CHECK_GT(worker_count, 0);
   std::vector<std::vector<int32_t>> worker_results(worker_count);
-  CHECK_LE(generation, str_count_);
   for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
     workers.emplace_back([&worker_results,
                           &pattern,
-                          generation,
+                          &candidates,
+                          check_count,
                           escape,
                           worker_idx,
                           worker_count,
                           this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
+      for (size_t i = worker_idx; i < check_count; i += worker_count) {
+        const int32_t string_id = candidates ? (*candidates)[i] : i;
         const auto str = getStringUnlocked(string_id);
         if (is_regexp_like(str, pattern, escape)) {
           worker_results[worker_idx].push_back(string_id);
@@ -952,6 +977,84 @@ std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
   return result;
 }
 
+std::shared_ptr<const StringDictionary::LowerStrings> StringDictionary::getLowerStrings(
+    const size_t generation) const {
+  // The strings are lower cased under the read lock, so that lookups and other queries
+  // aren't blocked meanwhile. Two queries may lower case the same strings.
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  if (client_) {
+    return nullptr;
+  }
+  CHECK_LE(generation, str_count_);
+  const auto cached_lower_strings = lower_strings_cache_;
+  if (cached_lower_strings && cached_lower_strings->ids.size() == str_count_) {
+    return cached_lower_strings;
+  }
+  const size_t str_count = str_count_;
+  auto lower_strings = std::make_shared<LowerStrings>();
+  lower_strings->ids.resize(str_count);
+  size_t first_string_id = 0;
+  if (cached_lower_strings) {
+    // Only the strings added since are lower cased, the missing lower case strings of
+    // the cached ones are looked up again as they may be among them.
+    first_string_id = cached_lower_strings->ids.size();
+    CHECK_LE(first_string_id, str_count);
+    std::copy(cached_lower_strings->ids.begin(),
+              cached_lower_strings->ids.end(),
+              lower_strings->ids.begin());
+    for (const auto& missing_string : cached_lower_strings->missing_strings) {
+      const auto lower_id = getUnlocked(missing_string.second);
+      if (lower_id == INVALID_STR_ID) {
+        lower_strings->missing_strings.push_back(missing_string);
+      } else {
+        lower_strings->ids[missing_string.first] = lower_id;
+      }
+    }
+  }
+  const int worker_count = get_check_worker_count(str_count - first_string_id);
+  CHECK_GT(worker_count, 0);
+  std::vector<std::vector<std::pair<int32_t, std::string>>> worker_missing_strings(
+      worker_count);
+  std::vector<std::thread> workers;
+  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
+    workers.emplace_back([&lower_strings,
+                          &worker_missing_strings,
+                          first_string_id,
+                          str_count,
+                          worker_idx,
+                          worker_count,
+                          this]() {
+      for (size_t string_id = first_string_id + worker_idx; string_id < str_count;
+           string_id += worker_count) {
+        auto lower_str = boost::locale::to_lower(getStringUnlocked(string_id));
+        const auto lower_id = getUnlocked(lower_str);
+        lower_strings->ids[string_id] = lower_id;
+        if (lower_id == INVALID_STR_ID) {
+          worker_missing_strings[worker_idx].emplace_back(string_id,
+                                                          std::move(lower_str));
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  for (auto& missing_strings : worker_missing_strings) {
+    std::move(missing_strings.begin(),
+              missing_strings.end(),
+              std::back_inserter(lower_strings->missing_strings));
+  }
+  read_lock.unlock();
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  // the strings added meanwhile are lower cased by the next call, which extends the
+  // cache from the largest result
+  if (!lower_strings_cache_ ||
+      lower_strings_cache_->ids.size() < lower_strings->ids.size()) {
+    lower_strings_cache_ = lower_strings;
+  }
+  return lower_strings;
+}
+
 std::shared_ptr<const std::vector<std::string>> StringDictionary::copyStrings() const {
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   if (client_) {
@@ -1403,9 +1506,40 @@ bool StringDictionary::checkpoint() noexcept {
         (omnisci::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
   ret = ret && (omnisci::fsync(offset_fd_) == 0);
   ret = ret && (omnisci::fsync(payload_fd_) == 0);
+  if (ret) {
+    // the index is rebuilt from the strings when missing, a failure isn't fatal
+    mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+    if (trigram_index_ && trigram_index_->isDirty()) {
+      trigram_index_->write(
+          (boost::filesystem::path(folder_) / "DictTrigrams").string());
+    }
+  }
   return ret;
 }
 
+TrigramIndex& StringDictionary::getTrigramIndexUnlocked() const {
+  if (!trigram_index_) {
+    trigram_index_ = std::make_unique<TrigramIndex>();
+    if (!isTemp_ && !folder_.empty()) {
+      trigram_index_->read((boost::filesystem::path(folder_) / "DictTrigrams").string(),
+                           str_count_);
+    }
+  }
+  for (size_t string_id = trigram_index_->size(); string_id < str_count_; ++string_id) {
+    trigram_index_->add(string_id, getStringFromStorageFast(string_id));
+  }
+  return *trigram_index_;
+}
+
+std::optional<std::vector<int32_t>> StringDictionary::getTrigramCandidatesUnlocked(
+    const std::vector<std::string>& substrings,
+    const size_t generation) const {
+  if (!g_enable_stringdict_trigram_index) {
+    return std::nullopt;
+  }
+  return getTrigramIndexUnlocked().getCandidates(substrings, generation);
+}
+
 void StringDictionary::buildSortedCache() {
   // This method is not thread-safe.
   const auto cur_cache_size = sorted_cache.size();
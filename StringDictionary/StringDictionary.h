@@ -21,14 +21,17 @@
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
 #include "LeafHostInfo.h"
+#include "TrigramIndex.h"
 
 #include <future>
 #include <map>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern bool g_enable_stringdict_trigram_index;
 
 class StringDictionaryClient;
 
@@ -78,6 +81,20 @@ class StringDictionary {
                                      const char escape,
                                      const size_t generation) const;
 
+  // The lower case strings of all the strings of the dictionary.
+  struct LowerStrings {
+    // Id of the lower case string of each string, INVALID_STR_ID when the lower case
+    // string isn't in the dictionary.
+    std::vector<int32_t> ids;
+    // Lower case strings which aren't in the dictionary, along with the id of the string.
+    std::vector<std::pair<int32_t, std::string>> missing_strings;
+  };
+
+  // Lower cases every string once, in parallel, under the read lock. The result is
+  // cached and extended to the strings added since on the next call. Returns null for
+  // the dictionaries served by a dictionary server.
+  std::shared_ptr<const LowerStrings> getLowerStrings(const size_t generation) const;
+
   std::shared_ptr<const std::vector<std::string>> copyStrings() const;
 
   bool checkpoint() noexcept;
@@ -194,6 +211,14 @@ class StringDictionary {
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
   void invalidateInvertedIndex() noexcept;
+  // Brings the trigram index up to date with the strings, loading the persisted one
+  // first. Requires the write lock.
+  TrigramIndex& getTrigramIndexUnlocked() const;
+  // The strings, below generation, which may contain all the substrings. Returns
+  // nullopt when the trigram index is disabled or can't narrow down the search.
+  std::optional<std::vector<int32_t>> getTrigramCandidatesUnlocked(
+      const std::vector<std::string>& substrings,
+      const size_t generation) const;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
                                  size_t generation);
@@ -226,6 +251,8 @@ class StringDictionary {
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  mutable std::shared_ptr<const LowerStrings> lower_strings_cache_;
+  mutable std::unique_ptr<TrigramIndex> trigram_index_;
   std::unique_ptr<StringDictionaryClient> client_;
   std::unique_ptr<StringDictionaryClient> client_no_timeout_;
 
@@ -85,6 +85,27 @@ int32_t StringDictionaryProxy::getIdOfStringNoGeneration(const std::string& str)
                                            : StringDictionary::INVALID_STR_ID;
 }
 
+const std::vector<int32_t>* StringDictionaryProxy::getLowerIdMap() {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  CHECK_GE(generation_, 0);
+  if (lower_id_map_) {
+    return lower_id_map_.get();
+  }
+  const auto lower_strings = string_dict_->getLowerStrings(generation_);
+  if (!lower_strings) {
+    return nullptr;
+  }
+  CHECK_LE(static_cast<size_t>(generation_), lower_strings->ids.size());
+  auto lower_id_map = std::make_unique<std::vector<int32_t>>(
+      lower_strings->ids.begin(), lower_strings->ids.begin() + generation_);
+  for (auto& lower_id : *lower_id_map) {
+    // lower case strings added to the dictionary after the generation
+    lower_id = truncate_to_generation(lower_id, generation_);
+  }
+  lower_id_map_ = std::move(lower_id_map);
+  return lower_id_map_.get();
+}
+
 std::string StringDictionaryProxy::getString(int32_t string_id) const {
   if (inline_int_null_value<int32_t>() == string_id) {
     return "";
@@ -21,6 +21,7 @@
 #include "StringDictionary.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -52,6 +53,12 @@ class StringDictionaryProxy {
 
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape) const;
 
+  // Maps the id of each string below the generation to the id of its lower case
+  // string, INVALID_STR_ID when the lower case string isn't below the generation. Built
+  // once per proxy from the strings lower cased by the dictionary. Returns null when the
+  // dictionary can't lower case its strings, e.g. on a dictionary server.
+  const std::vector<int32_t>* getLowerIdMap();
+
   const std::map<int32_t, std::string> getTransientMapping() const {
     return transient_int_to_str_;
   }
@@ -61,6 +68,7 @@ class StringDictionaryProxy {
   std::map<int32_t, std::string> transient_int_to_str_;
   std::map<std::string, int32_t> transient_str_to_int_;
   int64_t generation_;
+  std::unique_ptr<std::vector<int32_t>> lower_id_map_;
   mutable mapd_shared_mutex rw_mutex_;
 };
 #endif  // STRINGDICTIONARY_STRINGDICTIONARYPROXY_H
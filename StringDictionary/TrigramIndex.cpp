@@ -0,0 +1,326 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/TrigramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+
+#include "Logger/Logger.h"
+
+namespace {
+
+// Bumped whenever the layout of the file changes.
+constexpr uint64_t kTrigramIndexVersion{2};
+
+// FNV-1a hash of the bytes of the file, written after them so that a truncated or
+// corrupted file gets rebuilt rather than used.
+class Checksum {
+ public:
+  void update(const void* data, const size_t size) {
+    const auto bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+    }
+  }
+
+  uint64_t get() const { return hash_; }
+
+ private:
+  uint64_t hash_{14695981039346656037ULL};
+};
+
+uint32_t lowercase(const char c) {
+  const auto b = static_cast<uint8_t>(c);
+  return ('A' <= b && b <= 'Z') ? b + ('a' - 'A') : b;
+}
+
+uint32_t trigram_key(const char* str) {
+  return (lowercase(str[0]) << 16) | (lowercase(str[1]) << 8) | lowercase(str[2]);
+}
+
+}  // namespace
+
+void TrigramIndex::add(const int32_t string_id, const std::string_view str) {
+  CHECK_EQ(static_cast<size_t>(string_id), indexed_count_);
+  for (size_t i = 0; i + 3 <= str.size(); ++i) {
+    auto& ids = postings_[trigram_key(str.data() + i)];
+    if (ids.empty() || ids.back() != string_id) {
+      ids.push_back(string_id);
+    }
+  }
+  ++indexed_count_;
+  dirty_ = true;
+}
+
+std::optional<std::vector<int32_t>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& substrings,
+    const size_t generation) const {
+  std::vector<uint32_t> keys;
+  for (const auto& substring : substrings) {
+    for (size_t i = 0; i + 3 <= substring.size(); ++i) {
+      keys.push_back(trigram_key(substring.data() + i));
+    }
+  }
+  if (keys.empty()) {
+    return std::nullopt;
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  std::vector<const std::vector<int32_t>*> postings;
+  for (const auto key : keys) {
+    const auto it = postings_.find(key);
+    if (it == postings_.end()) {
+      return std::vector<int32_t>{};
+    }
+    postings.push_back(&it->second);
+  }
+  // intersect the shortest postings first
+  std::sort(postings.begin(),
+            postings.end(),
+            [](const std::vector<int32_t>* lhs, const std::vector<int32_t>* rhs) {
+              return lhs->size() < rhs->size();
+            });
+  const auto& shortest = *postings.front();
+  std::vector<int32_t> candidates(
+      shortest.begin(),
+      std::lower_bound(shortest.begin(), shortest.end(), generation));
+  std::vector<int32_t> intersection;
+  for (size_t i = 1; i < postings.size() && !candidates.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidates.begin(),
+                          candidates.end(),
+                          postings[i]->begin(),
+                          postings[i]->end(),
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  return candidates;
+}
+
+// The file holds the version, the number of strings indexed and the number of
+// trigrams, then for every trigram its key, the number of ids and the ids.
+bool TrigramIndex::write(const std::string& path) {
+  const auto tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    Checksum checksum;
+    const auto write_bytes = [&out, &checksum](const void* data, const size_t size) {
+      out.write(reinterpret_cast<const char*>(data), size);
+      checksum.update(data, size);
+    };
+    const uint64_t header[] = {kTrigramIndexVersion, indexed_count_, postings_.size()};
+    write_bytes(header, sizeof(header));
+    for (const auto& [key, ids] : postings_) {
+      const uint64_t id_count = ids.size();
+      write_bytes(&key, sizeof(key));
+      write_bytes(&id_count, sizeof(id_count));
+      write_bytes(ids.data(), ids.size() * sizeof(int32_t));
+    }
+    const auto checksum_value = checksum.get();
+    out.write(reinterpret_cast<const char*>(&checksum_value), sizeof(checksum_value));
+    out.close();
+    if (!out) {
+      LOG(WARNING) << "Could not write the trigram index " << tmp_path;
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str())) {
+    LOG(WARNING) << "Could not replace the trigram index " << path;
+    return false;
+  }
+  dirty_ = false;
+  return true;
+}
+
+bool TrigramIndex::read(const std::string& path, const size_t max_string_count) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  const auto fail = [this, &path]() {
+    LOG(WARNING) << "Ignoring the trigram index " << path
+                 << ", it will be built from the dictionary again";
+    postings_.clear();
+    indexed_count_ = 0;
+    return false;
+  };
+  Checksum checksum;
+  const auto read_bytes = [&in, &checksum](void* data, const size_t size) {
+    if (!in.read(reinterpret_cast<char*>(data), size)) {
+      return false;
+    }
+    checksum.update(data, size);
+    return true;
+  };
+  uint64_t header[3];
+  if (!read_bytes(header, sizeof(header)) || header[0] != kTrigramIndexVersion ||
+      header[1] > max_string_count) {
+    return fail();
+  }
+  indexed_count_ = header[1];
+  postings_.reserve(header[2]);
+  for (uint64_t i = 0; i < header[2]; ++i) {
+    uint32_t key;
+    uint64_t id_count;
+    if (!read_bytes(&key, sizeof(key)) || !read_bytes(&id_count, sizeof(id_count)) ||
+        id_count > indexed_count_) {
+      return fail();
+    }
+    auto& ids = postings_[key];
+    ids.resize(id_count);
+    if (!read_bytes(ids.data(), id_count * sizeof(int32_t)) ||
+        (id_count && static_cast<uint64_t>(ids.back()) >= indexed_count_)) {
+      return fail();
+    }
+  }
+  uint64_t checksum_value;
+  if (!in.read(reinterpret_cast<char*>(&checksum_value), sizeof(checksum_value)) ||
+      checksum_value != checksum.get() ||
+      in.peek() != std::ifstream::traits_type::eof()) {
+    return fail();
+  }
+  dirty_ = false;
+  return true;
+}
+
+std::vector<std::string> TrigramIndex::getLikeSubstrings(const std::string& pattern,
+                                                         const bool is_simple,
+                                                         const char escape) {
+  if (is_simple) {
+    // simple patterns are the substring to search for, the wildcards stripped
+    return {pattern};
+  }
+  std::vector<std::string> substrings;
+  std::string substring;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const auto c = pattern[i];
+    if (c == escape && i + 1 < pattern.size()) {
+      substring += pattern[++i];
+    } else if (c == '%' || c == '_' || c == '[') {
+      substrings.push_back(std::move(substring));
+      substring.clear();
+      if (c == '[') {
+        // a set of characters, matching any one of them
+        i = pattern.find(']', i + 1);
+        if (i == std::string::npos) {
+          return {};
+        }
+      }
+    } else {
+      substring += c;
+    }
+  }
+  substrings.push_back(std::move(substring));
+  return substrings;
+}
+
+// Only collects the literals outside of groups and bracket expressions, which is
+// conservative but covers the common patterns. Alternations have no required literals.
+std::vector<std::string> TrigramIndex::getRegexpSubstrings(const std::string& pattern) {
+  if (pattern.find('|') != std::string::npos) {
+    return {};
+  }
+  std::vector<std::string> substrings;
+  std::string substring;
+  const auto end_substring = [&substrings, &substring]() {
+    substrings.push_back(std::move(substring));
+    substring.clear();
+  };
+  int depth{0};
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const auto c = pattern[i];
+    if (c == '[') {
+      end_substring();
+      // skip the bracket expression, a leading ']' is part of it
+      size_t j = i + 1;
+      if (j < pattern.size() && pattern[j] == '^') {
+        ++j;
+      }
+      if (j < pattern.size() && pattern[j] == ']') {
+        ++j;
+      }
+      while (j < pattern.size() && pattern[j] != ']') {
+        if (pattern[j] == '[' && j + 1 < pattern.size() &&
+            (pattern[j + 1] == ':' || pattern[j + 1] == '=' || pattern[j + 1] == '.')) {
+          const char terminator[] = {pattern[j + 1], ']', '\0'};
+          j = pattern.find(terminator, j + 2);
+          if (j == std::string::npos) {
+            return {};
+          }
+          j += 2;
+        } else {
+          ++j;
+        }
+      }
+      if (j == pattern.size()) {
+        return {};
+      }
+      i = j;
+      continue;
+    }
+    if (c == '(' || c == ')') {
+      end_substring();
+      depth += c == '(' ? 1 : -1;
+      continue;
+    }
+    if (depth > 0) {
+      if (c == '\\') {
+        ++i;
+      }
+      continue;
+    }
+    switch (c) {
+      case '*':
+      case '?':
+      case '{':
+        // the preceding character is optional
+        if (!substring.empty()) {
+          substring.pop_back();
+        }
+        end_substring();
+        if (c == '{') {
+          i = pattern.find('}', i);
+          if (i == std::string::npos) {
+            return {};
+          }
+        }
+        break;
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        end_substring();
+        break;
+      case '\\':
+        if (i + 1 < pattern.size() && !isalnum(pattern[i + 1])) {
+          substring += pattern[++i];
+        } else {
+          // classes and assertions
+          end_substring();
+          ++i;
+        }
+        break;
+      default:
+        substring += c;
+    }
+  }
+  end_substring();
+  return substrings;
+}
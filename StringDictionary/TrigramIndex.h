@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    TrigramIndex.h
+ * @brief   Trigram postings of the strings of a dictionary, used to find the candidate
+ *          matches of LIKE, ILIKE and REGEXP patterns without scanning every string.
+ *
+ * Trigrams are taken from the lowercased strings, which serves both LIKE and ILIKE. A
+ * string containing all the trigrams of the substrings a pattern requires is only a
+ * candidate: the pattern itself is evaluated on it afterwards.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class TrigramIndex {
+ public:
+  // Indexes the string with the next id, strings are added in the order of their ids.
+  void add(const int32_t string_id, const std::string_view str);
+
+  // Number of strings indexed so far.
+  size_t size() const { return indexed_count_; }
+
+  // Whether strings have been added since the index was last read or written.
+  bool isDirty() const { return dirty_; }
+
+  // Sorted ids, below generation, of the strings containing all the given substrings,
+  // possibly with false positives. Returns nullopt when the substrings are too short to
+  // have trigrams, which leaves no choice but to scan all the strings.
+  std::optional<std::vector<int32_t>> getCandidates(
+      const std::vector<std::string>& substrings,
+      const size_t generation) const;
+
+  // Persists the index, replacing the file atomically. Returns false on failure.
+  bool write(const std::string& path);
+  // Loads the index written by write(), unless it covers more than max_string_count
+  // strings, for instance after a dictionary recovered fewer strings than it held.
+  // Returns false, leaving the index empty, when the file is missing or unusable: of
+  // another version, truncated or failing its checksum.
+  bool read(const std::string& path, const size_t max_string_count);
+
+  // Substrings contained by any string matching the LIKE pattern, which may have sets
+  // of characters in brackets.
+  static std::vector<std::string> getLikeSubstrings(const std::string& pattern,
+                                                    const bool is_simple,
+                                                    const char escape);
+  // Substrings contained by any string matching the POSIX extended regular expression.
+  static std::vector<std::string> getRegexpSubstrings(const std::string& pattern);
+
+ private:
+  std::unordered_map<uint32_t, std::vector<int32_t>> postings_;
+  size_t indexed_count_{0};
+  bool dirty_{false};
+};
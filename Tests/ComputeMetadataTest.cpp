@@ -19,6 +19,7 @@
 #include "Catalog/Catalog.h"
 #include "DBHandlerTestHelpers.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "Shared/scope.h"
 
 #include <gtest/gtest.h>
 #include <string>
@@ -29,6 +30,7 @@
 #endif
 
 extern float g_vacuum_min_selectivity;
+extern float g_optimize_vacuum_min_selectivity;
 
 namespace {
 
@@ -1532,6 +1534,31 @@ TEST_F(OpportunisticVacuumingTest,
                       {{i(3)}, {i(4)}, {i(5)}, {i(6)}, {i(7)}, {i(8)}});
 }
 
+TEST_F(OpportunisticVacuumingTest,
+       OptimizeAndPercentDeletedRowsBelowSelectivityThreshold) {
+  sql("create table test_table (i int) with (fragment_size = 5);");
+  getCatalog().setUncappedTableEpoch("test_table");
+  OptimizeTableVacuumTest::insertRange(1, 15);
+
+  sql("delete from test_table where i = 1 or (i >= 6 and i <= 8) or i >= 11;");
+  assertFragmentRowCount(15);
+
+  const auto optimize_vacuum_min_selectivity = g_optimize_vacuum_min_selectivity;
+  ScopeGuard reset = [optimize_vacuum_min_selectivity] {
+    g_optimize_vacuum_min_selectivity = optimize_vacuum_min_selectivity;
+  };
+  g_optimize_vacuum_min_selectivity = 0.5;
+  sql("optimize table test_table with (vacuum = 'true');");
+
+  // Only fragments with at least 50% deleted rows are compacted
+  assertChunkContentAndMetadata(0, {1, 2, 3, 4, 5});
+  assertChunkContentAndMetadata(1, {9, 10});
+  assertChunkContentAndMetadata(2, {});
+  assertFragmentRowCount(7);
+  sqlAndCompareResult("select * from test_table;",
+                      {{i(2)}, {i(3)}, {i(4)}, {i(5)}, {i(9)}, {i(10)}});
+}
+
 TEST_F(OpportunisticVacuumingTest, DeleteOnShardedTable) {
   sql("create table test_table (i int, shard key(i)) with (fragment_size = 2, "
       "shard_count = 2, max_rollback_epochs = 25);");
@@ -24,6 +24,7 @@
 #include "../QueryEngine/ResultSetReductionJIT.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
+#include "../Shared/Metrics.h"
 #include "../Shared/StringTransform.h"
 #include "../Shared/scope.h"
 #include "../SqliteConnector/SqliteConnector.h"
@@ -57,14 +58,18 @@ extern bool g_enable_left_join_filter_hoisting;
 
 extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_overlaps_hashjoin;
+extern bool g_enable_range_join;
 extern double g_gpu_mem_limit_percent;
 extern size_t g_parallel_top_min;
+extern int64_t g_bitmap_memory_limit;
 
 extern bool g_enable_window_functions;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
 extern bool g_enable_union;
+extern bool g_enable_concurrent_subqueries;
+extern bool g_enable_filter_project_fusion;
 
 extern size_t g_leaf_count;
 extern bool g_cluster;
@@ -1736,11 +1741,54 @@ TEST(Select, InValues) {
     c(R"(SELECT t FROM test WHERE t NOT IN (NULL) GROUP BY t ORDER BY t;)", dt);
     c(R"(SELECT t FROM test WHERE t NOT IN (1001, 1003, 1005, 1007, 1009, -10) GROUP BY t ORDER BY t;)",
       dt);
+    c(R"(SELECT t FROM test WHERE t NOT IN (1001, 1003, 1005, 1007, 1009, NULL) GROUP BY t ORDER BY t;)",
+      dt);
+    c(R"(SELECT ofq FROM test WHERE ofq IN (1, 3, 5, 9223372036854775807) GROUP BY ofq ORDER BY ofq;)",
+      dt);
+    c(R"(SELECT ofq FROM test WHERE ofq NOT IN (-1, 3, 5, 9223372036854775807) GROUP BY ofq ORDER BY ofq;)",
+      dt);
     c(R"(WITH dimensionValues AS (SELECT b FROM test GROUP BY b ORDER BY b) SELECT x FROM test WHERE b in (SELECT b FROM dimensionValues) GROUP BY x ORDER BY x;)",
       dt);
   }
 }
 
+TEST(Select, InSubqueryAboveIntegerSetLimit) {
+  run_ddl_statement("DROP TABLE IF EXISTS in_integer_set_test;");
+  run_ddl_statement("CREATE TABLE in_integer_set_test (i BIGINT);");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS in_integer_set_test;");
+  };
+  run_multiple_agg("INSERT INTO in_integer_set_test VALUES(0);", ExecutorDeviceType::CPU);
+  for (int64_t row_count = 1; row_count < 16384; row_count *= 2) {
+    run_ddl_statement("INSERT INTO in_integer_set_test SELECT i + " +
+                      std::to_string(row_count) + " FROM in_integer_set_test;");
+  }
+
+  const auto max_integer_set_size = g_max_integer_set_size;
+  const auto watchdog_state = g_enable_watchdog;
+  ScopeGuard reset = [max_integer_set_size, watchdog_state] {
+    g_max_integer_set_size = max_integer_set_size;
+    g_enable_watchdog = watchdog_state;
+  };
+  g_max_integer_set_size = 4096;
+
+  // the values of the subquery are too sparse for a bitmap and go to a hash set
+  const std::string in_query{
+      "SELECT COUNT(*) FROM in_integer_set_test WHERE i * 1000003 IN (SELECT i * "
+      "1000003 FROM in_integer_set_test WHERE i > 100);"};
+  const std::string not_in_query{
+      "SELECT COUNT(*) FROM in_integer_set_test WHERE i * 1000003 NOT IN (SELECT i * "
+      "1000003 FROM in_integer_set_test WHERE i > 100);"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    g_enable_watchdog = true;
+    EXPECT_THROW(run_multiple_agg(in_query, dt), std::runtime_error);
+    g_enable_watchdog = false;
+    EXPECT_EQ(int64_t(16283), v<int64_t>(run_simple_agg(in_query, dt)));
+    EXPECT_EQ(int64_t(101), v<int64_t>(run_simple_agg(not_in_query, dt)));
+  }
+}
+
 TEST(Select, FilterAndMultipleAggregation) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -2821,6 +2869,29 @@ TEST(Select, MultiStepQueries) {
   }
 }
 
+TEST(Select, FilterProjectFusion) {
+  const auto enable_filter_project_fusion = g_enable_filter_project_fusion;
+  ScopeGuard reset_enable_filter_project_fusion = [&enable_filter_project_fusion] {
+    g_enable_filter_project_fusion = enable_filter_project_fusion;
+  };
+
+  for (bool enable_fusion : {false, true}) {
+    g_enable_filter_project_fusion = enable_fusion;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT z, SUM(v) FROM (SELECT z, x * 2 + y AS v FROM test) WHERE v > 50 GROUP "
+        "BY z ORDER BY z;",
+        dt);
+      c("SELECT COUNT(*) FROM (SELECT x + y AS s, str FROM test) WHERE s > 48 AND str <> "
+        "'foo';",
+        dt);
+      c("SELECT s, str FROM (SELECT x * y AS s, str FROM test) WHERE s BETWEEN 300 AND "
+        "400 ORDER BY s, str;",
+        dt);
+    }
+  }
+}
+
 TEST(Select, GroupByPushDownFilterIntoExprRange) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -3443,6 +3514,18 @@ TEST(Select, StringsNoneEncoding) {
     c("SELECT COUNT(*) FROM test WHERE real_str LIKE 'real_ba_' or real_str LIKE "
       "'real_fo_';",
       dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE 'real%';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE '%bar';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE '%o';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str NOT LIKE 'real%';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE 'real@_f%' ESCAPE '@';", dt);
+    c("SELECT COUNT(*) FROM test WHERE real_str LIKE '%eal@_foo' ESCAPE '@';", dt);
+    ASSERT_EQ(static_cast<int64_t>(g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str ILIKE '%BaR';", dt)));
+    ASSERT_EQ(static_cast<int64_t>(2 * g_num_rows),
+              v<int64_t>(run_simple_agg(
+                  "SELECT COUNT(*) FROM test WHERE real_str ILIKE 'REAL%';", dt)));
     c("SELECT COUNT(*) FROM test WHERE real_str IS NULL;", dt);
     c("SELECT COUNT(*) FROM test WHERE real_str IS NOT NULL;", dt);
     c("SELECT COUNT(*) FROM test WHERE real_str > 'real_bar';", dt);
@@ -8133,6 +8216,133 @@ TEST(Select, GroupByBaselineHash) {
   }
 }
 
+TEST(Select, GroupByPartitionedOutOfMemory) {
+  // unable to flip the flags on the leaf nodes
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const std::string drop_table{"DROP TABLE IF EXISTS groupby_partition_test;"};
+  run_ddl_statement(drop_table);
+  g_sqlite_comparator.query(drop_table);
+  ScopeGuard drop_test_table = [&drop_table] {
+    run_ddl_statement(drop_table);
+    g_sqlite_comparator.query(drop_table);
+  };
+  // the sparse keys take the baseline hash layout, whose entry count follows the guess
+  run_ddl_statement(
+      "CREATE TABLE groupby_partition_test(k BIGINT, k2 INT, v INT) WITH "
+      "(fragment_size=64);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE groupby_partition_test(k BIGINT, k2 INT, v INT);");
+  TestHelpers::ValuesGenerator gen("groupby_partition_test");
+  for (size_t i = 0; i < 256; ++i) {
+    const auto insert_query = gen(static_cast<int64_t>(i * 1000003),
+                                  static_cast<int32_t>(i % 7),
+                                  static_cast<int32_t>(i % 100));
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+
+  const std::string query{
+      "SELECT k, k2, COUNT(DISTINCT v) FROM groupby_partition_test GROUP BY k, k2 "
+      "ORDER BY k, k2;"};
+  c(query, ExecutorDeviceType::CPU);
+
+  // the count distinct bitmaps of all the groups don't fit, the ones of a partition do,
+  // with entry counts from the cardinality estimation rather than the default guess
+  const auto bitmap_memory_limit = g_bitmap_memory_limit;
+  const auto max_groupby_retry_partitions = g_max_groupby_retry_partitions;
+  const auto big_group_threshold = g_big_group_threshold;
+  ScopeGuard reset = [&] {
+    g_bitmap_memory_limit = bitmap_memory_limit;
+    g_max_groupby_retry_partitions = max_groupby_retry_partitions;
+    g_big_group_threshold = big_group_threshold;
+  };
+  g_big_group_threshold = 1;
+  g_bitmap_memory_limit = 2000;
+  g_max_groupby_retry_partitions = 0;
+  EXPECT_ANY_THROW(run_multiple_agg(query, ExecutorDeviceType::CPU));
+  g_max_groupby_retry_partitions = 64;
+  c(query, ExecutorDeviceType::CPU);
+}
+
+uint64_t get_groupby_partitions() {
+  return metrics::Registry::instance()
+      .counter("omnisci_groupby_partitions_total",
+               "Key partitions aggregated by partitioned group by queries.")
+      .value();
+}
+
+TEST(Select, GroupByPartitionedKeys) {
+  // unable to flip the flags on the leaf nodes
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const std::string drop_table{"DROP TABLE IF EXISTS groupby_partition_keys_test;"};
+  run_ddl_statement(drop_table);
+  g_sqlite_comparator.query(drop_table);
+  ScopeGuard drop_test_table = [&drop_table] {
+    run_ddl_statement(drop_table);
+    g_sqlite_comparator.query(drop_table);
+  };
+  run_ddl_statement(
+      "CREATE TABLE groupby_partition_keys_test(k BIGINT, d DATE, dec DECIMAL(14, 2), "
+      "str TEXT ENCODING DICT(32), v INT, f FLOAT) WITH (fragment_size=64);");
+  g_sqlite_comparator.query(
+      "CREATE TABLE groupby_partition_keys_test(k BIGINT, d DATE, dec DECIMAL(14, 2), "
+      "str TEXT, v INT, f FLOAT);");
+  for (size_t i = 0; i < 300; ++i) {
+    // the keys of every 17th row are null
+    const bool null_keys = i % 17 == 0;
+    const std::string insert_query{
+        "INSERT INTO groupby_partition_keys_test VALUES(" +
+        (null_keys ? "NULL" : std::to_string((i % 150) * 1000003)) + ", " +
+        (null_keys ? "NULL" : "'" + std::to_string(1970 + i % 40) + "-03-15'") + ", " +
+        (null_keys ? "NULL" : std::to_string((i % 120) * 1000003) + ".25") + ", " +
+        (null_keys ? "NULL" : "'str" + std::to_string(i % 9) + "'") + ", " +
+        std::to_string(i) + ", " + std::to_string(i % 13) + ".5);"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+
+  // the keys are sparse enough for the baseline hash layout, which gets partitioned after
+  // the cardinality estimation
+  const auto groupby_partition_bytes = g_groupby_partition_bytes;
+  const auto big_group_threshold = g_big_group_threshold;
+  ScopeGuard reset = [&] {
+    g_groupby_partition_bytes = groupby_partition_bytes;
+    g_big_group_threshold = big_group_threshold;
+  };
+  g_big_group_threshold = 1;
+  for (const std::string query :
+       {"SELECT d, k, COUNT(*), SUM(v) FROM groupby_partition_keys_test GROUP BY d, k "
+        "ORDER BY d, k",
+        "SELECT dec, COUNT(*), MIN(v), MAX(f) FROM groupby_partition_keys_test GROUP BY "
+        "dec ORDER BY dec",
+        "SELECT d, dec, str, COUNT(*), SUM(v * 2) FROM groupby_partition_keys_test WHERE "
+        "v > 20 GROUP BY d, dec, str ORDER BY d, dec, str",
+        "SELECT k, COUNT(DISTINCT str), AVG(f) FROM groupby_partition_keys_test GROUP BY "
+        "k ORDER BY k"}) {
+    // the hash tables of these few groups stay within the default size
+    g_groupby_partition_bytes = groupby_partition_bytes;
+    const auto partitions_before = get_groupby_partitions();
+    c(query + " NULLS FIRST;", query + ";", ExecutorDeviceType::CPU);
+    EXPECT_EQ(partitions_before, get_groupby_partitions()) << query;
+    g_groupby_partition_bytes = 0;
+    c(query + " NULLS FIRST;", query + ";", ExecutorDeviceType::CPU);
+    EXPECT_EQ(partitions_before, get_groupby_partitions()) << query;
+    // more than a hundred groups of at least 24 bytes get a few partitions
+    g_groupby_partition_bytes = 1024;
+    c(query + " NULLS FIRST;", query + ";", ExecutorDeviceType::CPU);
+    const auto partitions_1k = get_groupby_partitions();
+    EXPECT_LT(partitions_before + 1, partitions_1k) << query;
+    // a hash table of a single byte is always too large, the group by gets as many
+    // partitions as it can, aggregated concurrently
+    g_groupby_partition_bytes = 1;
+    c(query + " NULLS FIRST;", query + ";", ExecutorDeviceType::CPU);
+    EXPECT_LT(partitions_1k - partitions_before, get_groupby_partitions() - partitions_1k)
+        << query;
+  }
+}
+
 TEST(Select, GroupByConstrainedByInQueryRewrite) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -8538,6 +8748,8 @@ TEST(Select, Subqueries) {
     c("SELECT COUNT(*) FROM test WHERE ofd IN (SELECT ofd FROM test GROUP BY ofd);", dt);
     c("SELECT COUNT(*) FROM test WHERE ofd NOT IN (SELECT ofd FROM test GROUP BY ofd);",
       dt);
+    c("SELECT COUNT(*) FROM test WHERE x NOT IN (SELECT ofd FROM test);", dt);
+    c("SELECT COUNT(*) FROM test WHERE x IN (SELECT ofd FROM test) OR x > 7;", dt);
     c("SELECT COUNT(*) FROM test WHERE ss IN (SELECT ss FROM test GROUP BY ss);", dt);
     c("SELECT COUNT(*) FROM test WHERE ss NOT IN (SELECT ss FROM test GROUP BY ss);", dt);
     c("SELECT COUNT(*) FROM test WHERE str IN (SELECT str FROM test_in_bitmap GROUP BY "
@@ -8623,6 +8835,30 @@ TEST(Select, Subqueries) {
   }
 }
 
+TEST(Select, ConcurrentSubqueries) {
+  const auto enable_concurrent_subqueries = g_enable_concurrent_subqueries;
+  ScopeGuard reset_enable_concurrent_subqueries = [&enable_concurrent_subqueries] {
+    g_enable_concurrent_subqueries = enable_concurrent_subqueries;
+  };
+  g_enable_concurrent_subqueries = true;
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test WHERE y > 42) AND y > "
+      "(SELECT MIN(y) FROM test_inner) AND str IN (SELECT str FROM test_in_bitmap GROUP "
+      "BY str);",
+      dt);
+    c("SELECT COUNT(*) FROM test WHERE x > (SELECT COUNT(*) FROM test) - 14 AND x < "
+      "(SELECT MAX(x) FROM test_inner) + 1;",
+      dt);
+    // The nested subquery has to run before the subquery it is nested in
+    c("SELECT COUNT(*) FROM test WHERE x IN (SELECT x FROM test WHERE x > (SELECT "
+      "COUNT(*) FROM test WHERE x > 7) - 15) AND y NOT IN (SELECT y FROM test_inner "
+      "GROUP BY y);",
+      dt);
+  }
+}
+
 TEST(Select, Export_Via_Query_Having_Scalar_Subquery) {
   // EXPORT stmt needs "validation_query" to gather some info from the query
   // before doing the actual data export
@@ -10681,6 +10917,123 @@ TEST(Select, Joins_Decimal) {
   }
 }
 
+TEST(Select, Joins_RangeJoin) {
+  // the range join is only built when the loop join isn't trivial
+  const auto trivial_join_loop_state = g_trivial_loop_join_threshold;
+  ScopeGuard reset = [&] { g_trivial_loop_join_threshold = trivial_join_loop_state; };
+  g_trivial_loop_join_threshold = 1;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.y BETWEEN b.y - 1 AND b.y;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.x < b.y AND a.t >= b.t;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.x <= b.x AND a.y > b.x;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.x <= a.y AND b.y >= a.y;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE b.x + 1 > a.x AND a.ofd < b.ofd;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.dd > b.dd;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.m < b.m;", dt);
+    c("SELECT COUNT(*) FROM test a, test b WHERE a.o1 <= b.o1;", dt);
+    c("SELECT a.x, b.y, COUNT(*) FROM test a, test b WHERE a.t BETWEEN b.t AND b.t + 1 "
+      "GROUP BY a.x, b.y ORDER BY a.x, b.y;",
+      dt);
+    if (!g_aggregator) {
+      const std::string query{
+          "SELECT COUNT(*) FROM test a, test b WHERE a.y BETWEEN b.y - 1 AND b.y;"};
+      EXPECT_NO_THROW(run_multiple_agg(query, dt, false));
+      // the loop join is expected to be cheaper on a bound open on one side, the range
+      // join is still built when the query can't fall back to the loop join
+      EXPECT_NO_THROW(run_multiple_agg(
+          "SELECT COUNT(*) FROM test a, test b WHERE a.dd > b.dd;", dt, false));
+      const auto enable_range_join_state = g_enable_range_join;
+      ScopeGuard reset_range_join = [&] {
+        g_enable_range_join = enable_range_join_state;
+      };
+      g_enable_range_join = false;
+      EXPECT_ANY_THROW(run_multiple_agg(query, dt, false));
+    }
+  }
+}
+
+uint64_t get_join_key_range_skipped_fragments() {
+  return metrics::Registry::instance()
+      .counter("omnisci_skipped_fragments_total",
+               "Fragments skipped by the runtime fragment skipping, by reason.",
+               "reason=\"join_key_range\"")
+      .value();
+}
+
+TEST(Select, Joins_RuntimeFilters) {
+  // unable to flip the flag on the leaf nodes
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const std::string drop_dim{"DROP TABLE IF EXISTS join_filter_dim;"};
+  const std::string drop_far_dim{"DROP TABLE IF EXISTS join_filter_far_dim;"};
+  for (const auto& drop : {drop_dim, drop_far_dim}) {
+    run_ddl_statement(drop);
+    g_sqlite_comparator.query(drop);
+  }
+  ScopeGuard drop_dim_tables = [&drop_dim, &drop_far_dim] {
+    for (const auto& drop : {drop_dim, drop_far_dim}) {
+      run_ddl_statement(drop);
+      g_sqlite_comparator.query(drop);
+    }
+  };
+  // the sparse keys make a perfect hash table large enough to be Bloom filtered
+  run_ddl_statement("CREATE TABLE join_filter_dim(k INT, v INT) WITH (fragment_size=2);");
+  g_sqlite_comparator.query("CREATE TABLE join_filter_dim(k INT, v INT);");
+  for (const auto& values : {"(7, 1)", "(2000000, 2)", "(-3, 3)", "(NULL, 4)"}) {
+    const std::string insert_query{"INSERT INTO join_filter_dim VALUES" +
+                                   std::string(values) + ";"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+  // all the keys are above the x values of test, 7 and 8
+  run_ddl_statement("CREATE TABLE join_filter_far_dim(k INT, v INT);");
+  g_sqlite_comparator.query("CREATE TABLE join_filter_far_dim(k INT, v INT);");
+  for (const auto& values : {"(1000, 1)", "(2001000, 2)", "(NULL, 3)"}) {
+    const std::string insert_query{"INSERT INTO join_filter_far_dim VALUES" +
+                                   std::string(values) + ";"};
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+
+  const auto runtime_join_filters_state = g_enable_runtime_join_filters;
+  ScopeGuard reset = [&] { g_enable_runtime_join_filters = runtime_join_filters_state; };
+  for (const bool enable_runtime_join_filters : {true, false}) {
+    g_enable_runtime_join_filters = enable_runtime_join_filters;
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM test, join_filter_dim WHERE test.x = join_filter_dim.k;",
+        dt);
+      c("SELECT test.y, join_filter_dim.v FROM test JOIN join_filter_dim ON test.x = "
+        "join_filter_dim.k ORDER BY test.y, join_filter_dim.v;",
+        dt);
+      c("SELECT COUNT(*) FROM test LEFT JOIN join_filter_dim ON test.x = "
+        "join_filter_dim.k AND join_filter_dim.v > 1;",
+        dt);
+      c("SELECT COUNT(*) FROM test a JOIN join_filter_dim b ON a.x = b.k JOIN test_inner "
+        "c ON a.x = c.x;",
+        dt);
+
+      // every fragment of test is outside of the key range of the inner rows
+      auto skipped_fragments = get_join_key_range_skipped_fragments();
+      c("SELECT COUNT(*) FROM test JOIN join_filter_far_dim ON test.x = "
+        "join_filter_far_dim.k;",
+        dt);
+      if (enable_runtime_join_filters) {
+        EXPECT_GT(get_join_key_range_skipped_fragments(), skipped_fragments);
+      } else {
+        EXPECT_EQ(get_join_key_range_skipped_fragments(), skipped_fragments);
+      }
+      // the outer rows of a left join are kept without a match
+      skipped_fragments = get_join_key_range_skipped_fragments();
+      c("SELECT COUNT(*) FROM test LEFT JOIN join_filter_far_dim ON test.x = "
+        "join_filter_far_dim.k;",
+        dt);
+      EXPECT_EQ(get_join_key_range_skipped_fragments(), skipped_fragments);
+    }
+  }
+}
+
 TEST(Select, RuntimeFunctions) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ExplainAnalyzeTest.cpp
+ * @brief Test suite for EXPLAIN and EXPLAIN ANALYZE queries
+ */
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "DBHandlerTestHelpers.h"
+#include "TestHelpers.h"
+
+class ExplainAnalyzeTest : public DBHandlerTestFixture {
+ protected:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    sql("DROP TABLE IF EXISTS explain_analyze_test;");
+    sql("CREATE TABLE explain_analyze_test (k INT, v INT) WITH (fragment_size = 4);");
+    for (int i = 0; i < 10; ++i) {
+      sql("INSERT INTO explain_analyze_test VALUES(" + std::to_string(i % 4) + ", " +
+          std::to_string(i) + ");");
+    }
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS explain_analyze_test;");
+    DBHandlerTestFixture::TearDown();
+  }
+
+  static std::string getExplanation(const std::string& query) {
+    TQueryResult result;
+    sql(result, query);
+    EXPECT_EQ(size_t(1), result.row_set.columns.size());
+    if (result.row_set.columns.empty()) {
+      return {};
+    }
+    const auto& explanation = result.row_set.columns[0].data.str_col;
+    EXPECT_EQ(size_t(1), explanation.size());
+    return explanation.empty() ? std::string{} : explanation[0];
+  }
+
+  // The first step filters and aggregates the 3 fragments of the table, the first
+  // fragment holds v from 0 to 3 and is skipped. The following steps filter and sort
+  // the 4 groups.
+  static constexpr const char* multi_step_query =
+      "SELECT k, cnt FROM (SELECT k, COUNT(*) AS cnt FROM explain_analyze_test WHERE v > "
+      "3 GROUP BY k) WHERE cnt > 1 ORDER BY k";
+};
+
+TEST_F(ExplainAnalyzeTest, MultiStepProfile) {
+  const auto profile_str =
+      getExplanation(std::string("EXPLAIN ANALYZE ") + multi_step_query + ";");
+  rapidjson::Document profile;
+  profile.Parse(profile_str.c_str());
+  ASSERT_FALSE(profile.HasParseError()) << profile_str;
+  ASSERT_TRUE(profile.IsObject());
+  ASSERT_TRUE(profile.HasMember("steps"));
+  ASSERT_TRUE(profile.HasMember("result_conversion_ms"));
+  EXPECT_GE(profile["result_conversion_ms"].GetInt64(), 0);
+
+  const auto& steps = profile["steps"];
+  ASSERT_TRUE(steps.IsArray());
+  ASSERT_GE(steps.Size(), 2U);
+  for (const auto& step : steps.GetArray()) {
+    EXPECT_FALSE(std::string(step["node"].GetString()).empty());
+    EXPECT_GE(step["total_ms"].GetInt64(), step["compile_ms"].GetInt64());
+    EXPECT_GE(step["compile_ms"].GetInt64(), 0);
+    EXPECT_GE(step["reduction_ms"].GetInt64(), 0);
+    uint64_t kernel_rows_in{0};
+    for (const auto& kernel : step["kernels"].GetArray()) {
+      EXPECT_EQ(std::string("CPU"), kernel["device_type"].GetString());
+      EXPECT_GE(kernel["time_ms"].GetInt64(), 0);
+      EXPECT_LE(kernel["time_ms"].GetInt64(), step["total_ms"].GetInt64());
+      kernel_rows_in += kernel["rows_in"].GetUint64();
+    }
+    EXPECT_EQ(kernel_rows_in, step["rows_in"].GetUint64());
+  }
+
+  const auto& aggregate_step = steps[0];
+  EXPECT_EQ(2U, aggregate_step["fragments_scanned"].GetUint64());
+  EXPECT_EQ(1U, aggregate_step["fragments_skipped"].GetUint64());
+  EXPECT_EQ(6U, aggregate_step["rows_in"].GetUint64());
+  EXPECT_EQ(4U, aggregate_step["rows_out"].GetUint64());
+  EXPECT_FALSE(aggregate_step["kernels"].GetArray().Empty());
+
+  const auto& last_step = steps[steps.Size() - 1];
+  EXPECT_EQ(2U, last_step["rows_out"].GetUint64());
+
+  // the profiled query leaves nothing behind for the following ones
+  sqlAndCompareResult(std::string(multi_step_query) + ";", {{i(0), i(2)}, {i(1), i(2)}});
+}
+
+TEST_F(ExplainAnalyzeTest, BytesFetchedFromSourceLevel) {
+  // bytes the aggregate step fetched from disk and from the CPU buffer pool
+  const auto get_bytes_fetched = []() -> std::pair<uint64_t, uint64_t> {
+    rapidjson::Document profile;
+    profile.Parse(
+        getExplanation(std::string("EXPLAIN ANALYZE ") + multi_step_query + ";")
+            .c_str());
+    EXPECT_FALSE(profile.HasParseError());
+    if (profile.HasParseError()) {
+      return {0, 0};
+    }
+    const auto& bytes_fetched = profile["steps"][0]["bytes_fetched"];
+    return {bytes_fetched["disk"].GetUint64(), bytes_fetched["cpu"].GetUint64()};
+  };
+  getCatalog().getDataMgr().clearMemory(Data_Namespace::MemoryLevel::CPU_LEVEL);
+  const auto cold_bytes_fetched = get_bytes_fetched();
+  EXPECT_GT(cold_bytes_fetched.first, 0U);
+  EXPECT_EQ(0U, cold_bytes_fetched.second);
+  // the chunks stay in the CPU buffer pool for the next query
+  const auto warm_bytes_fetched = get_bytes_fetched();
+  EXPECT_EQ(0U, warm_bytes_fetched.first);
+  EXPECT_EQ(cold_bytes_fetched.first, warm_bytes_fetched.second);
+}
+
+TEST_F(ExplainAnalyzeTest, Explain) {
+  const auto explanation =
+      getExplanation(std::string("EXPLAIN ") + multi_step_query + ";");
+  EXPECT_EQ(size_t(0), explanation.find("IR for the ")) << explanation;
+  EXPECT_EQ(std::string::npos, explanation.find("\"steps\"")) << explanation;
+
+  sqlAndCompareResult(std::string(multi_step_query) + ";", {{i(0), i(2)}, {i(1), i(2)}});
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+  DBHandlerTestFixture::initTestArgs(argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
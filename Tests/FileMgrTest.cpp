@@ -1014,6 +1014,73 @@ TEST_F(DataCompactionTest, RecoveryFromDeleteEmptyFileStatus) {
   assertBufferValueAndMetadata(1, "i");
 }
 
+class PageManifestTest : public DataCompactionTest {
+ protected:
+  bool pageManifestExists() {
+    return boost::filesystem::exists(
+        getFileMgr()->getFilePath(File_Namespace::FileMgr::PAGE_MANIFEST));
+  }
+};
+
+TEST_F(PageManifestTest, ReopenFromManifest) {
+  sql("create table test_table (i int);");
+  auto buffer = createBuffer("i");
+  writeMultipleValues(buffer, 1, 3);
+  assertStorageStats(1, 4093, 1, 253);
+  ASSERT_TRUE(pageManifestExists());
+
+  // Re-initializing the file mgr should load the page map from the manifest and end up
+  // with the same pages as a page scan
+  deleteFileMgr();
+  getFileMgr();
+  EXPECT_TRUE(pageManifestExists());
+  assertStorageStats(1, 4093, 1, 253);
+  assertBufferValueAndMetadata(3, "i");
+
+  // Pages keep getting allocated correctly after loading from the manifest
+  writeValue(getFileMgr()->getBuffer(getChunkKey("i")), 4);
+  assertBufferValueAndMetadata(4, "i");
+}
+
+TEST_F(PageManifestTest, WriteAfterCheckpointInvalidatesManifest) {
+  sql("create table test_table (i int);");
+  auto buffer = createBuffer("i");
+  writeValue(buffer, 1);
+  ASSERT_TRUE(pageManifestExists());
+
+  std::vector<int32_t> data{2};
+  writeData(buffer, data, 0);
+  EXPECT_FALSE(pageManifestExists());
+
+  // The uncheckpointed write gets rolled back by the page scan
+  deleteFileMgr();
+  getFileMgr();
+  assertBufferValueAndMetadata(1, "i");
+}
+
+TEST_F(PageManifestTest, CorruptManifestFallsBackToPageScan) {
+  sql("create table test_table (i int);");
+  auto buffer = createBuffer("i");
+  writeMultipleValues(buffer, 1, 2);
+  ASSERT_TRUE(pageManifestExists());
+
+  auto manifest_path =
+      getFileMgr()->getFilePath(File_Namespace::FileMgr::PAGE_MANIFEST).string();
+  deleteFileMgr();
+  {
+    std::fstream manifest_file{manifest_path,
+                               std::ios::in | std::ios::out | std::ios::binary};
+    manifest_file.seekp(sizeof(int32_t) * 3);
+    const char garbage{0x7f};
+    manifest_file.write(&garbage, sizeof(garbage));
+  }
+
+  getFileMgr();
+  EXPECT_FALSE(pageManifestExists());
+  assertStorageStats(1, 4094, 1, 254);
+  assertBufferValueAndMetadata(2, "i");
+}
+
 class MaxRollbackEpochTest : public FileMgrTest {
  protected:
   void SetUp() override {
@@ -29,7 +29,10 @@
 #include "DataMgr/ForeignStorage/ForeignTableRefresh.h"
 #include "Geospatial/Types.h"
 #include "ImportExport/DelimitedParserUtils.h"
+#include "Shared/Metrics.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
+#include "ThriftHandler/ForeignTableFileWatcher.h"
 #include "ThriftHandler/ForeignTableRefreshScheduler.h"
 
 #ifndef BASE_PATH
@@ -39,6 +42,8 @@
 extern bool g_enable_fsi;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_seconds_refresh;
+extern bool g_enable_foreign_table_file_change_refresh;
+extern size_t g_foreign_table_read_ahead_threads;
 
 std::string test_binary_file_path;
 
@@ -724,6 +729,62 @@ TEST_F(SelectQueryTest, ParquetStringDictionaryEncodedMetadataTest) {
                        result);
 }
 
+TEST_F(SelectQueryTest, ParquetStringDictionaryPagesAcrossRowGroups) {
+  // Each row group has its own dictionary page, the first one holds a, b, c and d and
+  // the others a single string, so the same index maps to different strings in the
+  // row groups of a chunk.
+  const auto& query = getCreateForeignTableQuery("(txt TEXT ENCODING DICT (32) )",
+                                                 {{"fragment_size", "8"}},
+                                                 "strings_repeating",
+                                                 "parquet");
+  sql(query);
+
+  TQueryResult result;
+  sql(result,
+      "SELECT txt, COUNT(*) FROM test_foreign_table GROUP BY txt ORDER BY txt;");
+  assertResultSetEqual({{"a", i(5)}, {"b", i(5)}, {"c", i(5)}, {"d", i(5)}}, result);
+}
+
+TEST_F(SelectQueryTest, ParquetStringDictionaryPagesWithNulls) {
+  // row groups of 3 rows, each chunk spans 2 row groups
+  const auto& query = getCreateForeignTableQuery(
+      "( id INT, txt1 TEXT ENCODING NONE, txt2 TEXT ENCODING DICT (32), txt3 TEXT "
+      "ENCODING DICT (16), txt4 TEXT ENCODING DICT (8))",
+      {{"fragment_size", "6"}},
+      "strings_with_all_null_placement_permutations",
+      "parquet");
+  sql(query);
+
+  TQueryResult result;
+  sql(result, "SELECT * FROM test_foreign_table WHERE id > 9 ORDER BY id;");
+  // clang-format off
+  assertResultSetEqual(
+      {
+        { i(10), "txt10", "txt10", "txt10", "txt10"},
+        { i(11), "txt11", "txt11", "txt11", "txt11"},
+        { i(12), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(13), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(14), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(15), "txt15", "txt15", "txt15", "txt15"},
+        { i(16), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(17), "txt17", "txt17", "txt17", "txt17"},
+        { i(18), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(19), "txt19", "txt19", "txt19", "txt19"},
+        { i(20), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(21), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(22), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(23), (void*)0, (void*)0, (void*)0, (void*)0 },
+        { i(24), (void*)0, (void*)0, (void*)0, (void*)0 }
+      },
+      result);
+  // clang-format on
+
+  sql(result,
+      "SELECT COUNT(txt2), COUNT(DISTINCT txt3), COUNT(*) FROM test_foreign_table "
+      "WHERE txt4 LIKE 'txt1%';");
+  assertResultSetEqual({{i(6), i(6), i(6)}}, result);
+}
+
 TEST_F(SelectQueryTest, ParquetNumericAndBooleanTypesWithAllNullPlacementPermutations) {
   const auto& query = getCreateForeignTableQuery(
       "( id INT, bool BOOLEAN, i8 TINYINT, u8 SMALLINT, i16 SMALLINT, "
@@ -1419,6 +1480,41 @@ TEST_F(SelectQueryTest, RowGroupSizeLargerThanFragmentSize) {
           getDataFilesPath() + "row_group_size_2.parquet");
 }
 
+uint64_t get_read_ahead_chunks() {
+  return metrics::Registry::instance()
+      .counter("omnisci_foreign_table_read_ahead_chunks_total",
+               "Foreign table chunks read by the read ahead threads, including the ones "
+               "a kernel loaded into the CPU buffer pool first.")
+      .value();
+}
+
+TEST_F(SelectQueryTest, ReadAheadMultipleFragments) {
+  const auto& query = getCreateForeignTableQuery(
+      "(t TEXT, i BIGINT, f DOUBLE)", {{"fragment_size", "1"}}, "example_2", "csv");
+
+  const auto read_ahead_threads = g_foreign_table_read_ahead_threads;
+  ScopeGuard reset_read_ahead_threads = [read_ahead_threads] {
+    g_foreign_table_read_ahead_threads = read_ahead_threads;
+  };
+  for (const size_t thread_count : {0, 1, 4}) {
+    // a new table every time, with none of its chunks in the buffer pool or the cache
+    sql("DROP FOREIGN TABLE IF EXISTS test_foreign_table;");
+    sql(query);
+    g_foreign_table_read_ahead_threads = thread_count;
+    const auto chunks_before = get_read_ahead_chunks();
+    sqlAndCompareResult("SELECT t, sum(i), max(f) FROM test_foreign_table GROUP BY t "
+                        "ORDER BY t;",
+                        {{"a", i(1), 1.1}, {"aa", i(3), 2.2}, {"aaa", i(6), 3.3}});
+    sqlAndCompareResult("SELECT i, f FROM test_foreign_table WHERE i > 1 ORDER BY f;",
+                        {{i(2), 2.2}, {i(2), 2.2}, {i(3), 3.3}});
+    if (thread_count) {
+      EXPECT_LT(chunks_before, get_read_ahead_chunks()) << thread_count;
+    } else {
+      EXPECT_EQ(chunks_before, get_read_ahead_chunks());
+    }
+  }
+}
+
 TEST_F(SelectQueryTest, DecimalIntEncoding) {
   const auto& query = getCreateForeignTableQuery(
       "(decimal_int_32 DECIMAL(9, 5), decimal_int_64 DECIMAL(15, 10))",
@@ -4090,7 +4186,8 @@ TEST_F(ScheduledRefreshTest, InvalidRefreshTimingType) {
   auto query = getCreateScheduledRefreshTableQuery("1S", "all", 1, "invalid");
   queryAndAssertException(query,
                           "Exception: Invalid value provided for the REFRESH_TIMING_TYPE "
-                          "option. Value must be \"MANUAL\" or \"SCHEDULED\".");
+                          "option. Value must be \"MANUAL\", \"SCHEDULED\" or "
+                          "\"FILE_CHANGE\".");
 }
 
 TEST_F(ScheduledRefreshTest, MissingStartDateTime) {
@@ -4200,6 +4297,166 @@ TEST_F(ScheduledRefreshTest, SecondsIntervalDisabled) {
       query, "Exception: Invalid value provided for the REFRESH_INTERVAL option.");
 }
 
+class FileChangeRefreshTest : public RefreshTests {
+ protected:
+  static void SetUpTestSuite() {
+    createDBHandler();
+    foreign_storage::ForeignTableFileWatcher::setDebounceDuration(100);
+  }
+
+  static void TearDownTestSuite() { stopWatcher(); }
+
+  static void startWatcher() {
+    is_program_running_ = true;
+    foreign_storage::ForeignTableFileWatcher::start(is_program_running_);
+    ASSERT_TRUE(foreign_storage::ForeignTableFileWatcher::isRunning());
+  }
+
+  static void stopWatcher() {
+    is_program_running_ = false;
+    foreign_storage::ForeignTableFileWatcher::stop();
+    ASSERT_FALSE(foreign_storage::ForeignTableFileWatcher::isRunning());
+  }
+
+  void SetUp() override {
+    g_enable_foreign_table_file_change_refresh = true;
+    ForeignTableTest::SetUp();
+    boost::filesystem::create_directory(REFRESH_TEST_DIR);
+    sql("DROP FOREIGN TABLE IF EXISTS test_foreign_table;");
+    foreign_storage::ForeignTableFileWatcher::resetHasRefreshedTable();
+    startWatcher();
+  }
+
+  void TearDown() override {
+    stopWatcher();
+    sql("DROP FOREIGN TABLE IF EXISTS test_foreign_table;");
+    boost::filesystem::remove_all(REFRESH_TEST_DIR);
+    g_enable_foreign_table_file_change_refresh = false;
+    ForeignTableTest::TearDown();
+  }
+
+  void setTestFile(const std::string& file_name) {
+    bf::copy_file(getDataFilesPath() + "/" + file_name,
+                  REFRESH_TEST_DIR + "/test.csv",
+                  bf::copy_option::overwrite_if_exists);
+  }
+
+  std::string getCreateFileChangeRefreshTableQuery(
+      const std::string& update_type,
+      const std::string& max_staleness = {}) {
+    auto test_file_path = boost::filesystem::canonical(REFRESH_TEST_DIR) / "test.csv";
+    std::string query =
+        "CREATE FOREIGN TABLE test_foreign_table (i INTEGER) server "
+        "omnisci_local_csv with (file_path = '" +
+        test_file_path.string() + "', refresh_update_type = '" + update_type +
+        "', refresh_timing_type = 'file_change'";
+    if (!max_staleness.empty()) {
+      query += ", refresh_max_staleness = '" + max_staleness + "'";
+    }
+    query += ");";
+    return query;
+  }
+
+  // The table is refreshed once when it starts being watched, and then on each change.
+  void waitForFileChangeRefresh() {
+    constexpr size_t max_check_count = 20;
+    size_t count = 0;
+    while (!foreign_storage::ForeignTableFileWatcher::hasRefreshedTable() &&
+           count < max_check_count) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+      count++;
+    }
+    if (!foreign_storage::ForeignTableFileWatcher::hasRefreshedTable()) {
+      throw std::runtime_error{
+          "Max wait time for file change table refresh has been exceeded."};
+    }
+    foreign_storage::ForeignTableFileWatcher::resetHasRefreshedTable();
+  }
+
+  inline static const std::string REFRESH_TEST_DIR{"./fsi_file_change_refresh_test"};
+  inline static std::atomic<bool> is_program_running_;
+};
+
+TEST_F(FileChangeRefreshTest, BatchMode) {
+  setTestFile("0.csv");
+  sql(getCreateFileChangeRefreshTableQuery("all"));
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(0)}});
+  waitForFileChangeRefresh();
+
+  setTestFile("1.csv");
+  waitForFileChangeRefresh();
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(1)}});
+}
+
+TEST_F(FileChangeRefreshTest, AppendMode) {
+  setTestFile("1.csv");
+  sql(getCreateFileChangeRefreshTableQuery("append"));
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(1)}});
+  waitForFileChangeRefresh();
+
+  setTestFile("two_row_1_2.csv");
+  waitForFileChangeRefresh();
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(1)}, {i(2)}});
+}
+
+TEST_F(FileChangeRefreshTest, MaxStalenessBoundsDebounce) {
+  stopWatcher();
+  foreign_storage::ForeignTableFileWatcher::setDebounceDuration(60 * 1000);
+  ScopeGuard reset_debounce_duration = [] {
+    foreign_storage::ForeignTableFileWatcher::setDebounceDuration(100);
+  };
+  startWatcher();
+  setTestFile("0.csv");
+  sql(getCreateFileChangeRefreshTableQuery("all", "1S"));
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(0)}});
+  waitForFileChangeRefresh();
+
+  setTestFile("1.csv");
+  waitForFileChangeRefresh();
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(1)}});
+}
+
+TEST_F(FileChangeRefreshTest, SubdirectoryFiles) {
+  setTestFile("0.csv");
+  sql("CREATE FOREIGN TABLE test_foreign_table (i INTEGER) server omnisci_local_csv "
+      "with (file_path = '" +
+      boost::filesystem::canonical(REFRESH_TEST_DIR).string() +
+      "', refresh_update_type = 'all', refresh_timing_type = 'file_change');");
+  sqlAndCompareResult("SELECT * FROM test_foreign_table;", {{i(0)}});
+  waitForFileChangeRefresh();
+
+  // the subdirectories created after the table are watched too
+  const auto nested_dir = REFRESH_TEST_DIR + "/subdirectory/nested";
+  bf::create_directories(nested_dir);
+  waitForFileChangeRefresh();
+  bf::copy_file(getDataFilesPath() + "/1.csv", nested_dir + "/test.csv");
+  waitForFileChangeRefresh();
+  sqlAndCompareResult("SELECT * FROM test_foreign_table ORDER BY i;", {{i(0)}, {i(1)}});
+
+  bf::copy_file(getDataFilesPath() + "/two_row_1_2.csv",
+                nested_dir + "/test.csv",
+                bf::copy_option::overwrite_if_exists);
+  waitForFileChangeRefresh();
+  sqlAndCompareResult("SELECT * FROM test_foreign_table ORDER BY i;",
+                      {{i(0)}, {i(1)}, {i(2)}});
+}
+
+TEST_F(FileChangeRefreshTest, InvalidMaxStaleness) {
+  setTestFile("0.csv");
+  queryAndAssertException(
+      getCreateFileChangeRefreshTableQuery("all", "1X"),
+      "Exception: Invalid value provided for the REFRESH_MAX_STALENESS option.");
+}
+
+TEST_F(FileChangeRefreshTest, FileChangeRefreshDisabled) {
+  g_enable_foreign_table_file_change_refresh = false;
+  setTestFile("0.csv");
+  queryAndAssertException(getCreateFileChangeRefreshTableQuery("all"),
+                          "Exception: File change refreshes are disabled. Restart the "
+                          "server with \"enable-foreign-table-file-change-refresh\" "
+                          "enabled.");
+}
+
 class QueryEngineCacheInvalidationTest : public ScheduledRefreshTest,
                                          public ::testing::WithParamInterface<bool> {
  protected:
@@ -4565,7 +4822,7 @@ TEST_F(AlterForeignTableTest, RefreshTimingTypeScheduledToInvalid) {
   queryAndAssertException(
       "ALTER FOREIGN TABLE test_foreign_table SET (REFRESH_TIMING_TYPE = '2D');",
       "Exception: Invalid value provided for the REFRESH_TIMING_TYPE "
-      "option. Value must be \"MANUAL\" or \"SCHEDULED\".");
+      "option. Value must be \"MANUAL\", \"SCHEDULED\" or \"FILE_CHANGE\".");
   assertOptionEquals("REFRESH_TIMING_TYPE", "SCHEDULED");
 }
 
@@ -16,7 +16,9 @@
 
 #include "TestHelpers.h"
 
+#include "../QueryEngine/GeoFragmentBounds.h"
 #include "../QueryRunner/QueryRunner.h"
+#include "../Shared/Metrics.h"
 #include "../Shared/scope.h"
 
 #ifndef BASE_PATH
@@ -1827,6 +1829,28 @@ TEST_F(GeoSpatialTempTables, Geos) {
                     "FROM geospatial_test WHERE id = 3;",
                     dt)),
                 static_cast<double>(0.03));
+    // ST_Difference punching a hole: MULTIPOLYGON (((0 0,4 0,4 4,0 4),(1 1,1 2,2 2,2 1)))
+    ASSERT_NEAR(static_cast<double>(15.0),
+                v<double>(run_simple_agg(
+                    "SELECT ST_Area(ST_Difference('POLYGON((0 0,4 0,4 4,0 4,0 0))', "
+                    "'POLYGON((1 1,2 1,2 2,1 2,1 1))')) FROM geospatial_test "
+                    "WHERE id = 2;",
+                    dt)),
+                static_cast<double>(0.00001));
+    // ST_Intersection with a literal across all rows: 0.5 + 2 + 3.5 + 7 * 4
+    ASSERT_NEAR(static_cast<double>(34.0),
+                v<double>(run_simple_agg(
+                    "SELECT SUM(ST_Area(ST_Intersection(poly, "
+                    "'POLYGON((0 0,2 0,2 2,0 2,0 0))'))) FROM geospatial_test;",
+                    dt)),
+                static_cast<double>(0.00001));
+    // Same literal as the first argument, the rest of the 4 * 10 area: 40 - 34
+    ASSERT_NEAR(static_cast<double>(6.0),
+                v<double>(run_simple_agg(
+                    "SELECT SUM(ST_Area(ST_Difference('POLYGON((0 0,2 0,2 2,0 2,0 0))', "
+                    "poly))) FROM geospatial_test;",
+                    dt)),
+                static_cast<double>(0.00001));
     // ST_IsValid
     ASSERT_EQ(static_cast<int64_t>(1),
               v<int64_t>(run_simple_agg(
@@ -2256,6 +2280,342 @@ INSTANTIATE_TEST_SUITE_P(GeospatialMultiFragExecutionTests,
                          GeoSpatialMultiFragTestTablesFixture,
                          ::testing::Values(true, false));
 
+TEST(GeoSpatial, FragmentSkippingByBounds) {
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_bounds_test;");
+  ScopeGuard drop_table = [] {
+    if (!g_keep_data) {
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_bounds_test;");
+    }
+  };
+  run_ddl_statement(build_create_table_statement("id INT, poly POLYGON",
+                                                 "geospatial_frag_bounds_test",
+                                                 {"", 0},
+                                                 {},
+                                                 2,
+                                                 /*use_temporary_tables=*/false,
+                                                 /*deleted_support=*/true,
+                                                 /*is_replicated=*/false));
+  // Fragments of two rows each, every fragment covering a disjoint 10 x 10 cell
+  TestHelpers::ValuesGenerator gen("geospatial_frag_bounds_test");
+  for (size_t i = 0; i < 8; ++i) {
+    const auto lo = std::to_string(10 * (i / 2));
+    const auto hi = std::to_string(10 * (i / 2) + 5 + i % 2);
+    const std::string poly{"'POLYGON((" + lo + " " + lo + ", " + hi + " " + lo + ", " +
+                           hi + " " + hi + ", " + lo + " " + hi + ", " + lo + " " + lo +
+                           "))'"};
+    run_multiple_agg(gen(i, poly), ExecutorDeviceType::CPU);
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    ASSERT_EQ(
+        static_cast<int64_t>(2),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE ST_Contains(poly, 'POINT(21 21)');)",
+            dt)));
+    ASSERT_EQ(
+        static_cast<int64_t>(1),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE ST_Contains(poly, 'POINT(35.5 35.5)');)",
+            dt)));
+    ASSERT_EQ(
+        static_cast<int64_t>(0),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE ST_Contains(poly, 'POINT(100 100)');)",
+            dt)));
+    ASSERT_EQ(
+        static_cast<int64_t>(4),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE ST_Intersects(poly, 'POLYGON((4 4, 12 4, 12 12, 4 12, 4 4))');)",
+            dt)));
+    ASSERT_EQ(
+        static_cast<int64_t>(0),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE ST_Intersects(poly, 'POLYGON((7 7, 8 7, 8 8, 7 8, 7 7))');)",
+            dt)));
+    // Predicates that do not imply bounds intersection are not used for skipping
+    ASSERT_EQ(
+        static_cast<int64_t>(8),
+        v<int64_t>(run_simple_agg(
+            R"(SELECT count(*) FROM geospatial_frag_bounds_test WHERE NOT ST_Contains(poly, 'POINT(100 100)');)",
+            dt)));
+  }
+}
+
+TEST(GeoSpatial, FragmentBoundsCacheReplacedOnAppend) {
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_bounds_cache_test;");
+  ScopeGuard drop_table = [] {
+    if (!g_keep_data) {
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_bounds_cache_test;");
+    }
+  };
+  run_ddl_statement(build_create_table_statement("id INT, poly POLYGON",
+                                                 "geospatial_frag_bounds_cache_test",
+                                                 {"", 0},
+                                                 {},
+                                                 4,
+                                                 /*use_temporary_tables=*/false,
+                                                 /*deleted_support=*/true,
+                                                 /*is_replicated=*/false));
+  TestHelpers::ValuesGenerator gen("geospatial_frag_bounds_cache_test");
+  run_multiple_agg(gen(0, "'POLYGON((0 0, 5 0, 5 5, 0 5, 0 0))'"),
+                   ExecutorDeviceType::CPU);
+  const auto count_containing = [](const std::string& point) {
+    const std::string query{
+        "SELECT count(*) FROM geospatial_frag_bounds_cache_test WHERE "
+        "ST_Contains(poly, '" +
+        point + "');"};
+    return v<int64_t>(run_simple_agg(query, ExecutorDeviceType::CPU));
+  };
+  ASSERT_EQ(int64_t(0), count_containing("POINT(21 21)"));
+  const auto cache_size = GeoFragmentBounds::getCacheSize();
+  // the fragment grows past the cached box, which gets replaced rather than kept along
+  run_multiple_agg(gen(1, "'POLYGON((20 20, 25 20, 25 25, 20 25, 20 20))'"),
+                   ExecutorDeviceType::CPU);
+  ASSERT_EQ(int64_t(1), count_containing("POINT(21 21)"));
+  EXPECT_EQ(cache_size, GeoFragmentBounds::getCacheSize());
+  // dropping the table drops its boxes
+  run_ddl_statement("DROP TABLE geospatial_frag_bounds_cache_test;");
+  EXPECT_EQ(size_t(0), GeoFragmentBounds::getCacheSize());
+}
+
+uint64_t get_geo_bounds_skipped_fragments() {
+  return metrics::Registry::instance()
+      .counter("omnisci_skipped_fragments_total",
+               "Fragments skipped by the runtime fragment skipping, by reason.",
+               "reason=\"geo_bounds\"")
+      .value();
+}
+
+TEST(GeoSpatial, FragmentSkippingByPointBounds) {
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_point_bounds_test;");
+  ScopeGuard drop_table = [] {
+    if (!g_keep_data) {
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_frag_point_bounds_test;");
+    }
+  };
+  run_ddl_statement(build_create_table_statement(
+      "id INT, pt POINT, pt4326 GEOMETRY(POINT, 4326), poly POLYGON",
+      "geospatial_frag_point_bounds_test",
+      {"", 0},
+      {},
+      2,
+      /*use_temporary_tables=*/false,
+      /*deleted_support=*/true,
+      /*is_replicated=*/false));
+  // The x range of the first fragment is the y range of the second one and conversely,
+  // as with longitudes and latitudes: only separate x and y ranges tell the fragments
+  // apart from a box around the origin.
+  TestHelpers::ValuesGenerator gen("geospatial_frag_point_bounds_test");
+  const std::vector<std::pair<int, int>> points{{1, 21}, {2, 22}, {21, 1}, {22, 2}};
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto x = std::to_string(points[i].first);
+    const auto y = std::to_string(points[i].second);
+    const auto x1 = std::to_string(points[i].first + 1);
+    const auto y1 = std::to_string(points[i].second + 1);
+    const std::string pt{"'POINT(" + x + " " + y + ")'"};
+    const std::string poly{"'POLYGON((" + x + " " + y + ", " + x1 + " " + y + ", " + x1 +
+                           " " + y1 + ", " + x + " " + y1 + ", " + x + " " + y + "))'"};
+    run_multiple_agg(gen(i, pt, pt, poly), ExecutorDeviceType::CPU);
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+
+    auto check = [dt](const std::string& filter,
+                      const int64_t expected_count,
+                      const uint64_t expected_skipped_fragments) {
+      const auto skipped_fragments = get_geo_bounds_skipped_fragments();
+      EXPECT_EQ(
+          expected_count,
+          v<int64_t>(run_simple_agg(
+              "SELECT count(*) FROM geospatial_frag_point_bounds_test WHERE " + filter +
+                  ";",
+              dt)))
+          << filter;
+      EXPECT_EQ(expected_skipped_fragments,
+                get_geo_bounds_skipped_fragments() - skipped_fragments)
+          << filter;
+    };
+    check("ST_Contains('POLYGON((0 0, 5 0, 5 5, 0 5, 0 0))', pt)", 0, 2);
+    check("ST_Contains('POLYGON((0 20, 5 20, 5 25, 0 25, 0 20))', pt)", 2, 1);
+    check(
+        "ST_Contains(ST_GeomFromText('POLYGON((0 0, 5 0, 5 5, 0 5, 0 0))', 4326), "
+        "pt4326)",
+        0,
+        2);
+    check(
+        "ST_Contains(ST_GeomFromText('POLYGON((20 0, 25 0, 25 5, 20 5, 20 0))', 4326), "
+        "pt4326)",
+        2,
+        1);
+    check("ST_Intersects(poly, 'POLYGON((0 0, 5 0, 5 5, 0 5, 0 0))')", 0, 2);
+    // viewport filters
+    check("ST_X(pt) BETWEEN 0 AND 5 AND ST_Y(pt) BETWEEN 0 AND 5", 0, 2);
+    check("ST_X(pt) >= 21.5", 1, 1);
+    check("ST_Y(pt4326) < 10", 2, 1);
+    check("ST_XMax(poly) < 10 AND ST_YMin(poly) >= 20", 2, 1);
+    check("ST_XMin(poly) > 100", 0, 2);
+    // a fragment is only skipped when none of its geometries can satisfy the filter
+    check("ST_X(pt) <= 21", 3, 0);
+  }
+}
+
+TEST(GeoSpatial, LargePolygonContainsPoint) {
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_poly_test;");
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_poly_points;");
+  ScopeGuard drop_tables = [] {
+    if (!g_keep_data) {
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_poly_test;");
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_poly_points;");
+    }
+  };
+  const auto enable_polygon_index_state = g_enable_polygon_index;
+  ScopeGuard reset_polygon_index_state = [&enable_polygon_index_state] {
+    g_enable_polygon_index = enable_polygon_index_state;
+  };
+
+  // 400-gon of radius 10 around the origin with a square hole, large enough to be
+  // indexed
+  std::string ring;
+  for (size_t i = 0; i <= 400; ++i) {
+    const double angle = 2 * M_PI * (i % 400) / 400;
+    ring += (i ? ", " : "") + std::to_string(10 * std::cos(angle)) + " " +
+            std::to_string(10 * std::sin(angle));
+  }
+  const std::string hole{"-2 -2, -2 2, 2 2, 2 -2, -2 -2"};
+  const std::string poly{"POLYGON((" + ring + "), (" + hole + "))"};
+  const std::string mpoly{"MULTIPOLYGON(((" + ring + "), (" + hole + ")))"};
+
+  run_ddl_statement(
+      "CREATE TABLE geospatial_large_poly_test (id INT, poly POLYGON, mpoly "
+      "MULTIPOLYGON, gpoly4326 GEOMETRY(POLYGON,4326) ENCODING COMPRESSED(32));");
+  run_multiple_agg("INSERT INTO geospatial_large_poly_test VALUES (0, '" + poly +
+                       "', '" + mpoly + "', '" + poly + "');",
+                   ExecutorDeviceType::CPU);
+  run_ddl_statement(build_create_table_statement(
+      "id INT, p POINT, gp4326 GEOMETRY(POINT,4326) ENCODING COMPRESSED(32)",
+      "geospatial_large_poly_points",
+      {"", 0},
+      {},
+      32,
+      /*use_temporary_tables=*/false,
+      /*deleted_support=*/true,
+      /*is_replicated=*/false));
+  // 13 x 13 grid of points, none of them close to the polygon edges
+  TestHelpers::ValuesGenerator gen("geospatial_large_poly_points");
+  for (size_t i = 0; i < 13 * 13; ++i) {
+    const std::string point{"'POINT(" + std::to_string(-12.5 + 2 * (i % 13)) + " " +
+                            std::to_string(-12.5 + 2 * (i / 13)) + ")'"};
+    run_multiple_agg(gen(i, point, point), ExecutorDeviceType::CPU);
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const bool enable_polygon_index : {true, false}) {
+      g_enable_polygon_index = enable_polygon_index;
+
+      ASSERT_EQ(
+          static_cast<int64_t>(75),
+          v<int64_t>(run_simple_agg(
+              R"(SELECT count(*) FROM geospatial_large_poly_points p, geospatial_large_poly_test t WHERE ST_Contains(t.poly, p.p);)",
+              dt)));
+      ASSERT_EQ(
+          static_cast<int64_t>(75),
+          v<int64_t>(run_simple_agg(
+              R"(SELECT count(*) FROM geospatial_large_poly_points p, geospatial_large_poly_test t WHERE ST_Contains(t.mpoly, p.p);)",
+              dt)));
+      ASSERT_EQ(
+          static_cast<int64_t>(75),
+          v<int64_t>(run_simple_agg(
+              R"(SELECT count(*) FROM geospatial_large_poly_points p, geospatial_large_poly_test t WHERE ST_Contains(t.gpoly4326, p.gp4326);)",
+              dt)));
+      ASSERT_EQ(static_cast<int64_t>(75),
+                v<int64_t>(run_simple_agg(
+                    "SELECT count(*) FROM geospatial_large_poly_points WHERE "
+                    "ST_Contains('" +
+                        poly + "', p);",
+                    dt)));
+    }
+  }
+}
+
+uint64_t get_polygon_indexes_built() {
+  return metrics::Registry::instance()
+      .counter("omnisci_polygon_indexes_built_total",
+               "Polygons indexed for point-in-polygon tests.")
+      .value();
+}
+
+TEST(GeoSpatial, LargePolygonsAcrossFragments) {
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_polys_test;");
+  run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_polys_points;");
+  ScopeGuard drop_tables = [] {
+    if (!g_keep_data) {
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_polys_test;");
+      run_ddl_statement("DROP TABLE IF EXISTS geospatial_large_polys_points;");
+    }
+  };
+  const auto enable_polygon_index_state = g_enable_polygon_index;
+  ScopeGuard reset_polygon_index_state = [&enable_polygon_index_state] {
+    g_enable_polygon_index = enable_polygon_index_state;
+  };
+  g_enable_polygon_index = true;
+
+  // 400-gons of radius 10 around (30 * k, 0), one per fragment: the coordinates of every
+  // polygon have the same size and may be loaded at the same address by the kernels
+  run_ddl_statement(
+      "CREATE TABLE geospatial_large_polys_test (id INT, poly POLYGON) WITH "
+      "(fragment_size=1);");
+  for (size_t k = 0; k < 4; ++k) {
+    std::string ring;
+    for (size_t i = 0; i <= 400; ++i) {
+      const double angle = 2 * M_PI * (i % 400) / 400;
+      ring += (i ? ", " : "") + std::to_string(30. * k + 10 * std::cos(angle)) + " " +
+              std::to_string(10 * std::sin(angle));
+    }
+    run_multiple_agg("INSERT INTO geospatial_large_polys_test VALUES (" +
+                         std::to_string(k) + ", 'POLYGON((" + ring + "))');",
+                     ExecutorDeviceType::CPU);
+  }
+  run_ddl_statement("CREATE TABLE geospatial_large_polys_points (id INT, p POINT);");
+  for (size_t k = 0; k < 4; ++k) {
+    run_multiple_agg("INSERT INTO geospatial_large_polys_points VALUES (" +
+                         std::to_string(k) + ", 'POINT(" + std::to_string(30 * k + 5) +
+                         " 0)');",
+                     ExecutorDeviceType::CPU);
+  }
+  run_multiple_agg("INSERT INTO geospatial_large_polys_points VALUES (4, 'POINT(15 0)');",
+                   ExecutorDeviceType::CPU);
+
+  // Polygons of the outer table are probed once, they are not indexed
+  auto indexes_built = get_polygon_indexes_built();
+  for (size_t k = 0; k < 4; ++k) {
+    ASSERT_EQ(
+        static_cast<int64_t>(k),
+        v<int64_t>(run_simple_agg(
+            "SELECT id FROM geospatial_large_polys_test WHERE ST_Contains(poly, "
+            "'POINT(" +
+                std::to_string(30 * k + 5) + " 0)');",
+            ExecutorDeviceType::CPU)));
+  }
+  ASSERT_EQ(indexes_built, get_polygon_indexes_built());
+
+  // Polygons of the inner table are indexed, each one by its row
+  ASSERT_EQ(
+      static_cast<int64_t>(4),
+      v<int64_t>(run_simple_agg(
+          R"(SELECT count(*) FROM geospatial_large_polys_points p, geospatial_large_polys_test t WHERE ST_Contains(t.poly, p.p) AND p.id = t.id;)",
+          ExecutorDeviceType::CPU)));
+  ASSERT_EQ(
+      static_cast<int64_t>(4),
+      v<int64_t>(run_simple_agg(
+          R"(SELECT count(*) FROM geospatial_large_polys_points p, geospatial_large_polys_test t WHERE ST_Contains(t.poly, p.p);)",
+          ExecutorDeviceType::CPU)));
+  ASSERT_LT(indexes_built, get_polygon_indexes_built());
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
@@ -2383,6 +2383,55 @@ TEST_F(ExportTest, CSV_Nulls) {
   ASSERT_NO_THROW(doTestNulls("query_export_test_csv_nulls.csv", "CSV", "*"));
 }
 
+TEST_F(ExportTest, CSV_ScalarsAcrossBatches) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ASSERT_NO_THROW(run_ddl_statement(
+      "CREATE TABLE query_export_test (i INTEGER, b BIGINT, bo BOOLEAN, f FLOAT, d "
+      "DOUBLE, n DECIMAL(8,2), t TEXT ENCODING DICT(32), tn TEXT ENCODING NONE, tm "
+      "TIME, ts TIMESTAMP(0), dt DATE);"));
+  run_query(
+      "INSERT INTO query_export_test VALUES(1, 20395569495, 'true', 292956.5, "
+      "-561514.42, -234.65, 'Holly \"H\" Goldstein', 'none', '19:46:08', '2011-11-02 "
+      "13:52:11', '2003-09-22');");
+  run_query(
+      "INSERT INTO query_export_test VALUES(NULL, NULL, NULL, NULL, NULL, NULL, NULL, "
+      "NULL, NULL, NULL, NULL);");
+  // 8192 rows, exported in more than one result set batch
+  for (int i = 0; i < 12; ++i) {
+    ASSERT_NO_THROW(run_ddl_statement(
+        "INSERT INTO query_export_test SELECT * FROM query_export_test;"));
+  }
+
+  const std::string file = "query_export_test_csv_scalars.csv";
+  ASSERT_NO_THROW(
+      run_ddl_statement("COPY (SELECT * FROM query_export_test) TO '" + file +
+                        "' WITH (file_type='CSV', header='true');"));
+
+  // the same values getNextRow() used to export
+  const std::string value_line =
+      "\"1\",\"20395569495\",\"1\",\"292956.5\",\"-561514.42\",\"-234.65\",\"Holly "
+      "\"\"H\"\" Goldstein\",\"none\",\"19:46:08\",\"1320241931\",\"1064188800\"";
+  const std::string null_line =
+      "\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\",\"\\N\","
+      "\"\\N\"";
+  std::ifstream exported_file(BASE_PATH "/mapd_export/" + file);
+  std::string line;
+  ASSERT_TRUE(std::getline(exported_file, line));
+  EXPECT_EQ("i,b,bo,f,d,n,t,tn,tm,ts,dt", line);
+  size_t value_line_count{0};
+  size_t null_line_count{0};
+  while (std::getline(exported_file, line)) {
+    if (line == value_line) {
+      ++value_line_count;
+    } else {
+      ASSERT_EQ(null_line, line);
+      ++null_line_count;
+    }
+  }
+  EXPECT_EQ(4096U, value_line_count);
+  EXPECT_EQ(4096U, null_line_count);
+}
+
 TEST_F(ExportTest, GeoJSON) {
   SKIP_ALL_ON_AGGREGATOR();
   doCreateAndImport();
@@ -451,6 +451,72 @@ TEST_F(OverlapsTest, EmptyPolyPolyJoin) {
   });
 }
 
+TEST_F(OverlapsTest, InnerJoinPointPointDistance) {
+  executeAllScenarios([](ExecutorDeviceType dt) -> void {
+    auto sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_DWithin(a.pt, b.pt, 1);";
+    ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(execSQL(sql, dt)));
+
+    sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_DWithin(b.pt, a.pt, 10);";
+    ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(execSQL(sql, dt)));
+
+    sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_Distance(a.pt, b.pt) <= 10;";
+    ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(execSQL(sql, dt)));
+
+    sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_Distance(a.pt, b.pt) < 0;";
+    ASSERT_EQ(static_cast<int64_t>(0), v<int64_t>(execSQL(sql, dt)));
+  });
+}
+
+TEST_F(OverlapsTest, InnerJoinPointPointGeodesicDistance) {
+  executeAllScenarios([](ExecutorDeviceType dt) -> void {
+    // (22, 22) and (28, 28) are about 920km apart
+    auto sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_Distance(CastToGeography(a.pt), CastToGeography(b.pt)) < 500000.0;";
+    ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(execSQL(sql, dt)));
+
+    sql =
+        "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+        "ST_Distance(CastToGeography(a.pt), CastToGeography(b.pt)) < 1000000.0;";
+    ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(execSQL(sql, dt)));
+  });
+}
+
+TEST_F(OverlapsTest, PointPointDistanceCaching) {
+  const auto enable_overlaps_hashjoin_state = g_enable_overlaps_hashjoin;
+  g_enable_overlaps_hashjoin = true;
+  g_trivial_loop_join_threshold = 1;
+
+  ScopeGuard reset_overlaps_state = [&enable_overlaps_hashjoin_state] {
+    g_enable_overlaps_hashjoin = enable_overlaps_hashjoin_state;
+    g_trivial_loop_join_threshold = 1000;
+  };
+
+  QR::get()->clearCpuMemory();
+  const auto q1 =
+      "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+      "ST_DWithin(a.pt, b.pt, 1);";
+  ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(execSQL(q1, ExecutorDeviceType::CPU)));
+  ASSERT_EQ(QR::get()->getNumberOfCachedOverlapsHashTables(), (size_t)1);
+  execSQL(q1, ExecutorDeviceType::CPU);
+  ASSERT_EQ(QR::get()->getNumberOfCachedOverlapsHashTables(), (size_t)1);
+
+  // a different distance needs a different hash table
+  const auto q2 =
+      "SELECT count(*) FROM does_intersect_b as b JOIN does_intersect_a as a ON "
+      "ST_DWithin(a.pt, b.pt, 10);";
+  ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(execSQL(q2, ExecutorDeviceType::CPU)));
+  ASSERT_EQ(QR::get()->getNumberOfCachedOverlapsHashTables(), (size_t)2);
+}
+
 TEST_F(OverlapsTest, SkipHashtableCaching) {
   const auto enable_overlaps_hashjoin_state = g_enable_overlaps_hashjoin;
   const auto enable_hashjoin_many_to_many_state = g_enable_hashjoin_many_to_many;
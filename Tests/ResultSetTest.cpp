@@ -29,11 +29,13 @@
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionary.h"
 #include "Tests/TestHelpers.h"
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <random>
 
@@ -44,6 +46,7 @@
 using QR = QueryRunner::QueryRunner;
 
 extern bool g_is_test_env;
+extern size_t g_parallel_sort_min;
 
 bool skip_tests(const ExecutorDeviceType device_type) {
 #ifdef HAVE_CUDA
@@ -947,6 +950,69 @@ void test_iterate(const std::vector<TargetInfo>& target_infos,
   }
 }
 
+// Fills two identical result sets and checks getNextBatch() returns the same values as
+// getNextRow() for them.
+void test_iterate_batches(const std::vector<TargetInfo>& target_infos,
+                          const QueryMemoryDescriptor& query_mem_desc) {
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  StringDictionaryProxy* sdp =
+      row_set_mem_owner->addStringDict(g_sd, 1, g_sd->storageEntryCount());
+  for (size_t i = 0; i < query_mem_desc.getEntryCount(); ++i) {
+    sdp->getOrAddTransient(std::to_string(i));
+  }
+  ResultSet rows_result_set(target_infos,
+                            ExecutorDeviceType::CPU,
+                            query_mem_desc,
+                            row_set_mem_owner,
+                            nullptr,
+                            0,
+                            0);
+  ResultSet batches_result_set(target_infos,
+                               ExecutorDeviceType::CPU,
+                               query_mem_desc,
+                               row_set_mem_owner,
+                               nullptr,
+                               0,
+                               0);
+  for (auto result_set : {&rows_result_set, &batches_result_set}) {
+    const auto storage = result_set->allocateStorage();
+    EvenNumberGenerator generator;
+    fill_storage_buffer(
+        storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 2);
+  }
+  constexpr size_t max_rows{7};
+  size_t row_count{0};
+  while (true) {
+    const auto batch = batches_result_set.getNextBatch(max_rows, true, false);
+    if (batch.empty()) {
+      break;
+    }
+    ASSERT_LE(batch.row_count, max_rows);
+    ASSERT_EQ(target_infos.size(), batch.columns.size());
+    for (size_t i = 0; i < target_infos.size(); ++i) {
+      ASSERT_EQ(batch.row_count, batch.columns[i].size());
+      // everything but AVG is decoded without going through TargetValue
+      ASSERT_EQ(target_infos[i].agg_kind == kAVG,
+                batch.columns[i].format == ResultSetColumnBatch::Format::TargetValue);
+    }
+    for (size_t row = 0; row < batch.row_count; ++row) {
+      const auto ref_row = rows_result_set.getNextRow(true, false);
+      ASSERT_EQ(target_infos.size(), ref_row.size());
+      for (size_t i = 0; i < target_infos.size(); ++i) {
+        const auto tv = batch.columns[i].getTargetValue(row);
+        const auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
+        const auto ref_scalar_tv = boost::get<ScalarTargetValue>(&ref_row[i]);
+        ASSERT_TRUE(scalar_tv && ref_scalar_tv);
+        ASSERT_EQ(*ref_scalar_tv, *scalar_tv);
+      }
+    }
+    row_count += batch.row_count;
+  }
+  ASSERT_GT(row_count, size_t(0));
+  ASSERT_TRUE(rows_result_set.getNextRow(true, false).empty());
+}
+
 std::vector<TargetInfo> generate_test_target_infos() {
   std::vector<TargetInfo> target_infos;
   SQLTypeInfo int_ti(kINT, false);
@@ -1616,6 +1682,86 @@ TEST(Iterate, BaselineHashColumnar) {
   test_iterate(target_infos, query_mem_desc);
 }
 
+TEST(IterateBatch, PerfectHashOneCol) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
+  test_iterate_batches(target_infos, query_mem_desc);
+}
+
+TEST(IterateBatch, PerfectHashOneColColumnar32) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 4, 0, 99);
+  query_mem_desc.setOutputColumnar(true);
+  test_iterate_batches(target_infos, query_mem_desc);
+}
+
+TEST(IterateBatch, PerfectHashTwoColKeyless) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = perfect_hash_two_col_desc(target_infos, 8);
+  query_mem_desc.setHasKeylessHash(true);
+  query_mem_desc.setTargetIdxForKey(2);
+  test_iterate_batches(target_infos, query_mem_desc);
+}
+
+TEST(IterateBatch, BaselineHash) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  test_iterate_batches(target_infos, query_mem_desc);
+}
+
+TEST(IterateBatch, BaselineHashColumnar) {
+  const auto target_infos = generate_test_target_infos();
+  auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 8);
+  query_mem_desc.setOutputColumnar(true);
+  test_iterate_batches(target_infos, query_mem_desc);
+}
+
+TEST(Sort, ParallelFullSort) {
+  const auto target_infos = generate_test_target_infos();
+  const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 9999);
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  const auto sort_rows = [&](const size_t parallel_sort_min) {
+    const auto prev_parallel_sort_min = g_parallel_sort_min;
+    ScopeGuard reset = [prev_parallel_sort_min] {
+      g_parallel_sort_min = prev_parallel_sort_min;
+    };
+    g_parallel_sort_min = parallel_sort_min;
+    ResultSet rs(target_infos,
+                 ExecutorDeviceType::CPU,
+                 query_mem_desc,
+                 row_set_mem_owner,
+                 nullptr,
+                 0,
+                 0);
+    const auto storage = rs.allocateStorage();
+    EvenNumberGenerator generator;
+    fill_storage_buffer(
+        storage->getUnderlyingBuffer(), target_infos, query_mem_desc, generator, 2);
+    std::list<Analyzer::OrderEntry> order_entries;
+    order_entries.emplace_back(3, true, false);
+    order_entries.emplace_back(1, false, false);
+    rs.sort(order_entries, 0, nullptr);
+    std::vector<OneRow> rows;
+    while (true) {
+      const auto row = rs.getNextRow(false, false);
+      if (row.empty()) {
+        break;
+      }
+      rows.push_back(row);
+    }
+    return rows;
+  };
+  const auto expected_rows = sort_rows(std::numeric_limits<size_t>::max());
+  const auto rows = sort_rows(0);
+  ASSERT_FALSE(rows.empty());
+  ASSERT_EQ(expected_rows.size(), rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(v<int64_t>(expected_rows[i][0]), v<int64_t>(rows[i][0]));
+    ASSERT_EQ(v<int64_t>(expected_rows[i][2]), v<int64_t>(rows[i][2]));
+  }
+}
+
 TEST(Reduce, PerfectHashOneCol) {
   const auto target_infos = generate_test_target_infos();
   const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 99);
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shared/Metrics.h"
+#include "Shared/MetricsServer.h"
+#include "Tests/TestHelpers.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool contains_line(const std::string& text, const std::string& line) {
+  return text.find(line + "\n") != std::string::npos;
+}
+
+}  // namespace
+
+TEST(Metrics, Counter) {
+  auto& registry = metrics::Registry::instance();
+  auto& counter = registry.counter("test_counter_total", "Test counter.");
+  EXPECT_EQ(&counter, &registry.counter("test_counter_total", "Test counter."));
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&counter] {
+      for (size_t j = 0; j < 1000; ++j) {
+        counter.increment();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.value(), uint64_t(4000));
+
+  const auto text = registry.toPrometheusText();
+  EXPECT_TRUE(contains_line(text, "# HELP test_counter_total Test counter."));
+  EXPECT_TRUE(contains_line(text, "# TYPE test_counter_total counter"));
+  EXPECT_TRUE(contains_line(text, "test_counter_total 4000"));
+}
+
+TEST(Metrics, LabeledGauge) {
+  auto& registry = metrics::Registry::instance();
+  registry.gauge("test_gauge", "Test gauge.", "level=\"cpu\"").set(7);
+  registry.gauge("test_gauge", "Test gauge.", "level=\"gpu\"").add(-3);
+
+  const auto text = registry.toPrometheusText();
+  EXPECT_TRUE(contains_line(text, "# TYPE test_gauge gauge"));
+  EXPECT_TRUE(contains_line(text, "test_gauge{level=\"cpu\"} 7"));
+  EXPECT_TRUE(contains_line(text, "test_gauge{level=\"gpu\"} -3"));
+}
+
+TEST(Metrics, Histogram) {
+  auto& registry = metrics::Registry::instance();
+  auto& histogram = registry.histogram("test_latency_ms", "Test latency.", {1, 10});
+  histogram.observe(0.5);
+  histogram.observe(1);
+  histogram.observe(5);
+  histogram.observe(100);
+
+  const auto text = registry.toPrometheusText();
+  EXPECT_TRUE(contains_line(text, "# TYPE test_latency_ms histogram"));
+  EXPECT_TRUE(contains_line(text, "test_latency_ms_bucket{le=\"1\"} 2"));
+  EXPECT_TRUE(contains_line(text, "test_latency_ms_bucket{le=\"10\"} 3"));
+  EXPECT_TRUE(contains_line(text, "test_latency_ms_bucket{le=\"+Inf\"} 4"));
+  EXPECT_TRUE(contains_line(text, "test_latency_ms_sum 106.5"));
+  EXPECT_TRUE(contains_line(text, "test_latency_ms_count 4"));
+}
+
+TEST(Metrics, CallbackGauge) {
+  auto& registry = metrics::Registry::instance();
+  double value{1};
+  const auto handle = registry.addCallbackGauge(
+      "test_callback_gauge", "Test callback gauge.", "", [&value] { return value; });
+  EXPECT_TRUE(contains_line(registry.toPrometheusText(), "test_callback_gauge 1"));
+  value = 2;
+  EXPECT_TRUE(contains_line(registry.toPrometheusText(), "test_callback_gauge 2"));
+
+  // a replaced callback is not removed through the handle of the previous one
+  const auto replacement_handle = registry.addCallbackGauge(
+      "test_callback_gauge", "Test callback gauge.", "", [] { return 3.0; });
+  registry.removeCallbackGauge(handle);
+  EXPECT_TRUE(contains_line(registry.toPrometheusText(), "test_callback_gauge 3"));
+  registry.removeCallbackGauge(replacement_handle);
+  EXPECT_EQ(registry.toPrometheusText().find("test_callback_gauge"), std::string::npos);
+}
+
+TEST(Metrics, Server) {
+  metrics::Registry::instance().counter("test_served_total", "Test counter.").increment();
+  metrics::MetricsServer server("127.0.0.1", 0);
+
+  auto get = [&server](const std::string& target) {
+    using boost::asio::ip::tcp;
+    boost::asio::io_context io_context;
+    tcp::socket socket(io_context);
+    socket.connect(
+        tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), server.getPort()));
+    const std::string request{"GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+    boost::asio::write(socket, boost::asio::buffer(request));
+    std::string response;
+    boost::system::error_code ec;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+    EXPECT_EQ(ec, boost::asio::error::eof);
+    return response;
+  };
+
+  const auto response = get("/metrics");
+  EXPECT_EQ(response.rfind("HTTP/1.1 200 OK\r\n", 0), size_t(0));
+  EXPECT_TRUE(contains_line(response, "test_served_total 1"));
+  EXPECT_EQ(get("/").rfind("HTTP/1.1 404 Not Found\r\n", 0), size_t(0));
+
+  // the request head is bounded, the unread rest of it may reset the connection
+  using boost::asio::ip::tcp;
+  boost::asio::io_context io_context;
+  tcp::socket socket(io_context);
+  socket.connect(
+      tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), server.getPort()));
+  const std::string request{"GET /metrics?" + std::string(16384, 'x') +
+                            " HTTP/1.1\r\n\r\n"};
+  boost::asio::write(socket, boost::asio::buffer(request));
+  std::string response;
+  boost::system::error_code ec;
+  boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+  EXPECT_EQ(response.rfind("HTTP/1.1 431 Request Header Fields Too Large\r\n", 0),
+            size_t(0));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -16,9 +16,14 @@
 
 #include "TestHelpers.h"
 
+#include "../Shared/scope.h"
 #include "../StringDictionary/StringDictionary.h"
 
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
 #include <cstdlib>
+#include <fstream>
 #include <limits>
 
 #ifndef BASE_PATH
@@ -101,6 +106,161 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, LowerStringsExtended) {
+  StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+  ASSERT_EQ(0, string_dict.getOrAdd("FOO"));
+  ASSERT_EQ(1, string_dict.getOrAdd("bar"));
+  ASSERT_EQ(2, string_dict.getOrAdd("Baz"));
+  const auto lower_strings = string_dict.getLowerStrings(3);
+  ASSERT_TRUE(lower_strings);
+  ASSERT_EQ(std::vector<int32_t>({StringDictionary::INVALID_STR_ID,
+                                  1,
+                                  StringDictionary::INVALID_STR_ID}),
+            lower_strings->ids);
+  ASSERT_EQ(lower_strings, string_dict.getLowerStrings(3));
+  // the lower case of a cached string and a string with a missing lower case
+  ASSERT_EQ(3, string_dict.getOrAdd("foo"));
+  ASSERT_EQ(4, string_dict.getOrAdd("QUX"));
+  const auto extended_lower_strings = string_dict.getLowerStrings(5);
+  ASSERT_EQ(std::vector<int32_t>({3,
+                                  1,
+                                  StringDictionary::INVALID_STR_ID,
+                                  3,
+                                  StringDictionary::INVALID_STR_ID}),
+            extended_lower_strings->ids);
+  ASSERT_EQ(size_t(2), extended_lower_strings->missing_strings.size());
+  // the strings handed out before stay as they were
+  ASSERT_EQ(size_t(3), lower_strings->ids.size());
+  ASSERT_EQ(StringDictionary::INVALID_STR_ID, lower_strings->ids[0]);
+}
+
+namespace {
+
+std::vector<std::string> trigram_test_strings() {
+  std::vector<std::string> strings;
+  for (int i = 0; i < 10000; ++i) {
+    strings.push_back((i % 3 ? "Item " : "item_") + std::to_string(i * 7919 % 10007) +
+                      (i % 5 ? " red" : " Blue.green"));
+  }
+  return strings;
+}
+
+std::vector<int32_t> sorted(std::vector<int32_t> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+}  // namespace
+
+TEST(StringDictionary, TrigramIndexMatchesScan) {
+  const auto enable_stringdict_trigram_index = g_enable_stringdict_trigram_index;
+  ScopeGuard reset = [enable_stringdict_trigram_index] {
+    g_enable_stringdict_trigram_index = enable_stringdict_trigram_index;
+  };
+  const auto strings = trigram_test_strings();
+  StringDictionary scanned_dict(BASE_PATH, true, false, g_cache_string_hash);
+  StringDictionary indexed_dict(BASE_PATH, true, false, g_cache_string_hash);
+  for (const auto& str : strings) {
+    scanned_dict.getOrAdd(str);
+    indexed_dict.getOrAdd(str);
+  }
+  const auto string_count = strings.size();
+  const auto like = [&](const std::string& pattern,
+                        const bool icase,
+                        const bool is_simple,
+                        const size_t generation) {
+    g_enable_stringdict_trigram_index = false;
+    const auto expected =
+        scanned_dict.getLike(pattern, icase, is_simple, '\\', generation);
+    g_enable_stringdict_trigram_index = true;
+    EXPECT_EQ(sorted(expected),
+              sorted(indexed_dict.getLike(pattern, icase, is_simple, '\\', generation)))
+        << pattern;
+  };
+  for (const auto gen : {string_count, string_count / 2}) {
+    like("123", false, true, gen);
+    like("blue", true, true, gen);
+    like("blue", false, true, gen);
+    like("it", false, true, gen);
+    like("item\\_1%red", false, false, gen);
+    like("%em 12_4 %", false, false, gen);
+    like("%blue.gr%", true, false, gen);
+    like("%nomatch%", false, false, gen);
+  }
+  const auto regexp = [&](const std::string& pattern, const size_t generation) {
+    g_enable_stringdict_trigram_index = false;
+    const auto expected = scanned_dict.getRegexpLike(pattern, '\\', generation);
+    g_enable_stringdict_trigram_index = true;
+    EXPECT_EQ(sorted(expected),
+              sorted(indexed_dict.getRegexpLike(pattern, '\\', generation)))
+        << pattern;
+  };
+  for (const auto gen : {string_count, string_count / 2}) {
+    regexp("Item 1[0-9]+ red", gen);
+    regexp("item_12*3.*", gen);
+    regexp(".*Blue\\.green", gen);
+    regexp("(Item|item_) 99.*", gen);
+    regexp(".*[0-9]{4} red", gen);
+  }
+}
+
+TEST(StringDictionary, TrigramIndexPersisted) {
+  const auto enable_stringdict_trigram_index = g_enable_stringdict_trigram_index;
+  ScopeGuard reset = [enable_stringdict_trigram_index] {
+    g_enable_stringdict_trigram_index = enable_stringdict_trigram_index;
+  };
+  g_enable_stringdict_trigram_index = true;
+  {
+    StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+    string_dict.getOrAdd("trigram index");
+    string_dict.getOrAdd("persisted");
+    ASSERT_EQ(std::vector<int32_t>{0}, string_dict.getLike("gram", false, true, '\\', 2));
+    ASSERT_TRUE(string_dict.checkpoint());
+  }
+  ASSERT_TRUE(boost::filesystem::exists(std::string(BASE_PATH) + "/DictTrigrams"));
+  {
+    StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+    string_dict.getOrAdd("another gram");
+    ASSERT_EQ(std::vector<int32_t>({0, 2}),
+              sorted(string_dict.getLike("gram", false, true, '\\', 3)));
+  }
+  // a new dictionary in the same place doesn't pick up the index of the old one
+  StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+  ASSERT_FALSE(boost::filesystem::exists(std::string(BASE_PATH) + "/DictTrigrams"));
+  string_dict.getOrAdd("ram");
+  ASSERT_EQ(std::vector<int32_t>{0}, string_dict.getLike("ram", false, true, '\\', 1));
+}
+
+TEST(StringDictionary, TrigramIndexCorrupted) {
+  const auto enable_stringdict_trigram_index = g_enable_stringdict_trigram_index;
+  ScopeGuard reset = [enable_stringdict_trigram_index] {
+    g_enable_stringdict_trigram_index = enable_stringdict_trigram_index;
+  };
+  g_enable_stringdict_trigram_index = true;
+  const auto index_path = std::string(BASE_PATH) + "/DictTrigrams";
+  {
+    StringDictionary string_dict(BASE_PATH, false, false, g_cache_string_hash);
+    string_dict.getOrAdd("trigram index");
+    string_dict.getOrAdd("corrupted");
+    ASSERT_EQ(std::vector<int32_t>{1}, string_dict.getLike("rupt", false, true, '\\', 2));
+    ASSERT_TRUE(string_dict.checkpoint());
+  }
+  {
+    // flip a byte of the postings, past the header
+    std::fstream index_file(index_path, std::ios::in | std::ios::out | std::ios::binary);
+    ASSERT_TRUE(index_file);
+    index_file.seekg(3 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t));
+    char byte;
+    ASSERT_TRUE(index_file.get(byte));
+    index_file.seekp(3 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t));
+    index_file.put(byte ^ 0x7f);
+  }
+  // the index fails its checksum and gets built from the strings again
+  StringDictionary string_dict(BASE_PATH, false, true, g_cache_string_hash);
+  ASSERT_EQ(std::vector<int32_t>{1}, string_dict.getLike("rupt", false, true, '\\', 2));
+  ASSERT_EQ(std::vector<int32_t>{0}, string_dict.getLike("gram", false, true, '\\', 2));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
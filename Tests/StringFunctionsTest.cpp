@@ -189,6 +189,45 @@ TEST_F(LowerFunctionTest, LowercaseGroupBy) {
   compare_result_set(expected_result_set, result_set);
 }
 
+TEST_F(LowerFunctionTest, LowercaseNull) {
+  sql("insert into lower_function_test_people values('Pat', 'Jones', 40, NULL);");
+  auto result_set =
+      sql("select count(*) from lower_function_test_people "
+          "where lower(country_code) is null;");
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{{int64_t(1)}};
+  compare_result_set(expected_result_set, result_set);
+}
+
+TEST_F(LowerFunctionTest, NestedLowercase) {
+  auto result_set =
+      sql("select lower(lower(first_name)), count(*) from lower_function_test_people "
+          "group by lower(lower(first_name)) order by 1;");
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{{"john", int64_t(3)},
+                                                                  {"sue", int64_t(1)}};
+  compare_result_set(expected_result_set, result_set);
+}
+
+TEST_F(LowerFunctionTest, LowercaseAfterDictionaryGrows) {
+  auto result_set =
+      sql("select lower(first_name), count(*) from lower_function_test_people "
+          "group by lower(first_name) order by 1;");
+  std::vector<std::vector<ScalarTargetValue>> expected_result_set{{"john", int64_t(3)},
+                                                                  {"sue", int64_t(1)}};
+  compare_result_set(expected_result_set, result_set);
+
+  // The strings lower cased by the first query are stale once new strings are added,
+  // including the lower case of existing ones.
+  multi_sql(R"(
+      insert into lower_function_test_people values('MARY', 'Brown', 35, 'us');
+      insert into lower_function_test_people values('sue', 'Green', 45, 'ca');
+    )");
+  result_set =
+      sql("select lower(first_name), count(*) from lower_function_test_people "
+          "group by lower(first_name) order by 1;");
+  expected_result_set = {{"john", int64_t(3)}, {"mary", int64_t(1)}, {"sue", int64_t(2)}};
+  compare_result_set(expected_result_set, result_set);
+}
+
 TEST_F(LowerFunctionTest, LowercaseJoin) {
   auto result_set =
       sql("select first_name, name as country_name "
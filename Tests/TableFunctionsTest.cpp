@@ -232,6 +232,25 @@ TEST_F(TableFunctions, GroupByInAndOut) {
   }
 }
 
+TEST_F(TableFunctions, ParallelProjection) {
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (int copies = 1; copies <= 4; copies++) {
+      const auto rows = run_multiple_agg(
+          "SELECT out0, count(*) FROM TABLE(row_copier_parallel(cursor(SELECT d FROM "
+          "tf_test), " +
+              std::to_string(copies) + ")) GROUP BY out0 ORDER BY out0;",
+          dt);
+      ASSERT_EQ(rows->rowCount(), size_t(5));
+      for (size_t i = 0; i < 5; i++) {
+        auto crt_row = rows->getNextRow(false, false);
+        ASSERT_DOUBLE_EQ(TestHelpers::v<double>(crt_row[0]), i * 1.1);
+        ASSERT_EQ(TestHelpers::v<int64_t>(crt_row[1]), static_cast<int64_t>(copies));
+      }
+    }
+  }
+}
+
 TEST_F(TableFunctions, Unsupported) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
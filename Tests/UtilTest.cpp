@@ -170,6 +170,38 @@ TEST(Utils, Regexp) {
   ASSERT_FALSE(regexp_like("abc100%efg", 10, ".+100!%...", 10, '!'));
   ASSERT_TRUE(regexp_like("[ hello", 7, ".*\\[.*", 6, '\\'));
   ASSERT_TRUE(regexp_like("hello [", 7, ".*\\[.*", 6, '\\'));
+  ASSERT_TRUE(regexp_like("abc\nxyz", 7, ".*xyz", 5, '\\'));
+  ASSERT_FALSE(regexp_like("abc", 3, "ab", 2, '\\'));
+  ASSERT_TRUE(regexp_like("a.c", 3, "a\\.c", 4, '\\'));
+  ASSERT_FALSE(regexp_like("abc", 3, "a\\.c", 4, '\\'));
+  ASSERT_TRUE(regexp_like("abc", 3, "ab.*", 4, '\\'));
+  ASSERT_TRUE(regexp_like("2021-01-31", 10, "[0-9]{4}-[0-9]{2}-[0-9]{2}", 26, '\\'));
+  ASSERT_FALSE(regexp_like("2021-1-31", 9, "[0-9]{4}-[0-9]{2}-[0-9]{2}", 26, '\\'));
+  ASSERT_TRUE(regexp_like("foobar", 6, "(foo|bar)+", 10, '\\'));
+  ASSERT_TRUE(regexp_like("Abc1", 4, "[[:upper:]][[:lower:]]+[[:digit:]]", 34, '\\'));
+  ASSERT_TRUE(regexp_like("x1", 2, "x\\d", 3, '\\'));
+  // Invalid patterns don't match.
+  ASSERT_FALSE(regexp_like("a", 1, "(a", 2, '\\'));
+  ASSERT_FALSE(regexp_like("a", 1, "*a", 2, '\\'));
+}
+
+TEST(Utils, RegexpPathological) {
+  // Matching takes linear time, a backtracking engine doesn't finish.
+  const std::string str(100000, 'a');
+  ASSERT_FALSE(regexp_like(str.c_str(), str.size(), "(a*)*b", 6, '\\'));
+  ASSERT_TRUE(regexp_like(str.c_str(), str.size(), "(a|aa)*", 7, '\\'));
+}
+
+TEST(Utils, RegexpCompiledPatterns) {
+  // Compiled patterns are cached per thread, alternate between them.
+  for (size_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(regexp_like("abcxyz", 6, "a.*z", 4, '\\'));
+    ASSERT_FALSE(regexp_like("abcxyz", 6, "a.*y", 4, '\\'));
+    const auto pattern = "a[b-c]+x" + std::to_string(i % 70);
+    const auto str = "abcx" + std::to_string(i % 70);
+    ASSERT_TRUE(
+        regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), '\\'));
+  }
 }
 
 int main(int argc, char* argv[]) {
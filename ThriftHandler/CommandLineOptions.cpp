@@ -48,6 +48,7 @@ extern size_t g_approx_quantile_buffer;
 extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
+extern size_t g_parallel_sort_min;
 
 namespace Catalog_Namespace {
 extern bool g_log_user_id;
@@ -162,6 +163,31 @@ void CommandLineOptions::fillOptions() {
                               ->implicit_value(true),
                           "Enable the overlaps hash join framework allowing for range "
                           "join (e.g. spatial overlaps) computation using a hash table.");
+  help_desc.add_options()("enable-distance-rangejoin",
+                          po::value<bool>(&g_enable_distance_rangejoin)
+                              ->default_value(g_enable_distance_rangejoin)
+                              ->implicit_value(true),
+                          "Enable accelerating point distance joins (e.g. ST_DWithin) "
+                          "with an overlaps hash table over the inner points.");
+  help_desc.add_options()("enable-polygon-index",
+                          po::value<bool>(&g_enable_polygon_index)
+                              ->default_value(g_enable_polygon_index)
+                              ->implicit_value(true),
+                          "Enable indexing large polygons once per query step to speed "
+                          "up point-in-polygon tests on CPU.");
+  help_desc.add_options()("enable-range-join",
+                          po::value<bool>(&g_enable_range_join)
+                              ->default_value(g_enable_range_join)
+                              ->implicit_value(true),
+                          "Enable joining on inequalities (e.g. BETWEEN) through the "
+                          "inner rows sorted on a column rather than a loop join.");
+  help_desc.add_options()("enable-runtime-join-filters",
+                          po::value<bool>(&g_enable_runtime_join_filters)
+                              ->default_value(g_enable_runtime_join_filters)
+                              ->implicit_value(true),
+                          "Enable skipping the outer fragments out of the key range of "
+                          "a hash join and probing sparse hash tables through a Bloom "
+                          "filter.");
   help_desc.add_options()("enable-runtime-query-interrupt",
                           po::value<bool>(&enable_runtime_query_interrupt)
                               ->default_value(enable_runtime_query_interrupt)
@@ -268,6 +294,15 @@ void CommandLineOptions::fillOptions() {
       "max-session-duration",
       po::value<int>(&max_session_duration)->default_value(max_session_duration),
       "Maximum duration of active session.");
+  help_desc.add_options()(
+      "metrics-port",
+      po::value<int>(&metrics_port)->default_value(metrics_port),
+      "Port serving engine metrics in the Prometheus text format at /metrics. Disabled "
+      "when 0.");
+  help_desc.add_options()(
+      "metrics-address",
+      po::value<std::string>(&metrics_address)->default_value(metrics_address),
+      "Address the metrics port is bound to.");
   help_desc.add_options()("num-sessions",
                           po::value<int>(&system_parameters.num_sessions)
                               ->default_value(system_parameters.num_sessions),
@@ -362,6 +397,19 @@ void CommandLineOptions::fillOptions() {
       "enable-fsi",
       po::value<bool>(&g_enable_fsi)->default_value(g_enable_fsi)->implicit_value(true),
       "Enable foreign storage interface.");
+  help_desc.add_options()(
+      "enable-foreign-table-file-change-refresh",
+      po::value<bool>(&g_enable_foreign_table_file_change_refresh)
+          ->default_value(g_enable_foreign_table_file_change_refresh)
+          ->implicit_value(true),
+      "Enable refreshing the foreign tables with a FILE_CHANGE refresh timing type "
+      "when their local source files change.");
+  help_desc.add_options()(
+      "foreign-table-read-ahead-threads",
+      po::value<size_t>(&g_foreign_table_read_ahead_threads)
+          ->default_value(g_foreign_table_read_ahead_threads),
+      "Number of threads reading ahead the foreign table chunks a query is about to "
+      "scan. 0 disables the read ahead.");
   help_desc.add_options()("disk-cache-path",
                           po::value<std::string>(&disk_cache_config.path),
                           "Specify the path for the disk cache.");
@@ -383,6 +431,20 @@ void CommandLineOptions::fillOptions() {
                               ->default_value(g_enable_union)
                               ->implicit_value(true),
                           "Enable UNION ALL SQL clause.");
+  help_desc.add_options()(
+      "enable-concurrent-subqueries",
+      po::value<bool>(&g_enable_concurrent_subqueries)
+          ->default_value(g_enable_concurrent_subqueries)
+          ->implicit_value(true),
+      "Execute independent uncorrelated subqueries of a query in parallel.");
+  help_desc.add_options()(
+      "enable-filter-project-fusion",
+      po::value<bool>(&g_enable_filter_project_fusion)
+          ->default_value(g_enable_filter_project_fusion)
+          ->implicit_value(true),
+      "Push filters below computed projections, so that the filter, the projection and "
+      "a following aggregate execute as a single step instead of materializing the "
+      "projection.");
   help_desc.add_options()(
       "calcite-service-timeout",
       po::value<size_t>(&system_parameters.calcite_timeout)
@@ -400,6 +462,14 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "enable-stringdict-trigram-index",
+      po::value<bool>(&g_enable_stringdict_trigram_index)
+          ->default_value(g_enable_stringdict_trigram_index)
+          ->implicit_value(true),
+      "Use a trigram index of the dictionary strings to evaluate LIKE, ILIKE and REGEXP "
+      "on dictionary encoded columns, which is kept in memory and persisted with the "
+      "dictionary");
   help_desc.add_options()(
       "log-user-id",
       po::value<bool>(&Catalog_Namespace::g_log_user_id)
@@ -698,6 +768,33 @@ void CommandLineOptions::fillAdvancedOptions() {
       "size of the group by buffer (entry count in Query Memory Descriptor) and "
       "multiplying it by the number of count distinct expression and the size of bitmap "
       "required for each. For approx_count_distinct this is typically 8192 bytes.");
+  developer_desc.add_options()(
+      "max-integer-set-size",
+      po::value<size_t>(&g_max_integer_set_size)->default_value(g_max_integer_set_size),
+      "Maximum number of values of an 'expr IN (subquery)' turned into a bitmap or a "
+      "hash set when the watchdog is enabled.");
+  developer_desc.add_options()(
+      "enable-page-manifest",
+      po::value<bool>(&g_enable_page_manifest)
+          ->default_value(g_enable_page_manifest)
+          ->implicit_value(true),
+      "Write a manifest of the table page headers at every checkpoint and use it to "
+      "open tables at startup rather than reading the header of every page.");
+  developer_desc.add_options()(
+      "max-groupby-retry-partitions",
+      po::value<size_t>(&g_max_groupby_retry_partitions)
+          ->default_value(g_max_groupby_retry_partitions),
+      "Maximum number of partitions a group by query which ran out of host memory is "
+      "split into, the partitions get aggregated a kernel each. Also bounds the "
+      "partitions used for groupby-partition-bytes. Use 0 to disable.");
+  developer_desc.add_options()(
+      "groupby-partition-bytes",
+      po::value<size_t>(&g_groupby_partition_bytes)
+          ->default_value(g_groupby_partition_bytes),
+      "Target size of the hash table of a group by query on CPU. A query with more "
+      "estimated groups is aggregated in key partitions which keep the hash tables "
+      "within the CPU caches, at the cost of projecting its input once. Disabled with "
+      "0.");
   developer_desc.add_options()(
       "enable-filter-function",
       po::value<bool>(&g_enable_filter_function)
@@ -727,6 +824,11 @@ void CommandLineOptions::fillAdvancedOptions() {
       po::value<size_t>(&g_parallel_top_min)->default_value(g_parallel_top_min),
       "For ResultSets requiring a heap sort, the number of rows necessary to trigger "
       "parallelTop() to sort.");
+  developer_desc.add_options()(
+      "parallel-sort-min",
+      po::value<size_t>(&g_parallel_sort_min)->default_value(g_parallel_sort_min),
+      "For ResultSets requiring a full sort, the number of rows necessary to trigger "
+      "parallelSort() to sort.");
   developer_desc.add_options()(
       "parallel-top-max",
       po::value<size_t>(&g_parallel_top_max)->default_value(g_parallel_top_max),
@@ -741,6 +843,14 @@ void CommandLineOptions::fillAdvancedOptions() {
                                "deleted rows in a fragment at which to perform "
                                "automatic vacuuming. A number greater than 1 can "
                                "be used to disable automatic vacuuming.");
+  developer_desc.add_options()(
+      "optimize-vacuum-min-selectivity",
+      po::value<float>(&g_optimize_vacuum_min_selectivity)
+          ->default_value(g_optimize_vacuum_min_selectivity),
+      "Minimum selectivity for vacuuming a fragment on OPTIMIZE TABLE with the vacuum "
+      "option. This specifies the percentage (with a value of 0 implying 0% and a value "
+      "of 1 implying 100%) of deleted rows in a fragment at which the fragment is "
+      "compacted. Fragments below the threshold are left as is.");
 }
 
 namespace {
@@ -933,6 +1043,10 @@ void CommandLineOptions::validate() {
     throw std::runtime_error{"vacuum-min-selectivity cannot be less than 0."};
   }
   LOG(INFO) << "Vacuum Min Selectivity: " << g_vacuum_min_selectivity;
+
+  if (g_optimize_vacuum_min_selectivity < 0) {
+    throw std::runtime_error{"optimize-vacuum-min-selectivity cannot be less than 0."};
+  }
 }
 
 boost::optional<int> CommandLineOptions::parse_command_line(
@@ -1119,6 +1233,7 @@ boost::optional<int> CommandLineOptions::parse_command_line(
             << (authMetadata.allowLocalAuthFallback ? "enabled" : "disabled");
   LOG(INFO) << " ParallelTop min threshold: " << g_parallel_top_min;
   LOG(INFO) << " ParallelTop watchdog max: " << g_parallel_top_max;
+  LOG(INFO) << " ParallelSort min threshold: " << g_parallel_sort_min;
 
   boost::algorithm::trim_if(authMetadata.distinguishedName, boost::is_any_of("\"'"));
   boost::algorithm::trim_if(authMetadata.uri, boost::is_any_of("\"'"));
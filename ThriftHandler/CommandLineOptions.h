@@ -44,6 +44,8 @@ class CommandLineOptions {
     fillAdvancedOptions();
   }
   int http_port = 6278;
+  int metrics_port = 0;
+  std::string metrics_address = {"127.0.0.1"};
   size_t reserved_gpu_mem = 384 * 1024 * 1024;
   std::string base_path;
   DiskCacheConfig disk_cache_config;
@@ -160,6 +162,11 @@ extern bool g_enable_columnar_output;
 extern bool g_optimize_row_initialization;
 extern bool g_enable_overlaps_hashjoin;
 extern bool g_enable_hashjoin_many_to_many;
+extern bool g_enable_distance_rangejoin;
+extern bool g_enable_polygon_index;
+extern bool g_enable_range_join;
+extern bool g_enable_runtime_join_filters;
+extern size_t g_foreign_table_read_ahead_threads;
 extern size_t g_overlaps_max_table_size_bytes;
 extern double g_overlaps_target_entries_per_bin;
 extern bool g_strip_join_covered_quals;
@@ -191,14 +198,22 @@ extern bool g_enable_bump_allocator;
 extern size_t g_max_memory_allocation_size;
 extern size_t g_min_memory_allocation_size;
 extern bool g_enable_experimental_string_functions;
+extern size_t g_max_integer_set_size;
 extern bool g_enable_table_functions;
 extern bool g_enable_fsi;
+extern bool g_enable_foreign_table_file_change_refresh;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_interop;
 extern bool g_enable_union;
+extern bool g_enable_concurrent_subqueries;
+extern bool g_enable_filter_project_fusion;
+extern size_t g_max_groupby_retry_partitions;
+extern size_t g_groupby_partition_bytes;
 extern bool g_use_tbb_pool;
 extern bool g_enable_filter_function;
 extern size_t g_max_import_threads;
 extern bool g_enable_auto_metadata_update;
 extern float g_vacuum_min_selectivity;
+extern float g_optimize_vacuum_min_selectivity;
 extern bool g_read_only;
+extern bool g_enable_page_manifest;
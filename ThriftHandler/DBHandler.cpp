@@ -1010,6 +1010,40 @@ void DBHandler::value_to_thrift_column(const TargetValue& tv,
   }
 }
 
+// Appends the rows of column_batch to column, like value_to_thrift_column() does for
+// every one of them.
+void DBHandler::column_batch_to_thrift_column(const ResultSetColumnBatch& column_batch,
+                                              const SQLTypeInfo& ti,
+                                              TColumn& column) {
+  using Format = ResultSetColumnBatch::Format;
+  const bool nullable = !ti.get_notnull();
+  if (column_batch.format == Format::Fp) {
+    const auto& values = column_batch.fp_values;
+    column.data.real_col.insert(column.data.real_col.end(), values.begin(), values.end());
+    for (const auto is_null : column_batch.null_map) {
+      column.nulls.push_back(is_null && nullable);
+    }
+  } else if (column_batch.format == Format::Int && column_batch.string_dict_proxy) {
+    for (size_t row = 0; row < column_batch.size(); ++row) {
+      const bool is_null = column_batch.isNull(row);
+      column.data.str_col.push_back(is_null ? std::string()
+                                            : column_batch.getString(row));
+      column.nulls.push_back(is_null && nullable);
+    }
+  } else if (column_batch.format == Format::Int && !ti.is_decimal() &&
+             !ti.is_string()) {
+    const auto& values = column_batch.int_values;
+    column.data.int_col.insert(column.data.int_col.end(), values.begin(), values.end());
+    for (const auto is_null : column_batch.null_map) {
+      column.nulls.push_back(is_null && nullable);
+    }
+  } else {
+    for (size_t row = 0; row < column_batch.size(); ++row) {
+      value_to_thrift_column(column_batch.getTargetValue(row), ti, column);
+    }
+  }
+}
+
 TDatum DBHandler::value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti) {
   TDatum datum;
   const auto scalar_tv = boost::get<ScalarTargetValue>(&tv);
@@ -5392,6 +5426,11 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
                                   .empty(),
                          g_running_query_interrupt_freq,
                          g_pending_query_interrupt_freq};
+  std::shared_ptr<QueryProfile> query_profile;
+  if (explain_info.analyze()) {
+    query_profile = std::make_shared<QueryProfile>();
+    ra_executor.setQueryProfile(query_profile);
+  }
   auto execution_time_ms = _return.getExecutionTime() + measure<>::execution([&]() {
                              _return = ra_executor.executeRelAlgQuery(
                                  co, eo, explain_info.explain_plan, nullptr);
@@ -5407,7 +5446,18 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
   if (!filter_push_down_info.empty()) {
     return filter_push_down_info;
   }
-  if (explain_info.justExplain()) {
+  if (query_profile) {
+    // the profile replaces the rows, decode them anyway to account for the conversion
+    // cost the client would otherwise pay
+    auto clock_begin = timer_start();
+    if (rs) {
+      rs->moveToBegin();
+      while (!rs->getNextRow(true, true).empty()) {
+      }
+    }
+    query_profile->setResultConversionTime(timer_stop(clock_begin));
+    _return.updateResultSet(query_profile->toString(), ExecutionResult::Explaination);
+  } else if (explain_info.justExplain()) {
     _return.setResultType(ExecutionResult::Explaination);
   } else if (!explain_info.justCalciteExplain()) {
     _return.setResultType(ExecutionResult::QueryResult);
@@ -5547,18 +5597,22 @@ void DBHandler::convertRows(TQueryResult& _return,
     _return.row_set.is_columnar = true;
     std::vector<TColumn> tcolumns(results.colCount());
     while (first_n == -1 || fetched < first_n) {
-      const auto crt_row = results.getNextRow(true, true);
-      if (crt_row.empty()) {
+      const size_t max_rows =
+          first_n == -1 ? ResultSet::kDefaultBatchRowCount
+                        : std::min(ResultSet::kDefaultBatchRowCount,
+                                   static_cast<size_t>(first_n - fetched));
+      const auto batch = results.getNextBatch(max_rows, true, true);
+      if (batch.empty()) {
         break;
       }
-      ++fetched;
+      fetched += static_cast<int32_t>(batch.row_count);
       if (at_most_n >= 0 && fetched > at_most_n) {
         THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
                              std::to_string(at_most_n));
       }
       for (size_t i = 0; i < results.colCount(); ++i) {
-        const auto agg_result = crt_row[i];
-        value_to_thrift_column(agg_result, targets[i].get_type_info(), tcolumns[i]);
+        column_batch_to_thrift_column(
+            batch.columns[i], targets[i].get_type_info(), tcolumns[i]);
       }
     }
     for (size_t i = 0; i < results.colCount(); ++i) {
@@ -5567,22 +5621,28 @@ void DBHandler::convertRows(TQueryResult& _return,
   } else {
     _return.row_set.is_columnar = false;
     while (first_n == -1 || fetched < first_n) {
-      const auto crt_row = results.getNextRow(true, true);
-      if (crt_row.empty()) {
+      const size_t max_rows =
+          first_n == -1 ? ResultSet::kDefaultBatchRowCount
+                        : std::min(ResultSet::kDefaultBatchRowCount,
+                                   static_cast<size_t>(first_n - fetched));
+      const auto batch = results.getNextBatch(max_rows, true, true);
+      if (batch.empty()) {
         break;
       }
-      ++fetched;
+      fetched += static_cast<int32_t>(batch.row_count);
       if (at_most_n >= 0 && fetched > at_most_n) {
         THROW_MAPD_EXCEPTION("The result contains more rows than the specified cap of " +
                              std::to_string(at_most_n));
       }
-      TRow trow;
-      trow.cols.reserve(results.colCount());
-      for (size_t i = 0; i < results.colCount(); ++i) {
-        const auto agg_result = crt_row[i];
-        trow.cols.push_back(value_to_thrift(agg_result, targets[i].get_type_info()));
+      for (size_t row = 0; row < batch.row_count; ++row) {
+        TRow trow;
+        trow.cols.reserve(results.colCount());
+        for (size_t i = 0; i < results.colCount(); ++i) {
+          trow.cols.push_back(value_to_thrift(batch.columns[i].getTargetValue(row),
+                                              targets[i].get_type_info()));
+        }
+        _return.row_set.rows.push_back(std::move(trow));
       }
-      _return.row_set.rows.push_back(trow);
     }
   }
 }
@@ -5777,7 +5837,7 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
               first_n,
               at_most_n,
               /*just_validate=*/false,
-              g_enable_filter_push_down && !g_cluster,
+              g_enable_filter_push_down && !g_cluster && !explain_info.analyze(),
               explain_info,
               executor_index);
           if (explain_info.justCalciteExplain() && filter_push_down_requests.empty()) {
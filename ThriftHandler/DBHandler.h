@@ -648,6 +648,9 @@ class DBHandler : public OmniSciIf {
   static void value_to_thrift_column(const TargetValue& tv,
                                      const SQLTypeInfo& ti,
                                      TColumn& column);
+  static void column_batch_to_thrift_column(const ResultSetColumnBatch& column_batch,
+                                            const SQLTypeInfo& ti,
+                                            TColumn& column);
   static TDatum value_to_thrift(const TargetValue& tv, const SQLTypeInfo& ti);
   static std::string apply_copy_to_shim(const std::string& query_str);
 
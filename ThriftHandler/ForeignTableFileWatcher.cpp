@@ -0,0 +1,405 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ForeignTableFileWatcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+
+#include <boost/filesystem.hpp>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Catalog/RefreshTimeCalculator.h"
+#include "Catalog/SysCatalog.h"
+#include "DataMgr/ForeignStorage/AbstractFileStorageDataWrapper.h"
+#include "DataMgr/ForeignStorage/ForeignTableRefresh.h"
+#include "Shared/scope.h"
+#include "ThriftHandler/ForeignTableRefreshScheduler.h"
+
+namespace foreign_storage {
+
+#ifdef __linux__
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Foreign tables created, altered or dropped are picked up at that interval.
+constexpr std::chrono::seconds kTableSyncInterval{1};
+constexpr std::chrono::milliseconds kPollTimeout{100};
+// Used when the table has no REFRESH_MAX_STALENESS option.
+constexpr std::chrono::seconds kDefaultMaxStaleness{60};
+
+constexpr uint32_t kWatchedEvents = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE |
+                                    IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE |
+                                    IN_DELETE_SELF;
+
+// Whether the directory is a subdirectory, at any depth, of the parent directory.
+bool is_subdirectory(const std::string& directory, const std::string& parent_directory) {
+  return directory.size() > parent_directory.size() &&
+         directory.compare(0, parent_directory.size(), parent_directory) == 0 &&
+         directory[parent_directory.size()] == '/';
+}
+
+struct WatchedTable {
+  std::shared_ptr<Catalog_Namespace::Catalog> catalog;
+  std::string table_name;
+  std::string directory;
+  // Empty when all the files in the directory, and in its subdirectories, are sources
+  // of the table.
+  std::string file_name;
+  // False when some of the directories could not be watched, the table is then
+  // refreshed every max_staleness.
+  bool is_fully_watched{false};
+  std::chrono::seconds max_staleness;
+  // Time of the first change the table has not been refreshed with yet, if any.
+  std::optional<Clock::time_point> first_change_time;
+  Clock::time_point last_change_time;
+};
+
+class FileChangeTracker {
+ public:
+  FileChangeTracker(const int inotify_fd) : inotify_fd_(inotify_fd) {}
+
+  // Updates the watched tables, and their directories, to the foreign tables currently
+  // configured for file change refreshes.
+  void syncTables() {
+    std::map<std::pair<int, int>, WatchedTable> tables;
+    auto& sys_catalog = Catalog_Namespace::SysCatalog::instance();
+    for (const auto& catalog : sys_catalog.getCatalogsForAllDbs()) {
+      for (const auto foreign_table :
+           catalog->getAllForeignTablesForFileChangeRefresh()) {
+        const std::pair<int, int> table_key{catalog->getCurrentDB().dbId,
+                                            foreign_table->tableId};
+        WatchedTable table;
+        table.catalog = catalog;
+        table.table_name = foreign_table->tableName;
+        boost::filesystem::path path{
+            AbstractFileStorageDataWrapper::getFullFilePath(foreign_table)};
+        boost::system::error_code ec;
+        if (boost::filesystem::is_directory(path, ec)) {
+          table.directory = getCanonicalPath(path);
+        } else {
+          table.directory = getCanonicalPath(path.parent_path());
+          table.file_name = path.filename().string();
+        }
+        auto max_staleness_entry =
+            foreign_table->options.find(ForeignTable::REFRESH_MAX_STALENESS_KEY);
+        table.max_staleness = max_staleness_entry == foreign_table->options.end()
+                                  ? kDefaultMaxStaleness
+                                  : std::chrono::seconds{get_interval_duration(
+                                        max_staleness_entry->second)};
+        auto it = tables_.find(table_key);
+        if (it != tables_.end() && it->second.directory == table.directory &&
+            it->second.file_name == table.file_name) {
+          // the changes not refreshed yet carry over
+          table.first_change_time = it->second.first_change_time;
+          table.last_change_time = it->second.last_change_time;
+          table.is_fully_watched = it->second.is_fully_watched;
+        } else {
+          // the files may have changed while they were not watched, e.g. while the
+          // server was down
+          markChanged(table, Clock::now());
+        }
+        if (!table.is_fully_watched) {
+          // the subdirectories created later are watched as their creation is read
+          table.is_fully_watched =
+              addDirectoryWatches(table.directory, table.file_name.empty());
+        }
+        if (!table.is_fully_watched) {
+          // changes keep being recorded, so that the table is refreshed once its
+          // maximum staleness is reached
+          markChanged(table, Clock::now());
+        }
+        tables.emplace(table_key, std::move(table));
+      }
+    }
+    tables_ = std::move(tables);
+
+    for (auto it = directory_watches_.begin(); it != directory_watches_.end();) {
+      if (!isWatchedByTable(it->first)) {
+        inotify_rm_watch(inotify_fd_, it->second);
+        watched_directories_.erase(it->second);
+        it = directory_watches_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  // Reads the pending file change events and marks the tables whose files changed.
+  void readEvents() {
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+      const auto length = read(inotify_fd_, buffer, sizeof(buffer));
+      if (length <= 0) {
+        return;
+      }
+      const auto now = Clock::now();
+      for (const char* ptr = buffer; ptr < buffer + length;) {
+        const auto event = reinterpret_cast<const struct inotify_event*>(ptr);
+        ptr += sizeof(struct inotify_event) + event->len;
+        if (event->mask & IN_Q_OVERFLOW) {
+          // events were dropped, any table may have changed
+          for (auto& [table_key, table] : tables_) {
+            markChanged(table, now);
+          }
+          continue;
+        }
+        const auto directory_it = watched_directories_.find(event->wd);
+        if (directory_it == watched_directories_.end()) {
+          continue;
+        }
+        const std::string directory = directory_it->second;
+        if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+          // the directory was removed, the directory of a table is watched again by
+          // the next sync if it comes back, a subdirectory when it is created again
+          directory_watches_.erase(directory);
+          watched_directories_.erase(directory_it);
+        }
+        const std::string file_name = event->len ? event->name : "";
+        if ((event->mask & IN_ISDIR) && (event->mask & IN_MOVED_FROM) &&
+            !file_name.empty()) {
+          // the watches follow the moved directories, their paths would be wrong
+          removeDirectoryWatches(directory + "/" + file_name);
+        }
+        if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)) &&
+            !file_name.empty() && isWatchedRecursively(directory)) {
+          const auto subdirectory = directory + "/" + file_name;
+          if (!addDirectoryWatches(subdirectory, true)) {
+            for (auto& [table_key, table] : tables_) {
+              if (table.file_name.empty() &&
+                  is_subdirectory(subdirectory, table.directory)) {
+                table.is_fully_watched = false;
+              }
+            }
+          }
+        }
+        for (auto& [table_key, table] : tables_) {
+          if ((table.directory == directory &&
+               (table.file_name.empty() || file_name.empty() ||
+                table.file_name == file_name)) ||
+              (table.file_name.empty() && is_subdirectory(directory, table.directory))) {
+            markChanged(table, now);
+          }
+        }
+      }
+    }
+  }
+
+  // Refreshes the tables whose files have not changed for the debounce duration, or
+  // whose oldest change reached their maximum staleness. Returns whether any table was
+  // refreshed.
+  bool refreshDueTables(const std::chrono::milliseconds debounce_duration) {
+    bool at_least_one_table_refreshed = false;
+    const auto now = Clock::now();
+    for (auto& [table_key, table] : tables_) {
+      if (!table.first_change_time) {
+        continue;
+      }
+      if (now - table.last_change_time < debounce_duration &&
+          now - *table.first_change_time < table.max_staleness) {
+        continue;
+      }
+      // the changes made during the refresh are picked up by the next one
+      table.first_change_time.reset();
+      try {
+        refresh_foreign_table(*table.catalog, table.table_name, false);
+      } catch (std::exception& e) {
+        LOG(ERROR) << "File change refresh for table \"" << table.table_name
+                   << "\" resulted in an error. " << e.what();
+      }
+      at_least_one_table_refreshed = true;
+    }
+    return at_least_one_table_refreshed;
+  }
+
+ private:
+  static std::string getCanonicalPath(const boost::filesystem::path& path) {
+    boost::system::error_code ec;
+    const auto canonical_path = boost::filesystem::canonical(path, ec);
+    return ec ? path.string() : canonical_path.string();
+  }
+
+  static void markChanged(WatchedTable& table, const Clock::time_point now) {
+    if (!table.first_change_time) {
+      table.first_change_time = now;
+    }
+    table.last_change_time = now;
+  }
+
+  // Whether the directory is the directory of a table, or one of the subdirectories of
+  // a table whose sources are all the files of its directory.
+  bool isWatchedByTable(const std::string& directory) const {
+    return std::any_of(tables_.begin(), tables_.end(), [&directory](const auto& entry) {
+      const auto& table = entry.second;
+      return table.directory == directory ||
+             (table.file_name.empty() && is_subdirectory(directory, table.directory));
+    });
+  }
+
+  bool isWatchedRecursively(const std::string& directory) const {
+    return std::any_of(tables_.begin(), tables_.end(), [&directory](const auto& entry) {
+      const auto& table = entry.second;
+      return table.file_name.empty() && (table.directory == directory ||
+                                         is_subdirectory(directory, table.directory));
+    });
+  }
+
+  // Watches the directory, and all its subdirectories when recursive, the same as the
+  // file readers of the wrappers go through them. Returns whether all of them are
+  // watched.
+  bool addDirectoryWatches(const std::string& directory, const bool recursive) {
+    bool all_watched = addDirectoryWatch(directory);
+    if (!recursive) {
+      return all_watched;
+    }
+    boost::system::error_code ec;
+    for (boost::filesystem::recursive_directory_iterator it(directory, ec), end;
+         !ec && it != end;
+         it.increment(ec)) {
+      // the iterator does not follow the symbolic links to directories either
+      boost::system::error_code status_ec;
+      if (boost::filesystem::is_directory(it->symlink_status(status_ec))) {
+        all_watched = addDirectoryWatch(it->path().string()) && all_watched;
+      }
+    }
+    return all_watched && !ec;
+  }
+
+  // Stops watching the directory and its subdirectories.
+  void removeDirectoryWatches(const std::string& directory) {
+    for (auto it = directory_watches_.begin(); it != directory_watches_.end();) {
+      if (it->first == directory || is_subdirectory(it->first, directory)) {
+        inotify_rm_watch(inotify_fd_, it->second);
+        watched_directories_.erase(it->second);
+        it = directory_watches_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  bool addDirectoryWatch(const std::string& directory) {
+    if (directory_watches_.find(directory) != directory_watches_.end()) {
+      return true;
+    }
+    const int watch_descriptor =
+        inotify_add_watch(inotify_fd_, directory.c_str(), kWatchedEvents);
+    if (watch_descriptor < 0) {
+      // retried on every sync, only reported once
+      if (unwatchable_directories_.emplace(directory).second) {
+        LOG(WARNING) << "Could not watch directory \"" << directory
+                     << "\" for foreign table file changes. " << strerror(errno);
+      }
+      return false;
+    }
+    unwatchable_directories_.erase(directory);
+    directory_watches_.emplace(directory, watch_descriptor);
+    watched_directories_[watch_descriptor] = directory;
+    return true;
+  }
+
+  const int inotify_fd_;
+  std::map<std::pair<int, int>, WatchedTable> tables_;
+  std::map<std::string, int> directory_watches_;
+  std::map<int, std::string> watched_directories_;
+  std::set<std::string> unwatchable_directories_;
+};
+}  // namespace
+
+void ForeignTableFileWatcher::watchFiles(std::atomic<bool>& is_program_running) {
+  const int inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd < 0) {
+    LOG(ERROR) << "Could not start watching foreign table files. " << strerror(errno);
+    return;
+  }
+  ScopeGuard close_inotify_fd = [inotify_fd] { close(inotify_fd); };
+  FileChangeTracker tracker(inotify_fd);
+  auto next_sync_time = Clock::now();
+  while (is_program_running && is_watcher_running_) {
+    if (Clock::now() >= next_sync_time) {
+      try {
+        tracker.syncTables();
+      } catch (std::exception& e) {
+        LOG(ERROR) << "Could not update the foreign tables watched for file changes. "
+                   << e.what();
+      }
+      next_sync_time = Clock::now() + kTableSyncInterval;
+    }
+    pollfd poll_fd{inotify_fd, POLLIN, 0};
+    if (poll(&poll_fd, 1, kPollTimeout.count()) > 0) {
+      tracker.readEvents();
+    }
+    // Exit if watcher has been stopped asynchronously
+    if (!is_program_running || !is_watcher_running_) {
+      return;
+    }
+    if (tracker.refreshDueTables(debounce_duration_)) {
+      has_refreshed_table_ = true;
+      ForeignTableRefreshScheduler::invalidateQueryEngineCaches();
+    }
+  }
+}
+#endif
+
+void ForeignTableFileWatcher::start(std::atomic<bool>& is_program_running) {
+#ifdef __linux__
+  if (is_program_running && !is_watcher_running_) {
+    is_watcher_running_ = true;
+    watcher_thread_ =
+        std::thread([&is_program_running]() { watchFiles(is_program_running); });
+  }
+#else
+  LOG(WARNING) << "Foreign table file change refreshes are only supported on Linux.";
+#endif
+}
+
+void ForeignTableFileWatcher::stop() {
+  if (is_watcher_running_) {
+    is_watcher_running_ = false;
+    watcher_thread_.join();
+  }
+}
+
+void ForeignTableFileWatcher::setDebounceDuration(int64_t duration_in_milliseconds) {
+  debounce_duration_ = std::chrono::milliseconds{duration_in_milliseconds};
+}
+
+bool ForeignTableFileWatcher::isRunning() {
+  return is_watcher_running_;
+}
+
+bool ForeignTableFileWatcher::hasRefreshedTable() {
+  return has_refreshed_table_;
+}
+
+void ForeignTableFileWatcher::resetHasRefreshedTable() {
+  has_refreshed_table_ = false;
+}
+
+std::atomic<bool> ForeignTableFileWatcher::is_watcher_running_{false};
+std::atomic<std::chrono::milliseconds> ForeignTableFileWatcher::debounce_duration_{
+    std::chrono::milliseconds{1000}};
+std::thread ForeignTableFileWatcher::watcher_thread_;
+std::atomic<bool> ForeignTableFileWatcher::has_refreshed_table_{false};
+}  // namespace foreign_storage
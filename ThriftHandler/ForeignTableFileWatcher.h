@@ -0,0 +1,56 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ForeignTableFileWatcher.h
+ * @brief   Refreshes of the foreign tables with a FILE_CHANGE refresh timing type when
+ *          their source files change.
+ *
+ * The directories of the source files are watched through inotify, along with all their
+ * subdirectories when the whole directory is the source of the table. A table is
+ * refreshed once its files have not changed for the debounce duration, so that a file
+ * being written triggers a single refresh, but no later than the REFRESH_MAX_STALENESS
+ * of the table after the first change it has not picked up. The tables with directories
+ * which can't be watched are refreshed every REFRESH_MAX_STALENESS instead.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace foreign_storage {
+class ForeignTableFileWatcher {
+ public:
+  static void start(std::atomic<bool>& is_program_running);
+  static void stop();
+
+  // The following methods are for testing purposes only
+  static void setDebounceDuration(int64_t duration_in_milliseconds);
+  static bool isRunning();
+  static bool hasRefreshedTable();
+  static void resetHasRefreshedTable();
+
+ private:
+  static void watchFiles(std::atomic<bool>& is_program_running);
+
+  static std::atomic<bool> is_watcher_running_;
+  static std::atomic<std::chrono::milliseconds> debounce_duration_;
+  static std::thread watcher_thread_;
+  static std::atomic<bool> has_refreshed_table_;
+};
+}  // namespace foreign_storage
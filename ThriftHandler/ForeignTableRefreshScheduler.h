@@ -27,6 +27,9 @@ class ForeignTableRefreshScheduler {
   static void start(std::atomic<bool>& is_program_running);
   static void stop();
 
+  // Also called by the file watcher after its refreshes
+  static void invalidateQueryEngineCaches();
+
   // The following methods are for testing purposes only
   static void setWaitDuration(int64_t duration_in_seconds);
   static bool isRunning();
@@ -34,7 +37,6 @@ class ForeignTableRefreshScheduler {
   static void resetHasRefreshedTable();
 
  private:
-  static void invalidateQueryEngineCaches();
   static std::atomic<bool> is_scheduler_running_;
   static std::chrono::seconds thread_wait_duration_;
   static std::thread scheduler_thread_;
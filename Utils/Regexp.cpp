@@ -26,7 +26,147 @@
 
 #ifndef __CUDACC__
 #include <boost/regex.hpp>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "RegexpDfa.h"
+
+namespace {
+
+// A pattern compiled for matching, choosing the cheapest engine it allows: patterns
+// made of a literal optionally preceded or followed by ".*" are matched with memcmp
+// and a substring search, the others with RegexpDfa, or boost::regex for the syntax
+// RegexpDfa doesn't support.
+class CompiledRegexp {
+ public:
+  CompiledRegexp(const char* pattern, const size_t pattern_len)
+      : pattern_(pattern, pattern_len) {
+    if (parseLiteralPattern()) {
+      return;
+    }
+    kind_ = Kind::Dfa;
+    dfa_ = RegexpDfa::compile(pattern, pattern_len);
+    if (dfa_) {
+      return;
+    }
+    kind_ = Kind::Boost;
+    try {
+      boost_re_ = std::make_unique<boost::regex>(
+          pattern, pattern + pattern_len, boost::regex::extended);
+    } catch (std::runtime_error& error) {
+      // invalid patterns never match
+      boost_re_ = nullptr;
+    }
+  }
+
+  const std::string& getPattern() const { return pattern_; }
+
+  bool match(const char* str, const size_t str_len) {
+    const std::string_view str_view(str, str_len);
+    switch (kind_) {
+      case Kind::Exact:
+        return str_view == literal_;
+      case Kind::Prefix:
+        return str_len >= literal_.size() &&
+               !memcmp(str, literal_.data(), literal_.size());
+      case Kind::Suffix:
+        return str_len >= literal_.size() &&
+               !memcmp(str + str_len - literal_.size(), literal_.data(), literal_.size());
+      case Kind::Contains:
+        return str_view.find(literal_) != std::string_view::npos;
+      case Kind::Dfa:
+        return dfa_->match(str, str_len);
+      case Kind::Boost: {
+        if (!boost_re_) {
+          return false;
+        }
+        boost::cmatch what;
+        return boost::regex_match(str, str + str_len, what, *boost_re_);
+      }
+    }
+    return false;
+  }
+
+ private:
+  // Recognizes a literal, with escaped metacharacters, optionally preceded and followed
+  // by ".*", which matches any byte including newlines.
+  bool parseLiteralPattern() {
+    const auto is_meta = [](const char c) {
+      return c && strchr(".[]()*+?{}|^$\\", c) != nullptr;
+    };
+    const auto is_any = [this](const size_t pos) {
+      return pos + 1 < pattern_.size() && pattern_[pos] == '.' &&
+             pattern_[pos + 1] == '*';
+    };
+    size_t pos{0};
+    const bool leading_any = is_any(pos);
+    if (leading_any) {
+      pos += 2;
+    }
+    bool trailing_any{false};
+    while (pos < pattern_.size()) {
+      const auto c = pattern_[pos];
+      if (c == '\\' && pos + 1 < pattern_.size() && is_meta(pattern_[pos + 1])) {
+        literal_ += pattern_[pos + 1];
+        pos += 2;
+      } else if (is_any(pos) && pos + 2 == pattern_.size()) {
+        trailing_any = true;
+        pos += 2;
+      } else if (is_meta(c)) {
+        literal_.clear();
+        return false;
+      } else {
+        literal_ += c;
+        ++pos;
+      }
+    }
+    if (leading_any) {
+      kind_ = trailing_any ? Kind::Contains : Kind::Suffix;
+    } else {
+      kind_ = trailing_any ? Kind::Prefix : Kind::Exact;
+    }
+    return true;
+  }
+
+  enum class Kind { Exact, Prefix, Suffix, Contains, Dfa, Boost };
+
+  const std::string pattern_;
+  Kind kind_;
+  std::string literal_;
+  std::unique_ptr<RegexpDfa> dfa_;
+  std::unique_ptr<boost::regex> boost_re_;
+};
+
+// Patterns are literals, so a query keeps matching the same one: they are compiled
+// once per thread and looked up by their text, checking the last one used first.
+CompiledRegexp& get_compiled_regexp(const char* pattern, const size_t pattern_len) {
+  constexpr size_t kMaxCachedRegexps{64};
+  thread_local std::unordered_map<std::string, std::unique_ptr<CompiledRegexp>>
+      compiled_regexps;
+  thread_local CompiledRegexp* last_regexp{nullptr};
+  if (last_regexp && last_regexp->getPattern().size() == pattern_len &&
+      !memcmp(last_regexp->getPattern().data(), pattern, pattern_len)) {
+    return *last_regexp;
+  }
+  std::string pattern_str(pattern, pattern_len);
+  auto it = compiled_regexps.find(pattern_str);
+  if (it == compiled_regexps.end()) {
+    if (compiled_regexps.size() >= kMaxCachedRegexps) {
+      compiled_regexps.clear();
+    }
+    auto compiled_regexp = std::make_unique<CompiledRegexp>(pattern, pattern_len);
+    it = compiled_regexps.emplace(std::move(pattern_str), std::move(compiled_regexp))
+             .first;
+  }
+  last_regexp = it->second.get();
+  return *last_regexp;
+}
+
+}  // namespace
 #endif
 
 /*
@@ -46,9 +186,7 @@ extern "C" RUNTIME_EXPORT DEVICE bool regexp_like(const char* str,
 #ifndef __CUDACC__
   bool result;
   try {
-    boost::regex re(pattern, pat_len, boost::regex::extended);
-    boost::cmatch what;
-    result = boost::regex_match(str, str + str_len, what, re);
+    result = get_compiled_regexp(pattern, pat_len).match(str, str_len);
   } catch (std::runtime_error& error) {
     // LOG(ERROR) << "Regexp match error: " << error.what();
     result = false;
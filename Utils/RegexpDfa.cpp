@@ -0,0 +1,514 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RegexpDfa.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+struct RegexpDfa::Node {
+  enum class Type { Bytes, Empty, Concat, Alternate, Repeat };
+
+  explicit Node(const Type type) : type(type) {}
+
+  Type type;
+  std::bitset<256> bytes;  // for Bytes
+  std::vector<std::unique_ptr<Node>> children;
+  int min{0};  // for Repeat, max is negative when unbounded
+  int max{0};
+};
+
+namespace {
+
+// Larger bounded repetitions and patterns are left to boost::regex.
+constexpr int kMaxRepeat{255};
+constexpr size_t kMaxNfaStates{16384};
+
+bool is_quantifier(const char c) {
+  return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+// Character classes of the C locale, the one boost::regex uses by default.
+bool add_char_class(std::bitset<256>& bytes, const std::string& name) {
+  int (*is_in_class)(int){nullptr};
+  if (name == "alpha") {
+    is_in_class = isalpha;
+  } else if (name == "digit") {
+    is_in_class = isdigit;
+  } else if (name == "alnum") {
+    is_in_class = isalnum;
+  } else if (name == "upper") {
+    is_in_class = isupper;
+  } else if (name == "lower") {
+    is_in_class = islower;
+  } else if (name == "space") {
+    is_in_class = isspace;
+  } else if (name == "blank") {
+    is_in_class = isblank;
+  } else if (name == "punct") {
+    is_in_class = ispunct;
+  } else if (name == "print") {
+    is_in_class = isprint;
+  } else if (name == "graph") {
+    is_in_class = isgraph;
+  } else if (name == "cntrl") {
+    is_in_class = iscntrl;
+  } else if (name == "xdigit") {
+    is_in_class = isxdigit;
+  } else {
+    return false;
+  }
+  for (int c = 0; c < 128; ++c) {
+    if (is_in_class(c)) {
+      bytes.set(c);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+// Recursive descent parser of the supported subset, returns null on anything else.
+class RegexpDfa::Parser {
+ public:
+  Parser(const char* pattern, const size_t pattern_len)
+      : pattern_(pattern), pattern_len_(pattern_len) {}
+
+  std::unique_ptr<Node> parse() {
+    auto node = parseAlternate();
+    if (!node || pos_ != pattern_len_) {
+      return nullptr;
+    }
+    return node;
+  }
+
+ private:
+  bool atEnd() const { return pos_ >= pattern_len_; }
+
+  char peek() const { return pattern_[pos_]; }
+
+  std::unique_ptr<Node> parseAlternate() {
+    std::vector<std::unique_ptr<Node>> branches;
+    while (true) {
+      auto branch = parseConcat();
+      if (!branch) {
+        return nullptr;
+      }
+      branches.push_back(std::move(branch));
+      if (atEnd() || peek() != '|') {
+        break;
+      }
+      ++pos_;
+    }
+    if (branches.size() == 1) {
+      return std::move(branches.front());
+    }
+    auto node = std::make_unique<Node>(Node::Type::Alternate);
+    node->children = std::move(branches);
+    return node;
+  }
+
+  std::unique_ptr<Node> parseConcat() {
+    std::vector<std::unique_ptr<Node>> pieces;
+    while (!atEnd() && peek() != '|' && peek() != ')') {
+      auto piece = parsePiece();
+      if (!piece) {
+        return nullptr;
+      }
+      pieces.push_back(std::move(piece));
+    }
+    if (pieces.empty()) {
+      // empty branches and groups are valid for boost::regex, but rare
+      return nullptr;
+    }
+    if (pieces.size() == 1) {
+      return std::move(pieces.front());
+    }
+    auto node = std::make_unique<Node>(Node::Type::Concat);
+    node->children = std::move(pieces);
+    return node;
+  }
+
+  std::unique_ptr<Node> parsePiece() {
+    const bool is_anchor = peek() == '^' || peek() == '$';
+    auto atom = parseAtom();
+    if (!atom || atEnd() || !is_quantifier(peek())) {
+      return atom;
+    }
+    if (is_anchor) {
+      return nullptr;
+    }
+    auto node = std::make_unique<Node>(Node::Type::Repeat);
+    switch (pattern_[pos_++]) {
+      case '*':
+        node->min = 0;
+        node->max = -1;
+        break;
+      case '+':
+        node->min = 1;
+        node->max = -1;
+        break;
+      case '?':
+        node->min = 0;
+        node->max = 1;
+        break;
+      default:
+        if (!parseBound(node->min, node->max)) {
+          return nullptr;
+        }
+    }
+    if (!atEnd() && is_quantifier(peek())) {
+      return nullptr;
+    }
+    node->children.push_back(std::move(atom));
+    return node;
+  }
+
+  // Parses the "m}", "m,}" or "m,n}" following a '{'.
+  bool parseBound(int& min, int& max) {
+    if (!parseNumber(min)) {
+      return false;
+    }
+    max = min;
+    if (!atEnd() && peek() == ',') {
+      ++pos_;
+      max = -1;
+      if (!atEnd() && isdigit(peek()) && (!parseNumber(max) || max < min)) {
+        return false;
+      }
+    }
+    if (atEnd() || peek() != '}') {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  bool parseNumber(int& number) {
+    if (atEnd() || !isdigit(peek())) {
+      return false;
+    }
+    number = 0;
+    while (!atEnd() && isdigit(peek())) {
+      number = number * 10 + (pattern_[pos_++] - '0');
+      if (number > kMaxRepeat) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<Node> parseAtom() {
+    const auto c = pattern_[pos_++];
+    switch (c) {
+      case '(': {
+        auto node = parseAlternate();
+        if (!node || atEnd() || peek() != ')') {
+          return nullptr;
+        }
+        ++pos_;
+        return node;
+      }
+      case '.': {
+        auto node = std::make_unique<Node>(Node::Type::Bytes);
+        node->bytes.set();
+        return node;
+      }
+      case '[':
+        return parseBracket();
+      case '\\': {
+        // escaped letters and digits are classes, assertions or back references
+        if (atEnd() || isalnum(peek())) {
+          return nullptr;
+        }
+        return makeLiteral(pattern_[pos_++]);
+      }
+      case '^':
+        // matching the whole string, anchors are no-ops where they are meaningful
+        return pos_ == 1 ? std::make_unique<Node>(Node::Type::Empty) : nullptr;
+      case '$':
+        return atEnd() ? std::make_unique<Node>(Node::Type::Empty) : nullptr;
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+      case '}':
+      case ']':
+      case ')':
+      case '|':
+        return nullptr;
+      default:
+        return makeLiteral(c);
+    }
+  }
+
+  std::unique_ptr<Node> parseBracket() {
+    auto node = std::make_unique<Node>(Node::Type::Bytes);
+    bool negate{false};
+    if (!atEnd() && peek() == '^') {
+      negate = true;
+      ++pos_;
+    }
+    for (bool first = true;; first = false) {
+      if (atEnd()) {
+        return nullptr;
+      }
+      const auto c = static_cast<uint8_t>(peek());
+      if (c == ']' && !first) {
+        ++pos_;
+        break;
+      }
+      if (c == '\\') {
+        // boost::regex treats escapes in lists as classes
+        return nullptr;
+      }
+      if (c == '[' && pos_ + 1 < pattern_len_) {
+        const auto kind = pattern_[pos_ + 1];
+        if (kind == '=' || kind == '.') {
+          return nullptr;
+        }
+        if (kind == ':') {
+          const char* name_begin = pattern_ + pos_ + 2;
+          const char* pattern_end = pattern_ + pattern_len_;
+          const char* terminator = ":]";
+          const auto name_end =
+              std::search(name_begin, pattern_end, terminator, terminator + 2);
+          if (name_end == pattern_end ||
+              !add_char_class(node->bytes, std::string(name_begin, name_end))) {
+            return nullptr;
+          }
+          pos_ = name_end + 2 - pattern_;
+          continue;
+        }
+      }
+      ++pos_;
+      if (pos_ + 1 < pattern_len_ && peek() == '-' && pattern_[pos_ + 1] != ']') {
+        // ranges follow the collation order, which is the byte order for ASCII only
+        const auto last = static_cast<uint8_t>(pattern_[pos_ + 1]);
+        if (last == '[' || last == '\\' || c >= 128 || last >= 128 || last < c) {
+          return nullptr;
+        }
+        for (int b = c; b <= last; ++b) {
+          node->bytes.set(b);
+        }
+        pos_ += 2;
+      } else {
+        node->bytes.set(c);
+      }
+    }
+    if (negate) {
+      node->bytes.flip();
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> makeLiteral(const char c) {
+    auto node = std::make_unique<Node>(Node::Type::Bytes);
+    node->bytes.set(static_cast<uint8_t>(c));
+    return node;
+  }
+
+  const char* pattern_;
+  const size_t pattern_len_;
+  size_t pos_{0};
+};
+
+size_t RegexpDfa::nfaStateCount(const Node& node) {
+  // saturates past the limit, so that nested repetitions can't overflow
+  const auto saturate = [](const size_t count) {
+    return std::min(count, kMaxNfaStates + 1);
+  };
+  switch (node.type) {
+    case Node::Type::Bytes:
+      return 1;
+    case Node::Type::Empty:
+      return 0;
+    case Node::Type::Concat:
+    case Node::Type::Alternate: {
+      // alternatives are joined by a split state each
+      size_t count = node.type == Node::Type::Alternate ? node.children.size() - 1 : 0;
+      for (const auto& child : node.children) {
+        count = saturate(count + nfaStateCount(*child));
+      }
+      return count;
+    }
+    case Node::Type::Repeat: {
+      const auto child_count = nfaStateCount(*node.children.front());
+      const size_t optional_count = node.max < 0 ? 1 : node.max - node.min;
+      return saturate(node.min * child_count + optional_count * (child_count + 1));
+    }
+  }
+  return kMaxNfaStates + 1;
+}
+
+std::unique_ptr<RegexpDfa> RegexpDfa::compile(const char* pattern,
+                                              const size_t pattern_len) {
+  if (!pattern_len) {
+    return nullptr;
+  }
+  const auto root = Parser(pattern, pattern_len).parse();
+  if (!root || nfaStateCount(*root) > kMaxNfaStates) {
+    return nullptr;
+  }
+  std::unique_ptr<RegexpDfa> dfa(new RegexpDfa());
+  dfa->nfa_match_ = dfa->addNfaState({NfaState::Type::Match, -1, -1, -1});
+  dfa->nfa_start_ = dfa->buildNfa(*root, dfa->nfa_match_);
+  return dfa;
+}
+
+int32_t RegexpDfa::addNfaState(const NfaState& state) {
+  nfa_states_.push_back(state);
+  return nfa_states_.size() - 1;
+}
+
+int32_t RegexpDfa::buildNfa(const Node& node, const int32_t next) {
+  switch (node.type) {
+    case Node::Type::Bytes:
+      byte_sets_.push_back(node.bytes);
+      return addNfaState(
+          {NfaState::Type::Bytes, static_cast<int32_t>(byte_sets_.size() - 1), next, -1});
+    case Node::Type::Empty:
+      return next;
+    case Node::Type::Concat: {
+      auto entry = next;
+      for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+        entry = buildNfa(**it, entry);
+      }
+      return entry;
+    }
+    case Node::Type::Alternate: {
+      auto entry = buildNfa(*node.children.back(), next);
+      for (auto it = std::next(node.children.rbegin()); it != node.children.rend();
+           ++it) {
+        const auto branch = buildNfa(**it, next);
+        entry = addNfaState({NfaState::Type::Split, -1, branch, entry});
+      }
+      return entry;
+    }
+    case Node::Type::Repeat: {
+      const auto& child = *node.children.front();
+      auto entry = next;
+      if (node.max < 0) {
+        entry = addNfaState({NfaState::Type::Split, -1, -1, next});
+        const auto body = buildNfa(child, entry);
+        nfa_states_[entry].out = body;
+      } else {
+        // every optional copy either continues to the next one or skips the rest
+        for (int i = node.min; i < node.max; ++i) {
+          const auto body = buildNfa(child, entry);
+          entry = addNfaState({NfaState::Type::Split, -1, body, next});
+        }
+      }
+      for (int i = 0; i < node.min; ++i) {
+        entry = buildNfa(child, entry);
+      }
+      return entry;
+    }
+  }
+  return next;
+}
+
+void RegexpDfa::addToClosure(NfaStateSet& state_set,
+                             std::vector<bool>& visited,
+                             const int32_t nfa_state) const {
+  std::vector<int32_t> stack{nfa_state};
+  while (!stack.empty()) {
+    const auto crt = stack.back();
+    stack.pop_back();
+    if (visited[crt]) {
+      continue;
+    }
+    visited[crt] = true;
+    const auto& state = nfa_states_[crt];
+    if (state.type == NfaState::Type::Split) {
+      stack.push_back(state.out1);
+      stack.push_back(state.out);
+    } else {
+      state_set.push_back(crt);
+    }
+  }
+}
+
+int32_t RegexpDfa::getDfaState(const NfaStateSet& state_set) {
+  const auto it = dfa_state_ids_.find(state_set);
+  if (it != dfa_state_ids_.end()) {
+    return it->second;
+  }
+  DfaState dfa_state;
+  dfa_state.nfa_states = state_set;
+  dfa_state.accepting =
+      std::find(state_set.begin(), state_set.end(), nfa_match_) != state_set.end();
+  dfa_state.dead = state_set.empty();
+  dfa_state.transitions.fill(kUnknownTransition);
+  dfa_states_.push_back(std::move(dfa_state));
+  const int32_t id = dfa_states_.size() - 1;
+  dfa_state_ids_.emplace(state_set, id);
+  return id;
+}
+
+int32_t RegexpDfa::getStartState() {
+  if (dfa_start_ == kUnknownTransition) {
+    NfaStateSet state_set;
+    std::vector<bool> visited(nfa_states_.size());
+    addToClosure(state_set, visited, nfa_start_);
+    std::sort(state_set.begin(), state_set.end());
+    dfa_start_ = getDfaState(state_set);
+  }
+  return dfa_start_;
+}
+
+int32_t RegexpDfa::computeTransition(const int32_t dfa_state, const uint8_t byte) {
+  NfaStateSet state_set;
+  std::vector<bool> visited(nfa_states_.size());
+  for (const auto nfa_state : dfa_states_[dfa_state].nfa_states) {
+    const auto& state = nfa_states_[nfa_state];
+    if (state.type == NfaState::Type::Bytes && byte_sets_[state.bytes_idx].test(byte)) {
+      addToClosure(state_set, visited, state.out);
+    }
+  }
+  std::sort(state_set.begin(), state_set.end());
+  if (dfa_states_.size() >= kMaxDfaStates &&
+      dfa_state_ids_.find(state_set) == dfa_state_ids_.end()) {
+    resetDfa();
+    return getDfaState(state_set);
+  }
+  const auto next = getDfaState(state_set);
+  dfa_states_[dfa_state].transitions[byte] = next;
+  return next;
+}
+
+void RegexpDfa::resetDfa() {
+  dfa_states_.clear();
+  dfa_state_ids_.clear();
+  dfa_start_ = kUnknownTransition;
+}
+
+bool RegexpDfa::match(const char* str, const size_t str_len) {
+  auto dfa_state = getStartState();
+  for (size_t i = 0; i < str_len; ++i) {
+    if (dfa_states_[dfa_state].dead) {
+      return false;
+    }
+    const auto byte = static_cast<uint8_t>(str[i]);
+    auto next = dfa_states_[dfa_state].transitions[byte];
+    if (next == kUnknownTransition) {
+      next = computeTransition(dfa_state, byte);
+    }
+    dfa_state = next;
+  }
+  return dfa_states_[dfa_state].accepting;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RegexpDfa.h
+ * @brief   Linear time matcher for POSIX extended regular expressions.
+ *
+ * The pattern is compiled to a Thompson NFA, which is turned into a DFA lazily while
+ * matching: every DFA state is the set of NFA states reachable after the bytes seen so
+ * far, and its transitions are computed on first use and cached. Matching is a single
+ * pass over the string regardless of the pattern, unlike the backtracking boost::regex.
+ *
+ * Only the common subset of the syntax is supported: literals, '.', bracket expressions
+ * with ranges and character classes, grouping, alternation and the '*', '+', '?' and
+ * bounded repetitions. compile() returns null for anything else, including malformed
+ * patterns, so that the caller can fall back to boost::regex and its error handling.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class RegexpDfa {
+ public:
+  static std::unique_ptr<RegexpDfa> compile(const char* pattern,
+                                            const size_t pattern_len);
+
+  // Whether the whole string matches, like boost::regex_match. Not thread safe, since
+  // the DFA states are built while matching.
+  bool match(const char* str, const size_t str_len);
+
+ private:
+  struct Node;
+  class Parser;
+
+  RegexpDfa() = default;
+
+  struct NfaState {
+    enum class Type { Bytes, Split, Match };
+    Type type;
+    int32_t bytes_idx;  // into byte_sets_, for Bytes
+    int32_t out;
+    int32_t out1;  // the second branch of a Split
+  };
+
+  using NfaStateSet = std::vector<int32_t>;
+
+  static size_t nfaStateCount(const Node& node);
+  int32_t addNfaState(const NfaState& state);
+  // Builds the states matching the node and continuing to next, returns the entry state.
+  int32_t buildNfa(const Node& node, const int32_t next);
+
+  void addToClosure(NfaStateSet& state_set,
+                    std::vector<bool>& visited,
+                    const int32_t nfa_state) const;
+  int32_t getDfaState(const NfaStateSet& state_set);
+  int32_t getStartState();
+  int32_t computeTransition(const int32_t dfa_state, const uint8_t byte);
+  void resetDfa();
+
+  std::vector<NfaState> nfa_states_;
+  std::vector<std::bitset<256>> byte_sets_;
+  int32_t nfa_start_{-1};
+  int32_t nfa_match_{-1};
+
+  static constexpr int32_t kUnknownTransition{-1};
+  // Bounds the memory of the DFA: once reached, the states are discarded and built
+  // again as needed, which keeps the matching linear with a larger constant.
+  static constexpr size_t kMaxDfaStates{1024};
+
+  struct DfaState {
+    NfaStateSet nfa_states;
+    bool accepting;
+    bool dead;
+    std::array<int32_t, 256> transitions;
+  };
+  std::vector<DfaState> dfa_states_;
+  std::map<NfaStateSet, int32_t> dfa_state_ids_;
+  int32_t dfa_start_{kUnknownTransition};
+};
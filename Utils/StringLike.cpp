@@ -40,36 +40,139 @@ DEVICE static int inline lowercase(char c) {
   return c;
 }
 
-extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
-                                                         const int32_t str_len,
-                                                         const char* pattern,
-                                                         const int32_t pat_len) {
-  int i, j;
-  int search_len = str_len - pat_len + 1;
-  for (i = 0; i < search_len; ++i) {
-    for (j = 0; j < pat_len && pattern[j] == str[j + i]; ++j) {
+// The substring search and the comparisons below go through 16 bytes at a time on
+// x86-64, where SSE2 is always available. The device code and the other architectures
+// keep to one byte at a time.
+#if defined(__SSE2__) && !defined(__CUDACC__)
+#include <emmintrin.h>
+#define STRING_LIKE_SSE2
+#endif
+
+#ifdef STRING_LIKE_SSE2
+static inline __m128i lowercase_16(const __m128i chars) {
+  // the comparisons are signed, the bytes above 0x7F are negative and left alone
+  const auto is_upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+                                      _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+  return _mm_add_epi8(chars, _mm_and_si128(is_upper, _mm_set1_epi8('a' - 'A')));
+}
+#endif
+
+template <bool fold_case>
+DEVICE static inline bool string_bytes_match(const char* str,
+                                             const char* pattern,
+                                             const int32_t len) {
+  int32_t i = 0;
+#ifdef STRING_LIKE_SSE2
+  for (; i + 16 <= len; i += 16) {
+    auto str_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    if (fold_case) {
+      str_block = lowercase_16(str_block);
+    }
+    const auto pattern_block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(str_block, pattern_block)) != 0xFFFF) {
+      return false;
+    }
+  }
+#endif
+  for (; i < len; ++i) {
+    if ((fold_case ? lowercase(str[i]) : str[i]) != pattern[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Looks for the pattern in the string. When fold_case is true, the pattern is assumed
+// to be already converted to all lowercase. The candidate positions are the ones where
+// both the first and the last bytes of the pattern match, the bytes in between are
+// only compared there.
+template <bool fold_case>
+DEVICE static inline bool string_contains(const char* str,
+                                          const int32_t str_len,
+                                          const char* pattern,
+                                          const int32_t pat_len) {
+  if (pat_len == 0) {
+    return true;
+  }
+  const int32_t search_len = str_len - pat_len + 1;
+  int32_t i = 0;
+#ifdef STRING_LIKE_SSE2
+  const auto first = _mm_set1_epi8(pattern[0]);
+  const auto last = _mm_set1_epi8(pattern[pat_len - 1]);
+  for (; i + 16 <= search_len; i += 16) {
+    auto first_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    auto last_block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + pat_len - 1));
+    if (fold_case) {
+      first_block = lowercase_16(first_block);
+      last_block = lowercase_16(last_block);
+    }
+    unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_block, first),
+                                                    _mm_cmpeq_epi8(last_block, last)));
+    while (mask) {
+      const int32_t pos = i + __builtin_ctz(mask);
+      if (pat_len <= 2 ||
+          string_bytes_match<fold_case>(str + pos + 1, pattern + 1, pat_len - 2)) {
+        return true;
+      }
+      mask &= mask - 1;
     }
-    if (j >= pat_len) {
+  }
+#endif
+  for (; i < search_len; ++i) {
+    if (string_bytes_match<fold_case>(str + i, pattern, pat_len)) {
       return true;
     }
   }
   return false;
 }
 
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_simple(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len) {
+  return string_contains<false>(str, str_len, pattern, pat_len);
+}
+
 extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_simple(const char* str,
                                                           const int32_t str_len,
                                                           const char* pattern,
                                                           const int32_t pat_len) {
-  int i, j;
-  int search_len = str_len - pat_len + 1;
-  for (i = 0; i < search_len; ++i) {
-    for (j = 0; j < pat_len && pattern[j] == lowercase(str[j + i]); ++j) {
-    }
-    if (j >= pat_len) {
-      return true;
-    }
-  }
-  return false;
+  return string_contains<true>(str, str_len, pattern, pat_len);
+}
+
+// Patterns with a single '%' wildcard, at their end or at their start, and no other
+// wildcard. The pattern is passed without the wildcard and with its escape characters
+// removed.
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_prefix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len) {
+  return pat_len <= str_len && string_bytes_match<false>(str, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_prefix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len) {
+  return pat_len <= str_len && string_bytes_match<true>(str, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_like_suffix(const char* str,
+                                                         const int32_t str_len,
+                                                         const char* pattern,
+                                                         const int32_t pat_len) {
+  return pat_len <= str_len &&
+         string_bytes_match<false>(str + str_len - pat_len, pattern, pat_len);
+}
+
+extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_suffix(const char* str,
+                                                          const int32_t str_len,
+                                                          const char* pattern,
+                                                          const int32_t pat_len) {
+  return pat_len <= str_len &&
+         string_bytes_match<true>(str + str_len - pat_len, pattern, pat_len);
 }
 
 #define STR_LIKE_SIMPLE_NULLABLE(base_func)                                              \
@@ -86,6 +189,10 @@ extern "C" RUNTIME_EXPORT DEVICE bool string_ilike_simple(const char* str,
 
 STR_LIKE_SIMPLE_NULLABLE(string_like_simple)
 STR_LIKE_SIMPLE_NULLABLE(string_ilike_simple)
+STR_LIKE_SIMPLE_NULLABLE(string_like_prefix)
+STR_LIKE_SIMPLE_NULLABLE(string_ilike_prefix)
+STR_LIKE_SIMPLE_NULLABLE(string_like_suffix)
+STR_LIKE_SIMPLE_NULLABLE(string_ilike_suffix)
 
 #undef STR_LIKE_SIMPLE_NULLABLE
 
@@ -272,6 +379,20 @@ extern "C" RUNTIME_EXPORT DEVICE int32_t StringCompare(const char* s1,
   const char* s1_ = s1;
   const char* s2_ = s2;
 
+#ifdef STRING_LIKE_SSE2
+  const int32_t common_len = s1_len < s2_len ? s1_len : s2_len;
+  for (; s1_ + 16 <= s1 + common_len; s1_ += 16, s2_ += 16) {
+    const unsigned mask = _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1_)),
+                       _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2_))));
+    if (mask != 0xFFFF) {
+      // first mismatch, found again by the loop below
+      s1_ += __builtin_ctz(~mask);
+      s2_ = s2 + (s1_ - s1);
+      break;
+    }
+  }
+#endif
   while (s1_ < s1 + s1_len && s2_ < s2 + s2_len && *s1_ == *s2_) {
     s1_++;
     s2_++;